@@ -80,8 +80,7 @@ BndProcessor::BndProcessor (EnvPtr env, EnginePtr engine,
 BndProcessor::~BndProcessor()
 {
   if (ws_) {
-    ws_->decrUseCnt();
-    if (0 == ws_->getUseCnt()) {
+    if (0 == ws_->decrUseCnt()) {
       delete ws_;
     }
   }
@@ -204,8 +203,7 @@ void BndProcessor::process(NodePtr node, RelaxationPtr rel,
     should_resolve = false;
 
     if (ws_) {
-      ws_->decrUseCnt();
-      if (0 == ws_->getUseCnt()) {
+      if (0 == ws_->decrUseCnt()) {
         delete ws_;
       } 
       ws_ = 0;
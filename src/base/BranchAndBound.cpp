@@ -11,9 +11,11 @@
 
 #include <cmath>
 #include <iomanip>
+#include <sstream>
 
 #include "MinotaurConfig.h"
 #include "BranchAndBound.h"
+#include "Profiler.h"
 
 
 //#define DEBUG 1
@@ -362,6 +364,9 @@ void BranchAndBound::solve()
   WarmStartPtr ws;
   RelaxationPtr rel = RelaxationPtr();
   bool should_stop = false;
+#ifndef NDEBUG
+  bool watch_opts = false;
+#endif
 
   // initialize timer
   timer_->start();
@@ -386,6 +391,7 @@ void BranchAndBound::solve()
 
   // call heuristics before the root, if needed 
   for (HeurVector::iterator it=preHeurs_.begin(); it!=preHeurs_.end(); ++it) {
+    ProfScope ps(env_->getProfiler(), "heuristic");
     (*it)->solve(current_node, rel, solPool_);
   }
   tm_->setUb(solPool_->getBestSolutionValue());
@@ -420,6 +426,15 @@ void BranchAndBound::solve()
   }
 
 
+#ifndef NDEBUG
+  // Options read on every node should be resolved once, outside the loop.
+  // Flag those that are still looked up by name.
+  watch_opts = (env_ && logger_->getMaxLevel() >= LogDebug);
+  if (watch_opts) {
+    env_->getOptions()->watchLookups(true);
+  }
+#endif
+
   // solve root outside the loop. save the useful information.
   while(should_stop == false) {
 #if SPEW
@@ -512,6 +527,18 @@ void BranchAndBound::solve()
 #endif
     }
   }
+#ifndef NDEBUG
+  if (watch_opts) {
+    std::ostringstream lookups;
+    env_->getOptions()->watchLookups(false);
+    if (env_->getOptions()->writeLookups(lookups) > 0) {
+      logger_->msgStream(LogDebug) << me_ << "options looked up by name in "
+        << "the branch-and-bound loop:" << std::endl << lookups.str();
+    }
+  }
+#endif
+  // undo the modifications that are still applied to the relaxation.
+  nodeRlxr_->reset(NodePtr(), false);
   showStatus_(false, true);
   //logger_->msgStream(LogError) << " " << std::endl;
   logger_->msgStream(LogError) << "----------------------------------------------------------------------------------------------" << std::endl;
@@ -532,6 +559,7 @@ void BranchAndBound::writeStats(std::ostream &out)
     << stats_->timeUsed << std::endl
     << me_ << "nodes processed = " << stats_->nodesProc << std::endl
     << me_ << "nodes created   = " << tm_->getSize() << std::endl;
+  tm_->writeStats(out);
   nodePrcssr_->writeStats(out);
   nodePrcssr_->getBrancher()->writeStats(out);
   for (HeurVector::iterator it=preHeurs_.begin(); it!=preHeurs_.end(); ++it) {
@@ -12,7 +12,10 @@
  * \author Ashutosh Mahajan, Argonne National Laboratory
  */
 
+#include <algorithm>
+#include <cerrno>
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 #include <stack>
@@ -23,20 +26,32 @@
 #include "HessianOfLag.h"
 #include "LinearFunction.h"
 #include "QuadraticFunction.h"
+#include "SharedDAG.h"
 #include "VarBoundMod.h"
 #include "Variable.h"
 
+#define DIV_BY_ZERO_TOL 1e-12
+
 using namespace Minotaur;
 
+/// Last stamp given to a compiled tape.
+static UInt lastTapeStamp = 0;
+
 CGraph::CGraph()
   : aNodes_(0),
     changed_(false),
+    compiled_(false),
+    dag_(0),
     hInds_(0),
     hNnz_(0),
     hOffs_(0),
     hStarts_(0),
     gOffs_(0),
-    oNode_(0)
+    oNode_(0),
+    tDq_(0),
+    tNv_(0),
+    tOut_(0),
+    tStamp_(0)
 {
   dq_.clear();
   varNode_.clear();
@@ -46,6 +61,9 @@ CGraph::CGraph()
 
 CGraph::~CGraph()
 {
+  if (dag_) {
+    dag_->unlink(this);
+  }
   varNode_.clear();
   vq_.clear();
   dq_.clear();
@@ -169,6 +187,107 @@ NonlinearFunctionPtr CGraph::cloneWithVars(VariableConstIterator vbeg,
 }
 
 
+void CGraph::compile()
+{
+  std::map<const CNode*, UInt> slot;
+  std::map<const CNode*, UInt>::iterator mit;
+  CNodeVector kids;
+  UInt nt;
+
+  assert(oNode_);
+  setDAG(0);
+  tOp_.clear();
+  tChild_.clear();
+  tCStart_.clear();
+  tPar_.clear();
+  tPStart_.clear();
+  tVal_.clear();
+  tVInd_.clear();
+
+  if (true == changed_) {
+    simplifyDq_();
+    changed_ = false;
+  }
+
+  // variables first, in the same order as varNode_ and hStarts_.
+  for (VarNodeMap::iterator it=varNode_.begin(); it!=varNode_.end(); ++it) {
+    slot[it->second] = tOp_.size();
+    tOp_.push_back(OpVar);
+    tVal_.push_back(0.0);
+    tVInd_.push_back(it->first->getIndex());
+  }
+  tNv_ = tOp_.size();
+
+  // then constants: children of dependent nodes that are not evaluated
+  // themselves. Their values do not change until the graph is modified.
+  for (CNodeQ::iterator it=dq_.begin(); it!=dq_.end(); ++it) {
+    slot[*it] = 0;
+  }
+  for (CNodeQ::iterator it=dq_.begin(); it!=dq_.end(); ++it) {
+    getChildren_(*it, &kids);
+    for (CNodeVector::iterator c=kids.begin(); c!=kids.end(); ++c) {
+      if (slot.find(*c)==slot.end()) {
+        slot[*c] = tOp_.size();
+        tOp_.push_back(OpNum);
+        tVal_.push_back((*c)->getVal());
+      }
+    }
+  }
+  if (slot.find(oNode_)==slot.end()) {
+    slot[oNode_] = tOp_.size();
+    tOp_.push_back(OpNum);
+    tVal_.push_back(oNode_->getVal());
+  }
+  tCStart_.assign(tOp_.size()+1, 0);
+  tDq_ = tOp_.size();
+
+  // finally the dependent nodes in topological order.
+  for (CNodeQ::iterator it=dq_.begin(); it!=dq_.end(); ++it) {
+    slot[*it] = tOp_.size();
+    tOp_.push_back((*it)->getOp());
+    tVal_.push_back(0.0);
+    getChildren_(*it, &kids);
+    for (CNodeVector::iterator c=kids.begin(); c!=kids.end(); ++c) {
+      mit = slot.find(*c);
+      assert(mit!=slot.end() && mit->second<tOp_.size()-1);
+      tChild_.push_back(mit->second);
+    }
+    tCStart_.push_back(tChild_.size());
+  }
+  tOut_ = slot[oNode_];
+
+  // parents of each entry, for the sweeps of evalHessian().
+  nt = tOp_.size();
+  tPStart_.assign(nt+1, 0);
+  for (UInt i=0; i<tChild_.size(); ++i) {
+    ++tPStart_[tChild_[i]+1];
+  }
+  for (UInt i=0; i<nt; ++i) {
+    tPStart_[i+1] += tPStart_[i];
+  }
+  tPar_.resize(tChild_.size());
+  {
+    UIntVector pos(tPStart_.begin(), tPStart_.end()-1);
+    for (UInt k=tDq_; k<nt; ++k) {
+      for (UInt i=tCStart_[k]; i<tCStart_[k+1]; ++i) {
+        tPar_[pos[tChild_[i]]++] = k;
+      }
+    }
+  }
+
+  work_.val.resize(nt);
+  work_.g.resize(nt);
+  work_.gi.resize(nt);
+  work_.h.resize(nt);
+  work_.dep.resize(nt);
+  work_.seen.resize(nt);
+#pragma omp atomic capture
+  tStamp_ = ++lastTapeStamp;
+  compiled_ = true;
+  tapeHessSlots_();
+}
+
+
 void CGraph::computeBounds(double *lb, double *ub, int *error)
 {
   *error = 0;
@@ -183,8 +302,130 @@ void CGraph::computeBounds(double *lb, double *ub, int *error)
 }
 
 
+double CGraph::evalOp(OpCode op, const double *val, const UInt *c,
+                      const UInt *cend, int *error)
+{
+  const UInt l = c[0];
+  const UInt r = (cend-c>1) ? c[1] : l;
+  double v = 0.0;
+
+  switch (op) {
+  case (OpAbs):
+    v = fabs(val[l]);
+    break;
+  case (OpAcos):
+    v = acos(val[l]);
+    break;
+  case (OpAcosh):
+    v = acosh(val[l]);
+    break;
+  case (OpAsin):
+    v = asin(val[l]);
+    break;
+  case (OpAsinh):
+    v = asinh(val[l]);
+    break;
+  case (OpAtan):
+    v = atan(val[l]);
+    break;
+  case (OpAtanh):
+    v = atanh(val[l]);
+    break;
+  case (OpCeil):
+    v = ceil(val[l]);
+    break;
+  case (OpCos):
+    v = cos(val[l]);
+    break;
+  case (OpCosh):
+    v = cosh(val[l]);
+    break;
+  case (OpCPow):
+    v = pow(val[l], val[r]);
+    break;
+  case (OpDiv):
+    if (fabs(val[r]) > DIV_BY_ZERO_TOL) {
+      v = val[l]/val[r];
+    } else {
+      *error = 1;
+    }
+    break;
+  case (OpExp):
+    v = exp(val[l]);
+    break;
+  case (OpFloor):
+    v = floor(val[l]);
+    break;
+  case (OpIntDiv):
+    // always round towards zero
+    v = val[l]/val[r];
+    if (v>0) {
+      v = floor(v); 
+    } else {
+      v = ceil(v);
+    }
+    break;
+  case (OpLog):
+    v = log(val[l]);
+    break;
+  case (OpLog10):
+    v = log10(val[l]);
+    break;
+  case (OpMinus):
+    v = val[l] - val[r];
+    break;
+  case (OpMult):
+    v = val[l] * val[r];
+    break;
+  case (OpPlus):
+    v = val[l] + val[r];
+    break;
+  case (OpPow):
+  case (OpPowK):
+    v = pow(val[l], val[r]);
+    break;
+  case (OpRound):
+    v = floor(val[l]+0.5);
+    break;
+  case (OpSin):
+    v = sin(val[l]);
+    break;
+  case (OpSinh):
+    v = sinh(val[l]);
+    break;
+  case (OpSqr):
+    v = val[l]*val[l];
+    break;
+  case (OpSqrt):
+    v = sqrt(val[l]);
+    break;
+  case (OpSumList):
+    v = 0;
+    for (; c<cend; ++c) {
+      v += val[*c];
+    }
+    break;
+  case (OpTan):
+    v = tan(val[l]);
+    break;
+  case (OpTanh):
+    v = tanh(val[l]);
+    break;
+  case (OpUMinus):
+    v = -(val[l]);
+    break;
+  default:
+    assert(!"cannot evaluate!");
+  }
+  return v;
+}
+
+
 double CGraph::eval(const double *x, int *error)
 {
+  if (true==compiled_) {
+    return tapeEval_(x, &work_, error);
+  }
   for (CNodeQ::iterator it=vq_.begin(); it!=vq_.end(); ++it) {
     (*it)->eval(x, error);
   }
@@ -199,8 +440,26 @@ double CGraph::eval(const double *x, int *error)
 }
 
 
+double CGraph::eval(const double *x, CGraphWork *work, int *error) const
+{
+  if (false==compiled_) {
+    // the node-based code changes the nodes, it can not be used here.
+    *error = 1;
+    return 0.0;
+  }
+  if (work->val.size() != tOp_.size()) {
+    work->val.resize(tOp_.size());
+  }
+  return tapeEval_(x, work, error);
+}
+
+
 void CGraph::evalGradient(const double *x, double *grad_f, int *error)
 {
+  if (true==compiled_) {
+    evalGradient(x, grad_f, &work_, error);
+    return;
+  }
   eval(x, error);
   if (*error>0) {
     return;
@@ -215,6 +474,31 @@ void CGraph::evalGradient(const double *x, double *grad_f, int *error)
 }
 
 
+void CGraph::evalGradient(const double *x, double *grad_f, CGraphWork *work,
+                          int *error) const
+{
+  if (false==compiled_) {
+    *error = 1;
+    return;
+  }
+  if (work->g.size() != tOp_.size()) {
+    work->val.resize(tOp_.size());
+    work->g.resize(tOp_.size());
+  }
+  tapeEval_(x, work, error);
+  if (*error>0) {
+    return;
+  }
+  tapeGrad_(work, error);
+  if (*error>0) {
+    return;
+  }
+  for (UInt i=0; i<tNv_; ++i) {
+    grad_f[tVInd_[i]] += work->g[i];
+  }
+}
+
+
 void CGraph::evalHessian(double mult, const double *x, 
                          const LTHessStor *, double *values, int *error)
 {
@@ -224,6 +508,11 @@ void CGraph::evalHessian(double mult, const double *x,
   UInt nz = 0;
   bool use2 = true;
   std::stack<CNode *> st2;
+
+  if (true==compiled_) {
+    evalHessian(mult, x, values, &work_, error);
+    return;
+  }
   // double thresh = vq_.size();
 
   // thresh = thresh*(thresh-1.0)/2.0 * 0.75;
@@ -290,6 +579,369 @@ void CGraph::evalHessian(double mult, const double *x,
 }
 
 
+void CGraph::evalHessian(double mult, const double *x, double *values,
+                         CGraphWork *work, int *error) const
+{
+  const UInt nt = tOp_.size();
+  const UInt *c, *cend;
+  UInt l, r, k;
+  double *val, *g, *gi, *h;
+  BoolVector &dep = work->dep;
+  BoolVector &seen = work->seen;
+  UIntVector &heap = work->heap;
+  UIntVector &touched = work->touched;
+
+  if (false==compiled_) {
+    *error = 1;
+    return;
+  }
+  if (work->h.size() != nt || work->seen.size() != nt) {
+    // gi, h, dep and seen are zero between calls. Only touched entries are
+    // reset at the end of each column.
+    work->val.resize(nt);
+    work->g.resize(nt);
+    work->gi.assign(nt, 0.0);
+    work->h.assign(nt, 0.0);
+    work->dep.assign(nt, false);
+    work->seen.assign(nt, false);
+  }
+  val = &(work->val[0]);
+  g = &(work->g[0]);
+  gi = &(work->gi[0]);
+  h = &(work->h[0]);
+
+  // values and gradient found by an earlier call at x are reused.
+  tapeEval_(x, work, error);
+  if (*error>0) {
+    return;
+  }
+  tapeGrad_(work, error);
+  if (*error>0) {
+    return;
+  }
+
+  // One column of the hessian for each variable: a forward sweep finds the
+  // derivative of each entry w.r.t. the variable and a reverse sweep pushes
+  // the second order adjoints to the children. Only entries that depend on
+  // the variable, or that have a nonzero adjoint, are visited, as in
+  // fwdGrad2_() and revHess2_().
+  errno = 0;
+  for (UInt i=0; i<tNv_; ++i) {
+    if (hStarts_[i]==hStarts_[i+1]) {
+      continue;
+    }
+    // find the dependent entries by a search over parents.
+    touched.clear();
+    touched.push_back(i);
+    gi[i] = 1.0;
+    dep[i] = true;
+    seen[i] = true;
+    for (UInt t=0; t<touched.size(); ++t) {
+      k = touched[t];
+      for (UInt p=tPStart_[k]; p<tPStart_[k+1]; ++p) {
+        if (false==dep[tPar_[p]]) {
+          dep[tPar_[p]] = true;
+          seen[tPar_[p]] = true;
+          touched.push_back(tPar_[p]);
+        }
+      }
+    }
+    // children come before parents in the tape. A list of sums may have
+    // many children, of which few depend on the variable. These children
+    // add their derivatives to it, instead of it looking at all children.
+    heap.assign(touched.begin()+1, touched.end());
+    std::sort(heap.begin(), heap.end());
+    sumListGi_(i, gi);
+
+    for (UIntVector::const_iterator it=heap.begin(); it!=heap.end(); ++it) {
+      k = *it;
+      c = &(tChild_[tCStart_[k]]);
+      cend = &(tChild_[0])+tCStart_[k+1];
+      l = c[0];
+      r = (cend-c>1) ? c[1] : l;
+      switch (tOp_[k]) {
+      case (OpAbs):
+        if (val[l]>1e-10) {
+          gi[k] += 1.0;
+        } else if (val[l]<-1e-10) {
+          gi[k] -= 1.0;
+        }
+        break;
+      case (OpAcos):
+        gi[k] -= gi[l]/sqrt(1-val[l]*val[l]);
+        break;
+      case (OpAcosh):
+        gi[k] += gi[l]/sqrt(val[l]*val[l] - 1.0);
+        break;
+      case (OpAsin):
+        gi[k] += gi[l]/sqrt(1-val[l]*val[l]);
+        break;
+      case (OpAsinh):
+        gi[k] += gi[l]/sqrt(val[l]*val[l] + 1.0);
+        break;
+      case (OpAtan):
+        gi[k] += gi[l]/(1+val[l]*val[l]);
+        break;
+      case (OpAtanh):
+        gi[k] += gi[l]/(1-val[l]*val[l]);
+        break;
+      case (OpCeil):
+        if (fabs(val[l] - floor(0.5+val[l]))<1e-12) {
+          gi[k] += gi[l];
+        }
+        break;
+      case (OpCos):
+        gi[k] -= gi[l]*sin(val[l]);
+        break;
+      case (OpCosh):
+        gi[k] += gi[l]*sinh(val[l]);
+        break;
+      case (OpCPow):
+        gi[k] += gi[r]*log(val[l])*val[k];
+        break;
+      case (OpDiv):
+        gi[k] += gi[l]/val[r];
+        gi[k] -= gi[r]*val[l]/(val[r]*val[r]);
+        break;
+      case (OpExp):
+        gi[k] += gi[l]*val[k];
+        break;
+      case (OpFloor):
+        gi[k] += gi[l];
+        break;
+      case (OpLog):
+        gi[k] += gi[l]/val[l];
+        break;
+      case (OpLog10):
+        gi[k] += gi[l]/val[l]/log(10.0);
+        break;
+      case (OpMinus):
+        gi[k] += gi[l];
+        gi[k] -= gi[r];
+        break;
+      case (OpMult):
+        gi[k] += gi[l]*val[r];
+        gi[k] += gi[r]*val[l];
+        break;
+      case (OpPlus):
+        gi[k] += gi[l];
+        gi[k] += gi[r];
+        break;
+      case (OpPowK):
+        gi[k] += gi[l]*val[r]*pow(val[l],val[r]-1.0);
+        break;
+      case (OpSin):
+        gi[k] += gi[l]*cos(val[l]);
+        break;
+      case (OpSinh):
+        gi[k] += gi[l]*cosh(val[l]);
+        break;
+      case (OpSqr):
+        gi[k] += 2.0*gi[l]*val[l];
+        break;
+      case (OpSqrt):
+        gi[k] += gi[l]*0.5/val[k];
+        break;
+      case (OpSumList):
+        // already added by the dependent children, see below.
+        break;
+      case (OpTan):
+        {
+          double d2 = cos(val[l]);
+          gi[k] += gi[l]/(d2*d2);
+        }
+        break;
+      case (OpTanh):
+        {
+          double d2 = cosh(val[l]);
+          gi[k] += gi[l]/(d2*d2);
+        }
+        break;
+      case (OpUMinus):
+        gi[k] -= gi[l];
+        break;
+      case (OpIntDiv):
+        assert(!"derivative of OpIntDiv not implemented!");
+        break;
+      case (OpPow):
+        assert(!"derivative of OpPow not implemented!");
+        break;
+      case (OpRound):
+        assert(!"derivative of OpRound not implemented!");
+        break;
+      default:
+        break;
+      }
+      sumListGi_(k, gi);
+    }
+
+    // the reverse sweep takes the largest entry first, so that all parents
+    // of an entry are done before it.
+    std::make_heap(heap.begin(), heap.end());
+    while (!heap.empty()) {
+      std::pop_heap(heap.begin(), heap.end());
+      k = heap.back();
+      heap.pop_back();
+      c = &(tChild_[tCStart_[k]]);
+      cend = &(tChild_[0])+tCStart_[k+1];
+      l = c[0];
+      r = (cend-c>1) ? c[1] : l;
+      switch (tOp_[k]) {
+      case (OpAcos):
+        h[l] += -h[k]/sqrt(1-val[l]*val[l]) 
+              - g[k] * gi[l] * val[l]/pow((1.0-val[l]*val[l]),1.5);
+        break;
+      case (OpAcosh):
+        h[l] +=  h[k]/sqrt(val[l]*val[l]-1.0) 
+              - g[k] * gi[l] * val[l]/pow((val[l]*val[l]-1.0),1.5);
+        break;
+      case (OpAsin):
+        h[l] +=  h[k]/sqrt(1-val[l]*val[l]) 
+              + g[k] * gi[l] * val[l]/pow((1-val[l]*val[l]),1.5);
+        break;
+      case (OpAsinh):
+        h[l] +=  h[k]/sqrt(1+val[l]*val[l]) 
+              - g[k] * gi[l] * val[l]/pow((1+val[l]*val[l]),1.5);
+        break;
+      case (OpAtan):
+        {
+        double d = 1+val[l]*val[l];
+        h[l] +=  h[k]/d - 2.0 * g[k] * gi[l] * val[l]/(d*d); 
+        }
+        break;
+      case (OpAtanh):
+        {
+        double d = (1.0 - val[l]*val[l]);
+        h[l] +=  h[k]/d + 2.0 * g[k] * gi[l] * val[l]/(d*d);
+        }
+        break;
+      case (OpCeil):
+        h[l] +=  h[k];
+        break;
+      case (OpCos):
+        h[l] += -h[k]*sin(val[l]) - g[k] * gi[l] * val[k];
+        break;
+      case (OpCosh):
+        h[l] += h[k]*sinh(val[l]) + g[k] * gi[l] * val[k];
+        break;
+      case (OpCPow):
+        h[r] += h[k]*log(val[l])*val[k] 
+              + g[k]*gi[r]*log(val[l])*log(val[l])*val[k];
+        break;
+      case (OpDiv):
+        if (fabs(val[r]) > DIV_BY_ZERO_TOL) {
+          h[l] += h[k]/val[r] - g[k] * gi[r] /(val[r]*val[r]);
+          h[r] += -h[k]*val[l]/(val[r]*val[r]) 
+                - g[k] * gi[l] /(val[r]*val[r])
+                + g[k] * gi[r] * val[l] * 2.0 /(val[r]*val[r]*val[r]);
+        } else {
+          *error = 1;
+        }
+        break;
+      case (OpExp):
+        h[l] += h[k]*val[k] + g[k] * gi[l] * val[k];
+        break;
+      case (OpFloor):
+        h[l] += h[k];
+        break;
+      case (OpLog):
+        h[l] += h[k]/val[l] - g[k] * gi[l]  / (val[l] * val[l]);
+        break;
+      case (OpLog10):
+        h[l] += h[k]/val[l]/log(10) - g[k] * gi[l] / (log(10)*val[l]*val[l]);
+        break;
+      case (OpMinus):
+        h[l] += h[k];
+        h[r] -= h[k];
+        break;
+      case (OpMult):
+        h[l] += h[k]*val[r] + g[k]*gi[r];
+        h[r] += h[k]*val[l] + g[k]*gi[l];
+        break;
+      case (OpPlus):
+        h[l] += h[k];
+        h[r] += h[k];
+        break;
+      case (OpPowK):
+        h[l] += h[k] * val[r] * pow(val[l],val[r]-1.0) 
+              + g[k]*gi[l]*val[r]*(val[r]-1.0)*pow(val[l], val[r]-2.0);
+        break;
+      case (OpSin):
+        h[l] += h[k]*cos(val[l]) - g[k] * gi[l] * val[k];
+        break;
+      case (OpSinh):
+        h[l] += h[k]*cosh(val[l]) + g[k] * gi[l] * val[k];
+        break;
+      case (OpSqr):
+        h[l] += 2.0*h[k]*val[l] + g[k] * 2.0 * gi[l];
+        break;
+      case (OpSqrt):
+        if (fabs(val[k]) > DIV_BY_ZERO_TOL) {
+          h[l] += h[k]*0.5/val[k] - g[k] * gi[l] * 0.25 /(val[k] * val[l]); 
+        } else {
+          *error = 1;
+        }
+        break;
+      case (OpSumList):
+        if (h[k]!=0.0) {
+          for (; c<cend; ++c) {
+            h[*c] += h[k];
+          }
+        }
+        break;
+      case (OpTan):
+        {
+        double d = cos(val[l]);
+        d *= d;
+        h[l] += h[k]/d  + 2.0 * g[k] * gi[l] * tan(val[l])/d;
+        }
+        break;
+      case (OpTanh):
+        { 
+        double d = cosh(val[l]);
+        d *= d;
+        h[l] += h[k]/d  - 2.0 * g[k] * gi[l] * tanh(val[l])/d;
+        }
+        break;
+      case (OpUMinus):
+        h[l] -= h[k];
+        break;
+      default:
+        break;
+      }
+      // a child that does not depend on the variable gets a nonzero adjoint
+      // only from h[k], or from a dependent sibling of a binary operation.
+      if (0.0==h[k] && cend-&(tChild_[tCStart_[k]])>2) {
+        continue;
+      }
+      for (c=&(tChild_[tCStart_[k]]); c<cend; ++c) {
+        if (false==seen[*c] && 0.0!=h[*c]) {
+          seen[*c] = true;
+          touched.push_back(*c);
+          if (*c>=tDq_) {
+            heap.push_back(*c);
+            std::push_heap(heap.begin(), heap.end());
+          }
+        }
+      }
+    }
+    for (UInt j=hStarts_[i]; j<hStarts_[i+1]; ++j) {
+      values[hOffs_[j]] += mult * h[tHSlot_[j]];
+    }
+    for (UIntVector::const_iterator it=touched.begin(); it!=touched.end();
+         ++it) {
+      gi[*it] = 0.0;
+      h[*it] = 0.0;
+      dep[*it] = false;
+      seen[*it] = false;
+    }
+  }
+  if (errno != 0) {
+    *error = errno;
+  }
+}
+
+
 void CGraph::fillHessInds_(CNode *node, UIntQ *inds)
 {
   CNode **c1=0, **c2=0;
@@ -496,6 +1148,11 @@ void CGraph::fillJac(const double *x, double *values, int *error)
 {
   UInt *goff = &gOffs_[0];
 
+  if (true==compiled_) {
+    fillJac(x, values, &work_, error);
+    return;
+  }
+
   *error = 0;
   eval(x, error);
   if (*error>0) {
@@ -513,6 +1170,34 @@ void CGraph::fillJac(const double *x, double *values, int *error)
 }
 
 
+void CGraph::fillJac(const double *x, double *values, CGraphWork *work,
+                     int *error) const
+{
+  const UInt *goff = &gOffs_[0];
+
+  if (false==compiled_) {
+    *error = 1;
+    return;
+  }
+  *error = 0;
+  if (work->g.size() != tOp_.size()) {
+    work->val.resize(tOp_.size());
+    work->g.resize(tOp_.size());
+  }
+  tapeEval_(x, work, error);
+  if (*error>0) {
+    return;
+  }
+  tapeGrad_(work, error);
+  if (*error>0) {
+    return;
+  }
+  for (UInt i=0; i<tNv_; ++i, ++goff) {
+    values[*goff] += work->g[i];
+  }
+}
+
+
 void CGraph::finalHessStor(const LTHessStor *stor)
 {
   UInt *st_cols;
@@ -551,6 +1236,7 @@ void CGraph::finalHessStor(const LTHessStor *stor)
     }
   }
   assert (hNnz_ == hOffs_.size());
+  compile();
 }
 
 
@@ -563,6 +1249,7 @@ void CGraph::finalize()
   assert(oNode_);
   st.push(oNode_);
 
+  compiled_ = false;
   vq_.clear();
   dq_.clear();
 
@@ -1101,6 +1788,20 @@ VariablePtr CGraph::getVar(const CNode *cnode) const
 }
 
 
+void CGraph::getChildren_(const CNode *node, CNodeVector *kids) const
+{
+  kids->clear();
+  if (node->getListL()) {
+    kids->assign(node->getListL(), node->getListR());
+  } else if (1==node->numChild()) {
+    kids->push_back(node->getL());
+  } else if (2==node->numChild()) {
+    kids->push_back(node->getL());
+    kids->push_back(node->getR());
+  }
+}
+
+
 void CGraph::getVars(VariableSet *vars)
 {
   for (VarNodeMap::iterator it=varNode_.begin(); it!=varNode_.end(); ++it) {
@@ -1304,6 +2005,7 @@ void CGraph::removeVar(VariablePtr v, double val)
     vars_.erase(v);
     varNode_.erase(it);
     changed_ = true;
+    compiled_ = false;
   }
 }
 
@@ -1374,6 +2076,7 @@ void CGraph::revHess2_(std::stack<CNode *> *st2, double mult, UInt vind,
 void CGraph::simplifyDq_()
 {
   UInt id = 1;
+  compiled_ = false;
   for (CNodeQ::iterator it=dq_.begin(); it!=dq_.end();) {
     if (Constant==(*it)->findFType()) {
       it = dq_.erase(it);
@@ -1553,12 +2256,47 @@ void CGraph::subst(VariablePtr out, VariablePtr in, double rat)
   }
   delete nout;
   changed_ = true;
+  compiled_ = false;
+}
+
+
+void CGraph::setDAG(SharedDAG *dag)
+{
+  const UInt nt = tOp_.size();
+  UIntVector kids;
+
+  if (dag_) {
+    dag_->unlink(this);
+    dag_ = 0;
+  }
+  tDag_.clear();
+  if (!dag || false==compiled_) {
+    return;
+  }
+
+  tDag_.resize(nt);
+  for (UInt k=0; k<nt; ++k) {
+    if (k<tNv_) {
+      tDag_[k] = dag->addVar(tVInd_[k]);
+    } else if (k<tDq_) {
+      tDag_[k] = dag->addConst(tVal_[k]);
+    } else {
+      kids.clear();
+      for (UInt i=tCStart_[k]; i<tCStart_[k+1]; ++i) {
+        kids.push_back(tDag_[tChild_[i]]);
+      }
+      tDag_[k] = dag->addOp(tOp_[k], &(kids[0]), kids.size());
+    }
+  }
+  dag_ = dag;
+  dag_->link(this, nt);
 }
 
 
 void CGraph::setOut(CNode *node)
 {
   oNode_ = node;
+  compiled_ = false;
 }
 
 
@@ -1644,6 +2382,310 @@ void CGraph::varBoundMods(double lb, double ub, VarBoundModVector &mods,
 }
 
 
+void CGraph::varBoundsInPlace(double lb, double ub, double *vlb, double *vub,
+                              bool *is_inf, int *error)
+{
+  const double etol = 1e-7;
+  UInt i;
+
+  *is_inf = false;
+  *error = 0;
+  for (CNodeQ::iterator it=vq_.begin(); it!=vq_.end(); ++it) {
+    i = (*it)->getV()->getIndex();
+    (*it)->setBounds(vlb[i], vub[i]);
+  }
+  for (CNodeQ::iterator it=dq_.begin(); it!=dq_.end(); ++it) {
+    (*it)->updateBnd(error);
+  }
+  if (*error>0) {
+    return;
+  }
+
+  lb = fmax(lb, oNode_->getLb());
+  ub = fmin(ub, oNode_->getUb());
+  if (lb > ub+etol) {
+    *is_inf = true;
+    return;
+  }
+  oNode_->setBounds(lb, ub);
+  for (CNodeQ::reverse_iterator it=dq_.rbegin(); it!=dq_.rend(); ++it) {
+    (*it)->propBounds(is_inf, error);
+    if (true == *is_inf || *error>0) {
+      return;
+    }
+  }
+
+  for (CNodeQ::iterator it=vq_.begin(); it!=vq_.end(); ++it) {
+    i = (*it)->getV()->getIndex();
+    vlb[i] = fmax(vlb[i], (*it)->getLb());
+    vub[i] = fmin(vub[i], (*it)->getUb());
+  }
+}
+
+
+void CGraph::sumListGi_(UInt k, double *gi) const
+{
+  for (UInt p=tPStart_[k]; p<tPStart_[k+1]; ++p) {
+    if (OpSumList==tOp_[tPar_[p]]) {
+      gi[tPar_[p]] += gi[k];
+    }
+  }
+}
+
+
+double CGraph::tapeEval_(const double *x, CGraphWork *work, int *error) const
+{
+  const UInt nt = tOp_.size();
+  const UInt *c, *cend;
+  double *val = &(work->val[0]);
+  const double *dx, *dval;
+  int err = 0;
+  UInt k;
+
+  // The values in work are current if this tape found them at the same
+  // values of its variables, e.g. in an earlier call to find the gradient
+  // or the hessian at the same point.
+  if (work->stamp==tStamp_) {
+    for (k=0; k<tNv_; ++k) {
+      if (0!=memcmp(x+tVInd_[k], &(work->x[k]), sizeof(double))) {
+        break;
+      }
+    }
+    if (k==tNv_) {
+      return val[tOut_];
+    }
+  }
+  work->stamp = 0;
+  work->hasG = false;
+
+  // A linked graph evaluated with its own workspace takes the values from
+  // the shared DAG, if the DAG was evaluated at the same values of the
+  // variables of this graph.
+  if (dag_ && work==&work_ && 0!=(dx = dag_->getPoint())) {
+    for (k=0; k<tNv_; ++k) {
+      if (0!=memcmp(x+tVInd_[k], dx+tVInd_[k], sizeof(double))) {
+        break;
+      }
+    }
+    if (k==tNv_) {
+      dval = dag_->getValues();
+      for (k=0; k<nt; ++k) {
+        val[k] = dval[tDag_[k]];
+      }
+      setPoint_(x, work);
+      return val[tOut_];
+    }
+  }
+
+  errno = 0; //declared in cerrno
+  for (k=0; k<tNv_; ++k) {
+    val[k] = x[tVInd_[k]];
+  }
+  for (; k<tDq_; ++k) {
+    val[k] = tVal_[k];
+  }
+  for (; k<nt; ++k) {
+    c = &(tChild_[tCStart_[k]]);
+    cend = &(tChild_[0])+tCStart_[k+1];
+    val[k] = evalOp(tOp_[k], val, c, cend, &err);
+    if (0!=err) {
+      *error = 1;
+      return val[tOut_];
+    }
+  }
+  if (errno!=0) {
+    *error = errno;
+    return val[tOut_];
+  }
+  setPoint_(x, work);
+  return val[tOut_];
+}
+
+
+void CGraph::setPoint_(const double *x, CGraphWork *work) const
+{
+  work->x.resize(tNv_);
+  for (UInt k=0; k<tNv_; ++k) {
+    work->x[k] = x[tVInd_[k]];
+  }
+  work->stamp = tStamp_;
+}
+
+
+void CGraph::tapeGrad_(CGraphWork *work, int *error) const
+{
+  const UInt nt = tOp_.size();
+  const UInt *c, *cend;
+  const double *val = &(work->val[0]);
+  double *g = &(work->g[0]);
+  UInt l, r, k;
+
+  if (true==work->hasG) {
+    return;
+  }
+  errno = 0; // declared in cerrno
+  std::fill(g, g+nt, 0.0);
+  g[tOut_] = 1.0;
+  for (k=nt; k>tDq_; ) {
+    --k;
+    c = &(tChild_[tCStart_[k]]);
+    cend = &(tChild_[0])+tCStart_[k+1];
+    l = c[0];
+    r = (cend-c>1) ? c[1] : l;
+    switch (tOp_[k]) {
+    case (OpAbs):
+      if (val[l]>1e-10) {
+        g[l] += g[k];
+      } else if (val[l]<-1e-10) {
+        g[l] -= g[k];
+      }
+      break;
+    case (OpAcos):
+      g[l] -= g[k]/sqrt(1-val[l]*val[l]); // -1/sqrt(1-x^2)
+      break;
+    case (OpAcosh):
+      g[l] += g[k]/sqrt(val[l]*val[l] - 1.0); // 1/sqrt(x^2-1)
+      break;
+    case (OpAsin):
+      g[l] += g[k]/sqrt(1-val[l]*val[l]); // 1/sqrt(1-x^2)
+      break;
+    case (OpAsinh):
+      g[l] += g[k]/sqrt(val[l]*val[l] + 1.0); // 1/sqrt(x^2+1)
+      break;
+    case (OpAtan):
+      g[l] += g[k]/(1+val[l]*val[l]); // 1/(1+x^2)
+      break;
+    case (OpAtanh):
+      g[l] += g[k]/(1-val[l]*val[l]); // 1/(1-x^2)
+      break;
+    case (OpCeil):
+      if (fabs(val[l] - floor(0.5+val[l]))<1e-12) {
+        g[l] += g[k];
+      }
+      break;
+    case (OpCos):
+      g[l] -= g[k]*sin(val[l]);
+      break;
+    case (OpCosh):
+      g[l] += g[k]*sinh(val[l]);
+      break;
+    case (OpCPow):
+      g[r] += g[k]*log(val[l])*val[k];
+      break;
+    case (OpDiv):
+      if (fabs(val[r]) > DIV_BY_ZERO_TOL) {
+        g[l] += g[k]/val[r];
+        g[r] -= g[k]*val[l]/(val[r]*val[r]);
+      } else {
+        *error = 1;
+      }
+      break;
+    case (OpExp):
+      g[l] += g[k]*val[k]; // val[k] = e^(val[l])
+      break;
+    case (OpFloor):
+      g[l] += g[k]; // assuming that gradient is 1.
+      break;
+    case (OpIntDiv):
+      assert(!"derivative of OpIntDiv not implemented!");
+      break;
+    case (OpLog):
+      g[l] += g[k]/val[l];
+      break;
+    case (OpLog10):
+      g[l] += g[k]/val[l]/log(10.0);
+      break;
+    case (OpMinus):
+      g[l] += g[k];
+      g[r] -= g[k];
+      break;
+    case (OpMult):
+      g[l] += g[k]*val[r];
+      g[r] += g[k]*val[l];
+      break;
+    case (OpPlus):
+      g[l] += g[k];
+      g[r] += g[k];
+      break;
+    case (OpPow):
+      assert(!"derivative of OpPow not implemented!");
+      break;
+    case (OpPowK):
+      g[l] += g[k]*val[r]*pow(val[l], val[r]-1.0);
+      break;
+    case (OpRound):
+      assert(!"derivative of OpRound not implemented!");
+      break;
+    case (OpSin):
+      g[l] += g[k]*cos(val[l]);
+      break;
+    case (OpSinh):
+      g[l] += g[k]*cosh(val[l]);
+      break;
+    case (OpSqr):
+      g[l] += 2.0*g[k]*val[l]; 
+      break;
+    case (OpSqrt):
+      if (fabs(val[k]) > DIV_BY_ZERO_TOL) {
+        g[l] += g[k]*0.5/val[k];
+      } else {
+        *error = 1;
+      }
+      break;
+    case (OpSumList):
+      if (g[k]!=0.0) {
+        for (; c<cend; ++c) {
+          g[*c] += g[k];
+        }
+      }
+      break;
+    case (OpTan):
+      {
+        double d = cos(val[l]);
+        g[l] += g[k]/(d*d);
+      }
+      break;
+    case (OpTanh):
+      { 
+        double d = cosh(val[l]);
+        g[l] += g[k]/(d*d);
+      }
+      break;
+    case (OpUMinus):
+      g[l] -= g[k];
+      break;
+    default:
+      break;
+    }
+  }
+  if (errno != 0) {
+    *error = errno;
+  } else {
+    work->hasG = (0!=work->stamp);
+  }
+}
+
+
+void CGraph::tapeHessSlots_()
+{
+  UInt j = 0;
+  std::map<UInt, UInt> islot;
+
+  tHSlot_.clear();
+  if (false==compiled_ || hInds_.size() < hNnz_) {
+    return;
+  }
+  for (UInt i=0; i<tNv_; ++i) {
+    islot[tVInd_[i]] = i;
+  }
+  tHSlot_.reserve(hNnz_);
+  for (j=0; j<hNnz_; ++j) {
+    assert(islot.find(hInds_[j])!=islot.end());
+    tHSlot_.push_back(islot[hInds_[j]]);
+  }
+}
+
+
 void CGraph::write(std::ostream &out) const
 {
   if (oNode_) {
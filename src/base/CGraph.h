@@ -25,11 +25,33 @@ namespace Minotaur {
 
 class CGraph;
 class CNode;
+class SharedDAG;
 typedef CGraph* CGraphPtr;
 typedef std::deque<CNode *> CNodeQ;
 typedef std::vector<CNode *> CNodeVector;
 typedef std::map<ConstVariablePtr, CNode*, CompareVariablePtr> VarNodeMap;
 
+/**
+ * \brief Values computed while evaluating a compiled CGraph. The compiled
+ * graph is never written to by the evaluation routines that accept a
+ * CGraphWork, so different threads can evaluate the same CGraph
+ * concurrently as long as each one uses its own CGraphWork.
+ */
+struct CGraphWork {
+  CGraphWork() : stamp(0), hasG(false) {};
+  DoubleVector val; /// Value of each entry of the tape
+  DoubleVector x;   /// Values of the variables of the tape used for val
+  UInt stamp;       /// Stamp of the tape whose values are in val, 0 if none
+  DoubleVector g;   /// Derivative of the output w.r.t. an entry (reverse)
+  bool hasG;        /// True if g is the gradient at the point in x
+  DoubleVector gi;  /// Derivative of an entry w.r.t. one variable (forward)
+  DoubleVector h;   /// Second order adjoint of an entry
+  BoolVector dep;   /// True if an entry depends upon the seeded variable
+  BoolVector seen;  /// True if an entry is in touched
+  UIntVector heap;  /// Entries waiting for the reverse sweep, largest first
+  UIntVector touched; /// Entries whose gi, h or dep are nonzero
+};
+
 class CGraph : public NonlinearFunction {
 public:
   /// Default constructor.
@@ -44,6 +66,17 @@ public:
 
   NonlinearFunctionPtr cloneWithVars(VariableConstIterator, int *) const;
 
+  /**
+   * \brief Convert the graph into a flat tape: an array of opcodes,
+   * an array of child positions and an array of constants, stored in
+   * topological order. After this call, eval(), evalGradient(),
+   * evalHessian() and fillJac() sweep over the tape instead of the nodes.
+   * Values are no longer stored in the CNodes. Any change to the graph
+   * (finalize(), subst(), removeVar() etc.) discards the tape, and the graph
+   * must be compiled again. It is called by finalHessStor().
+   */
+  void compile();
+
   // base class method.
   NonlinearFunctionPtr getPersp(VariablePtr z, double eps, int *err) const;
 
@@ -56,14 +89,56 @@ public:
   // Evaluate at a given array.
   double eval(const double *x, int *err);
 
+  /**
+   * \brief Value of one operation of a tape.
+   *
+   * \param [in] op The operation.
+   * \param [in] val Values of the entries of the tape.
+   * \param [in] c Position of the first child of the entry.
+   * \param [in] cend One past the position of the last child.
+   * \param [out] error Set to 1 if a division by zero is attempted. Left
+   * unchanged otherwise.
+   */
+  static double evalOp(OpCode op, const double *val, const UInt *c,
+                       const UInt *cend, int *error);
+
+  /**
+   * \brief Evaluate a compiled graph at a given point, storing all
+   * intermediate values in a caller-owned workspace.
+   *
+   * \param [in] x The point at which the function is evaluated.
+   * \param [in,out] work Workspace. It is resized if required.
+   * \param [out] error Nonzero if some error occurs in evaluation, or if
+   * the graph is not compiled.
+   * \return The value of the function.
+   */
+  double eval(const double *x, CGraphWork *work, int *error) const;
+
   // Evaluate gradient at a given array.
   void evalGradient(const double *x, double *grad_f, int *error);
 
+  /**
+   * \brief Evaluate the gradient of a compiled graph using a caller-owned
+   * workspace. Gradient values are added to grad_f. error is set if the
+   * graph is not compiled.
+   */
+  void evalGradient(const double *x, double *grad_f, CGraphWork *work,
+                    int *error) const;
+
   // Evaluate hessian of at a given vector.
   void evalHessian(double mult, const double *x, 
                    const LTHessStor *stor, double *values, 
                    int *error);
 
+  /**
+   * \brief Evaluate the hessian of a compiled graph using a caller-owned
+   * workspace. mult times the hessian values are added to values, at
+   * offsets found by finalHessStor(). error is set if the graph is not
+   * compiled.
+   */
+  void evalHessian(double mult, const double *x, double *values,
+                   CGraphWork *work, int *error) const;
+
   // Fill hessian sparsity.
   void fillHessStor(LTHessStor *stor);
 
@@ -73,6 +148,13 @@ public:
   // Add gradient values to sparse Jacobian
   void fillJac(const double *x, double *values, int *error);
 
+  /**
+   * \brief Add gradient values of a compiled graph to sparse Jacobian, using
+   * a caller-owned workspace. error is set if the graph is not compiled.
+   */
+  void fillJac(const double *x, double *values, CGraphWork *work,
+               int *error) const;
+
   /**
    * After adding all the nodes of the graph, finalize is called to create the
    * forward and backward traversal queues, and related book-keeping.
@@ -90,6 +172,19 @@ public:
   // get type of function
   FunctionType getType() const;
 
+  /// Return true if the graph has been compiled into a tape.
+  bool isCompiled() const { return compiled_; };
+
+  /**
+   * \brief Link a compiled graph to a shared DAG. The entries of the tape
+   * are added to the DAG. When the graph is evaluated with its own
+   * workspace at the point where the DAG was last evaluated, the values are
+   * copied from the DAG. Compiling the graph again unlinks it.
+   *
+   * \param [in] dag The DAG, or NULL to unlink the graph.
+   */
+  void setDAG(SharedDAG *dag);
+
   // base method
   std::string getNlString(int *err);
 
@@ -198,6 +293,25 @@ public:
   void varBoundMods(double lb, double ub, VarBoundModVector &mods,
                     SolveStatus *status);
 
+  /**
+   * \brief Tighten bounds of the variables of the graph by one forward and
+   * one backward pass of interval arithmetic, like varBoundMods(), but
+   * starting from the given bounds of variables instead of those stored in
+   * the variables. The bounds of the nodes of the graph are overwritten, so
+   * two threads may not call this function on the same graph at once.
+   *
+   * \param [in] lb Lower bound on the value of the graph.
+   * \param [in] ub Upper bound on the value of the graph.
+   * \param [in,out] vlb Lower bounds of all variables, by index. Those of
+   * the variables of the graph are tightened in place.
+   * \param [in,out] vub Upper bounds of all variables, by index.
+   * \param [out] is_inf True if no point within the bounds can have a value
+   * in [lb, ub].
+   * \param [out] error Positive if an interval could not be computed.
+   */
+  void varBoundsInPlace(double lb, double ub, double *vlb, double *vub,
+                        bool *is_inf, int *error);
+
   // method to return all the dependent nodes of the cgraph.
   CNodeQ dNodes() {return dq_ ;} ;
 
@@ -210,6 +324,12 @@ private:
 
   bool changed_;
 
+  /// True if the tape (tOp_, tChild_ etc.) is in sync with the graph.
+  bool compiled_;
+
+  /// Shared DAG the tape is linked to, NULL if none.
+  SharedDAG *dag_;
+
   /// All dependent nodes, i.e. nodes with OpCode different from OpVar, OpInt
   /// and OpNum.
   CNodeQ dq_;
@@ -232,12 +352,60 @@ private:
   /// All nodes with OpCode OpVar.
   CNodeQ vq_;
 
+  /// Position of the first dependent entry in the tape. Entries before it
+  /// are variables (first tNv_) and constants.
+  UInt tDq_;
+
+  /// Node of the shared DAG of each entry of the tape.
+  UIntVector tDag_;
+
+  /// Children of entry i of the tape are in tChild_[tCStart_[i]] to
+  /// tChild_[tCStart_[i+1]-1].
+  UIntVector tChild_;
+  UIntVector tCStart_;
+
+  /// Parents of entry i of the tape are in tPar_[tPStart_[i]] to
+  /// tPar_[tPStart_[i+1]-1].
+  UIntVector tPar_;
+  UIntVector tPStart_;
+
+  /// Position in the tape of the variable of each hessian entry (hInds_).
+  UIntVector tHSlot_;
+
+  /// Number of variables in the tape. 
+  UInt tNv_;
+
+  /// Opcode of each entry of the tape.
+  std::vector<OpCode> tOp_;
+
+  /// Position of the output node in the tape.
+  UInt tOut_;
+
+  /// Value of each constant entry of the tape. Zero for other entries.
+  DoubleVector tVal_;
+
+  /// Index of the variable of each of the first tNv_ entries of the tape.
+  UIntVector tVInd_;
+
+  /**
+   * Different for each compiled tape, including tapes of the same graph
+   * compiled again. A workspace whose stamp is the same holds values
+   * computed by this tape.
+   */
+  UInt tStamp_;
+
+  /// Workspace used when a compiled graph is evaluated without one.
+  CGraphWork work_;
+
   CGraphPtr clone_(int *err) const;
 
   void fwdGrad_(CNode *node);
   void fwdGrad2_(std::stack<CNode *> *st2, CNode *node);
 
   void fillHessInds_(CNode *node, UIntQ *inds);
+
+  /// Fill kids with pointers to the children of a node, from left to right.
+  void getChildren_(const CNode *node, CNodeVector *kids) const;
   void fillHessInds2_(CNode *node, UIntQ *inds);
 
   /// Recursive function to check whether CGraph represents a sum of squares.
@@ -247,6 +415,27 @@ private:
   void revHess2_(std::stack<CNode *> *st2, double mult, UInt vind,
                  double *values, UInt *nz, int *error);
 
+  /// Add gi[k] to gi of each parent of entry k that is an OpSumList.
+  void sumListGi_(UInt k, double *gi) const;
+
+  /// Save the values of the variables of the tape in work, and its stamp.
+  void setPoint_(const double *x, CGraphWork *work) const;
+
+  /// Fill tHSlot_ from hInds_ for a compiled graph.
+  void tapeHessSlots_();
+
+  /**
+   * Forward sweep over the tape. Returns the value of the output. The sweep
+   * is skipped if work already has the values at the same point.
+   */
+  double tapeEval_(const double *x, CGraphWork *work, int *error) const;
+
+  /**
+   * Reverse sweep over the tape to find gradient. Values must be current.
+   * The sweep is skipped if work already has the gradient at this point.
+   */
+  void tapeGrad_(CGraphWork *work, int *error) const;
+
   /**
    *  Routine to propagate gradient by a reverse mode traversal.
    *
@@ -1291,7 +1291,8 @@ void CNode::propBounds(bool *is_inf, int *error)
     // TODO: Implement me
     break;
   case (OpCeil):
-    lb = floor(lb_);
+    // ceil(x) >= lb_ only gives x > ceil(lb_)-1.
+    lb = ceil(lb_)-1.0;
     ub = floor(ub_);
     l_->propBounds_(lb, ub, is_inf);
     break;
@@ -1316,8 +1317,9 @@ void CNode::propBounds(bool *is_inf, int *error)
     l_->propBounds_(lb, ub, is_inf);
     break;
   case (OpFloor):
+    // floor(x) <= ub_ only gives x < floor(ub_)+1.
     lb = ceil(lb_);
-    ub = ceil(ub_);
+    ub = floor(ub_)+1.0;
     l_->propBounds_(lb, ub, is_inf);
     break;
   case (OpIntDiv):
@@ -1374,12 +1376,12 @@ void CNode::propBounds(bool *is_inf, int *error)
           // std::cout << "new bounds = " << lb << " " << ub << std::endl;
         }
       } else if (isInt((r_->val_+1)/2.0)) { 
-        if (lb < 0) {
+        if (lb_ < 0) {
           lb = -pow(-lb_, 1.0/r_->val_);
         } else {
           lb = pow(lb_, 1.0/r_->val_);
         }
-        if (ub < 0) {
+        if (ub_ < 0) {
           ub = -pow(-ub_, 1.0/r_->val_);
         } else {
           ub = pow(ub_, 1.0/r_->val_);
@@ -1397,17 +1399,21 @@ void CNode::propBounds(bool *is_inf, int *error)
     // TODO: Implement me
     break;
   case (OpSqr):
-    ub = sqrt(ub);
-    lb = -ub;
-    l_->propBounds_(lb, ub, is_inf);
+    if (ub_<0.0) {
+      *is_inf = true;
+    } else {
+      ub = sqrt(ub_);
+      lb = -ub;
+      l_->propBounds_(lb, ub, is_inf);
+    }
     break;
   case (OpSqrt):
     if (ub_<0.0) {
       *is_inf = true;
-    } else if (lb>=0.0) {
-      l_->propBounds_(lb*lb, ub*ub, is_inf);
+    } else if (lb_>=0.0) {
+      l_->propBounds_(lb_*lb_, ub_*ub_, is_inf);
     } else {
-      l_->propBounds_(0.0, ub*ub, is_inf);
+      l_->propBounds_(0.0, ub_*ub_, is_inf);
     }
     break;
   case (OpSumList):
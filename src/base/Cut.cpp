@@ -118,6 +118,7 @@ void Cut::initInfo_(bool never_delete, bool never_disable)
   info_.cntSinceViol = 0;
   info_.numActive = 0;
   info_.parent_active_cnts = 0;
+  info_.storeId = -1;
 
   info_.hash = 0;
   info_.fixedScore = 0;
@@ -29,6 +29,7 @@ namespace Minotaur {
     UInt numActive;	     /// Updated only for cuts in problem.
     int parent_active_cnts;  /// No. of cuts active in a node with
                              /// un-processed children
+    int storeId;             /// Id in a CutStore, -1 if not stored.
 
     double hash;             /// Hash value of this cut.
     double varScore;         /// Variable score (changes every iteration.)
@@ -122,6 +123,9 @@ namespace Minotaur {
     /// Constraint associated with the cut
     void setCons(ConstraintPtr c) { cons_ = c; }
 
+    /// Replace the function of the cut. The old function is not freed.
+    void setFunction(FunctionPtr f) { f_ = f; }
+
     /// Set name of the cut
     void setName_(std::string name) { name_ = name; }
 
@@ -20,6 +20,7 @@
 #include "Engine.h"
 #include "Environment.h"
 #include "Function.h"
+#include "LinCutPool.h"
 #include "LinearFunction.h"
 #include "Logger.h"
 #include "Node.h"
@@ -35,6 +36,7 @@
 using namespace Minotaur;
 
 typedef std::list<CutPtr>::const_iterator CCIter;
+typedef CutVector::const_iterator CVIter;
 typedef std::vector<ConstraintPtr>::const_iterator ConstIter;
 
 CutMan2::CutMan2()
@@ -44,12 +46,14 @@ CutMan2::CutMan2()
     absTol_(5e-2),
     MaxInactiveInRel_(10000),
     PoolSize_(200),
+    MaxInactiveInPool_(1000),
     CtThrsh_(0),
     ctMngrtime_(0),
     PrntCntThrsh_(0),
     numCuts_(0)
 {
   stats_ = new CutStat();
+  linPool_ = new LinCutPool();
   logger_ = (LoggerPtr) new Logger(LogDebug2);
   stats_->numAddedCuts = 0;
   stats_->numDeletedCuts = 0;
@@ -65,14 +69,17 @@ CutMan2::CutMan2()
 
 CutMan2::CutMan2(EnvPtr env, ProblemPtr p)
   : env_(env),
+    logger_(env->getLogger()),
     p_(ProblemPtr()),
     absTol_(5e-2),
     MaxInactiveInRel_(100),
     PoolSize_(70),
+    MaxInactiveInPool_(1000),
     ctMngrtime_(0),
     PrntCntThrsh_(0)
 {
   stats_ = new CutStat();
+  linPool_ = new LinCutPool();
   timer_ = env_->getNewTimer();
   UInt n = p->getNumVars();
   hashVec_ = new double[n];
@@ -112,6 +119,7 @@ CutMan2::~CutMan2()
   //env_.reset();
   env_ = 0;
   pool_.clear();
+  delete linPool_;
   rel_.clear();
   //p_.reset();
   p_ = 0;
@@ -122,34 +130,28 @@ void CutMan2::updateRel(ConstSolutionPtr sol, ProblemPtr rel)
 {
   if ( numCuts_ >= CtThrsh_){
     timer_->start();
-    UInt m = rel->getNumCons();
-    const double *y = new double[m];
-    y = sol->getDualOfCons();
+    const double *y = sol->getDualOfCons();
     int i;
     CutPtr cut;
-    cutList temp;
+    CutInfo *info;
+    std::vector<UInt> out;
 
-    for (std::list<CutPtr>::iterator it = rel_.begin(); it != rel_.end();)
+    for (UInt k = 0; k < rel_.size(); ++k)
     {
-      cut = *it;
-      i =cut->getConstraint()->getId();
+      cut = rel_[k];
+      info = cut->getInfo();
+      i = cut->getConstraint()->getId();
       if (y[i] > 1e-6 || y[i] < -1e-6)
       {
-        ++(cut->getInfo()->cntSinceActive);
-        cut->getInfo()->cntSinceActive = 0;
-      } else {
-        ++(cut->getInfo()->cntSinceActive);
-      } 
-
-      if ( (y[i] > -1e-6 && y[i] < 1e-6) && cut->getInfo()->parent_active_cnts <=PrntCntThrsh_ &&  
-	   cut->getInfo()->cntSinceActive > MaxInactiveInRel_) 
-      {
-        temp.push_back(cut);
-        it = rel_.erase(it);
+        info->cntSinceActive = 0;
       } else {
-        ++it;
+        ++(info->cntSinceActive);
+        if (info->parent_active_cnts <= PrntCntThrsh_ &&
+            info->cntSinceActive > MaxInactiveInRel_) {
+          out.push_back(k);
+        }
       }
-    }  
+    }
     double al;
 
     if (stats_->numRelToPool != 0){
@@ -162,18 +164,27 @@ void CutMan2::updateRel(ConstSolutionPtr sol, ProblemPtr rel)
       }
       ctmngrInfo_.RelTr = MaxInactiveInRel_;
     }
-    if (temp.size() > 5){
-      for (std::list<CutPtr>::iterator it = temp.begin(); 
-  	   it != temp.end();++it){
-	cut = *it;
-        addToPool_(cut);
-        cut->getInfo()->cntSinceViol = 0;
-        rel->markDelete(cut->getConstraint());
-        stats_->numRelToPool++;
+    if (out.size() > 5){
+      // out is sorted. Compact rel_ in one pass.
+      UInt j = 0;
+      UInt o = 0;
+      for (UInt k = 0; k < rel_.size(); ++k) {
+        cut = rel_[k];
+        if (o < out.size() && out[o] == k) {
+          ++o;
+          addToPool_(cut);
+          cut->getInfo()->cntSinceViol = 0;
+          rel->markDelete(cut->getConstraint());
+          // the constraint is freed by delMarkedCons() below.
+          cut->setCons(ConstraintPtr());
+          stats_->numRelToPool++;
+        } else {
+          rel_[j] = cut;
+          ++j;
+        }
       }
+      rel_.resize(j);
       rel->delMarkedCons();
-    } else {
-	rel_.merge(temp);        
     }
     double a1 = timer_->query();
     ctMngrtime_ += a1;
@@ -192,6 +203,31 @@ void CutMan2::updatePool(ProblemPtr rel, ConstSolutionPtr sol)
     int toRel = 0;
     int deleted = 0;
     CutPtr cut;
+
+    // Linear cuts: score all of them with one product, then move the
+    // violated ones and drop the stale ones in one pass.
+    linPool_->evalScores(rel, x);
+    for (UInt k = 0; k < linPool_->getNumRows(); ++k) {
+      cut = linPool_->getCut(k);
+      if (!cut) {
+        continue;
+      }
+      score = linPool_->getScore(k);
+      if (score >= absTol_) {
+        // the function of the cut was freed when it left the relaxation.
+        cut->setFunction(linPool_->newFunction(k));
+        addToRel_(rel,cut,false);
+        toRel++;
+        stats_->numPoolToRel++;
+        linPool_->remove(k);
+      } else if (linPool_->getAge(k) > MaxInactiveInPool_ &&
+                 !cut->getInfo()->neverDelete) {
+        delete linPool_->remove(k);
+        deleted++;
+      }
+    }
+    linPool_->purge();
+
     for (std::list<CutPtr>::iterator it = pool_.begin(); it != pool_.end();)
     {
       cut = *it;
@@ -267,16 +303,39 @@ void CutMan2::addToPool_(CutPtr cut)
     }
   }
 */
-  if (pool_.size() > PoolSize_ - 1){
-    std::list<CutPtr>::iterator it = pool_.begin();
-    it = pool_.erase(it);
+  bool lin = LinCutPool::accepts(cut);
+
+  // Make room by deleting the oldest cut of the same kind, if any. Cuts
+  // that must never be deleted stay in the pool.
+  if (getNumDisabledCuts() > PoolSize_ - 1){
+    if ((lin && linPool_->getSize() > 0) || pool_.empty()) {
+      delete linPool_->popOldest();
+    } else {
+      for (std::list<CutPtr>::iterator it = pool_.begin(); it != pool_.end();
+           ++it) {
+        if (!(*it)->getInfo()->neverDelete) {
+          delete *it;
+          pool_.erase(it);
+          break;
+        }
+      }
+    }
   }
 
-  pool_.push_back(cut);
+  if (lin) {
+    linPool_->add(cut);
+  } else {
+    pool_.push_back(cut);
+  }
   cut->getInfo()->inRel = false;
 
 }
 
+UInt CutMan2::getNumDisabledCuts() const
+{
+  return pool_.size() + linPool_->getSize();
+}
+
 void CutMan2::NodeIsBranched(NodePtr node, ConstSolutionPtr sol, int num)
 {
   CutPtr cut;
@@ -285,7 +344,7 @@ void CutMan2::NodeIsBranched(NodePtr node, ConstSolutionPtr sol, int num)
   int i;
   timer_->start();
     
-  for (CCIter it=rel_.begin(); it != rel_.end(); ++it){
+  for (CVIter it=rel_.begin(); it != rel_.end(); ++it){
     cut = *it;
     i = cut->getConstraint()->getId();
     if (y[i] > 1e-6 || y[i] < -1e-6){
@@ -327,10 +386,10 @@ void CutMan2::NodeIsProcessed(NodePtr node)
   timer_->stop();
 
   stats_->RelSize += rel_.size();
-  stats_->PoolSize += pool_.size();
+  stats_->PoolSize += getNumDisabledCuts();
 
   ctmngrInfo_.RelSize = rel_.size();
-  ctmngrInfo_.PoolSize = pool_.size();
+  ctmngrInfo_.PoolSize = getNumDisabledCuts();
   ctmngrInfo_.RelToPool = stats_->numRelToPool;
   ctmngrInfo_.PoolToRel = stats_->numPoolToRel;
   ctmngrInfo_.RelAve = (double)stats_->RelSize/stats_->callNums;
@@ -357,20 +416,45 @@ void CutMan2::addCut(CutPtr c)
   addToRel_(c);
 }
 
+
+void CutMan2::addCutToPool(CutPtr c)
+{
+  addToPool_(c);
+}
+
+
+std::vector<ConstraintPtr> CutMan2::getPoolCons()
+{
+  std::vector<ConstraintPtr> cp;
+
+  // cuts moved from the relaxation have no constraint.
+  for (CCIter it=pool_.begin(); it!=pool_.end(); ++it) {
+    if ((*it)->getConstraint()) {
+      cp.push_back((*it)->getConstraint());
+    }
+  }
+  for (UInt k=0; k<linPool_->getNumRows(); ++k) {
+    if (linPool_->getCut(k) && linPool_->getCut(k)->getConstraint()) {
+      cp.push_back(linPool_->getCut(k)->getConstraint());
+    }
+  }
+  return cp;
+}
+
 void CutMan2::writeStats(std::ostream &out) const
 {
   out << "nothing to do" << std::endl;
 }
 void CutMan2::writeStat()
 {
-  std::cout
+  logger_->msgStream(LogInfo)
     << "CutManager: number of cuts added........................ = " << stats_->numAddedCuts << std::endl
     << "CutManager: number of cuts deleted...................... = " << stats_->numDeletedCuts << std::endl
     << "CutManager: number of cuts moved from relaxation to pool = " << stats_->numRelToPool << std::endl
     << "CutManager: number of cuts moved from pool to relaxation = " << stats_->numPoolToRel << std::endl
     << "CutManager: number of calls............................. = " << stats_->callNums << std::endl
     << "CutManager: size of rel................................. = " << rel_.size() << std::endl  
-    << "CutManager: size of pool................................ = " << pool_.size() << std::endl
+    << "CutManager: size of pool................................ = " << getNumDisabledCuts() << std::endl
     << "CutManager: average size of rel......................... = " << (double)stats_->RelSize/stats_->callNums << std::endl
     << "CutManager: average size of pool........................ = " << (double)stats_->PoolSize/stats_->callNums << std::endl
     << "CutManager: MaxInactiveInRel............................ = " << MaxInactiveInRel_ << std::endl
@@ -21,7 +21,7 @@
 namespace Minotaur {
 
   class Constraint;
-
+  class LinCutPool;
   class Node;
   class Timer;
   typedef Constraint* ConstraintPtr; //changed from boost-> simple
@@ -58,6 +58,9 @@ namespace Minotaur {
     // base class method
     void addCut(CutPtr c);
 
+    // base class method
+    void addCutToPool(CutPtr c);
+
     // base class method
     void addCuts(CutVectorIter cbeg, CutVectorIter cend);
 
@@ -65,10 +68,14 @@ namespace Minotaur {
 
     UInt getNumEnabledCuts() const { return rel_.size(); };
 
-    UInt getNumDisabledCuts() const { return pool_.size(); };
+    UInt getNumDisabledCuts() const;
 
     UInt getNumNewCuts() const { return 0;};
 
+    // base class method. Cuts that were moved from the relaxation have no
+    // constraint and are left out.
+    std::vector<ConstraintPtr> getPoolCons();
+
     // base class method
     ConstraintPtr addCut(ProblemPtr rel,FunctionPtr fn, double lb, double ub, 
                          bool directToRel, bool neverDelete);
@@ -115,11 +122,14 @@ namespace Minotaur {
     ctMngrInfo getInfo() {return ctmngrInfo_;}
 
   private:
-    /// Cut pool
+    /// Cuts in the pool whose functions are not linear.
     cutList pool_;
 
-    /// list of cuts in the relaxation
-    cutList rel_;
+    /// Linear cuts in the pool, stored as rows of a sparse matrix.
+    LinCutPool *linPool_;
+
+    /// Cuts in the relaxation.
+    CutVector rel_;
 
     /// Map of active cuts to a node
     std::map< NodePtr , cutList > NodeCutsMap_;
@@ -163,6 +173,12 @@ namespace Minotaur {
     /// Maximum pool size
     UInt PoolSize_;
 
+    /**
+     * \brief Maximum number of calls to updatePool in which a linear cut in
+     * the pool is not violated before it is deleted.
+     */
+    UInt MaxInactiveInPool_;
+
     /// CutMan activation threshod
     UInt CtThrsh_;
 
@@ -0,0 +1,186 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+/**
+ * \file CutStore.cpp
+ * \brief Implement the methods of CutStore class.
+ * \author The Minotaur Team
+ */
+
+#include <cassert>
+
+#include "MinotaurConfig.h"
+#include "Constraint.h"
+#include "Cut.h"
+#include "CutStore.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Relaxation.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+CutStore::CutStore()
+  : numCuts_(0)
+{
+  for (UInt k=0; k<maxChunks_; ++k) {
+    chunks_[k] = 0;
+  }
+}
+
+
+CutStore::~CutStore()
+{
+  UInt n = getNumCuts();
+  const StoredCut *c;
+
+  for (UInt i=0; i<n; ++i) {
+    c = get_(i);
+    delete [] c->idx;
+    delete [] c->val;
+    delete c;
+  }
+  for (UInt k=0; k<maxChunks_; ++k) {
+    if (chunks_[k]) {
+      delete [] chunks_[k];
+    }
+  }
+}
+
+
+int CutStore::add(CutPtr cut, UInt owner)
+{
+  LinearFunctionPtr lf = cut->getFunction()->getLinearFunction();
+  StoredCut *c;
+  UInt i = 0;
+  UInt id, chunk, pos;
+  bool full = false;
+
+  if (!lf) {
+    return -1;
+  }
+
+  c = new StoredCut();
+  c->nz = lf->getNumTerms();
+  c->idx = new UInt[c->nz];
+  c->val = new double[c->nz];
+  for (VariableGroupConstIterator it=lf->termsBegin(); it!=lf->termsEnd();
+       ++it, ++i) {
+    c->idx[i] = it->first->getIndex();
+    c->val[i] = it->second;
+  }
+  c->lb = cut->getLb();
+  c->ub = cut->getUb();
+  c->owner = owner;
+  if (cut->getConstraint()) {
+    c->name = cut->getConstraint()->getName();
+  } else {
+    c->name = cut->getName();
+  }
+
+#pragma omp critical (cutStore)
+  {
+    // numCuts_ is changed only here, so it can be read without atomic.
+    id = numCuts_;
+    if (id >= maxCuts_) {
+      full = true;
+    } else {
+      locate_(id, &chunk, &pos);
+      if (!chunks_[chunk]) {
+        chunks_[chunk] = new StoredCut*[1 << (firstBits_+chunk)];
+      }
+      chunks_[chunk][pos] = c;
+      // seq_cst makes the slot visible to threads that read the new count.
+#pragma omp atomic write seq_cst
+      numCuts_ = id+1;
+    }
+  }
+  if (full) {
+    delete [] c->idx;
+    delete [] c->val;
+    delete c;
+    return -1;
+  }
+  cut->getInfo()->storeId = id;
+  return id;
+}
+
+
+void CutStore::addNewToRel(RelaxationPtr rel, UInt owner, UInt *first) const
+{
+  UInt n = getNumCuts();
+
+  for (UInt i=*first; i<n; ++i) {
+    if (get_(i)->owner != owner) {
+      addToRel(i, rel);
+    }
+  }
+  *first = n;
+}
+
+
+void CutStore::addToRel(UInt id, RelaxationPtr rel) const
+{
+  const StoredCut *c = get_(id);
+  LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+  VariableConstIterator vbeg = rel->varsBegin();
+  FunctionPtr f;
+
+  // terms were stored in the order of the map of a linear function, so each
+  // one goes to the end of the new map.
+  for (UInt i=0; i<c->nz; ++i) {
+    lf->appendTerm(*(vbeg+c->idx[i]), c->val[i]);
+  }
+  f = (FunctionPtr) new Function(lf);
+  rel->newConstraint(f, c->lb, c->ub, c->name);
+}
+
+
+const CutStore::StoredCut* CutStore::get_(UInt id) const
+{
+  UInt chunk, pos;
+
+  assert(id < getNumCuts());
+  locate_(id, &chunk, &pos);
+  return chunks_[chunk][pos];
+}
+
+
+UInt CutStore::getNumCuts() const
+{
+  UInt n;
+#pragma omp atomic read seq_cst
+  n = numCuts_;
+  return n;
+}
+
+
+void CutStore::locate_(UInt id, UInt *chunk, UInt *pos) const
+{
+  // chunk k has the ids from (2^k-1)*2^firstBits_ to
+  // (2^(k+1)-1)*2^firstBits_ - 1.
+  UInt m = (id >> firstBits_) + 1;
+  UInt k = 0;
+
+  while (m > 1) {
+    m >>= 1;
+    ++k;
+  }
+  *chunk = k;
+  *pos = id - (((1U << k) - 1) << firstBits_);
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,142 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+/**
+ * \file CutStore.h
+ * \brief Declare the class CutStore, which keeps the linear cuts shared by
+ * the threads of a parallel branch-and-bound.
+ * \author The Minotaur Team
+ */
+
+#ifndef MINOTAURCUTSTORE_H
+#define MINOTAURCUTSTORE_H
+
+#include "Types.h"
+
+namespace Minotaur {
+
+  class Relaxation;
+  typedef Relaxation* RelaxationPtr;
+
+  /**
+   * \brief An append-only store of linear cuts. Each cut gets an id, which is
+   * its position in the store, and is never changed or removed afterwards.
+   * Nodes and threads refer to cuts by their ids only.
+   *
+   * A cut is stored by the indices of its variables, not by pointers, and
+   * can be added to any relaxation whose variables have the same indices,
+   * e.g. the copies of the root relaxation used by different threads.
+   *
+   * Cuts are added in a critical section. Reading a cut does not lock:
+   * the slot of a cut is filled before the number of cuts is increased, and
+   * a slot is never moved. Slots are kept in chunks of increasing size, so
+   * the store grows without copying and needs little memory when empty.
+   */
+  class CutStore {
+  public:
+    /// Create an empty store.
+    CutStore();
+
+    /// Destroy the store and all its cuts.
+    ~CutStore();
+
+    /**
+     * \brief Add a cut to the store.
+     * \param[in] cut The cut. It is copied; the store does not keep the
+     * pointer.
+     * \param[in] owner Thread that generated the cut, see addNewToRel().
+     * \returns The id of the cut, or -1 if the cut was not stored because it
+     * is not linear or the store already has maxCuts_ cuts.
+     */
+    int add(CutPtr cut, UInt owner);
+
+    /**
+     * \brief Add the cuts that were stored after the last call, except those
+     * of owner, as new constraints of a relaxation.
+     * \param[in] rel The relaxation.
+     * \param[in] owner Cuts of this thread are skipped, since they are
+     * already in rel.
+     * \param[in,out] first Id of the first cut to be added. It is set to the
+     * number of cuts in the store, so that the next call adds only cuts
+     * stored later.
+     */
+    void addNewToRel(RelaxationPtr rel, UInt owner, UInt *first) const;
+
+    /// Add cut id as a new constraint of rel.
+    void addToRel(UInt id, RelaxationPtr rel) const;
+
+    /// Number of cuts in the store.
+    UInt getNumCuts() const;
+
+  private:
+    /// A stored cut, in the indices of its variables.
+    struct StoredCut {
+      /// Number of terms.
+      UInt nz;
+
+      /// Indices of the variables of the terms.
+      UInt *idx;
+
+      /// Coefficients of the terms.
+      double *val;
+
+      /// Lower bound.
+      double lb;
+
+      /// Upper bound.
+      double ub;
+
+      /// Thread that generated the cut.
+      UInt owner;
+
+      /// Name of the constraint.
+      std::string name;
+    };
+
+    /// Number of cuts in the first chunk is 2^firstBits_.
+    static const UInt firstBits_ = 10;
+
+    /**
+     * Number of chunks. Chunk k has 2^(firstBits_+k) cuts, so that the
+     * chunks together hold more than maxCuts_ cuts.
+     */
+    static const UInt maxChunks_ = 22;
+
+    /// Largest number of cuts, so that ids fit in an int.
+    static const UInt maxCuts_ = 0x7fffffff;
+
+    /**
+     * Chunks of slots of cuts. A chunk is allocated when its first cut is
+     * added, and is never moved afterwards.
+     */
+    StoredCut **chunks_[maxChunks_];
+
+    /**
+     * Number of cuts. It is increased, by an atomic write, after the slot of
+     * a cut is filled, and read by an atomic read.
+     */
+    UInt numCuts_;
+
+    /// Find the chunk, and the position in it, of the cut with a given id.
+    void locate_(UInt id, UInt *chunk, UInt *pos) const;
+
+    /// Get the cut with the given id.
+    const StoredCut *get_(UInt id) const;
+  };
+  typedef CutStore* CutStorePtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -12,6 +12,7 @@
 
 #include "Environment.h"
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <iostream>
@@ -21,6 +22,7 @@
 #include "Logger.h"
 #include "MinotaurConfig.h"
 #include "Option.h"
+#include "Profiler.h"
 #include "Timer.h"
 #include "Version.h"
 
@@ -34,11 +36,31 @@ Environment::Environment()
   options_ = (OptionDBPtr) new OptionDB();
   timerFac_ = new TimerFactory();
   timer_ = timerFac_->getTimer();
+  profiler_ = new Profiler();
   createDefaultOptions_();
 }
 
 Environment::~Environment()
 {
+  std::ofstream fs;
+  std::string fname;
+
+  if(profiler_->isOn()) {
+    profiler_->setOn(false);
+    profiler_->writeFlat(logger_->msgStream(LogInfo));
+    fname = options_->findString("profile_file")->getValue();
+    if(fname != "") {
+      fs.open(fname.c_str());
+      if(fs.is_open()) {
+        profiler_->writeTrace(fs);
+        fs.close();
+      } else {
+        logger_->errStream() << me_ << "could not write profile to "
+                             << fname << std::endl;
+      }
+    }
+  }
+  delete profiler_;
   delete logger_;
   delete options_;
   delete timer_;
@@ -94,6 +116,12 @@ void Environment::createDefaultOptions_()
       "persp_cuts", "Should perspective cuts be used: <0/1>", true, false);
   options_->insert(b_option);
 
+  b_option = (BoolOptionPtr) new Option<bool>(
+      "ws_diff",
+      "Should warm starts of open nodes be stored as differences from a "
+      "reference warm start: <0/1>", true, true);
+  options_->insert(b_option);
+
   b_option = (BoolOptionPtr) new Option<bool>(
       "presolve", "Should presolve be used: <0/1>", true, true);
   options_->insert(b_option);
@@ -189,6 +217,11 @@ void Environment::createDefaultOptions_()
       true);
   options_->insert(b_option);
 
+  b_option = (BoolOptionPtr) new Option<bool>(
+      "nl_fbbt", "Should tighten bounds at each node by propagating "
+      "nonlinear constraints: <0/1>", true, false);
+  options_->insert(b_option);
+
   b_option = (BoolOptionPtr) new Option<bool>(
       "MSheur",
       "Use multi-start heuristic for continuous nonlinear problem: <0/1>", true,
@@ -231,6 +264,39 @@ void Environment::createDefaultOptions_()
       true, true);
   options_->insert(b_option);
 
+  b_option = (BoolOptionPtr) new Option<bool>(
+      "shared_dag",
+      "If true, evaluate subexpressions that are common to several "
+      "computational graphs only once for the native Jacobian and Hessian: "
+      "<0/1>", true, false);
+  options_->insert(b_option);
+
+  b_option = (BoolOptionPtr) new Option<bool>(
+      "log_async",
+      "If true, threads queue their messages and a background thread writes "
+      "them in order, with the time and thread number: <0/1>", true, false);
+  options_->insert(b_option);
+
+  b_option = (BoolOptionPtr) new Option<bool>(
+      "profile",
+      "If true, record the wall time that each thread spends in presolve, "
+      "relaxations, engines, separation, branching and heuristics, and "
+      "write a flat profile and a trace at exit: <0/1>", true, false);
+  options_->insert(b_option);
+
+  i_option = (IntOptionPtr) new Option<int>(
+      "profile_events",
+      "Number of most recent scopes of each thread kept for the trace "
+      "written by the profiler: >=0", true, 100000);
+  options_->insert(i_option);
+
+  i_option = (IntOptionPtr) new Option<int>(
+      "eval_threads",
+      "Number of threads used to evaluate the Jacobian and the Hessian of "
+      "the Lagrangian in NLP engines. Small problems are evaluated serially: "
+      ">0", true, 1);
+  options_->insert(i_option);
+
   b_option = (BoolOptionPtr) new Option<bool>(
       "mcbnb_deter_mode",
       "If true, synchronize all threads in determinisitic mode in parallel "
@@ -322,6 +388,19 @@ void Environment::createDefaultOptions_()
       "OBBT", "Do optimization based bound tightening: <0/1>", true, true);
   options_->insert(b_option);
 
+  i_option = (IntOptionPtr) new Option<int>(
+      "obbt_threads",
+      "Number of threads used for optimization based bound tightening at "
+      "the root: >0", true, 1);
+  options_->insert(i_option);
+
+  i_option = (IntOptionPtr) new Option<int>(
+      "nlp_cache_size",
+      "Number of NLPs with fixed integer variables whose results are kept "
+      "by the QG handlers, so that they are not solved again. 0 disables the "
+      "cache. See also nlp_cache_mb: >=0", true, 10000);
+  options_->insert(i_option);
+
   b_option = (BoolOptionPtr) new Option<bool>(
       "sqTangentAtRoot",
       "Add tangents for bounds of square terms in root node: <0/1>", true,
@@ -346,6 +425,12 @@ void Environment::createDefaultOptions_()
       true, 1000000000);
   options_->insert(i_option);
 
+  i_option = (IntOptionPtr) new Option<int>("node_file_limit",
+      "Number of active nodes kept in memory, further nodes are written to a "
+      "temporary file (bfs and BthenD search only, 0 means no limit): >=0",
+      true, 0);
+  options_->insert(i_option);
+
   i_option = (IntOptionPtr) new Option<int>(
       "sol_limit", "Limit on the number of solutions found: >0", true,
       1000000000);
@@ -420,6 +505,12 @@ void Environment::createDefaultOptions_()
       25);
   options_->insert(i_option);
 
+  i_option = (IntOptionPtr) new Option<int>(
+      "strbr_threads",
+      "Number of threads used for strong branching in reliability branching: "
+      ">0", true, 1);
+  options_->insert(i_option);
+
   i_option = (IntOptionPtr) new Option<int>(
       "threads", "Number of threads to be used ", true, 1);
   options_->insert(i_option);
@@ -463,6 +554,19 @@ void Environment::createDefaultOptions_()
       0.00001);
   options_->insert(d_option);
 
+  d_option = (DoubleOptionPtr) new Option<double>(
+      "nlp_cache_mb",
+      "Memory in MB that the cache of NLPs with fixed integer variables may "
+      "use. The least recently used NLPs are dropped first. 0 disables the "
+      "cache: >=0", true, 64.0);
+  options_->insert(d_option);
+
+  d_option = (DoubleOptionPtr) new Option<double>(
+      "ws_mem_budget",
+      "Memory in MB that warm starts of open nodes may use before the "
+      "oldest ones are dropped, 0 for no limit: >=0", true, 0.0);
+  options_->insert(d_option);
+
   d_option = (DoubleOptionPtr) new Option<double>(
       "time_limit", "Limit on time in branch-and-bound in seconds: >0", true,
       1e20);
@@ -577,6 +681,13 @@ void Environment::createDefaultOptions_()
       "");
   options_->insert(s_option);
 
+  s_option = (StringOptionPtr) new Option<std::string>(
+      "profile_file",
+      "File to which the profiler writes a Chrome trace (chrome://tracing), "
+      "if the option profile is set. No trace is written if empty.", true,
+      "minotaur-trace.json");
+  options_->insert(s_option);
+
   s_option = (StringOptionPtr) new Option<std::string>(
       "debug_sol",
       "File containing a solution that is checked for wrong cutting off", true,
@@ -783,6 +894,11 @@ Timer* Environment::getNewTimer()
   return timerFac_->getTimer();
 }
 
+Profiler* Environment::getProfiler() const
+{
+  return profiler_;
+}
+
 OptionDBPtr Environment::getOptions()
 {
   return options_;
@@ -981,6 +1097,11 @@ void Environment::readOptions(int argc, char** argv)
   // update the log level if set by the user
   logger_->setMaxLevel(
       (LogLevel)getOptions()->findInt("log_level")->getValue());
+  logger_->setAsync(options_->findBool("log_async")->getValue());
+  // switch the profiler on or off as set by the user
+  profiler_->setCapacity(
+      std::max(0, options_->findInt("profile_events")->getValue()));
+  profiler_->setOn(options_->findBool("profile")->getValue());
   // display all the new options set.
   logger_->msgStream(LogInfo) << ostr.str();
 
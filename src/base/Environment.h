@@ -20,6 +20,8 @@
 
 namespace Minotaur {
 
+  class Profiler;
+
   /**
    * The environment is a container class that has pointers to the
    * Logger, interrupt handler, timer factory and options that need to be
@@ -45,6 +47,12 @@ namespace Minotaur {
       /// Get the options database.
       OptionDBPtr getOptions();
 
+      /**
+       * \brief Get the profiler of the environment. It is switched on by
+       * the option "profile" in readOptions(), or by Profiler::setOn().
+       */
+      Profiler* getProfiler() const;
+
       /**
        * Get the time from the 'global timer' i.e. the total time consumed so
        * far.
@@ -118,6 +126,9 @@ namespace Minotaur {
       /// The options database
       OptionDBPtr options_;
 
+      /// Profiler of the whole solve. Results are written when destroyed.
+      Profiler *profiler_;
+
       /// The global timer
       Timer *timer_;
 
@@ -0,0 +1,359 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+/**
+ * \file FbbtHandler.cpp
+ * \brief Implement the methods of FbbtHandler class.
+ * \author The Minotaur Team
+ */
+
+#include <cmath>
+#include <iostream>
+
+#include "MinotaurConfig.h"
+#include "CGraph.h"
+#include "Constraint.h"
+#include "Environment.h"
+#include "FbbtHandler.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Logger.h"
+#include "Problem.h"
+#include "Relaxation.h"
+#include "Timer.h"
+#include "VarBoundMod.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string FbbtHandler::me_ = "FbbtHandler: ";
+
+FbbtHandler::FbbtHandler(EnvPtr env, ProblemPtr problem)
+  : bSlack_(1e-5),
+    eTol_(1e-4),
+    logger_(env->getLogger()),
+    maxVisits_(3),
+    problem_(problem),
+    rel_(0),
+    relVersion_(0),
+    rTol_(1e-3),
+    timer_(env->getTimer())
+{
+  stats_.calls = 0;
+  stats_.inf = 0;
+  stats_.nlb = 0;
+  stats_.nub = 0;
+  stats_.visits = 0;
+  stats_.time = 0.0;
+  modProb_ = false;
+  modRel_ = true;
+  build_();
+  logger_->msgStream(LogExtraInfo) << me_ << "number of constraints to "
+    << "propagate = " << rowCons_.size() << std::endl;
+}
+
+
+FbbtHandler::~FbbtHandler()
+{
+  problem_ = 0;
+  rel_ = 0;
+}
+
+
+void FbbtHandler::build_()
+{
+  const UInt n = problem_->getNumVars();
+  ConstraintPtr c;
+  FunctionPtr f;
+  CGraph *cg;
+  UIntVector cnt(n+1, 0);
+
+  rowStart_.push_back(0);
+  for (ConstraintConstIterator it=problem_->consBegin();
+       it!=problem_->consEnd(); ++it) {
+    c = *it;
+    f = c->getFunction();
+    if (DeletedCons==c->getState() || !f || f->getQuadraticFunction()) {
+      continue;
+    }
+    cg = dynamic_cast<CGraph*>(f->getNonlinearFunction());
+    if (!cg) {
+      continue;
+    }
+    rowCons_.push_back(c);
+    graphs_.push_back(cg);
+    lfs_.push_back(f->getLinearFunction());
+    for (VarSetConstIterator vit=f->varsBegin(); vit!=f->varsEnd(); ++vit) {
+      rowVar_.push_back((*vit)->getIndex());
+      ++cnt[(*vit)->getIndex()+1];
+    }
+    rowStart_.push_back(rowVar_.size());
+  }
+
+  // columns
+  for (UInt j=0; j<n; ++j) {
+    cnt[j+1] += cnt[j];
+  }
+  colStart_ = cnt;
+  colRow_.resize(rowVar_.size());
+  for (UInt r=0; r+1<rowStart_.size(); ++r) {
+    for (UInt k=rowStart_[r]; k<rowStart_[r+1]; ++k) {
+      colRow_[cnt[rowVar_[k]]++] = r;
+    }
+  }
+
+  inQueue_.resize(rowCons_.size(), false);
+  visits_.resize(rowCons_.size(), 0);
+  lb_.resize(n, -INFINITY);
+  ub_.resize(n, INFINITY);
+  relVars_.resize(n, 0);
+}
+
+
+std::string FbbtHandler::getName() const
+{
+  return "FbbtHandler (bound propagation on nonlinear constraints)";
+}
+
+
+void FbbtHandler::linBnds_(UInt r, double *lo, double *up)
+{
+  LinearFunctionPtr lf = lfs_[r];
+  double a;
+  UInt j;
+
+  *lo = *up = 0.0;
+  if (!lf) {
+    return;
+  }
+  for (VariableGroupConstIterator it=lf->termsBegin(); it!=lf->termsEnd();
+       ++it) {
+    j = it->first->getIndex();
+    a = it->second;
+    if (a > 0) {
+      *lo += a*lb_[j];
+      *up += a*ub_[j];
+    } else {
+      *lo += a*ub_[j];
+      *up += a*lb_[j];
+    }
+  }
+  // inf - inf
+  if (std::isnan(*lo)) {
+    *lo = -INFINITY;
+  }
+  if (std::isnan(*up)) {
+    *up = INFINITY;
+  }
+}
+
+
+bool FbbtHandler::presolveNode(RelaxationPtr rel, NodePtr,
+                               SolutionPoolPtr, ModVector &p_mods,
+                               ModVector &r_mods)
+{
+  double stime = timer_->query();
+  DoubleVector olb, oub;
+  VarBoundModPtr mod;
+  VariablePtr v;
+  bool is_inf = false;
+  UInt r;
+
+  if (rowCons_.empty()) {
+    return false;
+  }
+  ++stats_.calls;
+  sync_(rel);
+  while (!queue_.empty() && false==is_inf) {
+    r = queue_.front();
+    queue_.pop_front();
+    inQueue_[r] = false;
+    if (visits_[r] < maxVisits_) {
+      is_inf = propRow_(r, olb, oub);
+    }
+  }
+  for (UInt i=0; i<queue_.size(); ++i) {
+    inQueue_[queue_[i]] = false;
+  }
+  queue_.clear();
+  std::fill(visits_.begin(), visits_.end(), 0);
+
+  if (is_inf) {
+    // lb_ and ub_ are not the bounds of any node now.
+    rel_ = 0;
+    ++stats_.inf;
+    stats_.time += timer_->query()-stime;
+    return true;
+  }
+
+  for (UInt j=0; j<relVars_.size(); ++j) {
+    v = relVars_[j];
+    if (!v) {
+      continue;
+    }
+    if (lb_[j] > v->getLb()) {
+      mod = (VarBoundModPtr) new VarBoundMod(v, Lower, lb_[j]);
+      mod->applyToProblem(rel);
+      r_mods.push_back(mod);
+      if (modProb_) {
+        mod = (VarBoundModPtr) new VarBoundMod(problem_->getVariable(j),
+                                               Lower, lb_[j]);
+        mod->applyToProblem(problem_);
+        p_mods.push_back(mod);
+      }
+      ++stats_.nlb;
+    }
+    if (ub_[j] < v->getUb()) {
+      mod = (VarBoundModPtr) new VarBoundMod(v, Upper, ub_[j]);
+      mod->applyToProblem(rel);
+      r_mods.push_back(mod);
+      if (modProb_) {
+        mod = (VarBoundModPtr) new VarBoundMod(problem_->getVariable(j),
+                                               Upper, ub_[j]);
+        mod->applyToProblem(problem_);
+        p_mods.push_back(mod);
+      }
+      ++stats_.nub;
+    }
+  }
+  stats_.time += timer_->query()-stime;
+  return false;
+}
+
+
+bool FbbtHandler::propRow_(UInt r, DoubleVector &olb, DoubleVector &oub)
+{
+  ConstraintPtr c = rowCons_[r];
+  const double itol = 1e-6;
+  double lo, up, l, u, w;
+  bool is_inf = false;
+  bool lchanged, uchanged;
+  int err = 0;
+  VariablePtr v;
+  UInt j;
+
+  ++visits_[r];
+  ++stats_.visits;
+  linBnds_(r, &lo, &up);
+  olb.clear();
+  oub.clear();
+  for (UInt k=rowStart_[r]; k<rowStart_[r+1]; ++k) {
+    olb.push_back(lb_[rowVar_[k]]);
+    oub.push_back(ub_[rowVar_[k]]);
+  }
+  graphs_[r]->varBoundsInPlace(c->getLb()-up, c->getUb()-lo, &(lb_[0]),
+                               &(ub_[0]), &is_inf, &err);
+  if (true==is_inf) {
+    return true;
+  }
+
+  for (UInt k=rowStart_[r], i=0; k<rowStart_[r+1]; ++k, ++i) {
+    j = rowVar_[k];
+    v = relVars_[j];
+    l = lb_[j];
+    u = ub_[j];
+    lb_[j] = olb[i];
+    ub_[j] = oub[i];
+    if (err>0 || !v) {
+      continue;
+    }
+    if (v->getType()==Binary || v->getType()==Integer) {
+      l = ceil(l-itol);
+      u = floor(u+itol);
+    } else {
+      l -= bSlack_;
+      u += bSlack_;
+    }
+    if (fmax(l, olb[i]) > fmin(u, oub[i])+eTol_) {
+      return true;
+    }
+
+    // small changes are ignored, so that propagation stops.
+    w = oub[i]-olb[i];
+    lchanged = l > olb[i]+eTol_ && (std::isinf(w) || l-olb[i] > rTol_*w);
+    uchanged = u < oub[i]-eTol_ && (std::isinf(w) || oub[i]-u > rTol_*w);
+    if (lchanged) {
+      lb_[j] = l;
+    }
+    if (uchanged) {
+      ub_[j] = u;
+    }
+    if (lchanged || uchanged) {
+      for (UInt m=colStart_[j]; m<colStart_[j+1]; ++m) {
+        if (colRow_[m]!=r) {
+          push_(colRow_[m]);
+        }
+      }
+    }
+  }
+  return false;
+}
+
+
+void FbbtHandler::push_(UInt r)
+{
+  if (!inQueue_[r]) {
+    inQueue_[r] = true;
+    queue_.push_back(r);
+  }
+}
+
+
+void FbbtHandler::sync_(RelaxationPtr rel)
+{
+  VariablePtr v;
+
+  if (rel!=rel_ || relVersion_!=rel->getVarIndexVersion()) {
+    // first call, or the bounds seen last are not usable: queue all rows.
+    rel_ = rel;
+    relVersion_ = rel->getVarIndexVersion();
+    for (UInt j=0; j<relVars_.size(); ++j) {
+      v = (j<rel->getNumVars()) ?
+        rel->getRelaxationVar(problem_->getVariable(j)) : 0;
+      relVars_[j] = v;
+      lb_[j] = v ? v->getLb() : -INFINITY;
+      ub_[j] = v ? v->getUb() : INFINITY;
+    }
+    for (UInt r=0; r<rowCons_.size(); ++r) {
+      push_(r);
+    }
+    return;
+  }
+
+  for (UInt j=0; j<relVars_.size(); ++j) {
+    v = relVars_[j];
+    if (v && (v->getLb()!=lb_[j] || v->getUb()!=ub_[j])) {
+      lb_[j] = v->getLb();
+      ub_[j] = v->getUb();
+      for (UInt m=colStart_[j]; m<colStart_[j+1]; ++m) {
+        push_(colRow_[m]);
+      }
+    }
+  }
+}
+
+
+void FbbtHandler::writeStats(std::ostream &out) const
+{
+  out << me_ << "nodes presolved            = " << stats_.calls << std::endl
+      << me_ << "nodes found infeasible     = " << stats_.inf << std::endl
+      << me_ << "constraints propagated     = " << stats_.visits << std::endl
+      << me_ << "lower bounds tightened     = " << stats_.nlb << std::endl
+      << me_ << "upper bounds tightened     = " << stats_.nub << std::endl
+      << me_ << "time taken                 = " << stats_.time << std::endl;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,240 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+/**
+ * \file FbbtHandler.h
+ * \brief Declare the FbbtHandler class that tightens bounds of variables at
+ * each node by feasibility-based propagation on nonlinear constraints.
+ * \author The Minotaur Team
+ */
+
+#ifndef MINOTAURFBBTHANDLER_H
+#define MINOTAURFBBTHANDLER_H
+
+#include <deque>
+
+#include "Handler.h"
+
+namespace Minotaur {
+
+class CGraph;
+class Timer;
+
+/// Statistics of FbbtHandler.
+struct FbbtStats {
+  UInt calls;   ///< Number of nodes presolved.
+  UInt inf;     ///< Number of nodes found infeasible.
+  UInt nlb;     ///< Number of lower bounds tightened.
+  UInt nub;     ///< Number of upper bounds tightened.
+  UInt visits;  ///< Number of times a constraint was propagated.
+  double time;  ///< Time spent in presolveNode().
+};
+
+
+/**
+ * \brief Feasibility-based bound tightening (FBBT) on nonlinear constraints
+ * at the nodes of the branch-and-bound tree.
+ *
+ * Each constraint \f$l \leq a^Tx + f(x) \leq u\f$ of the problem whose
+ * nonlinear part f is a computational graph (and that has no quadratic
+ * part) is a row of the handler. In presolveNode() the bounds of the
+ * variables in the relaxation are compared with those seen at the end of
+ * the previous call, e.g. at the parent. The rows of the variables whose
+ * bounds changed are put in a queue. A row is propagated by computing the
+ * bounds of \f$a^Tx\f$, and then bounds on f(x) by forward and backward
+ * interval arithmetic on its graph, see CGraph::varBoundsInPlace(). If
+ * this tightens a bound of a variable by a large enough amount, the other
+ * rows of that variable are put in the queue. A row is propagated at most
+ * a few times at each node.
+ *
+ * The new bounds are applied to the relaxation and returned as
+ * VarBoundMod objects, so that they are recorded on the node. The graphs
+ * are used as scratch space, so the handler may not be shared by threads
+ * that presolve nodes at the same time.
+ */
+class FbbtHandler : public Handler {
+public:
+  /**
+   * \brief Constructor.
+   *
+   * \param [in] env Minotaur environment.
+   * \param [in] problem Problem whose nonlinear constraints are propagated.
+   * The relaxation passed to presolveNode() must have a relaxation variable
+   * for each of its variables.
+   */
+  FbbtHandler(EnvPtr env, ProblemPtr problem);
+
+  /// Destroy.
+  ~FbbtHandler();
+
+  /// Does nothing.
+  Branches getBranches(BrCandPtr, DoubleVector &, RelaxationPtr,
+                       SolutionPoolPtr)
+  {return Branches();};
+
+  /// Does nothing.
+  void getBranchingCandidates(RelaxationPtr, const DoubleVector &,
+                              ModVector &, BrVarCandSet &, BrCandVector &,
+                              bool &) {};
+
+  /// Does nothing.
+  ModificationPtr getBrMod(BrCandPtr, DoubleVector &, RelaxationPtr,
+                           BranchDirection)
+  {return ModificationPtr();};
+
+  // Base class method.
+  std::string getName() const;
+
+  /// The handler does not check feasibility.
+  bool isFeasible(ConstSolutionPtr, RelaxationPtr, bool &, double &)
+  {return true;};
+
+  /// Does nothing.
+  void postsolveGetX(const double *, UInt, DoubleVector *) {};
+
+  /// Does nothing. Bounds at the root are tightened by NlPresHandler.
+  SolveStatus presolve(PreModQ *, bool *, Solution **) {return Finished;};
+
+  /**
+   * \brief Tighten bounds of variables in the relaxation by propagating
+   * the rows whose variables changed bounds since the last call.
+   *
+   * \return True if the node is infeasible.
+   */
+  bool presolveNode(RelaxationPtr rel, NodePtr node, SolutionPoolPtr s_pool,
+                    ModVector &p_mods, ModVector &r_mods);
+
+  /// Does nothing.
+  void relaxInitFull(RelaxationPtr, bool *) {};
+
+  /// Does nothing.
+  void relaxInitInc(RelaxationPtr, bool *) {};
+
+  /// Does nothing.
+  void relaxNodeFull(NodePtr, RelaxationPtr, bool *) {};
+
+  /// Does nothing.
+  void relaxNodeInc(NodePtr, RelaxationPtr, bool *) {};
+
+  /// Does nothing.
+  void separate(ConstSolutionPtr, NodePtr, RelaxationPtr, CutManager *,
+                SolutionPoolPtr, ModVector &, ModVector &, bool *,
+                SeparationStatus *) {};
+
+  // Base class method.
+  void writeStats(std::ostream &out) const;
+
+private:
+  /// Slack added to a tightened bound against round-off.
+  const double bSlack_;
+
+  /// Rows of each variable.
+  UIntVector colRow_;
+
+  /// Position of the first row of each variable, and one past the last.
+  UIntVector colStart_;
+
+  /// A bound must move by more than this to be tightened.
+  const double eTol_;
+
+  /// Graph of each row.
+  std::vector<CGraph *> graphs_;
+
+  /// True for rows that are in the queue.
+  std::vector<bool> inQueue_;
+
+  /// Lower bound of each variable seen last, by index.
+  DoubleVector lb_;
+
+  /// Linear part of each row, NULL if none.
+  std::vector<LinearFunctionPtr> lfs_;
+
+  /// Log.
+  LoggerPtr logger_;
+
+  /// Maximum number of times a row is propagated at a node.
+  const UInt maxVisits_;
+
+  /// For log.
+  static const std::string me_;
+
+  /// Problem whose constraints are propagated.
+  ProblemPtr problem_;
+
+  /// Rows to be propagated.
+  std::deque<UInt> queue_;
+
+  /// The relaxation seen last. NULL if lb_ and ub_ are not valid.
+  RelaxationPtr rel_;
+
+  /// Relaxation variable of each variable of problem_, by index.
+  VarVector relVars_;
+
+  /// Value of Problem::getVarIndexVersion() of rel_ when relVars_ was
+  /// filled.
+  UInt relVersion_;
+
+  /// Constraint of each row.
+  ConstraintVector rowCons_;
+
+  /// Position of the first variable of each row, and one past the last.
+  UIntVector rowStart_;
+
+  /// Variables (indices) of each row.
+  UIntVector rowVar_;
+
+  /**
+   * A bound must also move by more than this fraction of the width of the
+   * domain, if it is finite.
+   */
+  const double rTol_;
+
+  /// Statistics.
+  FbbtStats stats_;
+
+  /// Timer.
+  const Timer *timer_;
+
+  /// Upper bound of each variable seen last, by index.
+  DoubleVector ub_;
+
+  /// Number of times each row was propagated at the current node.
+  UIntVector visits_;
+
+  /// Store the rows and the columns of the problem.
+  void build_();
+
+  /// Bounds of the linear part of row r.
+  void linBnds_(UInt r, double *lo, double *up);
+
+  /**
+   * \brief Propagate row r and queue the rows of the variables whose
+   * bounds were tightened.
+   *
+   * \return True if the row can not be satisfied.
+   */
+  bool propRow_(UInt r, DoubleVector &olb, DoubleVector &oub);
+
+  /// Put row r in the queue if it is not there already.
+  void push_(UInt r);
+
+  /// Push the rows of variables whose bounds in rel differ from lb_, ub_.
+  void sync_(RelaxationPtr rel);
+};
+typedef FbbtHandler* FbbtHandlerPtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -485,6 +485,17 @@ void Function::finalHessStor(const LTHessStor *stor)
 }
 
 
+void Function::freeze()
+{
+  if (lf_) {
+    lf_->freeze();
+  }
+  if (qf_) {
+    qf_->freeze();
+  }
+}
+
+
 void Function::fillJac(const double *x, double *values, int *error) 
 {
   *error = 0;
@@ -92,6 +92,14 @@ namespace Minotaur {
       const;
 
     virtual void fillJac(const double *x, double *values, int *error);
+
+    /**
+     * \brief Freeze the linear and quadratic parts again, see
+     * LinearFunction::freeze(). Called when the indices of the variables
+     * change.
+     */
+    void freeze();
+
     /**
      * Get number of terms in the hessian of the function. We only count
      * terms that are nonzero in the lower-triangular half (including the
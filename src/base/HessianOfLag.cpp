@@ -12,6 +12,7 @@
 //
 // */
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -20,15 +21,27 @@
 #include "Constraint.h"
 #include "Function.h"
 #include "HessianOfLag.h"
+#include "NonlinearFunction.h"
 #include "Objective.h"
 #include "Problem.h"
+#include "QuadraticFunction.h"
+#include "SharedDAG.h"
 #include "Variable.h"
 
+#if USE_OPENMP
+#include <omp.h>
+#endif
+
 
 using namespace Minotaur;
 
+/// Fewest constraints with nonlinear terms for a parallel evaluation.
+static const UInt hessParMinCons = 128;
+
 HessianOfLag::HessianOfLag()
-: etol_(1e-12),
+: dag_(0),
+  etol_(1e-12),
+  nThreads_(1),
   obj_(FunctionPtr()),
   p_(0)  // NULL
 {
@@ -42,7 +55,9 @@ HessianOfLag::HessianOfLag()
 
 
 HessianOfLag::HessianOfLag(Problem *p)
-: etol_(1e-12),
+: dag_(0),
+  etol_(1e-12),
+  nThreads_(1),
   obj_(FunctionPtr()),
   p_(p) // NULL
 {
@@ -101,6 +116,9 @@ void HessianOfLag::fillRowColValues(const double *x, double obj_mult,
   FunctionPtr f;
 
   std::fill(values, values+stor_.nz, 0);
+  if (dag_) {
+    dag_->eval(x);
+  }
   if (p_->getObjective()) {
     f = p_->getObjective()->getFunction();
     if (f) {
@@ -110,6 +128,12 @@ void HessianOfLag::fillRowColValues(const double *x, double obj_mult,
     }
   }
 
+#if USE_OPENMP
+  if (!levCons_.empty() && !omp_in_parallel()) {
+    fillValuesPar_(x, con_mult, values, error);
+    return;
+  }
+#endif
   for (ConstraintConstIterator c_iter=p_->consBegin(); c_iter!=p_->consEnd(); 
        ++c_iter, ++i) {
     f = (*c_iter)->getFunction();
@@ -120,6 +144,129 @@ void HessianOfLag::fillRowColValues(const double *x, double obj_mult,
 }
 
 
+void HessianOfLag::fillValuesPar_(const double *x, const double *con_mult,
+                                  double *values, int *error)
+{
+  const ConstraintConstIterator c_begin = p_->consBegin();
+  const UInt nlevs = levStarts_.size()-1;
+  const UInt n = p_->getNumCons();
+
+  errs_.assign(n, 0);
+#pragma omp parallel num_threads(nThreads_)
+  {
+    for (UInt l=0; l<nlevs; ++l) {
+      // the implied barrier at the end of the loop finishes a level before
+      // the next one starts.
+#pragma omp for schedule(dynamic, 8)
+      for (UInt k=levStarts_[l]; k<levStarts_[l+1]; ++k) {
+        UInt i = levCons_[k];
+        if (fabs(con_mult[i]) > etol_) {
+          (*(c_begin+i))->getFunction()->evalHessian(con_mult[i], x, &stor_,
+                                                     values, &(errs_[i]));
+        }
+      }
+    }
+  }
+
+  // Like the serial code, report the error of the last constraint that was
+  // evaluated. Linear constraints report none.
+  for (UInt i=n; i>0; --i) {
+    if (fabs(con_mult[i-1]) > etol_) {
+      *error = errs_[i-1];
+      break;
+    }
+  }
+}
+
+
+void HessianOfLag::setNumThreads(UInt n)
+{
+  nThreads_ = (n > 1) ? n : 1;
+  setupLevels_();
+}
+
+
+void HessianOfLag::setupLevels_()
+{
+  UIntVector rowLev;   // one more than the last level that has the variable
+  UIntVector conLev;   // level of each constraint in levCons_
+  UIntVector cons, next;
+  UInt lev, nlevs;
+  FunctionPtr f;
+  QuadraticFunctionPtr qf;
+  NonlinearFunctionPtr nlf;
+  UInt i = 0;
+
+  levCons_.clear();
+  levStarts_.clear();
+  if (nThreads_ < 2 || !p_) {
+    return;
+  }
+
+  rowLev.assign(p_->getNumVars(), 0);
+  nlevs = 0;
+  for (ConstraintConstIterator c_iter=p_->consBegin(); c_iter!=p_->consEnd();
+       ++c_iter, ++i) {
+    f = (*c_iter)->getFunction();
+    qf = f->getQuadraticFunction();
+    nlf = f->getNonlinearFunction();
+    if (!qf && !nlf) {
+      continue;
+    }
+    lev = 0;
+    if (qf) {
+      for (VarIntMapConstIterator it=qf->varsBegin(); it!=qf->varsEnd();
+           ++it) {
+        lev = std::max(lev, rowLev[it->first->getIndex()]);
+      }
+    }
+    if (nlf) {
+      for (VariableSet::iterator it=nlf->varsBegin(); it!=nlf->varsEnd();
+           ++it) {
+        lev = std::max(lev, rowLev[(*it)->getIndex()]);
+      }
+    }
+    if (qf) {
+      for (VarIntMapConstIterator it=qf->varsBegin(); it!=qf->varsEnd();
+           ++it) {
+        rowLev[it->first->getIndex()] = lev+1;
+      }
+    }
+    if (nlf) {
+      for (VariableSet::iterator it=nlf->varsBegin(); it!=nlf->varsEnd();
+           ++it) {
+        rowLev[(*it)->getIndex()] = lev+1;
+      }
+    }
+    levCons_.push_back(i);
+    conLev.push_back(lev);
+    nlevs = std::max(nlevs, lev+1);
+  }
+
+  // Levels that have, on average, fewer constraints than threads leave the
+  // threads waiting at the barriers.
+  if (levCons_.size() < hessParMinCons || levCons_.size() < nlevs*nThreads_) {
+    levCons_.clear();
+    return;
+  }
+
+  // Counting sort by level, keeping the order of constraints in a level.
+  levStarts_.assign(nlevs+1, 0);
+  for (i=0; i<conLev.size(); ++i) {
+    ++levStarts_[conLev[i]+1];
+  }
+  for (lev=0; lev<nlevs; ++lev) {
+    levStarts_[lev+1] += levStarts_[lev];
+  }
+  cons.swap(levCons_);
+  next.assign(levStarts_.begin(), levStarts_.end()-1);
+  levCons_.resize(cons.size());
+  for (i=0; i<cons.size(); ++i) {
+    levCons_[next[conLev[i]]++] = cons[i];
+  }
+}
+
+
 void HessianOfLag::setupRowCol()
 {
   UInt nz;
@@ -198,7 +345,7 @@ void HessianOfLag::setupRowCol()
   }
   delete [] stor_.colQs;
   stor_.colQs = 0;
-
+  setupLevels_();
 }
 
 
@@ -18,6 +18,8 @@
 
 namespace Minotaur {
 
+  class SharedDAG;
+
   struct LTHessStor {
     UInt nz;
     UInt nlVars;
@@ -93,6 +95,30 @@ namespace Minotaur {
       /// Ugly hack to solve maximization problem. TODO: delete it.
       virtual void negateObj() {};
 
+      /**
+       * \brief Set a DAG that is evaluated at the start of
+       * fillRowColValues(), so that the graphs linked to it share the
+       * values of common subexpressions.
+       *
+       * \param [in] dag The DAG, or NULL. It is not freed by this class.
+       */
+      void setDAG(SharedDAG *dag) { dag_ = dag; }
+
+      /**
+       * \brief Set the number of threads used by fillRowColValues().
+       *
+       * Constraints are put in levels such that two constraints of a level
+       * never have a nonlinear variable in common, so they add to disjoint
+       * rows of stor_. The constraints of a level are evaluated concurrently
+       * and levels one after another. A constraint is in a higher level than
+       * all earlier constraints it shares a variable with, so every entry
+       * gets its terms in the same order as with one thread and the values
+       * are the same. If there are few nonlinear constraints, or the levels
+       * are too narrow, or the call is made from inside a parallel region,
+       * the Hessian is evaluated serially.
+       */
+      void setNumThreads(UInt n);
+
       virtual void setupRowCol();
 
       virtual void write(std::ostream &out) const;
@@ -102,8 +128,27 @@ namespace Minotaur {
        * If a lagrange multiplier is less than etol_, then it is considered
        * zero.
        */
+      /// Shared DAG evaluated before the functions. NULL if none.
+      SharedDAG *dag_;
+
       double etol_;
 
+      /// Error code of each constraint in the last parallel evaluation.
+      std::vector<int> errs_;
+
+      /// Position of the first constraint of each level in levCons_.
+      UIntVector levStarts_;
+
+      /**
+       * Positions of the constraints with quadratic or nonlinear terms,
+       * grouped by level, in increasing order within a level. Empty if the
+       * Hessian is evaluated serially.
+       */
+      UIntVector levCons_;
+
+      /// Number of threads used for evaluation.
+      UInt nThreads_;
+
       FunctionPtr obj_;
 
       /**
@@ -122,6 +167,13 @@ namespace Minotaur {
       Problem *p_;
       LTHessStor stor_;
 
+      /// Evaluate the constraints of each level with nThreads_ threads.
+      void fillValuesPar_(const double *x, const double *con_mult,
+                          double *values, int *error);
+
+      /// Fill levStarts_ and levCons_, or clear them for serial evaluation.
+      void setupLevels_();
+
   };
 
   typedef HessianOfLag* HessianOfLagPtr;
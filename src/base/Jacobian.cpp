@@ -4,34 +4,57 @@
 //    (C)opyright 2009 - 2024 The Minotaur Team.
 //
 
+#include <algorithm>
 #include <iostream>
 
 #include "MinotaurConfig.h"
 #include "Constraint.h"
 #include "Function.h"
 #include "Jacobian.h"
+#include "SharedDAG.h"
 #include "Variable.h"
 
+#if USE_OPENMP
+#include <omp.h>
+#endif
+
 using namespace Minotaur;
 
+/// Fewest constraints with nonlinear terms for a parallel evaluation.
+static const UInt jacParMinCons = 128;
+
 
 Jacobian::Jacobian()
   : cons_(0),
+    dag_(0),
+    nlCons_(0),
+    nThreads_(1),
     nz_(0)
 {
 }
 
 
 Jacobian::Jacobian(const std::vector<ConstraintPtr> & cons, const UInt)
+  : dag_(0),
+    nlCons_(0),
+    nThreads_(1)
 {
   ConstraintConstIterator c_iter;
+  FunctionPtr f;
 
   nz_ = 0;
   cons_ = &cons;
+  starts_.reserve(cons_->size()+1);
   for (c_iter=cons_->begin(); c_iter!=cons_->end(); ++c_iter) {
-    nz_ += (*c_iter)->getFunction()->getNumVars();
-    (*c_iter)->getFunction()->prepJac();
+    f = (*c_iter)->getFunction();
+    starts_.push_back(nz_);
+    nz_ += f->getNumVars();
+    f->prepJac();
+    if (f->getQuadraticFunction() || f->getNonlinearFunction()) {
+      ++nlCons_;
+    }
   }
+  starts_.push_back(nz_);
 }
 
 
@@ -77,6 +100,15 @@ void Jacobian::fillRowColValues(const double *x, double *values, int *error)
 
   *error = 0;
   std::fill(values, values+nz_, 0.0);
+  if (dag_) {
+    dag_->eval(x);
+  }
+#if USE_OPENMP
+  if (nThreads_ > 1 && nlCons_ >= jacParMinCons && !omp_in_parallel()) {
+    fillValuesPar_(x, values, error);
+    return;
+  }
+#endif
   for (c_iter=cons_->begin(); c_iter!=cons_->end(); ++c_iter) {
     f = (*c_iter)->getFunction();
     f->fillJac(x, values+nz_cnt, error);
@@ -89,6 +121,34 @@ void Jacobian::fillRowColValues(const double *x, double *values, int *error)
 }
 
 
+void Jacobian::fillValuesPar_(const double *x, double *values, int *error)
+{
+  const UInt n = cons_->size();
+
+  errs_.assign(n, 0);
+#pragma omp parallel for num_threads(nThreads_) schedule(dynamic, 32)
+  for (UInt i=0; i<n; ++i) {
+    (*cons_)[i]->getFunction()->fillJac(x, values+starts_[i], &(errs_[i]));
+  }
+
+  // The serial code stops at the first error and leaves the values of the
+  // remaining constraints zero.
+  for (UInt i=0; i<n; ++i) {
+    if (errs_[i] != 0) {
+      *error = errs_[i];
+      std::fill(values+starts_[i+1], values+nz_, 0.0);
+      return;
+    }
+  }
+}
+
+
+void Jacobian::setNumThreads(UInt n)
+{
+  nThreads_ = (n > 1) ? n : 1;
+}
+
+
 void Jacobian::write(std::ostream &out) const
 {
   out << "nz_ = " << nz_ << std::endl;
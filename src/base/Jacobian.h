@@ -17,6 +17,7 @@
 
 namespace Minotaur {
 
+  class SharedDAG;
 
   /**
    * This class is used for the Jacobian of a Problem. When a problem has
@@ -88,6 +89,25 @@ namespace Minotaur {
       virtual void fillRowColValues(const double *x, double *values, 
           int *error);
 
+      /**
+       * \brief Set a DAG that is evaluated at the start of
+       * fillRowColValues(), so that the graphs linked to it share the
+       * values of common subexpressions.
+       *
+       * \param [in] dag The DAG, or NULL. It is not freed by this class.
+       */
+      void setDAG(SharedDAG *dag) { dag_ = dag; }
+
+      /**
+       * \brief Set the number of threads used by fillRowColValues().
+       *
+       * Constraints fill disjoint ranges of values, so they are evaluated
+       * concurrently without locks, and the values are the same as with one
+       * thread. Problems with few nonlinear constraints, and calls made from
+       * inside a parallel region, are still evaluated serially.
+       */
+      void setNumThreads(UInt n);
+
       /// Fill indices, column wise.
       virtual void fillColRowIndices(UInt *, UInt *)
       { assert(!"implement me!");}
@@ -105,9 +125,30 @@ namespace Minotaur {
        */
       const std::vector<ConstraintPtr> * cons_;
 
+      /// Shared DAG evaluated before the constraints. NULL if none.
+      SharedDAG *dag_;
+
+      /// Error code of each constraint in the last parallel evaluation.
+      std::vector<int> errs_;
+
+      /// Number of constraints with quadratic or nonlinear terms.
+      UInt nlCons_;
+
+      /// Number of threads used for evaluation.
+      UInt nThreads_;
+
       /// Number of nonzeros
       UInt nz_;
 
+      /**
+       * Position in values of the first nonzero of each constraint. The
+       * last entry is nz_.
+       */
+      UIntVector starts_;
+
+      /// Fill values of constraints using nThreads_ threads.
+      void fillValuesPar_(const double *x, double *values, int *error);
+
   };
   typedef Jacobian* JacobianPtr;
 }
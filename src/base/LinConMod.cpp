@@ -59,6 +59,23 @@ void LinConMod::applyToProblem(ProblemPtr problem)
 }
 
 
+ModificationPtr LinConMod::copyByIndex(ProblemPtr p) const
+{
+  VariableConstIterator vbeg = p->varsBegin();
+  LinConModPtr mod = (LinConModPtr) new LinConMod(
+                                    p->getConstraint(con_->getIndex()),
+                                    newLf_->cloneWithVars(vbeg),
+                                    newLb_, newUb_);
+
+  // the constraint of p may not be in the old state now.
+  delete mod->oldLf_;
+  mod->oldLf_ = oldLf_->cloneWithVars(vbeg);
+  mod->oldLb_ = oldLb_;
+  mod->oldUb_ = oldUb_;
+  return mod;
+}
+
+
 void LinConMod::undoToProblem(ProblemPtr problem) 
 {
   LinearFunctionPtr lf = oldLf_->clone();
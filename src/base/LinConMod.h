@@ -46,6 +46,9 @@ public:
   /// Apply it to the problem.
   void applyToProblem(ProblemPtr problem);
 
+  // base class method.
+  ModificationPtr copyByIndex(ProblemPtr p) const;
+
   // base class method.
   ModificationPtr fromRel(RelaxationPtr, ProblemPtr ) const
     {return LinConModPtr();};
@@ -0,0 +1,252 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+/**
+ * \file LinCutPool.cpp
+ * \brief Implement the methods of LinCutPool class.
+ * \author The Minotaur Team
+ */
+
+#include <cmath>
+#include <iostream>
+
+#include "MinotaurConfig.h"
+#include "Cut.h"
+#include "Function.h"
+#include "LinCutPool.h"
+#include "LinearFunction.h"
+#include "Problem.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+
+LinCutPool::LinCutPool()
+  : colsP_(0),
+    colsVersion_(0),
+    head_(0),
+    numRemoved_(0)
+{
+  start_.push_back(0);
+}
+
+
+LinCutPool::~LinCutPool()
+{
+  clear();
+}
+
+
+bool LinCutPool::accepts(CutPtr cut)
+{
+  FunctionPtr f = cut->getFunction();
+  return (f && !f->getQuadraticFunction() && !f->getNonlinearFunction());
+}
+
+
+void LinCutPool::add(CutPtr cut)
+{
+  addRow_(cut);
+  cuts_.push_back(cut);
+  lb_.push_back(cut->getLb());
+  ub_.push_back(cut->getUb());
+  age_.push_back(0);
+  viol_.push_back(0.0);
+  score_.push_back(0.0);
+}
+
+
+void LinCutPool::addRow_(CutPtr cut)
+{
+  LinearFunctionPtr lf = cut->getFunction()->getLinearFunction();
+  double nrm = 0.0;
+
+  if (lf) {
+    for (VariableGroupConstIterator it=lf->termsBegin(); it!=lf->termsEnd();
+         ++it) {
+      col_.push_back(it->first->getIndex());
+      val_.push_back(it->second);
+      var_.push_back(it->first);
+      nrm += it->second*it->second;
+    }
+  }
+  start_.push_back(col_.size());
+  norm_.push_back(sqrt(nrm));
+}
+
+
+void LinCutPool::clear()
+{
+  age_.clear();
+  col_.clear();
+  cuts_.clear();
+  lb_.clear();
+  norm_.clear();
+  score_.clear();
+  start_.clear();
+  start_.push_back(0);
+  ub_.clear();
+  val_.clear();
+  var_.clear();
+  viol_.clear();
+  head_ = 0;
+  numRemoved_ = 0;
+}
+
+
+void LinCutPool::evalScores(ConstProblemPtr p, const double *x)
+{
+  UInt m = cuts_.size();
+  double act, v;
+
+  if (p != colsP_ || p->getVarIndexVersion() != colsVersion_) {
+    refreshCols_(p);
+  }
+  for (UInt i=head_; i<m; ++i) {
+    if (!cuts_[i]) {
+      continue;
+    }
+    act = 0.0;
+    for (UInt k=start_[i]; k<start_[i+1]; ++k) {
+      act += val_[k]*x[col_[k]];
+    }
+    if (ub_[i] < INFINITY) {
+      v = act - ub_[i];
+    } else if (lb_[i] > -INFINITY) {
+      v = lb_[i] - act;
+    } else {
+      v = 0.0;
+    }
+    viol_[i] = v;
+    score_[i] = (norm_[i] > 0.0) ? v/norm_[i] : 0.0;
+    if (score_[i] < 1e-6) {
+      ++age_[i];
+    } else {
+      age_[i] = 0;
+    }
+  }
+}
+
+
+FunctionPtr LinCutPool::newFunction(UInt i) const
+{
+  LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+  for (UInt k=start_[i]; k<start_[i+1]; ++k) {
+    lf->addTerm(var_[k], val_[k]);
+  }
+  return (FunctionPtr) new Function(lf);
+}
+
+
+CutPtr LinCutPool::popOldest()
+{
+  UInt m = cuts_.size();
+
+  while (head_ < m && !cuts_[head_]) {
+    ++head_;
+  }
+  // head_ stays at the first cut that is left, which may be kept for ever.
+  for (UInt i=head_; i<m; ++i) {
+    if (cuts_[i] && !cuts_[i]->getInfo()->neverDelete) {
+      return remove(i);
+    }
+  }
+  return CutPtr(); // NULL
+}
+
+
+void LinCutPool::purge()
+{
+  UInt m = cuts_.size();
+  UInt j = 0;
+  UInt nz = 0;
+
+  if (0 == numRemoved_) {
+    return;
+  }
+  for (UInt i=0; i<m; ++i) {
+    if (!cuts_[i]) {
+      continue;
+    }
+    for (UInt k=start_[i]; k<start_[i+1]; ++k, ++nz) {
+      col_[nz] = col_[k];
+      val_[nz] = val_[k];
+      var_[nz] = var_[k];
+    }
+    cuts_[j] = cuts_[i];
+    lb_[j] = lb_[i];
+    ub_[j] = ub_[i];
+    norm_[j] = norm_[i];
+    age_[j] = age_[i];
+    viol_[j] = viol_[i];
+    score_[j] = score_[i];
+    // j <= i, so this never overwrites an offset that is still to be read.
+    start_[j+1] = nz;
+    ++j;
+  }
+  col_.resize(nz);
+  val_.resize(nz);
+  var_.resize(nz);
+  cuts_.resize(j);
+  lb_.resize(j);
+  ub_.resize(j);
+  norm_.resize(j);
+  age_.resize(j);
+  viol_.resize(j);
+  score_.resize(j);
+  start_.resize(j+1);
+  head_ = 0;
+  numRemoved_ = 0;
+}
+
+
+void LinCutPool::refreshCols_(ConstProblemPtr p)
+{
+  for (UInt k=0; k<col_.size(); ++k) {
+    col_[k] = var_[k]->getIndex();
+  }
+  colsP_ = p;
+  colsVersion_ = p->getVarIndexVersion();
+}
+
+
+CutPtr LinCutPool::remove(UInt i)
+{
+  CutPtr cut = cuts_[i];
+
+  if (cut) {
+    cuts_[i] = CutPtr(); // NULL
+    ++numRemoved_;
+  }
+  return cut;
+}
+
+
+void LinCutPool::write(std::ostream &out) const
+{
+  for (UInt i=0; i<cuts_.size(); ++i) {
+    if (!cuts_[i]) {
+      continue;
+    }
+    out << lb_[i] << " <= ";
+    for (UInt k=start_[i]; k<start_[i+1]; ++k) {
+      out << "+ " << val_[k] << "*x" << col_[k] << " ";
+    }
+    out << "<= " << ub_[i] << "  age = " << age_[i] << std::endl;
+  }
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,185 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+/**
+ * \file LinCutPool.h
+ * \brief Declare the class LinCutPool that stores linear cuts as rows of a
+ * sparse matrix.
+ * \author The Minotaur Team
+ */
+
+#ifndef MINOTAURLINCUTPOOL_H
+#define MINOTAURLINCUTPOOL_H
+
+#include "Types.h"
+
+namespace Minotaur {
+
+  /**
+   * \brief A pool of linear cuts stored row-wise in one compressed sparse
+   * row (CSR) matrix.
+   *
+   * Each cut \f$l \leq a^Tx \leq u\f$ is one row of the matrix. Bounds, the
+   * Euclidean norm of \f$a\f$, and the number of calls since the cut was
+   * last violated are kept in arrays parallel to the rows. evalScores()
+   * computes the violation and efficacy (violation divided by the norm) of
+   * all cuts with one sparse matrix-vector product, instead of evaluating
+   * the Function of every cut.
+   *
+   * Rows are kept in the order in which cuts were added. remove() only
+   * marks a row; purge() compacts the arrays in one pass. Row numbers are
+   * stable between two calls to purge().
+   *
+   * The coefficients are copied when a cut is added, so the pool does not
+   * depend on the function of a cut after that. This matters because the
+   * function of a cut is freed along with its constraint when the cut is
+   * removed from the relaxation. The variable of each nonzero is kept as
+   * well, and the columns are refreshed before an evaluation if the
+   * variables of the problem have been renumbered since the last one.
+   */
+  class LinCutPool {
+  public:
+    /// Default constructor.
+    LinCutPool();
+
+    /// Destroy.
+    ~LinCutPool();
+
+    /// Return true if the function of the cut is linear.
+    static bool accepts(CutPtr cut);
+
+    /// Append a linear cut as the last row.
+    void add(CutPtr cut);
+
+    /// Remove all cuts.
+    void clear();
+
+    /**
+     * \brief Evaluate violation and efficacy of all cuts at a point.
+     *
+     * The violation of a cut is \f$a^Tx - u\f$ if \f$u\f$ is finite, and
+     * \f$l - a^Tx\f$ otherwise. The results are read with getViol() and
+     * getScore().
+     * \param [in] p The relaxation whose variables the cuts use.
+     * \param [in] x The point, indexed by the variables of p.
+     */
+    void evalScores(ConstProblemPtr p, const double *x);
+
+    /// Number of calls to evalScores() since the cut in row i was violated.
+    UInt getAge(UInt i) const { return age_[i]; }
+
+    /// Cut in row i, NULL if the row has been removed.
+    CutPtr getCut(UInt i) const { return cuts_[i]; }
+
+    /// Number of rows, including those removed since the last purge().
+    UInt getNumRows() const { return cuts_.size(); }
+
+    /// Efficacy of the cut in row i computed by the last evalScores().
+    double getScore(UInt i) const { return score_[i]; }
+
+    /**
+     * \brief Create a new Function from the coefficients of row i.
+     *
+     * Used to put a cut back into the relaxation after its original
+     * function was freed with its constraint.
+     */
+    FunctionPtr newFunction(UInt i) const;
+
+    /// Number of cuts in the pool.
+    UInt getSize() const { return cuts_.size() - numRemoved_; }
+
+    /// Violation of the cut in row i computed by the last evalScores().
+    double getViol(UInt i) const { return viol_[i]; }
+
+    /**
+     * \brief Remove the oldest cut that may be deleted.
+     *
+     * Cuts marked neverDelete are skipped. The pool does not free the cut.
+     * \return The cut removed, or NULL if there is no such cut.
+     */
+    CutPtr popOldest();
+
+    /// Compact the rows, dropping those that were removed.
+    void purge();
+
+    /**
+     * \brief Mark row i as removed. It is dropped by the next purge().
+     *
+     * \return The cut in row i, which the pool does not free, or NULL if
+     * the row was already removed.
+     */
+    CutPtr remove(UInt i);
+
+    /// Display the rows.
+    void write(std::ostream &out) const;
+
+  private:
+    /// Number of calls to evalScores() since each cut was violated.
+    std::vector<UInt> age_;
+
+    /// Column of each nonzero.
+    std::vector<UInt> col_;
+
+    /// Problem whose variable indices are in col_.
+    ConstProblemPtr colsP_;
+
+    /// Value of Problem::getVarIndexVersion() of colsP_ when the columns were
+    /// filled.
+    UInt colsVersion_;
+
+    /// The cuts, NULL for removed rows.
+    std::vector<CutPtr> cuts_;
+
+    /// Rows before this one have all been removed.
+    UInt head_;
+
+    /// Lower bound of each cut.
+    std::vector<double> lb_;
+
+    /// Euclidean norm of the coefficients of each cut.
+    std::vector<double> norm_;
+
+    /// Number of removed rows that are still in the arrays.
+    UInt numRemoved_;
+
+    /// Efficacy of each cut at the last point evaluated.
+    std::vector<double> score_;
+
+    /// Position of the first nonzero of each row, and one past the last.
+    std::vector<UInt> start_;
+
+    /// Upper bound of each cut.
+    std::vector<double> ub_;
+
+    /// Coefficient of each nonzero.
+    std::vector<double> val_;
+
+    /// Variable of each nonzero.
+    std::vector<VariablePtr> var_;
+
+    /// Violation of each cut at the last point evaluated.
+    std::vector<double> viol_;
+
+    /// Append the coefficients of a cut as a new row.
+    void addRow_(CutPtr cut);
+
+    /// Set the column of every nonzero to the index of its variable in p.
+    void refreshCols_(ConstProblemPtr p);
+  };
+  typedef LinCutPool* LinCutPoolPtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
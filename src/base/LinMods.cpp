@@ -107,6 +107,25 @@ bool LinMods::isEmpty() const
   return (lmods_.empty() && bmods2_.empty() && bmods_.empty());
 }
 
+ModificationPtr LinMods::copyByIndex(ProblemPtr p) const
+{
+  LinModsPtr lmods = (LinModsPtr) new LinMods();
+
+  for(VarBoundModConstIter it = bmods_.begin(); it != bmods_.end(); ++it)
+  {
+    lmods->insert((VarBoundModPtr) (*it)->copyByIndex(p));
+  }
+  for(VarBoundMod2ConstIter it = bmods2_.begin(); it != bmods2_.end(); ++it)
+  {
+    lmods->insert((VarBoundMod2Ptr) (*it)->copyByIndex(p));
+  }
+  for(LinConModConstIter it = lmods_.begin(); it != lmods_.end(); ++it)
+  {
+    lmods->insert((LinConModPtr) (*it)->copyByIndex(p));
+  }
+  return lmods;
+}
+
 ModificationPtr LinMods::fromRel(RelaxationPtr rel, ProblemPtr) const
 {
   LinModsPtr lmods = (LinModsPtr) new LinMods();
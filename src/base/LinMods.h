@@ -38,6 +38,9 @@ class LinMods : public Modification {
   /// Apply it to the problem.
   void applyToProblem(ProblemPtr problem);
 
+  // base class method.
+  ModificationPtr copyByIndex(ProblemPtr p) const;
+
   // base class method.
   ModificationPtr fromRel(RelaxationPtr, ProblemPtr) const;
 
@@ -0,0 +1,456 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+/**
+ * \file LinPropagator.cpp
+ * \brief Implement the methods of LinPropagator class.
+ * \author The Minotaur Team
+ */
+
+#include <cmath>
+#include <iostream>
+
+#include "MinotaurConfig.h"
+#include "Constraint.h"
+#include "Function.h"
+#include "LinPropagator.h"
+#include "LinearFunction.h"
+#include "Problem.h"
+#include "VarBoundMod.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+
+LinPropagator::LinPropagator(double etol, double infty)
+  : eTol_(etol),
+    infty_(infty),
+    p_(ProblemPtr()), // NULL
+    version_(0)
+{
+}
+
+
+LinPropagator::~LinPropagator()
+{
+  p_ = 0;
+}
+
+
+void LinPropagator::addTerm_(UInt r, double a, double l, double u, int sign)
+{
+  double lo, up;
+
+  if (a > 0) {
+    lo = l;
+    up = u;
+  } else if (a < 0) {
+    lo = u;
+    up = l;
+  } else {
+    return;
+  }
+
+  // contribution to the minimum activity.
+  if (lo <= -infty_ || lo >= infty_) {
+    if (sign > 0) {
+      ++minInf_[r];
+    } else {
+      --minInf_[r];
+    }
+  } else {
+    minFin_[r] += sign*a*lo;
+  }
+
+  // contribution to the maximum activity.
+  if (up <= -infty_ || up >= infty_) {
+    if (sign > 0) {
+      ++maxInf_[r];
+    } else {
+      --maxInf_[r];
+    }
+  } else {
+    maxFin_[r] += sign*a*up;
+  }
+}
+
+
+void LinPropagator::build_(ProblemPtr p)
+{
+  UInt n = p->getNumVars();
+  UInt m, k, j;
+  ConstraintPtr c;
+  LinearFunctionPtr lf;
+  VariablePtr v;
+  UIntVector cnt;
+
+  p_ = p;
+  version_ = p->getVarIndexVersion();
+
+  vars_.assign(n, VariablePtr());
+  lb_.resize(n);
+  ub_.resize(n);
+  for (VariableConstIterator it=p->varsBegin(); it!=p->varsEnd(); ++it) {
+    v = *it;
+    vars_[v->getIndex()] = v;
+    lb_[v->getIndex()] = v->getLb();
+    ub_[v->getIndex()] = v->getUb();
+  }
+
+  cons_.clear();
+  lfs_.clear();
+  nTerms_.clear();
+  rowCons_.clear();
+  rowLb_.clear();
+  rowUb_.clear();
+  rowStart_.clear();
+  rowCol_.clear();
+  rowVal_.clear();
+  rowStart_.push_back(0);
+  for (ConstraintConstIterator it=p->consBegin(); it!=p->consEnd(); ++it) {
+    c = *it;
+    cons_.push_back(c);
+    if (!isRow_(c)) {
+      lfs_.push_back(LinearFunctionPtr());
+      nTerms_.push_back(0);
+      continue;
+    }
+    lf = c->getLinearFunction();
+    lfs_.push_back(lf);
+    nTerms_.push_back(lf->getNumTerms());
+    for (VariableGroupConstIterator vit=lf->termsBegin();
+         vit!=lf->termsEnd(); ++vit) {
+      rowCol_.push_back(vit->first->getIndex());
+      rowVal_.push_back(vit->second);
+    }
+    rowStart_.push_back(rowCol_.size());
+    rowCons_.push_back(c);
+    rowLb_.push_back(c->getLb());
+    rowUb_.push_back(c->getUb());
+  }
+  m = rowCons_.size();
+
+  // columns, by counting the nonzeros of each.
+  cnt.assign(n+1, 0);
+  for (k=0; k<rowCol_.size(); ++k) {
+    ++cnt[rowCol_[k]+1];
+  }
+  for (j=0; j<n; ++j) {
+    cnt[j+1] += cnt[j];
+  }
+  colStart_ = cnt;
+  colRow_.resize(rowCol_.size());
+  colVal_.resize(rowCol_.size());
+  for (UInt r=0; r<m; ++r) {
+    for (k=rowStart_[r]; k<rowStart_[r+1]; ++k) {
+      j = rowCol_[k];
+      colRow_[cnt[j]] = r;
+      colVal_[cnt[j]] = rowVal_[k];
+      ++cnt[j];
+    }
+  }
+
+  minFin_.assign(m, 0.0);
+  maxFin_.assign(m, 0.0);
+  minInf_.assign(m, 0);
+  maxInf_.assign(m, 0);
+  visits_.assign(m, 0);
+  inQueue_.assign(m, false);
+  queue_.clear();
+  for (UInt r=0; r<m; ++r) {
+    computeAct_(r);
+    push_(r);
+  }
+}
+
+
+void LinPropagator::changeBnds_(UInt j, double l, double u)
+{
+  UInt r;
+  double a;
+
+  for (UInt k=colStart_[j]; k<colStart_[j+1]; ++k) {
+    r = colRow_[k];
+    a = colVal_[k];
+    addTerm_(r, a, lb_[j], ub_[j], -1);
+    addTerm_(r, a, l, u, 1);
+    push_(r);
+  }
+  lb_[j] = l;
+  ub_[j] = u;
+}
+
+
+void LinPropagator::computeAct_(UInt r)
+{
+  UInt j;
+
+  minFin_[r] = 0.0;
+  maxFin_[r] = 0.0;
+  minInf_[r] = 0;
+  maxInf_[r] = 0;
+  for (UInt k=rowStart_[r]; k<rowStart_[r+1]; ++k) {
+    j = rowCol_[k];
+    addTerm_(r, rowVal_[k], lb_[j], ub_[j], 1);
+  }
+}
+
+
+bool LinPropagator::getActivity(ConstraintPtr c, double *min_fin,
+                                UInt *min_inf, double *max_fin,
+                                UInt *max_inf) const
+{
+  for (UInt r=0; r<rowCons_.size(); ++r) {
+    if (rowCons_[r] == c) {
+      *min_fin = minFin_[r];
+      *min_inf = minInf_[r];
+      *max_fin = maxFin_[r];
+      *max_inf = maxInf_[r];
+      return true;
+    }
+  }
+  return false;
+}
+
+
+bool LinPropagator::isRow_(ConstraintPtr c) const
+{
+  return (c->getFunctionType() == Linear && c->getLinearFunction() &&
+          c->getQuadraticFunction() == 0 && c->getNonlinearFunction() == 0 &&
+          DeletedCons != c->getState());
+}
+
+
+bool LinPropagator::isStale_(ProblemPtr p)
+{
+  UInt k = 0;
+  ConstraintPtr c;
+  LinearFunctionPtr lf;
+
+  if (p->getNumVars() != vars_.size() || p->getNumCons() != cons_.size() ||
+      p->getVarIndexVersion() != version_) {
+    return true;
+  }
+  for (ConstraintConstIterator it=p->consBegin(); it!=p->consEnd();
+       ++it, ++k) {
+    c = *it;
+    if (c != cons_[k]) {
+      return true;
+    }
+    if (isRow_(c)) {
+      lf = c->getLinearFunction();
+      if (lf != lfs_[k] || lf->getNumTerms() != nTerms_[k]) {
+        return true;
+      }
+    } else if (lfs_[k]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+SolveStatus LinPropagator::propagate(ProblemPtr p, UInt max_visits,
+                                     bool *changed, ModQ *mods,
+                                     UInt *nintmods)
+{
+  UInt r;
+  bool lo_ok, up_ok;
+
+  std::fill(visits_.begin(), visits_.end(), 0);
+  while (!queue_.empty()) {
+    r = queue_.front();
+    queue_.pop_front();
+    inQueue_[r] = false;
+    if (visits_[r] >= max_visits) {
+      continue;
+    }
+
+    // A row can tighten a bound only if at most one term has an infinite
+    // contribution on that side. A redundant row tightens nothing.
+    lo_ok = (rowLb_[r] > -infty_ && maxInf_[r] <= 1);
+    up_ok = (rowUb_[r] < infty_ && minInf_[r] <= 1);
+    if (!lo_ok && !up_ok) {
+      continue;
+    }
+    if (0 == minInf_[r] && 0 == maxInf_[r] &&
+        minFin_[r] >= rowLb_[r] - eTol_ && maxFin_[r] <= rowUb_[r] + eTol_) {
+      continue;
+    }
+
+    ++visits_[r];
+    computeAct_(r);
+    if ((0 == minInf_[r] && minFin_[r] > rowUb_[r] + eTol_) ||
+        (0 == maxInf_[r] && maxFin_[r] < rowLb_[r] - eTol_)) {
+      while (!queue_.empty()) {
+        inQueue_[queue_.front()] = false;
+        queue_.pop_front();
+      }
+      return SolvedInfeasible;
+    }
+    tightenRow_(p, r, changed, mods, nintmods);
+  }
+  return Started;
+}
+
+
+void LinPropagator::push_(UInt r)
+{
+  if (!inQueue_[r]) {
+    inQueue_[r] = true;
+    queue_.push_back(r);
+  }
+}
+
+
+void LinPropagator::setBnd_(ProblemPtr p, UInt j, BoundType bt, double val,
+                            bool *changed, ModQ *mods, UInt *nintmods)
+{
+  VariablePtr v = vars_[j];
+  VarBoundModPtr mod = (VarBoundModPtr) new VarBoundMod(v, bt, val);
+
+  mod->applyToProblem(p);
+  mods->push_back(mod);
+  if (v->getType()==Binary || v->getType()==Integer) {
+    ++(*nintmods);
+  }
+  *changed = true;
+  changeBnds_(j, v->getLb(), v->getUb());
+}
+
+
+void LinPropagator::sync(ProblemPtr p)
+{
+  ConstraintPtr c;
+  VariablePtr v;
+  double l, u;
+
+  if (p != p_ || isStale_(p)) {
+    build_(p);
+    return;
+  }
+  for (UInt r=0; r<rowCons_.size(); ++r) {
+    c = rowCons_[r];
+    if (c->getLb() != rowLb_[r] || c->getUb() != rowUb_[r]) {
+      rowLb_[r] = c->getLb();
+      rowUb_[r] = c->getUb();
+      push_(r);
+    }
+  }
+  for (UInt j=0; j<vars_.size(); ++j) {
+    v = vars_[j];
+    l = v->getLb();
+    u = v->getUb();
+    if (l != lb_[j] || u != ub_[j]) {
+      changeBnds_(j, l, u);
+    }
+  }
+}
+
+
+void LinPropagator::tightenRow_(ProblemPtr p, UInt r, bool *changed,
+                                ModQ *mods, UInt *nintmods)
+{
+  UInt j;
+  double a, resid, nb;
+  const double rlb = rowLb_[r];
+  const double rub = rowUb_[r];
+
+  for (UInt k=rowStart_[r]; k<rowStart_[r+1]; ++k) {
+    j = rowCol_[k];
+    a = rowVal_[k];
+    if (a > eTol_) {
+      // from the lower bound of the row, using the maximum activity of the
+      // other terms.
+      if (rlb > -infty_ && maxInf_[r] <= 1) {
+        if (0 == maxInf_[r]) {
+          resid = maxFin_[r] - a*ub_[j];
+        } else if (ub_[j] >= infty_) {
+          resid = maxFin_[r];
+        } else {
+          resid = INFINITY;
+        }
+        if (resid < INFINITY) {
+          nb = (rlb - resid)/a;
+          if (nb > lb_[j] + eTol_) {
+            if (nb > ub_[j] - eTol_) {
+              nb = ub_[j];
+            }
+            setBnd_(p, j, Lower, nb, changed, mods, nintmods);
+          }
+        }
+      }
+      // from the upper bound of the row, using the minimum activity.
+      if (rub < infty_ && minInf_[r] <= 1) {
+        if (0 == minInf_[r]) {
+          resid = minFin_[r] - a*lb_[j];
+        } else if (lb_[j] <= -infty_) {
+          resid = minFin_[r];
+        } else {
+          resid = -INFINITY;
+        }
+        if (resid > -INFINITY) {
+          nb = (rub - resid)/a;
+          if (nb < ub_[j] - eTol_) {
+            if (nb < lb_[j] + eTol_) {
+              nb = lb_[j];
+            }
+            setBnd_(p, j, Upper, nb, changed, mods, nintmods);
+          }
+        }
+      }
+    } else if (a < -eTol_) {
+      if (rlb > -infty_ && maxInf_[r] <= 1) {
+        if (0 == maxInf_[r]) {
+          resid = maxFin_[r] - a*lb_[j];
+        } else if (lb_[j] <= -infty_) {
+          resid = maxFin_[r];
+        } else {
+          resid = INFINITY;
+        }
+        if (resid < INFINITY) {
+          nb = (rlb - resid)/a;
+          if (nb < ub_[j] - eTol_) {
+            if (nb < lb_[j] + eTol_) {
+              nb = lb_[j];
+            }
+            setBnd_(p, j, Upper, nb, changed, mods, nintmods);
+          }
+        }
+      }
+      if (rub < infty_ && minInf_[r] <= 1) {
+        if (0 == minInf_[r]) {
+          resid = minFin_[r] - a*ub_[j];
+        } else if (ub_[j] >= infty_) {
+          resid = minFin_[r];
+        } else {
+          resid = -INFINITY;
+        }
+        if (resid > -INFINITY) {
+          nb = (rub - resid)/a;
+          if (nb > lb_[j] + eTol_) {
+            if (nb > ub_[j] - eTol_) {
+              nb = ub_[j];
+            }
+            setBnd_(p, j, Lower, nb, changed, mods, nintmods);
+          }
+        }
+      }
+    }
+  }
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,221 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+/**
+ * \file LinPropagator.h
+ * \brief Declare the class LinPropagator that tightens bounds of variables
+ * using the activities of linear constraints.
+ * \author The Minotaur Team
+ */
+
+#ifndef MINOTAURLINPROPAGATOR_H
+#define MINOTAURLINPROPAGATOR_H
+
+#include <deque>
+
+#include "Types.h"
+
+namespace Minotaur {
+
+  /**
+   * \brief Activity-based bound propagation on the linear constraints of a
+   * problem.
+   *
+   * For every linear constraint \f$l \leq a^Tx \leq u\f$ (a row), the
+   * propagator keeps the finite parts of the minimum and maximum activity
+   * of \f$a^Tx\f$ over the bounds of x, and the number of terms that
+   * contribute an infinite amount to each. When the bound of a variable
+   * changes, the activities of the rows it appears in are updated in place
+   * (using a column-to-row adjacency) and those rows are put in a queue.
+   * propagate() only visits rows in the queue.
+   *
+   * The incremental activities decide whether a row needs to be scanned.
+   * Before a row is scanned its activities are computed again from the
+   * bounds, so round-off in the updates does not affect the bounds found.
+   *
+   * The rows and columns are copied from the problem. sync() compares them
+   * with the problem and copies them again if a linear constraint was
+   * added, removed or had its function replaced.
+   */
+  class LinPropagator {
+  public:
+    /**
+     * \brief Constructor.
+     *
+     * \param [in] etol Change in a bound smaller than this is ignored.
+     * \param [in] infty Bounds beyond this number are treated as infinity.
+     */
+    LinPropagator(double etol, double infty);
+
+    /// Destroy.
+    ~LinPropagator();
+
+    /**
+     * \brief Get the activities of a row as they are kept between calls.
+     *
+     * \param [in] c The constraint of the row.
+     * \param [out] min_fin Finite part of the minimum activity.
+     * \param [out] min_inf Number of infinite contributions to it.
+     * \param [out] max_fin Finite part of the maximum activity.
+     * \param [out] max_inf Number of infinite contributions to it.
+     * \return False if c is not a row of the propagator.
+     */
+    bool getActivity(ConstraintPtr c, double *min_fin, UInt *min_inf,
+                     double *max_fin, UInt *max_inf) const;
+
+    /**
+     * \brief Tighten bounds of variables until no row in the queue can
+     * tighten any further.
+     *
+     * \param [in] p The problem passed to the last call of sync().
+     * \param [in] max_visits Maximum number of times a row is scanned in
+     * this call.
+     * \param [out] changed Set to true if some bound is changed.
+     * \param [out] mods The bound changes are appended here. They have
+     * been applied to p already.
+     * \param [out] nintmods Incremented for each bound change of an integer
+     * variable.
+     * \return SolvedInfeasible if some row can not be satisfied within
+     * the bounds, Started otherwise.
+     */
+    SolveStatus propagate(ProblemPtr p, UInt max_visits, bool *changed,
+                          ModQ *mods, UInt *nintmods);
+
+    /**
+     * \brief Bring the rows and bounds up to date with a problem.
+     *
+     * Rows whose bounds, or whose variables' bounds, changed since the last
+     * call are put in the queue. If the problem is not the one seen last or
+     * its linear constraints changed, the rows are copied again and all of
+     * them are put in the queue.
+     */
+    void sync(ProblemPtr p);
+
+  private:
+    /// Rows of each column.
+    UIntVector colRow_;
+
+    /// Position of the first row of each column, and one past the last.
+    UIntVector colStart_;
+
+    /// Coefficient of each column in each of its rows.
+    DoubleVector colVal_;
+
+    /// All constraints of the problem, in its order.
+    std::vector<ConstraintPtr> cons_;
+
+    /// Tolerance for changes in bounds.
+    const double eTol_;
+
+    /// True for rows that are in the queue.
+    std::vector<bool> inQueue_;
+
+    /// Bounds beyond this are infinite.
+    const double infty_;
+
+    /// Lower bound of each variable used in the activities.
+    DoubleVector lb_;
+
+    /// Linear function of each constraint when the rows were copied.
+    std::vector<LinearFunctionPtr> lfs_;
+
+    /// Finite part of the maximum activity of each row.
+    DoubleVector maxFin_;
+
+    /// Number of infinite contributions to the maximum activity of a row.
+    UIntVector maxInf_;
+
+    /// Finite part of the minimum activity of each row.
+    DoubleVector minFin_;
+
+    /// Number of infinite contributions to the minimum activity of a row.
+    UIntVector minInf_;
+
+    /// Number of terms of each linear function when the rows were copied.
+    UIntVector nTerms_;
+
+    /// The problem whose rows are stored.
+    ProblemPtr p_;
+
+    /// Rows to be visited.
+    std::deque<UInt> queue_;
+
+    /// Column of each nonzero of the rows.
+    UIntVector rowCol_;
+
+    /// Constraint of each row.
+    std::vector<ConstraintPtr> rowCons_;
+
+    /// Lower bound of each row.
+    DoubleVector rowLb_;
+
+    /// Position of the first nonzero of each row, and one past the last.
+    UIntVector rowStart_;
+
+    /// Upper bound of each row.
+    DoubleVector rowUb_;
+
+    /// Coefficient of each nonzero of the rows.
+    DoubleVector rowVal_;
+
+    /// Upper bound of each variable used in the activities.
+    DoubleVector ub_;
+
+    /// Variable of each column.
+    std::vector<VariablePtr> vars_;
+
+    /// Value of Problem::getVarIndexVersion() when the rows were copied.
+    UInt version_;
+
+    /// Number of times each row was scanned in the current propagate().
+    UIntVector visits_;
+
+    /**
+     * \brief Add (sign 1) or remove (sign -1) the contribution of a term
+     * with coefficient a and bounds [l, u] to the activities of row r.
+     */
+    void addTerm_(UInt r, double a, double l, double u, int sign);
+
+    /// Copy rows and columns from p and put all rows in the queue.
+    void build_(ProblemPtr p);
+
+    /// Set the bounds of column j and update the rows it appears in.
+    void changeBnds_(UInt j, double l, double u);
+
+    /// Compute the activities of row r from the bounds.
+    void computeAct_(UInt r);
+
+    /// True if the linear constraints of p differ from the stored rows.
+    bool isStale_(ProblemPtr p);
+
+    /// True if the constraint is a row of the propagator.
+    bool isRow_(ConstraintPtr c) const;
+
+    /// Put row r in the queue if it is not there already.
+    void push_(UInt r);
+
+    /// Change a bound of column j in p and in the rows.
+    void setBnd_(ProblemPtr p, UInt j, BoundType bt, double val, bool *changed,
+                 ModQ *mods, UInt *nintmods);
+
+    /// Tighten bounds of the variables of row r using its activities.
+    void tightenRow_(ProblemPtr p, UInt r, bool *changed, ModQ *mods,
+                     UInt *nintmods);
+  };
+  typedef LinPropagator* LinPropagatorPtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -5,6 +5,7 @@
 // 
 
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -18,7 +19,8 @@ using namespace Minotaur;
 
 
 LinearFunction::LinearFunction()
-  : hasChanged_(true),
+  : frozen_(false),
+    hasChanged_(true),
     tol_(1e-9)
 {
   terms_.clear();
@@ -26,7 +28,8 @@ LinearFunction::LinearFunction()
 
 
 LinearFunction::LinearFunction(const double tol)
-  : hasChanged_(true),
+  : frozen_(false),
+    hasChanged_(true),
     tol_(tol)
 {
   terms_.clear();
@@ -35,7 +38,8 @@ LinearFunction::LinearFunction(const double tol)
 
 LinearFunction::LinearFunction(double *a, VariableConstIterator vbeg, 
     VariableConstIterator vend, double tol)
-  : hasChanged_(true),
+  : frozen_(false),
+    hasChanged_(true),
     tol_(tol)
 {
   VariablePtr v;
@@ -91,6 +95,17 @@ void LinearFunction::addTerm(ConstVariablePtr var, const double a)
   if (fabs(a) > tol_) {
     terms_.insert(std::make_pair(var, a));
     hasChanged_ = true;
+    frozen_ = false;
+  }
+}
+
+
+void LinearFunction::appendTerm(ConstVariablePtr var, const double a)
+{
+  if (fabs(a) > tol_) {
+    terms_.insert(terms_.end(), std::make_pair(var, a));
+    hasChanged_ = true;
+    frozen_ = false;
   }
 }
 
@@ -138,19 +153,33 @@ void LinearFunction::incTerm(ConstVariablePtr var, const double a)
       terms_.erase(var);
     } 
     hasChanged_ = true;
+    frozen_ = false;
   }
 }
 
 
 double LinearFunction::eval(const std::vector<double> &x) const
 {
-   return(InnerProduct(x, terms_));
+  if (frozen_) {
+    double value = 0;
+    for (UInt i=0; i<fInd_.size(); ++i) {
+      value += x[fInd_[i]] * fVal_[i];
+    }
+    return value;
+  }
+  return(InnerProduct(x, terms_));
 }
 
 
 double LinearFunction::eval(const double *x) const
 {
   double value = 0;
+  if (frozen_) {
+    for (UInt i=0; i<fInd_.size(); ++i) {
+      value += x[fInd_[i]] * fVal_[i];
+    }
+    return value;
+  }
   for (VariableGroupConstIterator it=terms_.begin(); it!=terms_.end(); ++it) {
     value += x[it->first->getIndex()] * it->second;
   }
@@ -160,6 +189,12 @@ double LinearFunction::eval(const double *x) const
 
 void LinearFunction::evalGradient(double *grad_f) const
 {
+  if (frozen_) {
+    for (UInt i=0; i<fInd_.size(); ++i) {
+      grad_f[fInd_[i]] += fVal_[i];
+    }
+    return;
+  }
   for (VariableGroupConstIterator it=terms_.begin(); it!=terms_.end(); ++it) {
     grad_f[it->first->getIndex()] += it->second;
   }
@@ -180,15 +215,32 @@ void LinearFunction::computeBounds(double *l, double *u)
   double lb = 0.0;
   double ub = 0.0;
   double a;
-
-  for (VariableGroupConstIterator it=terms_.begin(); it!=terms_.end(); ++it) {
-    a = it->second;
-    if (a>0) {
-      lb += a*it->first->getLb();
-      ub += a*it->first->getUb();
-    } else {
-      lb += a*it->first->getUb();
-      ub += a*it->first->getLb();
+  ConstVariablePtr v;
+
+  // may be called by several threads, so it does not freeze.
+  if (frozen_) {
+    for (UInt i=0; i<fVal_.size(); ++i) {
+      a = fVal_[i];
+      v = fVar_[i];
+      if (a>0) {
+        lb += a*v->getLb();
+        ub += a*v->getUb();
+      } else {
+        lb += a*v->getUb();
+        ub += a*v->getLb();
+      }
+    }
+  } else {
+    for (VariableGroupConstIterator it=terms_.begin(); it!=terms_.end();
+         ++it) {
+      a = it->second;
+      if (a>0) {
+        lb += a*it->first->getLb();
+        ub += a*it->first->getUb();
+      } else {
+        lb += a*it->first->getUb();
+        ub += a*it->first->getLb();
+      }
     }
   }
   *l = lb;
@@ -196,6 +248,37 @@ void LinearFunction::computeBounds(double *l, double *u)
 }
 
 
+void LinearFunction::freeze()
+{
+  // pairs of index of variable and position of its term in terms_.
+  std::vector<std::pair<UInt, UInt> > order;
+  VarVector vars;
+  DoubleVector vals;
+  UInt i = 0;
+
+  order.reserve(terms_.size());
+  vars.reserve(terms_.size());
+  vals.reserve(terms_.size());
+  for (VariableGroupConstIterator it=terms_.begin(); it!=terms_.end(); 
+       ++it, ++i) {
+    order.push_back(std::make_pair(it->first->getIndex(), i));
+    vars.push_back(it->first);
+    vals.push_back(it->second);
+  }
+  std::sort(order.begin(), order.end());
+
+  fInd_.resize(order.size());
+  fVal_.resize(order.size());
+  fVar_.resize(order.size());
+  for (i=0; i<order.size(); ++i) {
+    fInd_[i] = order[i].first;
+    fVar_[i] = vars[order[i].second];
+    fVal_[i] = vals[order[i].second];
+  }
+  frozen_ = true;
+}
+
+
 void LinearFunction::getVars(VariableSet *vars)
 {
   for (VariableGroupConstIterator it=terms_.begin(); it!=terms_.end(); ++it) {
@@ -231,6 +314,7 @@ void LinearFunction::multiply(double d)
     }
   }
   hasChanged_ = true;
+  frozen_ = false;
 }
 
 
@@ -273,6 +357,7 @@ void LinearFunction::removeVar(VariablePtr v, double )
 {
   terms_.erase(v);
   hasChanged_ = true;
+  frozen_ = false;
 }
 
 void LinearFunction::clearAll()
@@ -280,6 +365,7 @@ void LinearFunction::clearAll()
   terms_.clear();
   off_.clear();
   hasChanged_ = true;
+  frozen_ = false;
 }
 
 
@@ -305,6 +391,9 @@ void LinearFunction::prepJac(VarSetConstIter vbeg, VarSetConstIter vend)
     }
     hasChanged_ = false;
   }
+  if (!frozen_) {
+    freeze();
+  }
 }
 
 
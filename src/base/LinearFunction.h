@@ -62,6 +62,14 @@ namespace Minotaur {
      */
     void addTerm(ConstVariablePtr var, const double a); 
 
+    /**
+     * Same as addTerm(), but faster if var comes after all the variables
+     * already in this function, e.g. when terms are added in the order of
+     * termsBegin() to termsEnd() of another function on the same variables.
+     * The result is correct in any order.
+     */
+    void appendTerm(ConstVariablePtr var, const double a);
+
     /**
      * Removes all terms from the function
      */
@@ -107,6 +115,19 @@ namespace Minotaur {
 
     void fillJac(double *values, int *error);
 
+    /**
+     * \brief Copy the terms into contiguous arrays sorted by the index of
+     * the variables.
+     *
+     * Evaluation routines use these arrays instead of walking the map of
+     * terms. The arrays are discarded whenever the function is modified or
+     * the index of a variable changes; until freeze() is called again, the
+     * map is used. prepJac() calls this function, and so does
+     * Problem::delMarkedVars() after it renumbers the variables. Not
+     * thread-safe.
+     */
+    void freeze();
+
     double getFixVarOffset(VariablePtr v, double val);
 
     /// Get the number of terms in this function.
@@ -189,6 +210,18 @@ namespace Minotaur {
     QuadraticFunctionPtr copyMult(ConstLinearFunctionPtr l1);
 
   private:
+    /// Indices of variables of the frozen terms, in increasing order.
+    UIntVector fInd_;
+
+    /// Coefficients of the frozen terms.
+    DoubleVector fVal_;
+
+    /// Variables of the frozen terms.
+    VarVector fVar_;
+
+    /// True if fInd_, fVal_ and fVar_ have the same terms as terms_.
+    bool frozen_;
+
     /**
      * True if terms in linear function are modified since previous call to
      * prepJac.
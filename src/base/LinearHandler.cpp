@@ -22,6 +22,7 @@
 #include "Constraint.h"
 #include "Environment.h"
 #include "Function.h"
+#include "LinPropagator.h"
 #include "LinearFunction.h"
 #include "Logger.h"
 #include "Node.h"
@@ -57,7 +58,8 @@ LinearHandler::LinearHandler()
     eTol_(1e-8),
     infty_(1e20),
     pStats_(0),
-    pOpts_(0)
+    pOpts_(0),
+    prop_(0)
 {
   linVars_.clear();
 }
@@ -70,7 +72,8 @@ LinearHandler::LinearHandler(EnvPtr env, ProblemPtr problem)
     eTol_(1e-8),
     infty_(1e20),
     pStats_(0),
-    pOpts_(0)
+    pOpts_(0),
+    prop_(0)
 {
   logger_ = env->getLogger();
   pStats_ = new LinPresolveStats();
@@ -101,6 +104,9 @@ LinearHandler::~LinearHandler()
 {
   delete pStats_;
   delete pOpts_;
+  if (prop_) {
+    delete prop_;
+  }
   linVars_.clear();
 }
 
@@ -1612,15 +1618,15 @@ void LinearHandler::simplePresolve(ProblemPtr p, SolutionPoolPtr spool,
   UInt iters = 1;
   UInt nintmods;
   Timer *timer = 0;
-  ConstraintPtr c_ptr;
   timer = env_->getNewTimer();
   timer->start();
 
-  for (ConstraintConstIterator c_iter = p->consBegin(); c_iter != p->consEnd();
-       ++c_iter) {
-    c_ptr = *c_iter;
-    c_ptr->setBFlag(true);
+  // Only rows whose bounds or variables changed since the last call, e.g.
+  // by branching, are visited.
+  if (!prop_) {
+    prop_ = new LinPropagator(eTol_, infty_);
   }
+  prop_->sync(p);
 
   while (true == changed && iters <= max_iters &&
          (iters <= min_iters || nintmods > 0) &&
@@ -1628,7 +1634,11 @@ void LinearHandler::simplePresolve(ProblemPtr p, SolutionPoolPtr spool,
     nintmods = 0;
     changed = false;
     ++iters;
-    varBndsFromCons_(p, false, &changed, &mods, &nintmods);
+    if (SolvedInfeasible == prop_->propagate(p, max_iters, &changed, &mods,
+                                             &nintmods)) {
+      status = SolvedInfeasible;
+      break;
+    }
 #if USE_OPENMP
 #pragma omp critical
 #endif
@@ -1641,6 +1651,7 @@ void LinearHandler::simplePresolve(ProblemPtr p, SolutionPoolPtr spool,
     }
     tightenInts_(p, false, &changed, &mods);
     status = checkBounds_(p);
+    prop_->sync(p);
   }
 
   for (ModQ::const_iterator it = mods.begin(); it != mods.end(); ++it) {
@@ -18,6 +18,8 @@
 
 namespace Minotaur {
 
+class LinPropagator;
+
 /// Store statistics of presolving.
 struct LinPresolveStats 
 {
@@ -183,6 +185,9 @@ protected:
   /// Options for presolve.
   LinPresolveOpts *pOpts_;
 
+  /// Bound propagation on linear constraints, used by simplePresolve.
+  LinPropagator *prop_;
+
   /**
    * Linear variables: variables that do not appear in nonlinear
    * functions, both in objective and constraints.
@@ -76,6 +76,7 @@ Linearizations::Linearizations(EnvPtr env, RelaxationPtr rel,
   rgs1_ = env_->getOptions()->findBool("root_linGenScheme1")->getValue();
   rgs2Per_ = env_->getOptions()->findDouble("root_linGenScheme2_per")->getValue();
   intTol_ = env_->getOptions()->findDouble("int_tol")->getValue();
+  linCoeffTol_ = env_->getOptions()->findDouble("conCoeff_tol");
   solAbsTol_ = env_->getOptions()->findDouble("feasAbs_tol")->getValue();
   solRelTol_ = env_->getOptions()->findDouble("feasRel_tol")->getValue();
   objATol_ = env_->getOptions()->findDouble("solAbs_tol")->getValue();
@@ -723,8 +724,7 @@ void Linearizations::linearAt_(FunctionPtr f, double fval, const double *x,
   int n = rel_->getNumVars();
   double *a = new double[n];
   VariableConstIterator vbeg = rel_->varsBegin(), vend = rel_->varsEnd();
-  const double linCoeffTol =
-    env_->getOptions()->findDouble("conCoeff_tol")->getValue();
+  const double linCoeffTol = linCoeffTol_->getValue();
 
   std::fill(a, a+n, 0.);
   f->evalGradient(x, a, error);
@@ -1856,8 +1856,7 @@ void Linearizations::genLin_(double *x, std::vector<UInt > vioConsPos,
     std::stringstream sstm;
     LinearFunctionPtr lf = 0;
     VariableConstIterator vbeg = rel_->varsBegin(), vend = rel_->varsEnd();
-    const double linCoeffTol =
-    env_->getOptions()->findDouble("conCoeff_tol")->getValue();
+    const double linCoeffTol = linCoeffTol_->getValue();
     for (UInt j = 0; j < vioConsPos.size(); ++j) {
       error = 0;
       isCont = false;
@@ -2508,8 +2507,7 @@ void Linearizations::rScheme2Cut_(FunctionPtr f, double UB, double &delta,
     FunctionPtr newF;
     LinearFunctionPtr lf = 0;
     VariableConstIterator vbeg = rel_->varsBegin(), vend = rel_->varsEnd();
-    const double linCoeffTol =
-      env_->getOptions()->findDouble("conCoeff_tol")->getValue();
+    const double linCoeffTol = linCoeffTol_->getValue();
     double c, act = f->eval(npt, &error);
 
     if (error == 0) {
@@ -2695,8 +2693,7 @@ bool Linearizations::uniVarNlFunc_(FunctionPtr f, double &lVarCoeff,
   QuadraticFunctionPtr qf = f->getQuadraticFunction();
   NonlinearFunctionPtr nlf = f->getNonlinearFunction();
 
-  const double linCoeffTol =
-    env_->getOptions()->findDouble("conCoeff_tol")->getValue();
+  const double linCoeffTol = linCoeffTol_->getValue();
 
   if (nlf) {
     nlTerms = nlf->numVars();
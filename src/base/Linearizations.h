@@ -53,6 +53,9 @@ private:
   /// Tolerance for checking integrality (should be obtained from env).
   double intTol_;
 
+  /// Option conCoeff_tol, read for every linearization.
+  DoubleOptionPtr linCoeffTol_;
+
   /// Log.
   LoggerPtr logger_;
 
@@ -4,44 +4,394 @@
 //     (C)opyright 2008 - 2024 The Minotaur Team.
 //
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "MinotaurConfig.h"
 #include "Logger.h"
 
+#if USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace Minotaur {
+  /// A line written by a thread.
+  struct LogRecord {
+    /// Seconds since the logger was created.
+    double time;
+
+    /// OpenMP thread number of the writer.
+    int thread;
+
+    std::string text;
+  };
+
+  /// Data of a logger that is shared by all threads.
+  struct LogShared {
+    /// True if lines are queued for the background thread.
+    std::atomic<bool> async;
+
+    /// Unique number of the logger.
+    UInt id;
+
+    /// Time at which the logger was created.
+    std::chrono::steady_clock::time_point start;
+
+    /// Held while writing to std::cout or taking lines from the queues.
+    std::mutex outMutex;
+
+    /// Lines taken from the queues but not written yet. Guarded by
+    /// outMutex.
+    std::vector<LogRecord> pending;
+
+    /// Held while adding or reading slots.
+    std::mutex slotMutex;
+
+    /// Buffers of all threads that wrote a message.
+    std::vector<LogSlot *> slots;
+
+    /// True if the background thread must stop. Guarded by wakeMutex.
+    bool stop;
+
+    /// The background thread.
+    std::thread drainer;
+
+    /// To wake up the background thread.
+    std::condition_variable wake;
+
+    /// Guards stop.
+    std::mutex wakeMutex;
+  };
+
+  /// Stream buffer of one thread. It passes on complete lines.
+  class LogBuf : public std::streambuf {
+  public:
+    LogBuf(LogShared *sh, LogSlot *sl) : sh_(sh), sl_(sl) {}
+
+    /// Pass on the text that is not a complete line.
+    void put();
+
+  protected:
+    virtual int_type overflow(int_type c);
+    virtual int sync();
+    virtual std::streamsize xsputn(const char *s, std::streamsize n);
+
+  private:
+    /// Text after the last line passed on.
+    std::string line_;
+
+    LogShared *sh_;
+
+    LogSlot *sl_;
+  };
+
+  /// Buffer, stream and queue of one thread.
+  struct LogSlot {
+    LogSlot(LogShared *sh)
+      : buf(sh, this), out(&buf), urgent(false), ring(1024), head(0),
+        tail(0) {}
+
+    LogBuf buf;
+
+    std::ostream out;
+
+    /// True if the message being written is an error.
+    bool urgent;
+
+    /// Queue of lines, a ring buffer with one writer (the owner of the
+    /// slot) and one reader (whoever holds outMutex).
+    std::vector<LogRecord> ring;
+
+    /// Number of lines ever taken from ring.
+    std::atomic<size_t> head;
+
+    /// Number of lines ever put in ring.
+    std::atomic<size_t> tail;
+  };
+}
+
 using namespace Minotaur;
 
-Logger::Logger(LogLevel max_level) 
-  : maxLevel_(max_level),  nb_(), nout_(&nb_)
+/// Lines younger than this many seconds are held back by the background
+/// thread, so that a line queued late by a slow thread is still in order.
+static const double logHoldBack = 0.005;
+
+/// Source of unique ids of loggers.
+static std::atomic<UInt> logCount(0);
+
+
+/// Compare lines by time.
+static bool logEarlier(const LogRecord &a, const LogRecord &b)
+{
+  return a.time < b.time;
+}
+
+
+/// Write lines taken from the queues, all of them or only the old ones.
+static void logDrain(LogShared *sh, bool all)
 {
+  std::lock_guard<std::mutex> lk(sh->outMutex);
+  std::vector<LogRecord> &pend = sh->pending;
+  double upto;
+  size_t h, t, n, w;
+  char stamp[48];
+
+  {
+    std::lock_guard<std::mutex> sk(sh->slotMutex);
+    for (UInt i=0; i<sh->slots.size(); ++i) {
+      LogSlot *sl = sh->slots[i];
+      n = sl->ring.size();
+      h = sl->head.load(std::memory_order_relaxed);
+      t = sl->tail.load(std::memory_order_acquire);
+      for (; h<t; ++h) {
+        pend.push_back(LogRecord());
+        pend.back().time = sl->ring[h % n].time;
+        pend.back().thread = sl->ring[h % n].thread;
+        pend.back().text.swap(sl->ring[h % n].text);
+      }
+      sl->head.store(t, std::memory_order_release);
+    }
+  }
+  if (pend.empty()) {
+    return;
+  }
 
+  // lines of one thread are already in order.
+  std::stable_sort(pend.begin(), pend.end(), logEarlier);
+  upto = std::chrono::duration<double>
+    (std::chrono::steady_clock::now() - sh->start).count() - logHoldBack;
+  for (w=0; w<pend.size() && (all || pend[w].time <= upto); ++w) {
+    std::snprintf(stamp, sizeof(stamp), "[%12.6f %3d] ", pend[w].time,
+                  pend[w].thread);
+    std::cout << stamp << pend[w].text;
+  }
+  pend.erase(pend.begin(), pend.begin()+w);
+  std::cout.flush();
 }
 
 
-Logger::~Logger() 
+/// Write or queue text written by the owner of sl, and empty it.
+static void logPut(LogShared *sh, LogSlot *sl, std::string &text,
+                   bool flush)
+{
+  size_t t, n;
+
+  if (!sh->async.load(std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> lk(sh->outMutex);
+    std::cout.write(text.data(), text.size());
+    if (flush) {
+      std::cout.flush();
+    }
+    text.clear();
+    return;
+  }
+
+  if (!text.empty()) {
+    n = sl->ring.size();
+    t = sl->tail.load(std::memory_order_relaxed);
+    if (t - sl->head.load(std::memory_order_acquire) >= n) {
+      // full, move the queue to the pending lines.
+      logDrain(sh, false);
+    }
+    LogRecord &r = sl->ring[t % n];
+    r.time = std::chrono::duration<double>
+      (std::chrono::steady_clock::now() - sh->start).count();
+#if USE_OPENMP
+    r.thread = omp_get_thread_num();
+#else
+    r.thread = 0;
+#endif
+    r.text.swap(text);
+    text.clear();
+    sl->tail.store(t+1, std::memory_order_release);
+  }
+  if (sl->urgent) {
+    logDrain(sh, true);
+  }
+}
+
+
+/// Body of the background thread.
+static void logRun(LogShared *sh)
 {
-  // Destructor 
+  std::unique_lock<std::mutex> lk(sh->wakeMutex);
+
+  while (!sh->stop) {
+    sh->wake.wait_for(lk, std::chrono::milliseconds(10));
+    lk.unlock();
+    logDrain(sh, false);
+    lk.lock();
+  }
 }
 
 
-std::ostream& Logger::msgStream(LogLevel level) const 
+std::streambuf::int_type LogBuf::overflow(int_type c)
 {
-  if (level <= maxLevel_) { 
-    return std::cout; 
+  if (!traits_type::eq_int_type(c, traits_type::eof())) {
+    line_ += traits_type::to_char_type(c);
+    if ('\n' == traits_type::to_char_type(c)) {
+      logPut(sh_, sl_, line_, false);
+    }
   }
-  return nout_;
+  return traits_type::not_eof(c);
+}
+
+
+void LogBuf::put()
+{
+  if (!line_.empty()) {
+    logPut(sh_, sl_, line_, true);
+  }
+}
+
+
+int LogBuf::sync()
+{
+  logPut(sh_, sl_, line_, true);
+  return 0;
+}
+
+
+std::streamsize LogBuf::xsputn(const char *s, std::streamsize n)
+{
+  const char *e = s+n;
+  const char *nl;
+
+  while (s < e) {
+    nl = (const char *) std::memchr(s, '\n', e-s);
+    if (!nl) {
+      line_.append(s, e-s);
+      break;
+    }
+    line_.append(s, nl+1-s);
+    logPut(sh_, sl_, line_, false);
+    s = nl+1;
+  }
+  return n;
+}
+
+
+Logger::Logger(LogLevel max_level) 
+  : maxLevel_(max_level),  nb_(), nout_(&nb_), sh_(new LogShared())
+{
+  // operands written to a failed stream are not formatted.
+  nout_.setstate(std::ios_base::badbit);
+  sh_->async = false;
+  sh_->id = logCount++;
+  sh_->start = std::chrono::steady_clock::now();
+  sh_->stop = false;
+}
+
+
+Logger::~Logger() 
+{
+  setAsync(false);
+  for (UInt i=0; i<sh_->slots.size(); ++i) {
+    sh_->slots[i]->buf.put();
+    delete sh_->slots[i];
+  }
+  delete sh_;
 }
 
 
 std::ostream& Logger::errStream() const 
 { 
   if (maxLevel_ > LogNone) { 
+    flush();
     return std::cerr; 
   } else {
     return nout_;
   }
 }
 
+
+void Logger::flush() const
+{
+  if (sh_->async) {
+    logDrain(sh_, true);
+  }
+}
+
+
+bool Logger::getAsync() const
+{
+  return sh_->async;
+}
+
+
+std::ostream& Logger::msgStream(LogLevel level) const 
+{
+  LogSlot *sl;
+
+  if (level > maxLevel_) {
+    return nout_;
+  }
+#if USE_OPENMP
+  if (!sh_->async && !omp_in_parallel()) {
+    return std::cout;
+  }
+#else
+  if (!sh_->async) {
+    return std::cout;
+  }
+#endif
+  sl = slot_();
+  sl->urgent = (level <= LogError);
+  return sl->out;
+}
+
+
+void Logger::setAsync(bool async)
+{
+  if (async == sh_->async) {
+    return;
+  } else if (async) {
+    std::cout.flush();
+    sh_->stop = false;
+    sh_->async = true;
+    sh_->drainer = std::thread(logRun, sh_);
+  } else {
+    {
+      std::lock_guard<std::mutex> lk(sh_->wakeMutex);
+      sh_->stop = true;
+    }
+    sh_->wake.notify_one();
+    sh_->drainer.join();
+    sh_->async = false;
+    logDrain(sh_, true);
+  }
+}
+
+
+LogSlot* Logger::slot_() const
+{
+  // slots of this thread, by id of the logger.
+  static thread_local std::vector<std::pair<UInt, LogSlot *> > mine;
+  LogSlot *sl;
+
+  for (UInt i=0; i<mine.size(); ++i) {
+    if (mine[i].first == sh_->id) {
+      return mine[i].second;
+    }
+  }
+  sl = new LogSlot(sh_);
+  {
+    std::lock_guard<std::mutex> lk(sh_->slotMutex);
+    sh_->slots.push_back(sl);
+  }
+  mine.push_back(std::make_pair(sh_->id, sl));
+  return sl;
+}
+
+
 // Local Variables: 
 // mode: c++ 
 // eval: (c-set-style "k&r") 
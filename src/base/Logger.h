@@ -26,6 +26,19 @@
  * that writes the string using FORTRAN calls.
  * 
  * We may want to describe the output levels in this section.
+ *
+ * The stream returned for a suppressed level is in a failed state, so
+ * operands written to it are not formatted.
+ *
+ * Threads never share a stream. A thread that logs inside an OpenMP
+ * parallel region writes into a buffer of its own, and each complete line
+ * is written to std::cout at once. In the asynchronous mode, see setAsync(),
+ * every thread, also the master, only queues its lines with a time stamp
+ * in a lock-free queue of its own. A background thread writes the queued
+ * lines in the order of their time stamps. Lines are not mixed up, and no
+ * thread waits for another one to format its message. A line of level
+ * LogError or lower is written at once, together with all lines queued
+ * before it, so that it is not lost if the program aborts.
  */
 
 #include <iostream>
@@ -34,6 +47,9 @@
 #include "Types.h"
 
 namespace Minotaur {
+  struct LogShared;
+  struct LogSlot;
+
   class Logger {
     public:
       /// Default constructor
@@ -54,6 +70,22 @@ namespace Minotaur {
       /// Get the stream where one can write errors.
       std::ostream& errStream() const;
 
+      /// Write all lines queued by any thread. Only useful when async.
+      void flush() const;
+
+      /// Return true if lines are written by a background thread.
+      bool getAsync() const;
+
+      /**
+       * \brief Start or stop the background thread that writes messages.
+       * When stopped, all queued lines are written first.
+       *
+       * \param [in] async If true, lines are queued by the threads that
+       * write them and are written later with the time (in seconds) since
+       * this logger was created and the number of the thread.
+       */
+      void setAsync(bool async);
+
     protected:
       // Maximum output level
       LogLevel maxLevel_;
@@ -76,6 +108,12 @@ namespace Minotaur {
 
       // Null output stream
       mutable std::ostream nout_;
+
+      /// Queues, buffers and background thread, shared by all threads.
+      LogShared *sh_;
+
+      /// Get the buffer of the calling thread, create if needed.
+      LogSlot* slot_() const;
   };
 
   typedef const Logger* ConstLoggerPtr;
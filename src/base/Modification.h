@@ -54,6 +54,18 @@ namespace Minotaur {
        */
       virtual ModificationPtr toRel(ProblemPtr p, RelaxationPtr rel) const = 0;
 
+      /**
+       * \brief Copy a modification made to another problem with the same
+       * variables and constraints, e.g. the copy of a relaxation used by
+       * another thread, to one for p. The variables and constraints of p
+       * that have the same indices are used.
+       * \param[in] p Problem for which the new mod will be applicable.
+       * \returns Modification applicable to p. NULL if the modification can
+       * not be copied, and then it must be applied as it is.
+       */
+      virtual ModificationPtr copyByIndex(ProblemPtr) const
+      {return ModificationPtr();};
+
       /// Apply it to the problem.
       virtual void applyToProblem(ProblemPtr problem) = 0;
 
@@ -0,0 +1,185 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+/**
+ * \file NLPCache.cpp
+ * \brief Implement the methods of NLPCache class.
+ * \author The Minotaur Team
+ */
+
+#include <cmath>
+#include <iostream>
+
+#include "MinotaurConfig.h"
+#include "NLPCache.h"
+#include "Problem.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string NLPCache::me_ = "NLPCache: ";
+
+size_t NLPCacheKeyHash::operator()(const DoubleVector &key) const
+{
+  size_t h = 14695981039346656037ULL;
+  long long v;
+
+  for (DoubleVector::const_iterator it=key.begin(); it!=key.end(); ++it) {
+    // keys are integral, so the hash of the value is used.
+    v = (long long) *it;
+    h = (h ^ (size_t) v) * 1099511628211ULL;
+  }
+  return h;
+}
+
+
+NLPCache::NLPCache(UInt max_size, size_t max_bytes)
+  : bytes_(0),
+    maxBytes_(max_bytes),
+    maxSize_(max_size),
+    nHits_(0),
+    nMisses_(0),
+    nEvicted_(0)
+{
+}
+
+
+NLPCache::~NLPCache()
+{
+  table_.clear();
+  entries_.clear();
+}
+
+
+size_t NLPCache::entryBytes_(size_t key_size, size_t n)
+{
+  // the key is stored twice: in the entry and in the table. The nodes of
+  // the list and of the table are counted roughly.
+  return sizeof(Entry) + 2*key_size*sizeof(double) + n*sizeof(double) +
+    4*sizeof(void *);
+}
+
+
+bool NLPCache::find(const DoubleVector &key, EngineStatus *status,
+                    double *obj, DoubleVector &x)
+{
+  bool found = false;
+
+#pragma omp critical (nlpCache)
+  {
+    EntryMap::iterator it = table_.find(key);
+    if (it!=table_.end()) {
+      // most recently used entry is moved to the front.
+      entries_.splice(entries_.begin(), entries_, it->second);
+      *status = it->second->status;
+      *obj = it->second->obj;
+      x = it->second->x;
+      ++nHits_;
+      found = true;
+    } else {
+      ++nMisses_;
+    }
+  }
+  return found;
+}
+
+
+void NLPCache::getKey(ProblemPtr p, const double *x, DoubleVector &key)
+{
+  VariablePtr v;
+
+  key.clear();
+  for (VariableConstIterator it=p->varsBegin(); it!=p->varsEnd(); ++it) {
+    v = *it;
+    if (v->getType()==Binary || v->getType()==Integer) {
+      key.push_back(floor(x[v->getIndex()]+0.5));
+    }
+  }
+}
+
+
+UInt NLPCache::getSize() const
+{
+  UInt n;
+
+#pragma omp critical (nlpCache)
+  n = entries_.size();
+  return n;
+}
+
+
+void NLPCache::insert(const DoubleVector &key, EngineStatus status,
+                      double obj, const double *x, UInt n)
+{
+  const size_t bytes = entryBytes_(key.size(), n);
+
+  if (0==maxSize_ || bytes>maxBytes_ || false==isCacheable(status)) {
+    return;
+  }
+
+#pragma omp critical (nlpCache)
+  {
+    if (table_.find(key)==table_.end()) {
+      while (entries_.size() >= maxSize_ || bytes_+bytes > maxBytes_) {
+        bytes_ -= entryBytes_(entries_.back().key.size(),
+                              entries_.back().x.size());
+        table_.erase(entries_.back().key);
+        entries_.pop_back();
+        ++nEvicted_;
+      }
+      bytes_ += bytes;
+      entries_.push_front(Entry());
+      entries_.front().key = key;
+      entries_.front().status = status;
+      entries_.front().obj = obj;
+      entries_.front().x.assign(x, x+n);
+      table_[key] = entries_.begin();
+    }
+  }
+}
+
+
+bool NLPCache::isCacheable(EngineStatus status)
+{
+  switch (status) {
+  case (ProvenOptimal):
+  case (ProvenLocalOptimal):
+  case (ProvenInfeasible):
+  case (ProvenLocalInfeasible):
+  case (ProvenObjectiveCutOff):
+    return true;
+  default:
+    break;
+  }
+  return false;
+}
+
+
+void NLPCache::writeStats(std::ostream &out) const
+{
+  out << me_ << "maximum entries             = " << maxSize_ << std::endl
+      << me_ << "maximum memory (MB)         = " << maxBytes_/1048576.0
+      << std::endl
+      << me_ << "entries                     = " << entries_.size()
+      << std::endl
+      << me_ << "memory used (MB)            = " << bytes_/1048576.0
+      << std::endl
+      << me_ << "lookups that found the NLP  = " << nHits_ << std::endl
+      << me_ << "lookups that missed the NLP = " << nMisses_ << std::endl
+      << me_ << "entries evicted             = " << nEvicted_ << std::endl;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,168 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+/**
+ * \file NLPCache.h
+ * \brief Declare the class NLPCache, which stores the results of NLPs solved
+ * after fixing the integer variables.
+ * \author The Minotaur Team
+ */
+
+#ifndef MINOTAURNLPCACHE_H
+#define MINOTAURNLPCACHE_H
+
+#include <unordered_map>
+
+#include "Types.h"
+
+namespace Minotaur {
+
+  class Problem;
+  typedef Problem* ProblemPtr;
+
+  /// Hash function for the keys of an NLPCache.
+  struct NLPCacheKeyHash {
+    size_t operator()(const DoubleVector &key) const;
+  };
+
+  /**
+   * \brief A cache of the results of NLPs in which all integer variables are
+   * fixed. The key of an NLP is the vector of the rounded values of the
+   * integer variables of the problem, in the order of their indices. For
+   * each NLP, the status, the objective value and the primal solution
+   * returned by the engine are stored. Only results that can be used to
+   * generate cuts are stored, see isCacheable().
+   *
+   * The cache is bounded both in the number of entries and in the memory
+   * used by the keys and solutions. When either bound would be exceeded,
+   * the entries that were used least recently are removed. One cache can
+   * be shared by the handlers of all threads, since all functions are
+   * synchronized. The problems of all handlers that use a cache must have
+   * the same variables.
+   */
+  class NLPCache {
+  public:
+    /**
+     * \brief Create an empty cache.
+     * \param[in] max_size Maximum number of entries.
+     * \param[in] max_bytes Maximum memory in bytes used by the entries.
+     */
+    NLPCache(UInt max_size, size_t max_bytes);
+
+    /// Destroy.
+    ~NLPCache();
+
+    /**
+     * \brief Find the result of an NLP.
+     * \param[in] key Key of the NLP, see getKey().
+     * \param[out] status Status of the NLP, if found.
+     * \param[out] obj Objective value of the solution, if found.
+     * \param[out] x Primal solution, if found. It is resized as needed.
+     * \returns True if the NLP is in the cache, false otherwise.
+     */
+    bool find(const DoubleVector &key, EngineStatus *status, double *obj,
+              DoubleVector &x);
+
+    /**
+     * \brief Get the key of the NLP obtained by fixing the integer
+     * variables of a problem.
+     * \param[in] p Problem whose integer variables are fixed.
+     * \param[in] x Point whose rounded values are used to fix them.
+     * \param[out] key The key. Its old contents are removed.
+     */
+    static void getKey(ProblemPtr p, const double *x, DoubleVector &key);
+
+    /// Number of entries in the cache.
+    UInt getSize() const;
+
+    /**
+     * \brief Add the result of an NLP. If an NLP with the same key is
+     * already stored, e.g. because another thread solved it at the same
+     * time, the cache is not changed.
+     * \param[in] key Key of the NLP, see getKey().
+     * \param[in] status Status returned by the engine. Nothing is stored if
+     * it is not cacheable.
+     * \param[in] obj Objective value of the solution.
+     * \param[in] x Primal solution.
+     * \param[in] n Number of variables in the solution.
+     * Nothing is stored if one entry is larger than the memory bound.
+     */
+    void insert(const DoubleVector &key, EngineStatus status, double obj,
+                const double *x, UInt n);
+
+    /**
+     * \brief Check if the result of an NLP with this status can be stored:
+     * the NLP was solved to optimality, or it was found infeasible or worse
+     * than the cutoff. The solution is then used to generate cuts.
+     */
+    static bool isCacheable(EngineStatus status);
+
+    /// Write statistics about the cache.
+    void writeStats(std::ostream &out) const;
+
+  private:
+    /// An NLP stored in the cache.
+    struct Entry {
+      /// Key of the NLP.
+      DoubleVector key;
+
+      /// Status of the NLP.
+      EngineStatus status;
+
+      /// Objective value.
+      double obj;
+
+      /// Primal solution.
+      DoubleVector x;
+    };
+    typedef std::list<Entry> EntryList;
+    typedef std::unordered_map<DoubleVector, EntryList::iterator,
+                               NLPCacheKeyHash> EntryMap;
+
+    /// Memory used by the entries, in bytes. See entryBytes_().
+    size_t bytes_;
+
+    /// Entries, the most recently used one first.
+    EntryList entries_;
+
+    /// Maximum memory used by the entries, in bytes.
+    size_t maxBytes_;
+
+    /// Maximum number of entries.
+    UInt maxSize_;
+
+    /// For logging.
+    static const std::string me_;
+
+    /// Number of lookups that found the NLP.
+    UInt nHits_;
+
+    /// Number of lookups that did not find the NLP.
+    UInt nMisses_;
+
+    /// Number of entries removed to make room for new ones.
+    UInt nEvicted_;
+
+    /// Find an entry by its key.
+    EntryMap table_;
+
+    /// Approximate memory used by an entry with this key and solution size.
+    static size_t entryBytes_(size_t key_size, size_t n);
+  };
+  typedef NLPCache* NLPCachePtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -16,15 +16,33 @@
 #include "MinotaurConfig.h"
 #include "Branch.h"
 #include "Constraint.h"
-#include "Cut.h"
-#include "Function.h"
-#include "LinearFunction.h"
+#include "CutStore.h"
 #include "Modification.h"
 #include "Node.h"
+#include "PseudoCosts.h"
 #include "Relaxation.h"
 #include "WarmStart.h"
 
 using namespace Minotaur;
+
+/// Apply mod, or undo it, to p after copying it by index if it can be.
+static void modByIndex(ModificationPtr mod, ProblemPtr p, bool undo)
+{
+  ModificationPtr mod2 = mod->copyByIndex(p);
+
+  if (!mod2) {
+    mod2 = mod;
+  }
+  if (undo) {
+    mod2->undoToProblem(p);
+  } else {
+    mod2->applyToProblem(p);
+  }
+  if (mod2!=mod) {
+    delete mod2;
+  }
+}
+
 using namespace std;
 
 Node::Node()
@@ -34,11 +52,15 @@ Node::Node()
     lb_(-INFINITY),
     pMods_(0), 
     rMods_(0), 
+    numChildrenInFile_(0),
     parent_(NodePtr()),
+    pins_(0),
+    removed_(false),
+    pCosts_(0),
     status_(NodeNotProcessed),
     vioVal_(0),
     tbScore_(0),
-    cutPool_(0),
+    cutIds_(0),
     ws_(0)
 {
 }
@@ -50,11 +72,15 @@ Node::Node(NodePtr parentNode, BranchPtr branch)
     id_(0),
     pMods_(0), 
     rMods_(0), 
+    numChildrenInFile_(0),
     parent_(parentNode),
+    pins_(0),
+    removed_(false),
+    pCosts_(0),
     status_(NodeNotProcessed),
     vioVal_(0),
     tbScore_(0),
-    cutPool_(0),
+    cutIds_(0),
     ws_(0)
 {
   lb_ = parentNode->getLb();
@@ -64,6 +90,9 @@ Node::Node(NodePtr parentNode, BranchPtr branch)
 Node::~Node()
 {
   removeWarmStart();
+  if (pCosts_) {
+    delete pCosts_;
+  }
   if (branch_) {
     delete branch_;
   }
@@ -73,13 +102,10 @@ Node::~Node()
   for (ModificationConstIterator it=rMods_.begin(); it!=rMods_.end(); ++it) {
     delete *it;
   }
-  for (CutListIter it=cutPool_.begin(); it!=cutPool_.end(); ++it) {
-    delete *it;
-  }
 
   pMods_.clear();
   rMods_.clear();
-  cutPool_.clear();
+  cutIds_.clear();
   children_.clear();
 }
 
@@ -130,48 +156,17 @@ void Node::applyRMods(RelaxationPtr rel)
 }
 
 
-void Node::addCutToPool(CutPtr cut, RelaxationPtr rel)
+void Node::addCutToPool(UInt id)
 {
-  FunctionPtr f;
-  VariablePtr v;
-  LinearFunctionPtr lf, lfnew;
-  lf = cut->getFunction()->getLinearFunction();
-  if (lf) {
-    lfnew = (LinearFunctionPtr) new LinearFunction();
-    for (VariableGroupConstIterator it=lf->termsBegin(); it!=lf->termsEnd();++it) {
-      v = it->first;
-      //transform the cut
-      lfnew->addTerm(rel->getRelaxationVar(rel->getOriginalVar(v)),it->second);
-    }
-    f = (FunctionPtr) new Function(lfnew);
-    CutPtr c = (CutPtr) new Cut(rel->getNumVars(),f, cut->getLb(), cut->getUb(), false,false);
-    //c->setCons(cut->getConstraint());
-    c->setName_(cut->getName());
-    cutPool_.push_back(c);
-  }
+  cutIds_.push_back(id);
 }
 
 
-void Node::applyCutsByIndex(RelaxationPtr rel)
+void Node::applyCutsByIndex(RelaxationPtr rel, const CutStore *store)
 {
-  if (cutPool_.size() > 0) {
-    FunctionPtr f;
-    VariablePtr v;
-    LinearFunctionPtr lf, lfnew;
-    for (CutListIter it=cutPool_.begin(); it!=cutPool_.end(); ++it) {
-      //lf = dynamic_cast <LinearFunction*> ((*it)->getFunction());
-      lf = (*it)->getFunction()->getLinearFunction();
-      if (lf) {
-        lfnew = (LinearFunctionPtr) new LinearFunction();
-        for (VariableGroupConstIterator it1=lf->termsBegin(); it1!=lf->termsEnd();++it1) {
-          v = it1->first;
-          //transform the cut
-          lfnew->addTerm(rel->getRelaxationVar(rel->getOriginalVar(v)),it1->second);
-        }
-        f = (FunctionPtr) new Function(lfnew);
-        rel->newConstraint(f, (*it)->getLb(), (*it)->getUb(), (*it)->getName());
-      }
-    }
+  for (UIntVector::const_iterator it=cutIds_.begin(); it!=cutIds_.end();
+       ++it) {
+    store->addToRel(*it, rel);
   }
 }
 
@@ -223,6 +218,67 @@ void Node::applyMods(RelaxationPtr rel, ProblemPtr p)
 }
 
 
+void Node::applyModsByIndex(RelaxationPtr rel, ProblemPtr p)
+{
+  ModificationConstIterator mod_iter;
+
+  // the mods that created this node from its parent first, as in
+  // applyPMods() and applyRMods().
+  if (branch_) {
+    for (mod_iter=branch_->pModsBegin(); mod_iter!=branch_->pModsEnd();
+         ++mod_iter) {
+      modByIndex(*mod_iter, p, false);
+    }
+  }
+  for (mod_iter=pMods_.begin(); mod_iter!=pMods_.end(); ++mod_iter) {
+    modByIndex(*mod_iter, p, false);
+  }
+  if (branch_) {
+    for (mod_iter=branch_->rModsBegin(); mod_iter!=branch_->rModsEnd();
+         ++mod_iter) {
+      modByIndex(*mod_iter, rel, false);
+    }
+  }
+  for (mod_iter=rMods_.begin(); mod_iter!=rMods_.end(); ++mod_iter) {
+    modByIndex(*mod_iter, rel, false);
+  }
+}
+
+
+bool Node::markRemoved()
+{
+  bool del;
+#pragma omp critical (nodePin)
+  {
+    removed_ = true;
+    del = (0==pins_);
+  }
+  return del;
+}
+
+
+void Node::pin()
+{
+#pragma omp critical (nodePin)
+  ++pins_;
+}
+
+
+void Node::childFromFile(NodePtr child)
+{
+  assert(numChildrenInFile_>0);
+  --numChildrenInFile_;
+  children_.push_back(child);
+}
+
+
+void Node::childToFile(NodePtrIterator childNodeIter)
+{
+  children_.erase(childNodeIter);
+  ++numChildrenInFile_;
+}
+
+
 void Node::removeChild(NodePtrIterator childNodeIter)
 {
   children_.erase(childNodeIter);
@@ -245,8 +301,7 @@ void Node::removeWarmStart()
 { 
   if (ws_) {
     assert(ws_->getUseCnt()>0);
-    ws_->decrUseCnt();
-    if (0==ws_->getUseCnt()) {
+    if (0==ws_->decrUseCnt()) {
       delete ws_;
     }
   }
@@ -272,6 +327,15 @@ void Node::setLb(double value)
 }
 
 
+void Node::setPCosts(ConstPseudoCostsPtr pc)
+{
+  if (pCosts_) {
+    delete pCosts_;
+  }
+  pCosts_ = (PseudoCostsPtr) new PseudoCosts(pc);
+}
+
+
 void Node::setWarmStart (WarmStartPtr ws) 
 { 
   if (ws) {
@@ -312,6 +376,19 @@ void Node::undoPMods(ProblemPtr p)
 }
 
 
+bool Node::unpin()
+{
+  bool del;
+#pragma omp critical (nodePin)
+  {
+    assert(pins_>0);
+    --pins_;
+    del = (0==pins_ && removed_);
+  }
+  return del;
+}
+
+
 void Node::undoRMods(RelaxationPtr rel)
 {
   ModificationRConstIterator mod_iter;
@@ -393,53 +470,40 @@ void Node::undoMods(RelaxationPtr rel, ProblemPtr p)
 }
 
 
-void Node::updateBrCands(UInt index) {
-  brCands_.push_back(index);
-}
-
+void Node::undoModsByIndex(RelaxationPtr rel, ProblemPtr p)
+{
+  ModificationRConstIterator mod_iter;
+  ModificationRConstIterator prend = pMods_.rend();
+  ModificationRConstIterator rrend = rMods_.rend();
 
-void Node::updateLastStrBranched(UInt index, double value) {
-  if (index >= lastStrBranched_.size()) {
-    lastStrBranched_.push_back(value);
-  } else {
-    lastStrBranched_[index] = value;
+  // reverse order of applyModsByIndex().
+  for (mod_iter=pMods_.rbegin(); mod_iter!=prend; ++mod_iter) {
+    modByIndex(*mod_iter, p, true);
   }
-}
-
-
-void Node::updatePCDown(UInt index, double value) {
-  if (index >= pseudoDown_.size()) {
-    pseudoDown_.push_back(value);
-  } else {
-    pseudoDown_[index] = value;
+  if (branch_) {
+    for (mod_iter=branch_->pModsRBegin(); mod_iter!=branch_->pModsREnd();
+         ++mod_iter) {
+      modByIndex(*mod_iter, p, true);
+    }
   }
-}
-
-
-void Node::updatePCUp(UInt index, double value) {
-  if (index >= pseudoUp_.size()) {
-    pseudoUp_.push_back(value);
-  } else {
-    pseudoUp_[index] = value;
+  for (mod_iter=rMods_.rbegin(); mod_iter!=rrend; ++mod_iter) {
+    modByIndex(*mod_iter, rel, true);
   }
-}
-
-
-void Node::updateTimesDown(UInt index, double value) {
-  if (index >= timesDown_.size()) {
-    timesDown_.push_back(value);
-  } else {
-    timesDown_[index] = value;
+  if (branch_) {
+    for (mod_iter=branch_->rModsRBegin(); mod_iter!=branch_->rModsREnd();
+         ++mod_iter) {
+      modByIndex(*mod_iter, rel, true);
+    }
   }
 }
 
 
-void Node::updateTimesUp(UInt index, double value) {
-  if (index >= timesUp_.size()) {
-    timesUp_.push_back(value);
-  } else {
-    timesUp_[index] = value;
+void Node::updatePCost(UInt index, const PCostRecord &rec)
+{
+  if (!pCosts_) {
+    pCosts_ = (PseudoCostsPtr) new PseudoCosts();
   }
+  pCosts_->set(index, rec);
 }
 
 
@@ -18,10 +18,15 @@
 
 namespace Minotaur {
 
+  class CutStore;
   class Node;
+  class PseudoCosts;
   class Relaxation;
   class WarmStart;
+  struct PCostRecord;
   typedef const Node* ConstNodePtr;
+  typedef const PseudoCosts* ConstPseudoCostsPtr;
+  typedef PseudoCosts* PseudoCostsPtr;
   typedef Relaxation* RelaxationPtr;
   typedef WarmStart* WarmStartPtr;
   
@@ -69,8 +74,11 @@ namespace Minotaur {
     /// Add a child node.
     void addChild(NodePtr childNode);
 
-    /// Add cut to the cut-pool of this node
-    void addCutToPool(CutPtr cut, RelaxationPtr rel);
+    /**
+     * Add a cut to the cut-pool of this node. Only its id in a CutStore is
+     * kept by the node.
+     */
+    void addCutToPool(UInt id);
 
     /**
      * At each node one can make several modifications to the problem.
@@ -89,11 +97,11 @@ namespace Minotaur {
     void addRMod(ModificationPtr m) { rMods_.push_back(m); }
 
     /**
-     * Apply the cuts generated at the ancestors of this node at this node to
-     * the relaxation. First, each cut is translated appropriately so that it
-     * becomes applicable for this relaxation.
+     * Apply the cuts in the cut-pool of this node to the relaxation. The
+     * cuts are taken from store, and their variables are those of rel with
+     * the same indices.
      */
-    void applyCutsByIndex(RelaxationPtr rel);
+    void applyCutsByIndex(RelaxationPtr rel, const CutStore *store);
 
     /**
      * Apply the modifications including the branching that were made 
@@ -119,6 +127,26 @@ namespace Minotaur {
      */
     void applyMods(RelaxationPtr rel, ProblemPtr p);
 
+    /**
+     * Apply the modifications to problem and relaxation. The modifications
+     * may have been made by another thread to its own copies of the problem
+     * and the relaxation. Each one is first copied to the variables and
+     * constraints of p or rel with the same indices, see
+     * Modification::copyByIndex().
+     */
+    void applyModsByIndex(RelaxationPtr rel, ProblemPtr p);
+
+    /// Add a child node that was read back from a node file.
+    void childFromFile(NodePtr child);
+
+    /**
+     * Remove a child node that is written to a node file from the list of
+     * children. It is still counted by getNumChildren() until
+     * childFromFile() is called, so that this node is not removed from the
+     * tree meanwhile.
+     */
+    void childToFile(NodePtrIterator childNodeIter);
+
     /// Access the children by iterating over the vector.
     NodePtrIterator childrenBegin() { return children_.begin(); }
 
@@ -131,8 +159,8 @@ namespace Minotaur {
      */
     BranchPtr getBranch() const { return branch_; }
 
-    /// Return the cut-pool of this node.
-    CutList getCutPool() { return cutPool_; }
+    /// Return the ids of the cuts in the cut-pool of this node.
+    const UIntVector & getCutIds() const { return cutIds_; }
 
     /// Return the depth of the node in the tree.
     UInt getDepth() const { return depth_; }
@@ -140,36 +168,20 @@ namespace Minotaur {
     /// Return the ID of this node.
     UInt getId() const { return id_; }
 
-    /// Return the vector of last strong branching information of candidates.
-    UIntVector getLastStrongBranched() {return lastStrBranched_;}
-
     /// Return the lower bound of the relaxation obtained at this node.
     double getLb() const { return lb_; }
 
     /// Number of children of this node.
-    UInt getNumChildren() { return children_.size(); }
+    UInt getNumChildren() { return children_.size()+numChildrenInFile_; }
 
     /// Return a pointer to the parent node.
     NodePtr getParent() const { return parent_; }
 
     /**
-     * Return the vector of pseudocosts of down-branchings upto this node in
-     * the parental chain (direct ancestors only).
+     * Return the pseudocosts of candidates branched upon up to this node in
+     * the parental chain (direct ancestors only). NULL if there are none.
      */
-    //DoubleVector getPCDown() const { return pseudoDown_; }
-    DoubleVector getPCDown() { return pseudoDown_; }
-
-    /**
-     * Return the vector of indices of the variables branched till this node.
-     * in the parental chain (direct ancestors only).
-     */
-    UIntVector getBrCands() const { return brCands_; }
-
-    /**
-     * Return the vector of pseudocosts of up-branchings upto this node in
-     * the parental chain (direct ancestors only).
-     */
-    DoubleVector getPCUp() const { return pseudoUp_; }
+    ConstPseudoCostsPtr getPCosts() const { return pCosts_; }
 
     /// Get the status of this node.
     NodeStatus getStatus() const { return status_; }
@@ -181,24 +193,21 @@ namespace Minotaur {
     
     double getVioVal() { return vioVal_; }
 
-    /**
-     * Return the vector of number of down-branchings of a variable upto this
-     * in the parental chain (direct ancestors only).
-     */
-    UIntVector getTimesDown() const { return timesDown_; }
-
-    /**
-     * Return the vector of number of up-branchings of a variable upto this
-     * node in the parental chain (direct ancestors only).
-     */
-    UIntVector getTimesUp() const { return timesUp_; }
-
     /// Get the warm start information.
     WarmStartPtr getWarmStart() { return ws_; }
 
     /// \todo Dont know what this is meant for.
     void makeChildOf(const Node* parent);
 
+    /**
+     * Called by the tree manager when the node is removed from the tree.
+     * Returns true if the node can be deleted right away. If a node relaxer
+     * still has the modifications of this node applied (see pin()), it
+     * returns false and the node is deleted by the relaxer when it calls
+     * unpin().
+     */
+    bool markRemoved();
+
     /**
      * Get the first modification that was applied at this node to the
      * problem (and not the relaxation). Remember
@@ -232,8 +241,19 @@ namespace Minotaur {
     /// Remove warm start information associated with this node.
     void removeWarmStart();
 
-    /// Set the branching candidate information for this node.
-    void setBrCands(UIntVector brCands) { brCands_ = brCands; }
+    /**
+     * Called by a node relaxer after it applies the modifications of this
+     * node to its relaxation and keeps them applied while it processes other
+     * nodes. The node is not deleted until the relaxer calls unpin().
+     */
+    void pin();
+
+    /**
+     * Called by a node relaxer after it undoes the modifications of this node.
+     * Returns true if the node has been removed from the tree while it was
+     * pinned. The caller must then delete the node.
+     */
+    bool unpin();
 
     /// Set the depth of the node in the tree.
     void setDepth(UInt depth);
@@ -244,17 +264,15 @@ namespace Minotaur {
      */
     void setId(UInt id);
 
-    /// Set the vector of last strong branched information of candidates.
-    void setLastStrongBranched(UIntVector lstStrnBrnchd) {lastStrBranched_ = lstStrnBrnchd;}
-
     /// Set a lower bound for the relaxation at this node.
     void setLb(double value);
 
-    /// Set the down pseudocosts for this node.
-    void setPCDown(DoubleVector pcDown) { pseudoDown_ = pcDown; }
-
-    /// Set the up pseudocosts for this node.
-    void setPCUp(DoubleVector pcUp) { pseudoUp_ = pcUp; }
+    /**
+     * Replace the pseudocosts of this node by those of pc, e.g. of the
+     * parent. The records are shared until either node changes them, so
+     * this takes constant time.
+     */
+    void setPCosts(ConstPseudoCostsPtr pc);
 
     /// Set the status of this node.
     void setStatus(NodeStatus status) { status_ = status; }
@@ -262,12 +280,6 @@ namespace Minotaur {
     /// Get the tie-breaking score.
     void setTbScore(double d) { tbScore_ = d; }
 
-    /// Set the times down for this node.
-    void setTimesDown(UIntVector timesDown) { timesDown_ = timesDown; }
-
-    /// Set the times up for this node.
-    void setTimesUp(UIntVector timesUp) { timesUp_ = timesUp; }
-
     /// Set warm start information
     void setWarmStart (WarmStartPtr ws);
 
@@ -297,34 +309,17 @@ namespace Minotaur {
     void undoMods(RelaxationPtr rel, ProblemPtr p);
 
     /**
-     * Update the branching candidate vector at this node.
+     * Undo the modifications to the problem and the relaxation that were
+     * applied by applyModsByIndex().
      */
-    void updateBrCands(UInt index);
+    void undoModsByIndex(RelaxationPtr rel, ProblemPtr p);
 
     /**
-     * Update the last strong branched statistic at this node.
+     * Set the pseudocost record of the candidate with pseudocost index
+     * index at this node. Other nodes sharing the pseudocosts are not
+     * affected.
      */
-    void updateLastStrBranched(UInt index, double value);
-
-    /**
-     * Update the down-branching pseudocosts at this node.
-     */
-    void updatePCDown(UInt index, double value);
-
-    /**
-     * Update the up-branching pseudocosts at this node.
-     */
-    void updatePCUp(UInt index, double value);
-
-    /**
-     * Update the down-branching count of candidates at this node.
-     */
-    void updateTimesDown(UInt index, double value);
-
-    /**
-     * Update the up-branching count of candidates at this node.
-     */
-    void updateTimesUp(UInt index, double value);
+    void updatePCost(UInt index, const PCostRecord &rec);
 
     ///Write the node
     void write(std::ostream &o) const;
@@ -345,9 +340,6 @@ namespace Minotaur {
     /// Id of this node.
     UInt id_;
 
-    /// When did we last strong-branch on a candidate.
-    UIntVector lastStrBranched_;
-
     /**
      * Lower bound on the relaxation at this node (not to original
      * relaxation).
@@ -366,20 +358,21 @@ namespace Minotaur {
      */
     std::vector<ModificationPtr> rMods_;
 
+    /// Number of children that are written to a node file.
+    UInt numChildrenInFile_;
+
     /// The parent of this node. This is NULL if the node is a root node.
     NodePtr parent_;
 
-    /**
-     * Vector of indices of variables branched on till this node in the
-     * parental chain (direct ancestors only).
-     */
-    UIntVector brCands_;
+    /// Number of node relaxers that have the modifications of this node
+    /// applied.
+    UInt pins_;
 
-    /// Vector of pseudocosts for rounding down ().
-    DoubleVector pseudoDown_;
+    /// True if the tree manager removed this node while it was pinned.
+    bool removed_;
 
-    /// Vector of pseudocosts for rounding up.
-    DoubleVector pseudoUp_;
+    /// Pseudocosts of candidates branched upon, NULL if there are none.
+    PseudoCostsPtr pCosts_;
 
     /// The status of this node.
     NodeStatus status_;   
@@ -390,20 +383,8 @@ namespace Minotaur {
     /// Score to break tie-breaks.
     double tbScore_;
 
-    /// List of cuts generated at this node.
-    CutList cutPool_;
-
-    /**
-     * \brief Number of times we have branched down and noted the effect on
-     * objective improvement.
-     */
-    UIntVector timesDown_;
-
-    /**
-     * \brief Number of times we have branched up and noted the effect on objective
-     * improvement.
-     */
-    UIntVector timesUp_;
+    /// Ids, in a CutStore, of the cuts generated at this node.
+    UIntVector cutIds_;
 
     /// The warm start information saved for this node
     WarmStartPtr ws_;
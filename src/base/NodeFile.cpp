@@ -0,0 +1,482 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+/**
+ * \file NodeFile.cpp
+ * \brief Implement the methods of NodeFile class.
+ * \author The Minotaur Team
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <typeinfo>
+
+#include "MinotaurConfig.h"
+#include "Branch.h"
+#include "Node.h"
+#include "NodeFile.h"
+#include "VarBoundMod.h"
+#include "WarmStart.h"
+
+using namespace Minotaur;
+
+namespace {
+  /// Record of a node in the file. It is followed by its modifications.
+  struct NodeRecord {
+    UInt id;
+    UInt depth;
+    double lb;
+    double tbScore;
+    double vioVal;
+    double activity;
+    NodePtr parent;
+    BrCandPtr cand;
+    WarmStartPtr ws;  /// Only if the warm start could not be written.
+    int wsInFile;     /// 1 if the warm start follows the modifications.
+    UInt numPMods;
+    UInt numRMods;
+  };
+
+  /**
+   * Record of a modification of a branch. type is Lower or Upper for a
+   * VarBoundMod and -1 for a VarBoundMod2.
+   */
+  struct ModRecord {
+    VariablePtr var;
+    int type;
+    double val1;
+    double val2;
+  };
+}
+
+const std::string NodeFile::me_ = "NodeFile: ";
+const long NodeFile::minCompact_ = 1<<20;
+
+NodeFile::NodeFile()
+  : bestLb_(INFINITY),
+    dead_(0),
+    end_(0),
+    wsProto_(0),
+    lostLb_(INFINITY),
+    size_(0),
+    statCompact_(0),
+    statLost_(0),
+    statMaxSize_(0),
+    statRead_(0),
+    statWritten_(0),
+    statWsWritten_(0)
+{
+  file_ = tmpfile();
+  if (!file_) {
+    std::cerr << me_ << "cannot create a temporary file. Nodes are kept in "
+      << "memory." << std::endl;
+  }
+}
+
+
+NodeFile::~NodeFile()
+{
+  if (file_) {
+    fclose(file_);
+  }
+  if (wsProto_ && 0==wsProto_->decrUseCnt()) {
+    delete wsProto_;
+  }
+  keys_.clear();
+}
+
+
+bool NodeFile::canWrite_(NodePtr node) const
+{
+  BranchPtr br = node->getBranch();
+
+  if (!file_ || !br || !node->getParent() || node->getNumChildren()>0 ||
+      node->getStatus()!=NodeNotProcessed || node->getPCosts() ||
+      !node->getCutIds().empty() || node->modsBegin()!=node->modsEnd() ||
+      node->modsrBegin()!=node->modsrEnd()) {
+    return false;
+  }
+  for (ModificationConstIterator it=br->pModsBegin(); it!=br->pModsEnd();
+       ++it) {
+    if (!dynamic_cast<VarBoundModPtr>(*it) &&
+        !dynamic_cast<VarBoundMod2Ptr>(*it)) {
+      return false;
+    }
+  }
+  for (ModificationConstIterator it=br->rModsBegin(); it!=br->rModsEnd();
+       ++it) {
+    if (!dynamic_cast<VarBoundModPtr>(*it) &&
+        !dynamic_cast<VarBoundMod2Ptr>(*it)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+void NodeFile::compact_()
+{
+  FILE *f = tmpfile();
+  std::vector<std::pair<long, UInt> > order(keys_.size());
+  std::vector<char> buf;
+  std::vector<long> pos(keys_.size());
+  long end = 0;
+  bool ok = (0!=f);
+
+  // copy in the order of positions, so that the old file is read from its
+  // start to its end.
+  for (UInt i=0; i<keys_.size(); ++i) {
+    order[i] = std::make_pair(keys_[i].pos, i);
+  }
+  std::sort(order.begin(), order.end());
+  for (UInt i=0; ok && i<order.size(); ++i) {
+    const Key &k = keys_[order[i].second];
+    buf.resize(k.len);
+    ok = (0==fseek(file_, k.pos, SEEK_SET)) &&
+         ((size_t) k.len==fread(&buf[0], 1, k.len, file_)) &&
+         ((size_t) k.len==fwrite(&buf[0], 1, k.len, f));
+    pos[order[i].second] = end;
+    end += k.len;
+  }
+  if (!ok) {
+    // e.g. the disk is full. Keep using the old file.
+    if (f) {
+      fclose(f);
+    }
+    return;
+  }
+  for (UInt i=0; i<keys_.size(); ++i) {
+    keys_[i].pos = pos[i];
+  }
+  fclose(file_);
+  file_ = f;
+  end_ = end;
+  dead_ = 0;
+  ++statCompact_;
+}
+
+
+bool NodeFile::comesBefore(ConstNodePtr n) const
+{
+  Key k;
+
+  if (keys_.empty()) {
+    return false;
+  }
+  k.lb = n->getLb();
+  k.tbScore = n->getTbScore();
+  k.depth = n->getDepth();
+  k.id = n->getId();
+  return keyGreaterThan_(k, keys_.front());
+}
+
+
+double NodeFile::getBestLB() const
+{
+  double lb;
+#pragma omp atomic read
+  lb = bestLb_;
+  return lb;
+}
+
+
+UInt NodeFile::getSize() const
+{
+  UInt size;
+#pragma omp atomic read
+  size = size_;
+  return size;
+}
+
+
+bool NodeFile::isEmpty() const
+{
+  return 0==getSize();
+}
+
+
+bool NodeFile::keyGreaterThan_(const Key &k1, const Key &k2)
+{
+  // same order as valueGreaterThan() of NodeHeap.
+  if (k1.lb > k2.lb + 1e-6) {
+    return true;
+  } else if (k1.lb < k2.lb - 1e-6) {
+    return false;
+  }
+  if (k1.tbScore > k2.tbScore + 1e-6) {
+    return true;
+  } else if (k1.tbScore < k2.tbScore - 1e-6) {
+    return false;
+  }
+  if (k1.depth < k2.depth) {
+    return false;
+  } else if (k1.depth > k2.depth) {
+    return true;
+  }
+  return (k1.id < k2.id);
+}
+
+
+NodePtr NodeFile::read()
+{
+  NodePtr node;
+  Key k;
+  double lb = INFINITY;
+
+  if (keys_.empty()) {
+    return NodePtr();
+  }
+
+  k = keys_.front();
+  std::pop_heap(keys_.begin(), keys_.end(), keyGreaterThan_);
+  keys_.pop_back();
+  dead_ += k.len;
+
+  node = readRecord_(k);
+  if (!node) {
+    std::cerr << me_ << "cannot read node " << k.id << " from the file. "
+      << "Its subtree is not searched." << std::endl;
+    lostLb_ = std::min(lostLb_, k.lb);
+    ++statLost_;
+  }
+
+#pragma omp atomic
+  --size_;
+  ++statRead_;
+  if (keys_.empty()) {
+    // reuse the file from its start.
+    end_ = 0;
+    dead_ = 0;
+  } else {
+    lb = keys_.front().lb;
+    if (dead_ >= minCompact_ && 2*dead_ > end_) {
+      compact_();
+    }
+  }
+#pragma omp atomic write
+  bestLb_ = std::min(lb, lostLb_);
+  return node;
+}
+
+
+NodePtr NodeFile::readRecord_(const Key &k)
+{
+  NodeRecord rec;
+  ModRecord mrec;
+  BranchPtr br;
+  ModificationPtr mod;
+  NodePtr node;
+  WarmStartPtr ws;
+
+  if (0!=fseek(file_, k.pos, SEEK_SET) ||
+      1!=fread(&rec, sizeof(NodeRecord), 1, file_)) {
+    return NodePtr();
+  }
+  br = (BranchPtr) new Branch();
+  for (UInt i=0; i<rec.numPMods+rec.numRMods; ++i) {
+    if (1!=fread(&mrec, sizeof(ModRecord), 1, file_)) {
+      // also deletes the modifications read so far.
+      delete br;
+      return NodePtr();
+    }
+    if (mrec.type<0) {
+      mod = (VarBoundMod2Ptr) new VarBoundMod2(mrec.var, mrec.val1,
+                                               mrec.val2);
+    } else {
+      mod = (VarBoundModPtr) new VarBoundMod(mrec.var, (BoundType) mrec.type,
+                                             mrec.val1);
+    }
+    if (i<rec.numPMods) {
+      br->addPMod(mod);
+    } else {
+      br->addRMod(mod);
+    }
+  }
+  br->setActivity(rec.activity);
+  br->setBrCand(rec.cand);
+
+  node = (NodePtr) new Node(rec.parent, br);
+  node->setId(rec.id);
+  node->setDepth(rec.depth);
+  node->setLb(rec.lb);
+  node->setTbScore(rec.tbScore);
+  node->setVioVal(rec.vioVal);
+  rec.parent->childFromFile(node);
+  if (rec.wsInFile) {
+    // if it can not be read, the node is solved without a warm start.
+    ws = wsProto_->readNew(file_);
+    if (ws) {
+      node->setWarmStart(ws);
+    }
+  } else if (rec.ws) {
+    // the use count of the file is handed over to the node.
+    node->setWarmStart(rec.ws);
+    rec.ws->decrUseCnt();
+  }
+  return node;
+}
+
+
+bool NodeFile::write(NodePtr node)
+{
+  BranchPtr br;
+  NodePtr parent;
+  NodeRecord rec;
+  NodePtrIterator it;
+  Key k;
+  long pos;
+  bool ok;
+
+  if (!canWrite_(node)) {
+    return false;
+  }
+  br = node->getBranch();
+  parent = node->getParent();
+
+  rec.id = node->getId();
+  rec.depth = node->getDepth();
+  rec.lb = node->getLb();
+  rec.tbScore = node->getTbScore();
+  rec.vioVal = node->getVioVal();
+  rec.activity = br->getActivity();
+  rec.parent = parent;
+  rec.cand = br->getBrCand();
+  rec.ws = node->getWarmStart();
+  rec.wsInFile = 0;
+  rec.numPMods = br->pModsEnd()-br->pModsBegin();
+  rec.numRMods = br->rModsEnd()-br->rModsBegin();
+
+  fseek(file_, end_, SEEK_SET);
+  ok = (1==fwrite(&rec, sizeof(NodeRecord), 1, file_));
+  for (ModificationConstIterator mit=br->pModsBegin();
+       ok && mit!=br->pModsEnd(); ++mit) {
+    ok = writeMod_(*mit);
+  }
+  for (ModificationConstIterator mit=br->rModsBegin();
+       ok && mit!=br->rModsEnd(); ++mit) {
+    ok = writeMod_(*mit);
+  }
+  pos = ftell(file_);
+  if (ok && rec.ws && writeWs_(rec.ws)) {
+    // the record does not point to the warm start any more.
+    pos = ftell(file_);
+    rec.ws = 0;
+    rec.wsInFile = 1;
+    ok = (0==fseek(file_, end_, SEEK_SET)) &&
+         (1==fwrite(&rec, sizeof(NodeRecord), 1, file_));
+  }
+  if (!ok) {
+    // e.g. the disk is full. The node stays in memory.
+    return false;
+  }
+
+  k.lb = rec.lb;
+  k.tbScore = rec.tbScore;
+  k.depth = rec.depth;
+  k.id = rec.id;
+  k.pos = end_;
+  k.len = pos-end_;
+  end_ = pos;
+  keys_.push_back(k);
+  std::push_heap(keys_.begin(), keys_.end(), keyGreaterThan_);
+
+  // the node is deleted, but its parent still counts it and the file keeps
+  // its warm start and branching candidate.
+  for (it=parent->childrenBegin(); it!=parent->childrenEnd(); ++it) {
+    if (*it==node) {
+      break;
+    }
+  }
+  assert(it!=parent->childrenEnd());
+  parent->childToFile(it);
+  node->removeParent();
+  if (rec.ws) {
+    rec.ws->incrUseCnt();
+  }
+  br->setBrCand(0);
+  if (node->markRemoved()) {
+    delete node;
+  }
+
+#pragma omp atomic
+  ++size_;
+  ++statWritten_;
+  statMaxSize_ = std::max(statMaxSize_, getSize());
+#pragma omp atomic write
+  bestLb_ = std::min(keys_.front().lb, lostLb_);
+  return true;
+}
+
+
+bool NodeFile::writeMod_(ModificationPtr mod)
+{
+  ModRecord mrec;
+  VarBoundModPtr bmod = dynamic_cast<VarBoundModPtr>(mod);
+  VarBoundMod2Ptr bmod2;
+
+  if (bmod) {
+    mrec.var = bmod->getVar();
+    mrec.type = bmod->getLU();
+    mrec.val1 = bmod->getNewVal();
+    mrec.val2 = 0.0;
+  } else {
+    bmod2 = dynamic_cast<VarBoundMod2Ptr>(mod);
+    assert(bmod2);
+    mrec.var = bmod2->getVar();
+    mrec.type = -1;
+    mrec.val1 = bmod2->getNewLb();
+    mrec.val2 = bmod2->getNewUb();
+  }
+  return (1==fwrite(&mrec, sizeof(ModRecord), 1, file_));
+}
+
+
+void NodeFile::writeStats(std::ostream &out) const
+{
+  out << me_ << "nodes written       = " << statWritten_ << std::endl
+      << me_ << "nodes read          = " << statRead_ << std::endl
+      << me_ << "max nodes in file   = " << statMaxSize_ << std::endl
+      << me_ << "warm starts written = " << statWsWritten_ << std::endl
+      << me_ << "times compacted     = " << statCompact_ << std::endl
+      << me_ << "nodes not read      = " << statLost_ << std::endl;
+}
+
+
+bool NodeFile::writeWs_(WarmStartPtr ws)
+{
+  bool ok;
+
+  // all warm starts in the file are read by wsProto_.
+  if (wsProto_ && typeid(*ws)!=typeid(*wsProto_)) {
+    return false;
+  }
+  // WarmStartStore may drop the information from another thread.
+#pragma omp critical (wsStore)
+  ok = ws->writeInfo(file_);
+  if (!ok) {
+    return false;
+  }
+  if (!wsProto_) {
+    wsProto_ = ws;
+    wsProto_->incrUseCnt();
+  }
+  ++statWsWritten_;
+  return true;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
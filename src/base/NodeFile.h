@@ -0,0 +1,225 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+/**
+ * \file NodeFile.h
+ * \brief Declare the class NodeFile, which keeps active nodes of the
+ * branch-and-bound tree in a file instead of memory.
+ * \author The Minotaur Team
+ */
+
+#ifndef MINOTAURNODEFILE_H
+#define MINOTAURNODEFILE_H
+
+#include <cstdio>
+
+#include "Types.h"
+
+namespace Minotaur {
+
+  class Node;
+  class WarmStart;
+  typedef const Node* ConstNodePtr;
+  typedef WarmStart* WarmStartPtr;
+
+  /**
+   * \brief Store active nodes in a temporary file.
+   *
+   * A tree manager writes nodes to the file when it has too many active nodes
+   * in memory. A node written to the file is deleted. Only a small key is
+   * kept in memory: the lower bound, tie-breaking score, depth and id of the
+   * node, and the position of its record in the file. The keys are kept in a
+   * heap ordered in the same way as a NodeHeap of type NodeHeap::Value, so
+   * that the tree manager can read a node back exactly when it would have
+   * been taken from the heap of active nodes.
+   *
+   * A record holds the bound changes of the branch that created the node,
+   * the full information of its warm start (see WarmStart::writeInfo()),
+   * and pointers to its parent and branching candidate, which stay in
+   * memory. The parent keeps counting the node as its child (see
+   * Node::childToFile()). The warm start of the node is released, and a new
+   * one is read when the node is read. If the warm start can not be
+   * written, e.g. because its engine does not implement writeInfo(), the
+   * record keeps a pointer to it instead, and the file keeps one use count
+   * on it. The file lives only as long as this object and is reused from
+   * its start whenever it becomes empty. When more than half of it is taken
+   * by records that were already read, the remaining records are copied to
+   * a new file.
+   *
+   * If a record can not be read back, an error is written to std::cerr and
+   * the node is lost. Its parent keeps counting it as a child. The lower
+   * bound of the node is still reported by getBestLB(), so that the search
+   * does not claim a better bound than it has proved.
+   *
+   * Only nodes whose branch changes bounds of variables (VarBoundMod and
+   * VarBoundMod2) and that carry no other modifications, cuts or
+   * pseudocosts can be written. The functions are not thread safe.
+   */
+  class NodeFile {
+  public:
+    /// Create an empty file.
+    NodeFile();
+
+    /// Close the file. The nodes still in it are lost.
+    ~NodeFile();
+
+    /**
+     * \brief Check if the node comes before n in a best-first search, i.e.
+     * it should be read before n is processed.
+     * \param[in] n Best active node in memory.
+     * \returns True if the file is not empty and its best node comes before
+     * n, false otherwise.
+     */
+    bool comesBefore(ConstNodePtr n) const;
+
+    /**
+     * Minimum lower bound of the nodes in the file and of the nodes that could
+     * not be read, INFINITY if there are none.
+     */
+    double getBestLB() const;
+
+    /// Number of nodes in the file.
+    UInt getSize() const;
+
+    /// Return true if there are no nodes in the file.
+    bool isEmpty() const;
+
+    /**
+     * \brief Read the best node from the file. The node is created again and
+     * added to the children of its parent.
+     * \returns The node, or NULL if the file is empty or the node could not
+     * be read.
+     */
+    NodePtr read();
+
+    /**
+     * \brief Write an active node to the file and delete it. Nothing is done
+     * if the node can not be written.
+     * \param[in] node The node. It must be a child of its parent, and not
+     * in any other store of active nodes.
+     * \returns True if the node was written and deleted, false otherwise.
+     */
+    bool write(NodePtr node);
+
+    /// Write statistics.
+    void writeStats(std::ostream &out) const;
+
+  private:
+    /// Key of a node in the file.
+    struct Key {
+      /// Lower bound of the node.
+      double lb;
+
+      /// Tie-breaking score.
+      double tbScore;
+
+      /// Depth of the node.
+      UInt depth;
+
+      /// Id of the node.
+      UInt id;
+
+      /// Position of the record in the file.
+      long pos;
+
+      /// Length of the record in bytes, including its warm start.
+      long len;
+    };
+
+    /// Minimum lower bound of the nodes in the file and of lost nodes.
+    double bestLb_;
+
+    /// Bytes taken by records before end_ that were already read.
+    long dead_;
+
+    /// Position at which the next record is written.
+    long end_;
+
+    /**
+     * A warm start of the type written to the file, used to read them (see
+     * WarmStart::readNew()). The file keeps one use count on it. NULL until
+     * a warm start is written.
+     */
+    WarmStartPtr wsProto_;
+
+    /// The file, NULL if it could not be created.
+    FILE *file_;
+
+    /// Heap of keys of the nodes in the file, the best one first.
+    std::vector<Key> keys_;
+
+    /// Minimum lower bound of the nodes that could not be read.
+    double lostLb_;
+
+    /// For logging.
+    static const std::string me_;
+
+    /// The file is not compacted while it has fewer dead bytes than this.
+    static const long minCompact_;
+
+    /// Number of nodes in the file. Changed and read by atomic operations.
+    UInt size_;
+
+    /// Number of times the file was compacted.
+    UInt statCompact_;
+
+    /// Number of nodes that could not be read.
+    UInt statLost_;
+
+    /// Largest number of nodes in the file at any time.
+    UInt statMaxSize_;
+
+    /// Number of nodes read.
+    UInt statRead_;
+
+    /// Number of nodes written.
+    UInt statWritten_;
+
+    /// Number of warm starts written.
+    UInt statWsWritten_;
+
+    /// Check if node can be written to the file.
+    bool canWrite_(NodePtr node) const;
+
+    /**
+     * \brief Copy the records of the nodes in the file to a new file, and
+     * use it instead. Nothing is changed if the copy fails.
+     */
+    void compact_();
+
+    /// Order of the keys in the heap: true if k1 comes after k2.
+    static bool keyGreaterThan_(const Key &k1, const Key &k2);
+
+    /**
+     * \brief Read the record at the position of a key and create its node.
+     * \returns The node, or NULL if the record could not be read.
+     */
+    NodePtr readRecord_(const Key &k);
+
+    /// Write a modification of a branch at the current position.
+    bool writeMod_(ModificationPtr mod);
+
+    /**
+     * \brief Write the information of a warm start at the current position.
+     * \returns True if written, false if the warm start is not of the type
+     * of wsProto_ or could not be written.
+     */
+    bool writeWs_(WarmStartPtr ws);
+  };
+  typedef NodeFile* NodeFilePtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
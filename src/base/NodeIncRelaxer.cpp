@@ -19,7 +19,9 @@
 #include "Node.h"
 #include "NodeIncRelaxer.h"
 #include "Option.h"
+#include "Profiler.h"
 #include "Relaxation.h"
+#include "WarmStart.h"
 
 
 using namespace Minotaur;
@@ -37,6 +39,12 @@ NodeIncRelaxer::NodeIncRelaxer (EnvPtr env, HandlerVector handlers)
 
 NodeIncRelaxer::~NodeIncRelaxer ()
 {
+  while (!path_.empty()) {
+    if (path_.back()->unpin()) {
+      delete path_.back();
+    }
+    path_.pop_back();
+  }
   if (rel_) {
     delete rel_;
     rel_ = 0;
@@ -48,7 +56,14 @@ NodeIncRelaxer::~NodeIncRelaxer ()
 
 RelaxationPtr NodeIncRelaxer::createRootRelaxation(NodePtr, bool &prune)
 {
+  ProfScope prof(env_->getProfiler(), "relax_root");
   prune = false;
+  while (!path_.empty()) {
+    if (path_.back()->unpin()) {
+      delete path_.back();
+    }
+    path_.pop_back();
+  }
   rel_ = (RelaxationPtr) new Relaxation(env_);
   for (HandlerIterator h = handlers_.begin(); h != handlers_.end() && !prune; 
       ++h) {
@@ -94,44 +109,37 @@ void NodeIncRelaxer::setModFlag(bool mod_prob)
 RelaxationPtr NodeIncRelaxer::createNodeRelaxation(NodePtr node, bool dived, 
                                                    bool &prune)
 {
+  ProfScope prof(env_->getProfiler(), "relax_node");
   NodePtr t_node; // temporary
   WarmStartPtr ws;
+  std::stack<NodePtr> predecessors;
   prune = false;
 
-  if (!dived) {
-    // traceback to root and put in all modifications that need to go into the
-    // relaxation and the engine.
-    std::stack<NodePtr> predecessors;
-    t_node = node->getParent();
+  if (dived) {
+    // if we dived from the root, its modifications are already applied.
+    pushRoot_(node->getParent());
+  }
 
-    while (t_node) {
-      predecessors.push(t_node);
-      t_node = t_node->getParent();
-    }
+  // traceback until we hit the lowest common ancestor of node and the last
+  // node whose modifications are in the relaxation. When we dive, it is the
+  // parent of node.
+  t_node = node;
+  while (t_node && !(t_node->getDepth() < path_.size() &&
+                     path_[t_node->getDepth()] == t_node)) {
+    predecessors.push(t_node);
+    t_node = t_node->getParent();
+  }
 
-    // starting from the top, put in modifications made at each node to the
-    // engine
-    if (modProb_) {
-      while (!predecessors.empty()) {
-        t_node = predecessors.top();
-        t_node->applyMods(rel_, p_);
-        predecessors.pop();
-      }
-    } else {
-      while (!predecessors.empty()) {
-        t_node = predecessors.top();
-        t_node->applyRMods(rel_);
-        predecessors.pop();
-      }
-    }
-  } 
+  // undo the modifications of nodes below the common ancestor.
+  while (path_.size() > (t_node ? t_node->getDepth()+1 : 0)) {
+    popNode_();
+  }
 
-  // put in the modifications that were used to create this node from
-  // its parent.
-  if (modProb_) {
-    node->applyMods(rel_, p_);
-  } else {
-    node->applyRMods(rel_);
+  // starting from the top, put in modifications made at each node, including
+  // the ones used to create this node from its parent.
+  while (!predecessors.empty()) {
+    pushNode_(predecessors.top());
+    predecessors.pop();
   }
 
   for (HandlerIterator h = handlers_.begin(); h != handlers_.end() && !prune; 
@@ -144,8 +152,10 @@ RelaxationPtr NodeIncRelaxer::createNodeRelaxation(NodePtr node, bool dived,
 
   // give the warm start info to the engine.
   if (!prune) {
+    // The information may have been dropped by WarmStartStore. The engine
+    // then starts from what it has loaded.
     ws = node->getWarmStart();
-    if (ws) {
+    if (ws && ws->hasInfo()) {
       engine_->loadFromWarmStart(ws);
     }
   } else {
@@ -155,21 +165,52 @@ RelaxationPtr NodeIncRelaxer::createNodeRelaxation(NodePtr node, bool dived,
 }
 
 
-void NodeIncRelaxer::reset(NodePtr node, bool diving)
+void NodeIncRelaxer::popNode_()
 {
-  NodePtr t_node = node;
-
-  if (!diving) {
-    if (modProb_) {
-      while (t_node) {
-        t_node->undoMods(rel_, p_);
-        t_node = t_node->getParent();
-      }
-    } else {
-      while (t_node) {
-        t_node->undoRMods(rel_);
-        t_node = t_node->getParent();
-      }
+  NodePtr t_node = path_.back();
+
+  if (modProb_) {
+    t_node->undoMods(rel_, p_);
+  } else {
+    t_node->undoRMods(rel_);
+  }
+  path_.pop_back();
+  if (t_node->unpin()) {
+    delete t_node;
+  }
+}
+
+
+void NodeIncRelaxer::pushNode_(NodePtr node)
+{
+  if (modProb_) {
+    node->applyMods(rel_, p_);
+  } else {
+    node->applyRMods(rel_);
+  }
+  node->pin();
+  path_.push_back(node);
+}
+
+
+void NodeIncRelaxer::pushRoot_(NodePtr node)
+{
+  if (path_.empty() && node && !node->getParent()) {
+    node->pin();
+    path_.push_back(node);
+  }
+}
+
+
+void NodeIncRelaxer::reset(NodePtr node, bool)
+{
+  if (node) {
+    // the root is processed without a call to createNodeRelaxation. Its
+    // modifications are already in the relaxation.
+    pushRoot_(node);
+  } else {
+    while (!path_.empty()) {
+      popNode_();
     }
   }
 }
@@ -22,11 +22,19 @@ namespace Minotaur {
 
 /**
  * The root relaxation is stored as rel_. In each node, we apply all
- * modifications stored in each ancestor of the node. When we are done
- * processing the node, we undo all these changes. 
+ * modifications stored in each ancestor of the node. 
  *
- * If we dive after processing a node, we do not need to undo all changes
- * and apply them again. We just apply the modifications of the parent.
+ * The modifications of the last processed node and its ancestors are kept
+ * applied after the node is processed. When a new node is to be processed,
+ * we find the lowest common ancestor of the new node and the last one. We
+ * undo the modifications of nodes below the common ancestor on the old path
+ * and apply the modifications of nodes below it on the new path. If we dive
+ * after processing a node, the common ancestor is the parent itself and we
+ * only apply the modifications of the new node.
+ *
+ * Nodes whose modifications are applied are pinned (see Node::pin()), so
+ * that the tree manager does not delete them before we undo their
+ * modifications.
  */
 class NodeIncRelaxer : public NodeRelaxer {
 public:
@@ -45,7 +53,11 @@ public:
   /// Get the current value of modProb_ flag.
   bool getModFlag();
 
-  // Implement NodeRelaxer::reset()
+  /**
+   * Implement NodeRelaxer::reset(). Modifications are not undone here, but
+   * when the next node is created. If node is NULL, all modifications are
+   * undone and the relaxation is the same as the root relaxation.
+   */
   void reset(NodePtr node, bool diving);
 
   /**
@@ -90,11 +102,30 @@ private:
   /// The problem being solved by branch-and-bound.
   ProblemPtr p_;
 
+  /**
+   * Nodes whose modifications are currently applied to the relaxation,
+   * starting from the root. path_[i] is at depth i.
+   */
+  NodePtrVector path_;
+
   /**
    * \brief We only keep one relaxation. It is modified at each node and then
    * reset.
    */
   RelaxationPtr rel_;
+
+  /// Apply the modifications of a node and add it to the end of path_.
+  void pushNode_(NodePtr node);
+
+  /// Undo the modifications of the last node in path_ and remove it.
+  void popNode_();
+
+  /**
+   * If path_ is empty and node is the root, add it to path_. The
+   * modifications of the root are applied while it is processed, without a
+   * call to createNodeRelaxation().
+   */
+  void pushRoot_(NodePtr node);
 };
 
 typedef NodeIncRelaxer* NodeIncRelaxerPtr;
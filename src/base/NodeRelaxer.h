@@ -68,7 +68,9 @@ public:
   /**
    * After processing the node, some node relaxers may like to make
    * changes. This function is the place to do it. diving is true if the
-   * next node to be processed is a child node of the current node.
+   * next node to be processed is a child node of the current node. It is
+   * called with a NULL node after the last node has been processed, so that
+   * the relaxer can bring the relaxation back to its root state.
    */
   virtual void reset(NodePtr node, bool diving) = 0;
 
@@ -68,6 +68,7 @@ OAHandler::OAHandler(EnvPtr env, ProblemPtr minlp, EnginePtr nlpe,
 {
   timer_ = env->getNewTimer();
   intTol_ = env_->getOptions()->findDouble("int_tol")->getValue();
+  linCoeffTol_ = env_->getOptions()->findDouble("conCoeff_tol");
   solAbsTol_ = env_->getOptions()->findDouble("solAbs_tol")->getValue();
   solRelTol_ = env_->getOptions()->findDouble("solRel_tol")->getValue();
   objATol_ = env_->getOptions()->findDouble("solAbs_tol")->getValue();
@@ -517,8 +518,7 @@ void OAHandler::linearAt_(FunctionPtr f, double fval, const double *x,
   int n = rel_->getNumVars();
   double *a = new double[n];
   VariableConstIterator vbeg = rel_->varsBegin(), vend = rel_->varsEnd();
-  const double linCoeffTol =
-    env_->getOptions()->findDouble("conCoeff_tol")->getValue();
+  const double linCoeffTol = linCoeffTol_->getValue();
 
   std::fill(a, a+n, 0.);
   f->evalGradient(x, a, error);
@@ -11,6 +11,7 @@
  */
 
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <iostream> 
@@ -367,6 +368,23 @@ void Minotaur::sortRec(VarVector &vvec, double *x, int left, int right,
 }
 
 
+void Minotaur::renumberRows(IntVector &map, const UIntVector &dels)
+{
+  UInt ndel;
+  for (IntVector::iterator it=map.begin(); it!=map.end(); ++it) {
+    if (*it>=0) {
+      ndel = std::lower_bound(dels.begin(), dels.end(), (UInt) *it) -
+        dels.begin();
+      if (ndel<dels.size() && dels[ndel]==(UInt) *it) {
+        *it = -1;
+      } else {
+        *it -= ndel;
+      }
+    }
+  }
+}
+
+
 void Minotaur::toLowerCase(std::string &str)
 {
   int diff = ('z'-'Z');
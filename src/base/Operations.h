@@ -79,6 +79,17 @@ namespace Minotaur {
   void sort(VarVector &vvec, double *x, bool ascend=true);
   void sortRec(VarVector &vvec, double *x, int left, int right, int pivotind);
 
+  /**
+   * \brief Renumber rows after some of them are deleted.
+   *
+   * map[i] is the current index of row i, or -1 if row i was deleted
+   * earlier. Entries whose index is in dels become -1. The others are
+   * shifted down by the number of indices in dels that are smaller.
+   * \param [in,out] map The map to update.
+   * \param [in] dels Current indices of the deleted rows, sorted.
+   */
+  void renumberRows(IntVector &map, const UIntVector &dels);
+
   /// Convert a string to lower case.
   void toLowerCase(std::string &str);
 
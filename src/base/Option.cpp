@@ -78,6 +78,7 @@ template class Minotaur::Option<std::string>;
 //------------------------------------------------------------------------ // 
 
 OptionDB::OptionDB()
+  : watch_(false)
 {
 }
 
@@ -109,15 +110,24 @@ OptionDB::~OptionDB()
   doubleOps_.clear();
   stringOps_.clear();
   flagOps_.clear();
+  boolIdx_.clear();
+  intIdx_.clear();
+  doubleIdx_.clear();
+  stringIdx_.clear();
+  flagIdx_.clear();
 }
 
 
+// If two options of the same type have the same name, lookups return the
+// one inserted first.
 void OptionDB::insert(BoolOptionPtr option, bool is_flag)
 {
   if (is_flag) {
     flagOps_.insert(option);
+    flagIdx_.insert(std::make_pair(option->getName(), option));
   } else {
     boolOps_.insert(option);
+    boolIdx_.insert(std::make_pair(option->getName(), option));
   }
 }
 
@@ -125,98 +135,88 @@ void OptionDB::insert(BoolOptionPtr option, bool is_flag)
 void OptionDB::insert(IntOptionPtr option)
 {
   intOps_.insert(option);
+  intIdx_.insert(std::make_pair(option->getName(), option));
 }
 
 
 void OptionDB::insert(DoubleOptionPtr option)
 {
   doubleOps_.insert(option);
+  doubleIdx_.insert(std::make_pair(option->getName(), option));
 }
 
 
 void OptionDB::insert(StringOptionPtr option)
 {
   stringOps_.insert(option);
+  stringIdx_.insert(std::make_pair(option->getName(), option));
 }
 
 
 BoolOptionPtr OptionDB::findBool(const std::string &cname)
 {
-  BoolOptionPtr option = BoolOptionPtr(); //NULL
-  std::string name(cname);
-  toLowerCase(name);
-  for (BoolOptionSetIter iter=boolOps_.begin(); iter!=boolOps_.end(); 
-      ++iter) {
-    if ((*iter)->getName()==name) {
-      option = (*iter);
-      break;
-    }
+  std::map<std::string, BoolOptionPtr>::iterator it =
+    boolIdx_.find(key_(cname));
+  if (it==boolIdx_.end()) {
+    return BoolOptionPtr(); //NULL
   }
-  return option;
+  return it->second;
 }
 
 
 IntOptionPtr OptionDB::findInt(const std::string &cname)
 {
-  IntOptionPtr option = IntOptionPtr(); //NULL
-  std::string name(cname);
-  toLowerCase(name);
-  for (IntOptionSetIter iter=intOps_.begin(); iter!=intOps_.end(); 
-      ++iter) {
-    if ((*iter)->getName()==name) {
-      option = (*iter);
-      break;
-    }
+  std::map<std::string, IntOptionPtr>::iterator it =
+    intIdx_.find(key_(cname));
+  if (it==intIdx_.end()) {
+    return IntOptionPtr(); //NULL
   }
-  return option;
+  return it->second;
 }
 
 
 DoubleOptionPtr OptionDB::findDouble(const std::string &cname)
 {
-  DoubleOptionPtr option = DoubleOptionPtr(); //NULL
-  std::string name(cname);
-  toLowerCase(name);
-  for (DoubleOptionSetIter iter=doubleOps_.begin(); iter!=doubleOps_.end(); 
-      ++iter) {
-    if ((*iter)->getName()==name) {
-      option = (*iter);
-      break;
-    }
+  std::map<std::string, DoubleOptionPtr>::iterator it =
+    doubleIdx_.find(key_(cname));
+  if (it==doubleIdx_.end()) {
+    return DoubleOptionPtr(); //NULL
   }
-  return option;
+  return it->second;
 }
 
 
 StringOptionPtr OptionDB::findString(const std::string &cname)
 {
-  StringOptionPtr option = StringOptionPtr(); //NULL
-  std::string name(cname);
-  toLowerCase(name);
-  for (StringOptionSetIter iter=stringOps_.begin(); iter!=stringOps_.end(); 
-      ++iter) {
-    if ((*iter)->getName()==name) {
-      option = (*iter);
-      break;
-    }
+  std::map<std::string, StringOptionPtr>::iterator it =
+    stringIdx_.find(key_(cname));
+  if (it==stringIdx_.end()) {
+    return StringOptionPtr(); //NULL
   }
-  return option;
+  return it->second;
 }
 
 
 FlagOptionPtr OptionDB::findFlag(const std::string &cname)
 {
-  FlagOptionPtr option = FlagOptionPtr(); //NULL
+  std::map<std::string, FlagOptionPtr>::iterator it =
+    flagIdx_.find(key_(cname));
+  if (it==flagIdx_.end()) {
+    return FlagOptionPtr(); //NULL
+  }
+  return it->second;
+}
+
+
+std::string OptionDB::key_(const std::string &cname)
+{
   std::string name(cname);
   toLowerCase(name);
-  for (FlagOptionSetIter iter=flagOps_.begin(); iter!=flagOps_.end(); 
-      ++iter) {
-    if ((*iter)->getName()==name) {
-      option = (*iter);
-      break;
-    }
+  if (watch_) {
+#pragma omp critical (optionLookups)
+    ++lookups_[name];
   }
-  return option;
+  return name;
 }
 
 
@@ -271,6 +271,29 @@ FlagOptionSetIter OptionDB::flagEnd()
 }
 
 
+void OptionDB::watchLookups(bool watch)
+{
+  watch_ = watch;
+}
+
+
+UInt OptionDB::writeLookups(std::ostream &out)
+{
+  UInt total = 0;
+#pragma omp critical (optionLookups)
+  {
+    for (std::map<std::string, UInt>::iterator it=lookups_.begin();
+         it!=lookups_.end(); ++it) {
+      out << "  " << it->first << " looked up " << it->second << " times"
+          << std::endl;
+      total += it->second;
+    }
+    lookups_.clear();
+  }
+  return total;
+}
+
+
 void OptionDB::write(std::ostream &out) const
 {
   out << "## boolean options:" << std::endl;
@@ -14,6 +14,7 @@
 #ifndef MINOTAUR_OPTIONS
 #define MINOTAUR_OPTIONS
 
+#include <map>
 #include <string>
 
 #include "Types.h"
@@ -137,6 +138,14 @@ namespace Minotaur {
    * the API. Further, some of the options may be invalid (with typos). This
    * class can tell if the options specified by the user are legitimate
    * options.
+   *
+   * Looking up an option by name costs a string copy and a search.
+   * Code that reads an option repeatedly, e.g. once for every cut or node,
+   * should look the option up once and keep the returned pointer. The
+   * pointer remains valid for the lifetime of the database, and values set
+   * later through the Environment are seen through it, since options are
+   * updated in place. watchLookups() helps find lookups that should be
+   * resolved this way.
    */
   class OptionDB {
   public:
@@ -209,6 +218,25 @@ namespace Minotaur {
     /// Iterator to access the last flag.
     FlagOptionSetIter flagEnd();
 
+    /**
+     * \brief Start or stop recording the names that are looked up.
+     *
+     * Used in debug mode to flag lookups by name on hot paths, e.g. inside
+     * the branch-and-bound loop. See writeLookups().
+     * \param[in] watch True to start recording, false to stop. Names
+     * recorded earlier are kept.
+     */
+    void watchLookups(bool watch);
+
+    /**
+     * \brief Write the names looked up while watchLookups() was on, and the
+     * number of lookups of each. Clears the record.
+     *
+     * \param[in] out The output stream to write to.
+     * \return The total number of lookups written.
+     */
+    UInt writeLookups(std::ostream &out);
+
     /**
      * Write the database  to the output stream. It will print the option
      * name, the value and if it was ever used.
@@ -230,6 +258,30 @@ namespace Minotaur {
 
     /// Set of all flags (options that don't need any arguments).
     FlagOptionSet flagOps_;
+
+    /// Boolean options indexed by their names.
+    std::map<std::string, BoolOptionPtr> boolIdx_;
+
+    /// Integer options indexed by their names.
+    std::map<std::string, IntOptionPtr> intIdx_;
+
+    /// Double options indexed by their names.
+    std::map<std::string, DoubleOptionPtr> doubleIdx_;
+
+    /// String options indexed by their names.
+    std::map<std::string, StringOptionPtr> stringIdx_;
+
+    /// Flags indexed by their names.
+    std::map<std::string, FlagOptionPtr> flagIdx_;
+
+    /// Names looked up while watch_ is true, and the number of lookups.
+    std::map<std::string, UInt> lookups_;
+
+    /// True if names looked up must be recorded in lookups_.
+    bool watch_;
+
+    /// Return the name in lower case, record it if watch_ is true.
+    std::string key_(const std::string &name);
   };
   typedef OptionDB* OptionDBPtr;
 }
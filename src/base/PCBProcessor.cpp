@@ -23,6 +23,7 @@
 #include "Logger.h"
 #include "Node.h"
 #include "Option.h"
+#include "Profiler.h"
 #include "Modification.h"
 #include "Relaxation.h"
 #include "SolutionPool.h"
@@ -62,8 +63,7 @@ PCBProcessor::PCBProcessor (EnvPtr env, EnginePtr engine, HandlerVector handlers
 PCBProcessor::~PCBProcessor()
 {
   if (ws_) {
-    ws_->decrUseCnt();
-    if (0 == ws_->getUseCnt()) {
+    if (0 == ws_->decrUseCnt()) {
       delete ws_;
     }
   }
@@ -133,6 +133,7 @@ bool PCBProcessor::isFeasible_(NodePtr node, ConstSolutionPtr sol,
 
 bool PCBProcessor::presolveNode_(NodePtr node, SolutionPoolPtr s_pool) 
 {
+  ProfScope prof(env_->getProfiler(), "node_presolve");
   ModVector p_mods;      // Mods that are applied to the problem
   ModVector r_mods;      // Mods that are applied to the relaxation.
   bool is_inf = false;
@@ -178,6 +179,7 @@ bool PCBProcessor::presolveNode_(NodePtr node, SolutionPoolPtr s_pool)
 void PCBProcessor::process(NodePtr node, RelaxationPtr rel,
                           SolutionPoolPtr s_pool)
 {
+  ProfScope prof(env_->getProfiler(), "process_node");
   bool should_prune = true;
   bool should_resolve;
   bool sol_found = false;
@@ -219,8 +221,7 @@ void PCBProcessor::process(NodePtr node, RelaxationPtr rel,
     should_resolve = false;
 
     if (ws_) {
-      ws_->decrUseCnt();
-      if (0 == ws_->getUseCnt()) {
+      if (0 == ws_->decrUseCnt()) {
         delete ws_;
       } 
       ws_ = 0;
@@ -256,6 +257,7 @@ void PCBProcessor::process(NodePtr node, RelaxationPtr rel,
     if (iter == 1 && !node->getParent()) {
       // in root, in first iteration, run a heuristic. XXX: better management.
       for (HeurVector::iterator it=heurs_.begin(); it!=heurs_.end(); ++it) {
+        ProfScope ps(env_->getProfiler(), "heuristic");
         (*it)->solve(node, rel, s_pool);
       }
       tightenBounds_(node, s_pool, sol, &sep_status);
@@ -283,8 +285,11 @@ void PCBProcessor::process(NodePtr node, RelaxationPtr rel,
       if (ws_) {
         ws_->incrUseCnt();
       }
-      branches_ = brancher_->findBranches(relaxation_, node, sol, s_pool, 
-                                          br_status, mods);
+      {
+        ProfScope ps(env_->getProfiler(), "branch");
+        branches_ = brancher_->findBranches(relaxation_, node, sol, s_pool, 
+                                            br_status, mods);
+      }
       if (br_status==PrunedByBrancher) {
 
         should_prune = true;
@@ -356,6 +361,7 @@ void PCBProcessor::process(NodePtr node, RelaxationPtr rel,
 void PCBProcessor::separate_(ConstSolutionPtr sol, NodePtr node, 
                             SolutionPoolPtr s_pool, SeparationStatus *status) 
 {
+  ProfScope prof(env_->getProfiler(), "separate");
   ModVector mods;
   HandlerIterator h;
   SeparationStatus st = SepaContinue;
@@ -525,6 +531,7 @@ bool PCBProcessor::shouldPrune_(NodePtr node, double solval,
 
 void PCBProcessor::solveRelaxation_() 
 {
+  ProfScope prof(env_->getProfiler(), "engine_solve");
   engineStatus_ = EngineError;
   engine_->solve();
   engineStatus_ = engine_->getStatus();
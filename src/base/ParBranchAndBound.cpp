@@ -484,7 +484,15 @@ void ParBranchAndBound::showStatus_(bool current_uncounted)
 void ParBranchAndBound::showParStatus_(UInt off, double treeLb,
                                        double WallTimeStart, UInt i)
 {
+  bool show = false;
+
+  // only one thread shows the status of an interval.
+#pragma omp critical (stats)
   if (timer_->query()-stats_->updateTime > options_->logInterval) {
+    stats_->updateTime = timer_->query();
+    show = true;
+  }
+  if (show) {
     logger_->msgStream(LogInfo) 
       << me_ 
       << std::fixed
@@ -496,7 +504,6 @@ void ParBranchAndBound::showParStatus_(UInt off, double treeLb,
       << " left = " << tm_->getActiveNodes()+off
       << " thread " << i
       << std::endl;
-    stats_->updateTime = timer_->query();
   }
 }
 
@@ -636,8 +643,8 @@ void ParBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
   {
     i = omp_get_thread_num();
     ParReliabilityBrancherPtr parRelBr;
-    UIntVector tmpTimesUp, tmpTimesDown, timesUp, timesDown, lastStrBranched;
-    DoubleVector tmpPseudoUp, tmpPseudoDown, pseudoUp, pseudoDown;
+    UIntVector timesUp, timesDown, lastStrBranched;
+    DoubleVector pseudoUp, pseudoDown;
     if (isParRel) {
       timesUp.resize(numVars,0);
       timesDown.resize(numVars,0);
@@ -648,32 +655,22 @@ void ParBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
  
     while (nodeCountTh[i] > 0 && shouldRun) {
       if (current_node[i]) {
-#pragma omp critical (treeManager)
-        {
-          if (tm_->shouldPrune_(current_node[i])) {
-            parNodeRlxr[i]->reset(current_node[i], false);
+        if (tm_->shouldPrune_(current_node[i])) {
+          parNodeRlxr[i]->reset(current_node[i], false);
 #if SPEW
-            logger_->msgStream(LogInfo) << me_ << "prune node "
-              << current_node[i]->getId() << " thread "
-              << omp_get_thread_num() << std::endl;
+          logger_->msgStream(LogInfo) << me_ << "prune node "
+            << current_node[i]->getId() << " thread "
+            << omp_get_thread_num() << std::endl;
 #endif
-            tm_->pruneNode(current_node[i]);
+          tm_->pruneNode(current_node[i]);
 #pragma omp critical (current_node)
-            current_node[i] = NodePtr();
-          }
+          current_node[i] = NodePtr();
         }
       } else {
-#pragma omp critical (treeManager)
-        {
-          current_node[i] = tm_->getCandidate();
-          if (current_node[i]) {
-            tm_->removeActiveNode(current_node[i]);
-          }
-        }
+        current_node[i] = tm_->takeCandidate();
         if (current_node[i]) {
           nodesProcTh[i]++;
 #if SPEW
-#pragma omp critical (logger)
           logger_->msgStream(LogDebug) << me_ << "get node "
             << current_node[i]->getId() << " thread "
             << omp_get_thread_num() << std::endl;
@@ -683,7 +680,6 @@ void ParBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
       }
       if (current_node[i]) {
 #if SPEW
-#pragma omp critical (logger)
         logger_->msgStream(LogInfo) << me_ << "process node "
           << current_node[i]->getId() << " thread " << omp_get_thread_num() << std::endl;
           //<< me_ << "depth = " << current_node[i]->getDepth() << std::endl
@@ -698,10 +694,10 @@ void ParBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
           for (UInt j = 0; j < numThreads; ++j) {
             if (i!=j) {
               parRelBr = dynamic_cast <ParReliabilityBrancher*> (nodePrcssr[j]->getBrancher());
-              tmpTimesUp = parRelBr->getTimesUp();
-              tmpTimesDown = parRelBr->getTimesDown();
-              tmpPseudoUp = parRelBr->getPCUp();
-              tmpPseudoDown = parRelBr->getPCDown();
+              const UIntVector &tmpTimesUp = parRelBr->getTimesUp();
+              const UIntVector &tmpTimesDown = parRelBr->getTimesDown();
+              const DoubleVector &tmpPseudoUp = parRelBr->getPCUp();
+              const DoubleVector &tmpPseudoDown = parRelBr->getPCDown();
               for (UInt l=0; l < tmpTimesDown.size(); ++l) {
                 timesUp[l] += tmpTimesUp[l];
                 timesDown[l] += tmpTimesDown[l];
@@ -719,55 +715,39 @@ void ParBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
           ++stats_->nodesProc;
         }
 #if SPEW
-#pragma omp critical (logger)
         logger_->msgStream(LogDebug1) << me_ << "node " 
           << current_node[i]->getId() << " lower bound = "
           << current_node[i]->getLb() << " thread " 
           << omp_get_thread_num() << std::endl;
 #endif
         if (nodePrcssr[i]->foundNewSolution()) {
-#pragma omp critical (treeManager)
-          {
-            tm_->setUb(solPool_->getBestSolutionValue());
-          }
+          tm_->setUb(solPool_->getBestSolutionValue());
         }
         should_prune[i] = shouldPrune_(current_node[i]);
 
         if (should_prune[i]) {
 #if SPEW
-#pragma omp critical (logger)
           logger_->msgStream(LogInfo) << me_ << "prune node "
             << current_node[i]->getId() << " thread "
             << omp_get_thread_num() << std::endl;
 #endif
           parNodeRlxr[i]->reset(current_node[i], false);
-#pragma omp critical (treeManager)
-          {
-            tm_->pruneNode(current_node[i]);
-          }
+          tm_->pruneNode(current_node[i]);
 #pragma omp critical (current_node)
           current_node[i] = NodePtr();
-#pragma omp critical (treeManager)
-          {
-            new_node[i] = tm_->getCandidate();
-            if (new_node[i]) {
-              //getting and removing node must be in the same critical
-              //block otherwise some other thread might take the same node
-              tm_->removeActiveNode(new_node[i]);
-              nodesProcTh[i]++;
+          new_node[i] = tm_->takeCandidate();
+          if (new_node[i]) {
+            nodesProcTh[i]++;
 #if SPEW
-#pragma omp critical (logger)
-              logger_->msgStream(LogDebug) << me_ << "get node "
-                << new_node[i]->getId() << " (prune) thread "
-                << omp_get_thread_num() << std::endl;
+            logger_->msgStream(LogDebug) << me_ << "get node "
+              << new_node[i]->getId() << " (prune) thread "
+              << omp_get_thread_num() << std::endl;
 #endif
-            }
           }
           dived_prev[i] = false;
         } else {
           initialized[i] = true;
 #if SPEW
-#pragma omp critical (logger)
           logger_->msgStream(LogDebug) << me_ << "branch at node "
             << current_node[i]->getId() << " thread "
             << omp_get_thread_num() << std::endl;
@@ -780,49 +760,37 @@ void ParBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
           if (!branches[i]) {
             logger_->msgStream(LogDebug) << " NO BRANCHES \n";
           }
-#pragma omp critical (treeManager)
-          {
 #pragma omp critical (current_node)
-            new_node[i] = tm_->branch(branches[i], current_node[i], ws[i]);
+          new_node[i] = tm_->branch(branches[i], current_node[i], ws[i]);
 #if SPEW
-#pragma omp critical (logger)
-            logger_->msgStream(LogDebug) << me_ << "get node "
-              << new_node[i]->getId() << " (branch) thread " << omp_get_thread_num()
-              << std::endl;
+          logger_->msgStream(LogDebug) << me_ << "get node "
+            << new_node[i]->getId() << " (branch) thread " << omp_get_thread_num()
+            << std::endl;
 #endif
-          }
           assert((should_dive[i] && new_node[i])
                  || (!should_dive[i] && !new_node[i]));
           if (should_dive[i]) {
             dived_prev[i] = true;
           } else {
             parNodeRlxr[i]->reset(current_node[i], false);
-#pragma omp critical (treeManager)
-            {
-              new_node[i] = tm_->getCandidate(); // Can be NULL. The
-              // branches that were created could have large lb and tm
-              // might have eliminated them.
-              if (new_node[i]) {
-                tm_->removeActiveNode(new_node[i]);
+            new_node[i] = tm_->takeCandidate(); // Can be NULL. The
+            // branches that were created could have large lb and tm
+            // might have eliminated them.
+            if (new_node[i]) {
 #if SPEW
-#pragma omp critical (logger)
-                logger_->msgStream(LogDebug) << me_ << "get/remove node "
-                  << new_node[i]->getId() << " thread "
-                  << omp_get_thread_num() << std::endl;
+              logger_->msgStream(LogDebug) << me_ << "get/remove node "
+                << new_node[i]->getId() << " thread "
+                << omp_get_thread_num() << std::endl;
 #endif
-              }
-              dived_prev[i] = false;
             }
+            dived_prev[i] = false;
           }
         }
 #pragma omp critical (current_node)
         current_node[i] = new_node[i];
       } // if (current_node[i]) ends
       //update lower bound
-#pragma omp critical (treeManager)
-      {
-        treeLbTh[i] = tm_->updateLb();
-      }
+      treeLbTh[i] = tm_->updateLb();
       minNodeLbTh[i] = INFINITY;
       for (UInt j=0; j < numThreads; ++j) {
 #pragma omp critical (current_node)
@@ -851,15 +819,9 @@ void ParBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
           }
         }
       }
-#pragma omp critical (logger)
-      {
-        showParStatus_(nodeCountTh[i], treeLbTh[i], wallTimeStart, i);
-      }
+      showParStatus_(nodeCountTh[i], treeLbTh[i], wallTimeStart, i);
       if (shouldStopPar_(wallTimeStart, treeLbTh[i])) {
-#pragma omp critical (treeManager)
-        {
-          tm_->updateLb();
-        }
+        tm_->updateLb();
       }
 
       // update stopping conditions
@@ -890,7 +852,6 @@ void ParBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
         ////shouldRun = false;
       } else {
 #if SPEW
-#pragma omp critical (logger)
         //logger_->msgStream(LogInfo) << "nodesCount " << nodeCountThread << " thread " << i << std::endl;
         logger_->msgStream(LogDebug) << std::setprecision(8)
           << me_ << "lb = " << tm_->updateLb() << std::endl
@@ -925,6 +886,10 @@ void ParBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
   delete[] dived_prev;
   delete[] should_prune;
   delete[] initialized;
+  // undo the modifications that are still applied to the relaxations.
+  for (UInt k = 0; k < numThreads; ++k) {
+    parNodeRlxr[k]->reset(NodePtr(), false);
+  }
   for (UInt j=0; j < numThreads; j++) {
     if (current_node[j]) {
       delete current_node[j]; current_node[j] = 0;
@@ -1088,8 +1053,8 @@ void ParBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
       for (UInt i = 0; i < numThreads; ++i) {
         sTimeTh[i] = omp_get_wtime();
         ParReliabilityBrancherPtr parRelBr;
-        UIntVector tmpTimesUp, tmpTimesDown, timesUp, timesDown, lastStrBranched;
-        DoubleVector tmpPseudoUp, tmpPseudoDown, pseudoUp, pseudoDown;
+        UIntVector timesUp, timesDown, lastStrBranched;
+        DoubleVector pseudoUp, pseudoDown;
         if (isParRel) {
           timesUp.resize(numVars,0);
           timesDown.resize(numVars,0);
@@ -1105,32 +1070,22 @@ void ParBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
             //<< me_ << "depth = " << current_node[0]->getDepth() << std::endl
             //<< me_ << "did we dive = " << dived_prev[0] << std::endl;
 //#endif
-#pragma omp critical (treeManager)
-          {
-            if (tm_->shouldPrune_(current_node[i])) {
-              parNodeRlxr[i]->reset(current_node[i], false);
+          if (tm_->shouldPrune_(current_node[i])) {
+            parNodeRlxr[i]->reset(current_node[i], false);
 #if SPEW
-              logger_->msgStream(LogInfo) << me_ << "prune node "
-                << current_node[i]->getId() << " thread "
-                << omp_get_thread_num() << std::endl;
+            logger_->msgStream(LogInfo) << me_ << "prune node "
+              << current_node[i]->getId() << " thread "
+              << omp_get_thread_num() << std::endl;
 #endif
-              tm_->pruneNode(current_node[i]);
-              current_node[i] = NodePtr();
-            }
+            tm_->pruneNode(current_node[i]);
+            current_node[i] = NodePtr();
           }
         } else {
-#pragma omp critical (treeManager)
-          {
-            current_node[i] = tm_->getCandidate();
-            if(current_node[i]) {
-              tm_->removeActiveNode(current_node[i]);
-            }
-          }
+          current_node[i] = tm_->takeCandidate();
           dived_prev[i] = false;
         }
         if (current_node[i]) {
 #if SPEW
-#pragma omp critical (logger)
           logger_->msgStream(LogInfo) << me_ << "process node "
             << current_node[i]->getId() << " thread " << omp_get_thread_num() << std::endl
             << me_ << "depth = " << current_node[i]->getDepth() << std::endl
@@ -1145,10 +1100,10 @@ void ParBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
             for (UInt j = 0; j < numThreads; ++j) {
               if (i!=j) {
                 parRelBr = dynamic_cast <ParReliabilityBrancher*> (nodePrcssr[j]->getBrancher());
-                tmpTimesUp = parRelBr->getTimesUp();
-                tmpTimesDown = parRelBr->getTimesDown();
-                tmpPseudoUp = parRelBr->getPCUp();
-                tmpPseudoDown = parRelBr->getPCDown();
+                const UIntVector &tmpTimesUp = parRelBr->getTimesUp();
+                const UIntVector &tmpTimesDown = parRelBr->getTimesDown();
+                const DoubleVector &tmpPseudoUp = parRelBr->getPCUp();
+                const DoubleVector &tmpPseudoDown = parRelBr->getPCDown();
                 for (UInt l=0; l < tmpTimesDown.size(); ++l) {
                   timesUp[l] += tmpTimesUp[l];
                   timesDown[l] += tmpTimesDown[l];
@@ -1168,53 +1123,37 @@ void ParBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
           }
 
 #if SPEW
-#pragma omp critical (logger)
           logger_->msgStream(LogDebug1) << me_ << "node lower bound = " <<
             current_node[i]->getLb() << current_node[i]->getId() << " thread "
             << omp_get_thread_num()<< std::endl;
 #endif
           if (nodePrcssr[i]->foundNewSolution()) {
-#pragma omp critical (treeManager)
-            {
-              tm_->setUb(solPool_->getBestSolutionValue());
-            }
+            tm_->setUb(solPool_->getBestSolutionValue());
           }
           should_prune[i] = shouldPrune_(current_node[i]);
 
           if (should_prune[i]) {
 #if SPEW
-#pragma omp critical (logger)
             logger_->msgStream(LogInfo) << me_ << "prune node "
               << current_node[i]->getId() << " thread "
               << omp_get_thread_num() << std::endl;
 #endif
             parNodeRlxr[i]->reset(current_node[i], false);
-#pragma omp critical (treeManager)
-            {
-              tm_->pruneNode(current_node[i]);
-            }
+            tm_->pruneNode(current_node[i]);
             current_node[i] = NodePtr();
-#pragma omp critical (treeManager)
-            {
-              new_node[i] = tm_->getCandidate();
-              if (new_node[i]) {
+            new_node[i] = tm_->takeCandidate();
+            if (new_node[i]) {
 #if SPEW
-#pragma omp critical (logger)
-                logger_->msgStream(LogDebug) << me_ << "get node "
-                  << new_node[i]->getId() << " (prune) thread "
-                  << omp_get_thread_num() << std::endl;
+              logger_->msgStream(LogDebug) << me_ << "get node "
+                << new_node[i]->getId() << " (prune) thread "
+                << omp_get_thread_num() << std::endl;
 #endif
-                //getting and removing node must be in the same critical
-                //block otherwise some other thread might take the same node
-                tm_->removeActiveNode(new_node[i]);
-              }
             }
             dived_prev[i] = false;
 
           } else {
             initialized[i] = true;
 #if SPEW
-#pragma omp critical (logger)
             logger_->msgStream(LogDebug) << me_ << "branch at node "
               << current_node[i]->getId() << " thread "
               << omp_get_thread_num() << std::endl;
@@ -1227,38 +1166,29 @@ void ParBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
             if (!branches[i]) {
               logger_->msgStream(LogDebug) << " NO BRANCHES \n";
             }
-#pragma omp critical (treeManager)
-            {
-              new_node[i] = tm_->branch(branches[i], current_node[i], ws[i]);
+            new_node[i] = tm_->branch(branches[i], current_node[i], ws[i]);
 #if SPEW
-#pragma omp critical (logger)
-              logger_->msgStream(LogDebug) << me_ << "get node "
-                << new_node[i]->getId() << " (branch) thread " << omp_get_thread_num()
-                << std::endl;
+            logger_->msgStream(LogDebug) << me_ << "get node "
+              << new_node[i]->getId() << " (branch) thread " << omp_get_thread_num()
+              << std::endl;
 #endif
-            }
             assert((should_dive[i] && new_node[i])
                    || (!should_dive[i] && !new_node[i]));
             if (should_dive[i]) {
               dived_prev[i] = true;
             } else {
               parNodeRlxr[i]->reset(current_node[i], false);
-#pragma omp critical (treeManager)
-              {
-                new_node[i] = tm_->getCandidate(); // Can be NULL. The
-                // branches that were created could have large lb and tm
-                // might have eliminated them.
-                if (new_node[i]) {
-                  tm_->removeActiveNode(new_node[i]);
+              new_node[i] = tm_->takeCandidate(); // Can be NULL. The
+              // branches that were created could have large lb and tm
+              // might have eliminated them.
+              if (new_node[i]) {
 #if SPEW
-#pragma omp critical (logger)
-                  logger_->msgStream(LogDebug) << me_ << "get/remove node "
-                    << new_node[i]->getId() << " thread "
-                    << omp_get_thread_num() << std::endl;
+                logger_->msgStream(LogDebug) << me_ << "get/remove node "
+                  << new_node[i]->getId() << " thread "
+                  << omp_get_thread_num() << std::endl;
 #endif
-                }
-                dived_prev[i] = false;
               }
+              dived_prev[i] = false;
             }
           }
           current_node[i] = new_node[i];
@@ -1273,10 +1203,7 @@ void ParBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
         sTimeTh[i] = omp_get_wtime();
         //stopping condition at each thread
         nodeCountTh[i] = 0;
-#pragma omp critical (treeManager)
-        {
-          treeLbTh[i] = tm_->updateLb();
-        }
+        treeLbTh[i] = tm_->updateLb();
         minNodeLbTh[i] = INFINITY;
 
         for (UInt j=0; j < numThreads; ++j) {
@@ -1293,15 +1220,9 @@ void ParBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
         if (minNodeLbTh[i] < treeLbTh[i]) {
           treeLbTh[i] = minNodeLbTh[i];
         }
-#pragma omp critical (logger)
-        {
-          showParStatus_(nodeCountTh[i], treeLbTh[i], wallTimeStart, i);
-        }
+        showParStatus_(nodeCountTh[i], treeLbTh[i], wallTimeStart, i);
         if (shouldStopPar_(wallTimeStart, treeLbTh[i])) {
-#pragma omp critical (treeManager)
-          {
-            tm_->updateLb();
-          }
+          tm_->updateLb();
           shouldRunTh[i] = false;
         }
         wTimeTh[i] += omp_get_wtime() - sTimeTh[i];
@@ -1342,7 +1263,6 @@ void ParBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
             status_ = SolvedInfeasible; // TODO: get the right status
           }
 #if SPEW
-#pragma omp critical (logger)
           logger_->msgStream(LogDebug) << me_ << "all nodes have "
             << "been processed" << std::endl;
 #endif
@@ -1352,14 +1272,12 @@ void ParBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
         } else if (notRampedUp && (nodeCount == numThreads)) {
           tm_->updateLb();
           notRampedUp = false;
-#pragma omp critical (logger)
           logger_->msgStream(LogExtraInfo) << me_
             << "ramp-up time = "
             << getWallTime() - wallTimeStart << std::endl;
           //shouldRun = false;
         } else {
 #if SPEW
-#pragma omp critical (logger)
           logger_->msgStream(LogDebug) << std::setprecision(8)
             << me_ << "lb = " << tm_->updateLb() << std::endl 
             << me_ << "ub = " << tm_->getUb() << std::endl;
@@ -1399,6 +1317,10 @@ void ParBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
   delete[] dived_prev;
   delete[] should_prune;
   delete[] initialized;
+  // undo the modifications that are still applied to the relaxations.
+  for (UInt k = 0; k < numThreads; ++k) {
+    parNodeRlxr[k]->reset(NodePtr(), false);
+  }
   for (UInt i=0; i < numThreads; i++) {
     if (current_node[i]) {
       delete current_node[i]; current_node[i] = 0;
@@ -1558,25 +1480,19 @@ void ParBranchAndBound::parsolveSync(ParNodeIncRelaxerPtr parNodeRlxr[],
     for (UInt i = 0; i < numThreads; ++i) {
       if (current_node[i]) {
 #if SPEW
-#pragma omp critical (logger)
           logger_->msgStream(LogDebug1) << me_ << "process node "
             << current_node[0]->getId() << std::endl
             << me_ << "depth = " << current_node[0]->getDepth() << std::endl
             << me_ << "did we dive = " << dived_prev[0] << std::endl;
 #endif
       } else {
-#pragma omp critical (treeManager)
-        {
-          current_node[i] = tm_->getCandidate();
-          if (current_node[i]) {
+        current_node[i] = tm_->takeCandidate();
+        if (current_node[i]) {
 #if SPEW
-#pragma omp critical (logger)
-            logger_->msgStream(LogDebug1) << "assign node " << current_node[i]->getId() << " score "
-              << (int)current_node[i]->getTbScore() << " lb "
-              << current_node[i]->getLb() << " thread " << omp_get_thread_num() << "\n";
+          logger_->msgStream(LogDebug1) << "assign node " << current_node[i]->getId() << " score "
+            << (int)current_node[i]->getTbScore() << " lb "
+            << current_node[i]->getLb() << " thread " << omp_get_thread_num() << "\n";
 #endif
-            tm_->removeActiveNode(current_node[i]);
-          }
         }
         dived_prev[i] = false;
       }
@@ -1588,8 +1504,8 @@ void ParBranchAndBound::parsolveSync(ParNodeIncRelaxerPtr parNodeRlxr[],
       // NODE SOLVING
 #pragma omp for
       for (UInt i = 0; i < numThreads; ++i) {
-        UIntVector tmpTimesUp, tmpTimesDown, timesUp, timesDown, lastStrBranched;
-        DoubleVector tmpPseudoUp, tmpPseudoDown, pseudoUp, pseudoDown;
+        UIntVector timesUp, timesDown, lastStrBranched;
+        DoubleVector pseudoUp, pseudoDown;
 
         if (current_node[i]) {
           should_dive[i] = false;
@@ -1597,7 +1513,6 @@ void ParBranchAndBound::parsolveSync(ParNodeIncRelaxerPtr parNodeRlxr[],
                                                         dived_prev[i],
                                                         should_prune[i]);
 #if SPEW
-#pragma omp critical (logger)
           logger_->msgStream(LogInfo) << me_ << "process node "
             << current_node[i]->getId() << " score "
             << (int)current_node[i]->getTbScore() << " thread "
@@ -1640,23 +1555,18 @@ void ParBranchAndBound::parsolveSync(ParNodeIncRelaxerPtr parNodeRlxr[],
           //}
           if (should_prune[i]) {
 #if SPEW
-#pragma omp critical (logger)
             logger_->msgStream(LogInfo) << me_ << "prune node "
               << current_node[i]->getId() << " score "
               << (int)current_node[i]->getTbScore() << " thread "
               << omp_get_thread_num() << std::endl;
 #endif
             parNodeRlxr[i]->reset(current_node[i], false);
-#pragma omp critical (treeManager)
-            {
-              tm_->pruneNode(current_node[i]);
-              new_node[i] = NodePtr();
-            }
+            tm_->pruneNode(current_node[i]);
+            new_node[i] = NodePtr();
             dived_prev[i] = false;
           } else {
             initialized[i] = true;
 #if SPEW
-#pragma omp critical (logger)
             logger_->msgStream(LogInfo) << me_ << "branch at node "
               << current_node[i]->getId() << " score "
               << (int)current_node[i]->getTbScore() << " thread "
@@ -1681,38 +1591,29 @@ void ParBranchAndBound::parsolveSync(ParNodeIncRelaxerPtr parNodeRlxr[],
             ws[i] = nodePrcssr[i]->getWarmStart();
             should_dive[i] = tm_->shouldDive();
             assert(branches[i]);
-#pragma omp critical (treeManager)
-            {
-              new_node[i] = tm_->branch(branches[i], current_node[i], ws[i]);
+            new_node[i] = tm_->branch(branches[i], current_node[i], ws[i]);
 #if SPEW
-#pragma omp critical (logger)
-              logger_->msgStream(LogInfo) << me_ << "get node "
-                << new_node[i]->getId() << " score "
-                << (int)new_node[i]->getTbScore() << " (branch) thread "
-                << omp_get_thread_num() << std::endl;
+            logger_->msgStream(LogInfo) << me_ << "get node "
+              << new_node[i]->getId() << " score "
+              << (int)new_node[i]->getTbScore() << " (branch) thread "
+              << omp_get_thread_num() << std::endl;
 #endif
-            }
             assert((should_dive[i] && new_node[i])
                    || (!should_dive[i] && !new_node[i]));
             if (should_dive[i]) {
               dived_prev[i] = true;
             } else {
               parNodeRlxr[i]->reset(current_node[i], false);
-#pragma omp critical (treeManager)
-              {
-                new_node[i] = tm_->getCandidate(); // Can be NULL. The
-                // branches that were created could have large lb and tm
-                // might have eliminated them.
-                if (new_node[i]) {
-                  tm_->removeActiveNode(new_node[i]);
+              new_node[i] = tm_->takeCandidate(); // Can be NULL. The
+              // branches that were created could have large lb and tm
+              // might have eliminated them.
+              if (new_node[i]) {
 #if SPEW
-#pragma omp critical (logger)
               logger_->msgStream(LogInfo) << me_ << "get node "
-                << new_node[i]->getId() << " score "
-                << (int)new_node[i]->getTbScore() << " (prune) thread "
-                << omp_get_thread_num() << std::endl;
+              << new_node[i]->getId() << " score "
+              << (int)new_node[i]->getTbScore() << " (prune) thread "
+              << omp_get_thread_num() << std::endl;
 #endif
-                }
               }
               dived_prev[i] = false;
             }
@@ -1751,7 +1652,6 @@ void ParBranchAndBound::parsolveSync(ParNodeIncRelaxerPtr parNodeRlxr[],
             status_ = SolvedInfeasible; // TODO: get the right status
           }
 #if SPEW
-#pragma omp critical (logger)
           logger_->msgStream(LogDebug) << me_ << "all nodes have "
             << "been processed" << std::endl;
 #endif
@@ -1760,7 +1660,6 @@ void ParBranchAndBound::parsolveSync(ParNodeIncRelaxerPtr parNodeRlxr[],
           shouldRun = false;
         } else {
 #if SPEW
-#pragma omp critical (logger)
           logger_->msgStream(LogDebug) << std::setprecision(8)
             << me_ << "lb = " << tm_->updateLb() << std::endl
             << me_ << "ub = " << tm_->getUb() << std::endl;
@@ -1783,6 +1682,10 @@ void ParBranchAndBound::parsolveSync(ParNodeIncRelaxerPtr parNodeRlxr[],
   delete[] dived_prev;
   delete[] should_prune;
   delete[] initialized;
+  // undo the modifications that are still applied to the relaxations.
+  for (UInt k = 0; k < numThreads; ++k) {
+    parNodeRlxr[k]->reset(NodePtr(), false);
+  }
   for (UInt i=0; i < numThreads; i++) {
     if (current_node[i]) {
       delete current_node[i]; current_node[i] = 0;
@@ -1816,6 +1719,7 @@ void ParBranchAndBound::writeStats(std::ostream &out)
     << stats_->timeUsed << std::endl
     << me_ << "nodes processed = " << stats_->nodesProc << std::endl
     << me_ << "nodes created   = " << tm_->getSize() << std::endl;
+  tm_->writeStats(out);
   nodePrcssr_->writeStats(out);
   nodePrcssr_->getBrancher()->writeStats(out);
   for (HeurVector::iterator it=preHeurs_.begin(); it!=preHeurs_.end(); ++it) {
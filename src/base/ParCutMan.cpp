@@ -17,6 +17,7 @@
 #include "Environment.h"
 #include "Function.h"
 #include "Cut.h"
+#include "CutStore.h"
 #include "ParCutMan.h"
 #include "LinearFunction.h"
 #include "Logger.h"
@@ -35,9 +36,11 @@ const std::string ParCutMan::me_ = "ParCutMan: ";
 
 ParCutMan::ParCutMan()
   : absTol_(1e-6),
+    cutStore_(0),
     env_(EnvPtr()),   // NULL
     maxDisCutAge_(3),
     maxInactCutAge_(1),
+    owner_(0),
     p_(ProblemPtr())  // NULL
 {
   logger_ = (LoggerPtr) new Logger(LogDebug2);
@@ -46,9 +49,11 @@ ParCutMan::ParCutMan()
 
 ParCutMan::ParCutMan(EnvPtr env, ProblemPtr p)
   : absTol_(1e-6),
+    cutStore_(0),
     env_(env),
     maxDisCutAge_(1),
     maxInactCutAge_(1),
+    owner_(0),
     p_(p)
 {
   logger_ = env->getLogger();
@@ -211,8 +216,19 @@ void ParCutMan::addToPool_(CutPtr cut)
 void ParCutMan::addCutToPool(CutPtr cut)
 {
   pool_.push_back(cut);
+  if (cutStore_) {
+    cutStore_->add(cut, owner_);
+  }
+}
+
+
+void ParCutMan::setCutStore(CutStore *store, UInt owner)
+{
+  cutStore_ = store;
+  owner_ = owner;
 }
 
+
 void ParCutMan::write(std::ostream &out) const
 {
   out << me_ << "Nothing to write" << std::endl;
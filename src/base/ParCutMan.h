@@ -20,6 +20,8 @@
 
 namespace Minotaur {
 
+class CutStore;
+
 /**
  * \brief Derived class for managing cuts. Add and remove cuts based on
  * priority and violation.
@@ -44,6 +46,10 @@ public:
   // Base class method.
   void addCut(CutPtr c);
   
+  /**
+   * Add a cut to the pool. If a cut store is set, the cut is also added to
+   * it, so that other threads can use it.
+   */
   void addCutToPool(CutPtr cut);
   
   std::vector<ConstraintPtr > getPoolCons();
@@ -73,6 +79,14 @@ public:
   void separate(ProblemPtr p, ConstSolutionPtr sol, bool *separated,
                 UInt *n_added);
 
+  /**
+   * \brief Set the store in which the cuts of the pool are shared with other
+   * threads.
+   * \param [in] store The store. It is not deleted by the cut manager.
+   * \param [in] owner Number of the thread that uses this cut manager.
+   */
+  void setCutStore(CutStore *store, UInt owner);
+
   // Base class method.
   void write(std::ostream &out) const;
 
@@ -84,6 +98,9 @@ private:
   /// Absolute tolerance limit for comparing double values.
   double absTol_;
 
+  /// Store in which cuts added to the pool are shared, if any.
+  CutStore *cutStore_;
+
   /// Cut storage for disabled cuts, i.e., those not added to the problem.
   CutList disCuts_;
 
@@ -114,6 +131,9 @@ private:
    */
   CutList newCuts_;
 
+  /// Thread that uses this cut manager, see setCutStore().
+  UInt owner_;
+
   /// The relaxation problem that cuts are added to and deleted from.
   ProblemPtr p_;
 
@@ -436,9 +436,6 @@ void ParMINLPDiving::implementDive_(int i, const double* x, SolutionPoolPtr s_po
       } else {
         // dive further down by rounding variable in current solution "x"
         lastNodeMods.clear();
-#if USE_OPENMP
-#pragma omp critical (log)
-#endif
         logger_->msgStream(LogInfo) << "Diving down" << std::endl;
         n_moded = (this->*f)(numfrac, x, d, o, p, violated, mods, lh,
                              lastNodeMods, score, avgDual, gradientObj);
@@ -450,9 +447,6 @@ void ParMINLPDiving::implementDive_(int i, const double* x, SolutionPoolPtr s_po
       return;
     } else {
       // backtrack to the other child of the parent
-#if USE_OPENMP
-#pragma omp critical (log)
-#endif
 //#if SPEW
       logger_->msgStream(LogInfo) << me_ << "Backtracking " << std::endl;
 //#endif
@@ -779,7 +773,6 @@ void ParMINLPDiving::saveBounds_(double* LB_copy, double* UB_copy, UInt vars)
 ParMINLPDiving::FuncPtr ParMINLPDiving::selectHeur_(int i, Direction &d, Order &o)
 {
 #if USE_OPENMP
-#pragma omp critical (log)
   logger_->msgStream(LogInfo) << "Thread " << omp_get_thread_num() << " i = " << i << " : "
     << getScoreString(i) << " : " << getDirectionString(i) << " : "
     << getOrderString(i) << std::endl;
@@ -19,23 +19,33 @@
 #include "Node.h"
 #include "ParNodeIncRelaxer.h"
 #include "Option.h"
+#include "Profiler.h"
 #include "Relaxation.h"
+#include "WarmStart.h"
 
 using namespace Minotaur;
 
 
 ParNodeIncRelaxer::ParNodeIncRelaxer (EnvPtr env, HandlerVector handlers) 
-  : engine_(EnginePtr()),  // NULL
+  : cutStore_(0),
+    engine_(EnginePtr()),  // NULL
     env_(env),
     handlers_(handlers),
     modProb_(true),
     rel_(RelaxationPtr()) // NULL
 {
+  storeCuts_ = env_->getOptions()->findBool("storeCutsAtNode");
 }
 
 
 ParNodeIncRelaxer::~ParNodeIncRelaxer ()
 {
+  while (!path_.empty()) {
+    if (path_.back()->unpin()) {
+      delete path_.back();
+    }
+    path_.pop_back();
+  }
   if (rel_) {
     delete rel_;
     rel_ = 0;
@@ -47,7 +57,14 @@ ParNodeIncRelaxer::~ParNodeIncRelaxer ()
 
 RelaxationPtr ParNodeIncRelaxer::createRootRelaxation(NodePtr, bool &prune)
 {
+  ProfScope prof(env_->getProfiler(), "relax_root");
   prune = false;
+  while (!path_.empty()) {
+    if (path_.back()->unpin()) {
+      delete path_.back();
+    }
+    path_.pop_back();
+  }
   rel_ = (RelaxationPtr) new Relaxation(env_);
   for (HandlerIterator h = handlers_.begin(); h != handlers_.end() && !prune; 
       ++h) {
@@ -84,6 +101,12 @@ void ParNodeIncRelaxer::setEngine(EnginePtr e)
 }
 
 
+void ParNodeIncRelaxer::setCutStore(CutStore *store)
+{
+  cutStore_ = store;
+}
+
+
 void ParNodeIncRelaxer::setModFlag(bool mod_prob)
 {
   modProb_ = mod_prob;
@@ -93,47 +116,40 @@ void ParNodeIncRelaxer::setModFlag(bool mod_prob)
 RelaxationPtr ParNodeIncRelaxer::createNodeRelaxation(NodePtr node, bool dived, 
                                                    bool &prune)
 {
+  ProfScope prof(env_->getProfiler(), "relax_node");
   NodePtr t_node; // temporary
   WarmStartPtr ws;
+  std::stack<NodePtr> predecessors;
+  bool store_cuts = storeCuts_->getValue();
   prune = false;
 
-  if (!dived) {
-    // traceback to root and put in all modifications that need to go into the
-    // relaxation and the engine.
-    std::stack<NodePtr> predecessors;
-    t_node = node->getParent();
+  if (dived) {
+    // if we dived from the root, its modifications are already applied.
+    pushRoot_(node->getParent());
+  }
 
-    while (t_node) {
-      predecessors.push(t_node);
-      t_node = t_node->getParent();
-    }
+  // traceback until we hit the lowest common ancestor of node and the last
+  // node whose modifications are in the relaxation. When we dive, it is the
+  // parent of node.
+  t_node = node;
+  while (t_node && !(t_node->getDepth() < path_.size() &&
+                     path_[t_node->getDepth()] == t_node)) {
+    predecessors.push(t_node);
+    t_node = t_node->getParent();
+  }
 
-    // starting from the top, put in modifications made at each node to the
-    // engine
-    if (modProb_) {
-      while (!predecessors.empty()) {
-        t_node = predecessors.top();
-        t_node->applyMods(rel_, p_);
-        predecessors.pop();
-      }
-    } else {
-      while (!predecessors.empty()) {
-        t_node = predecessors.top();
-        t_node->applyRModsTrans(rel_);
-        if (env_->getOptions()->findBool("storeCutsAtNode")->getValue() == true) {
-          t_node->applyCutsByIndex(rel_);
-        }
-        predecessors.pop();
-      }
-    }
+  // undo the modifications of nodes below the common ancestor.
+  while (path_.size() > (t_node ? t_node->getDepth()+1 : 0)) {
+    popNode_();
   }
 
-  // put in the modifications that were used to create this node from
-  // its parent.
-  if (modProb_) {
-    node->applyMods(rel_, p_);
-  } else {
-    node->applyRModsTrans(rel_);
+  // starting from the top, put in modifications made at each node, including
+  // the ones used to create this node from its parent. Cuts stored at the
+  // ancestors may have been generated by other threads.
+  while (!predecessors.empty()) {
+    t_node = predecessors.top();
+    pushNode_(t_node, store_cuts && t_node != node);
+    predecessors.pop();
   }
 
   for (HandlerIterator h = handlers_.begin(); h != handlers_.end() && !prune; 
@@ -146,9 +162,13 @@ RelaxationPtr ParNodeIncRelaxer::createNodeRelaxation(NodePtr node, bool dived,
 
   // give the warm start info to the engine.
   if (!prune) {
+    // WarmStartStore may drop the information from another thread.
     ws = node->getWarmStart();
     if (ws) {
-      engine_->loadFromWarmStart(ws);
+#pragma omp critical (wsStore)
+      if (ws->hasInfo()) {
+        engine_->loadFromWarmStart(ws);
+      }
     }
   } else {
     node->removeWarmStart();
@@ -158,21 +178,56 @@ RelaxationPtr ParNodeIncRelaxer::createNodeRelaxation(NodePtr node, bool dived,
 }
 
 
-void ParNodeIncRelaxer::reset(NodePtr node, bool diving)
+void ParNodeIncRelaxer::popNode_()
 {
-  NodePtr t_node = node;
+  NodePtr t_node = path_.back();
 
-  if (!diving) {
-    if (modProb_) {
-      while (t_node) {
-        t_node->undoMods(rel_, p_);
-        t_node = t_node->getParent();
-      }
-    } else {
-      while (t_node) {
-        t_node->undoRModsTrans(rel_);
-        t_node = t_node->getParent();
-      }
+  if (modProb_) {
+    t_node->undoModsByIndex(rel_, p_);
+  } else {
+    t_node->undoRModsTrans(rel_);
+  }
+  path_.pop_back();
+  if (t_node->unpin()) {
+    delete t_node;
+  }
+}
+
+
+void ParNodeIncRelaxer::pushNode_(NodePtr node, bool add_cuts)
+{
+  if (modProb_) {
+    // the mods may have been made by another thread to its own copies.
+    node->applyModsByIndex(rel_, p_);
+  } else {
+    node->applyRModsTrans(rel_);
+    if (add_cuts && cutStore_) {
+      node->applyCutsByIndex(rel_, cutStore_);
+    }
+  }
+  node->pin();
+  path_.push_back(node);
+}
+
+
+void ParNodeIncRelaxer::pushRoot_(NodePtr node)
+{
+  if (path_.empty() && node && !node->getParent()) {
+    node->pin();
+    path_.push_back(node);
+  }
+}
+
+
+void ParNodeIncRelaxer::reset(NodePtr node, bool)
+{
+  if (node) {
+    // the root is processed without a call to createNodeRelaxation. Its
+    // modifications are already in the relaxation.
+    pushRoot_(node);
+  } else {
+    while (!path_.empty()) {
+      popNode_();
     }
   }
 }
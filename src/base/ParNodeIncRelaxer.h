@@ -21,13 +21,24 @@
 
 namespace Minotaur {
 
+class CutStore;
+
 /**
  * The root relaxation is stored as rel_. In each node, we apply all
- * modifications stored in each ancestor of the node. When we are done
- * processing the node, we undo all these changes. 
+ * modifications stored in each ancestor of the node. 
+ *
+ * The modifications of the last processed node and its ancestors are kept
+ * applied after the node is processed. When a new node is to be processed,
+ * we find the lowest common ancestor of the new node and the last one. We
+ * undo the modifications of nodes below the common ancestor on the old path
+ * and apply the modifications of nodes below it on the new path. If we dive
+ * after processing a node, the common ancestor is the parent itself and we
+ * only apply the modifications of the new node.
  *
- * If we dive after processing a node, we do not need to undo all changes
- * and apply them again. We just apply the modifications of the parent.
+ * Nodes whose modifications are applied are pinned (see Node::pin()), so
+ * that the tree manager does not delete them before we undo their
+ * modifications. This is needed because other threads may prune or remove
+ * these nodes while this relaxer still has them applied.
  */
 class ParNodeIncRelaxer : public NodeRelaxer {
 public:
@@ -46,7 +57,11 @@ public:
   /// Get the current value of modProb_ flag.
   bool getModFlag();
 
-  // Implement NodeRelaxer::reset()
+  /**
+   * Implement NodeRelaxer::reset(). Modifications are not undone here, but
+   * when the next node is created. If node is NULL, all modifications are
+   * undone and the relaxation is the same as the root relaxation.
+   */
   void reset(NodePtr node, bool diving);
 
   /**
@@ -60,19 +75,31 @@ public:
 
   /**
    * \brief If mod_prob is true, the problem will also be modified at each
-   * node. By default, only the relaxation is modified.
+   * node. By default, only the relaxation is modified. The modifications
+   * of a node are copied by index to the problem and the relaxation of this
+   * relaxer, so the copies used by all threads must have the same variables
+   * and constraints.
    */
   void setModFlag(bool mod_prob);
 
   // get the relaxation pointer, rel_.
   RelaxationPtr getRelaxation();
 
+  /**
+   * \brief Set the store of the cuts kept in the cut-pools of nodes. If it
+   * is NULL, the cuts of the nodes are not added to the relaxation.
+   */
+  void setCutStore(CutStore *store);
+
   /// Set your own relaxation pointer.
   void setRelaxation(RelaxationPtr rel);
 
   /// Set the problem pointer
   void setProblem(ProblemPtr p);
 private:
+  /// Store of the cuts in the cut-pools of nodes.
+  CutStore *cutStore_;
+
   /// Pointer engine used to solve the relaxation.
   EnginePtr engine_;
 
@@ -88,14 +115,39 @@ private:
    */
   bool modProb_;
 
+  /// Option storeCutsAtNode, read for every node.
+  BoolOptionPtr storeCuts_;
+
   /// The problem being solved by branch-and-bound.
   ProblemPtr p_;
 
+  /**
+   * Nodes whose modifications are currently applied to the relaxation,
+   * starting from the root. path_[i] is at depth i.
+   */
+  NodePtrVector path_;
+
   /**
    * \brief We only keep one relaxation. It is modified at each node and then
    * reset.
    */
   RelaxationPtr rel_;
+
+  /**
+   * Apply the modifications of a node and add it to the end of path_. If
+   * add_cuts is true, the cuts stored at the node are also added.
+   */
+  void pushNode_(NodePtr node, bool add_cuts);
+
+  /// Undo the modifications of the last node in path_ and remove it.
+  void popNode_();
+
+  /**
+   * If path_ is empty and node is the root, add it to path_. The
+   * modifications of the root are applied while it is processed, without a
+   * call to createNodeRelaxation().
+   */
+  void pushRoot_(NodePtr node);
 };
 
 typedef ParNodeIncRelaxer* ParNodeIncRelaxerPtr;
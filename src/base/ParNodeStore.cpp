@@ -0,0 +1,239 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2024 The Minotaur Team.
+//
+
+/**
+ * \file ParNodeStore.cpp
+ * \brief Implement the class ParNodeStore for storing active nodes of a
+ * branch-and-bound tree that is explored by several threads at once.
+ * \author The Minotaur Team
+ */
+
+#include <cmath>
+#include <iostream>
+
+#include "MinotaurConfig.h"
+#include "Node.h"
+#include "NodeHeap.h"
+#include "NodeStack.h"
+#include "ParNodeStore.h"
+
+using namespace Minotaur;
+
+
+ParNodeStore::ParNodeStore(UInt num_stores, TreeSearchOrder order)
+: numStores_(num_stores > 0 ? num_stores : 1),
+  size_(0)
+{
+  lbs_ = new double[numStores_];
+  locks_ = new omp_lock_t[numStores_];
+  sizes_ = new UInt[numStores_];
+  for (UInt k = 0; k < numStores_; ++k) {
+    if (DepthFirst == order) {
+      stores_.push_back((NodeStackPtr) new NodeStack());
+    } else {
+      stores_.push_back((NodeHeapPtr) new NodeHeap(NodeHeap::Value));
+    }
+    lbs_[k] = INFINITY;
+    sizes_[k] = 0;
+    omp_init_lock(&locks_[k]);
+  }
+}
+
+
+ParNodeStore::~ParNodeStore()
+{
+  for (UInt k = 0; k < numStores_; ++k) {
+    omp_destroy_lock(&locks_[k]);
+    delete stores_[k];
+  }
+  stores_.clear();
+  delete [] lbs_;
+  delete [] locks_;
+  delete [] sizes_;
+}
+
+
+double ParNodeStore::getBestLB() const
+{
+  double best = INFINITY;
+  double lb;
+  for (UInt k = 0; k < numStores_; ++k) {
+#pragma omp atomic read
+    lb = lbs_[k];
+    if (lb < best) {
+      best = lb;
+    }
+  }
+  return best;
+}
+
+
+UInt ParNodeStore::getDeepestLevel() const
+{
+  UInt deepest = 0;
+  for (UInt k = 0; k < numStores_; ++k) {
+    omp_set_lock(&locks_[k]);
+    if (!stores_[k]->isEmpty() && stores_[k]->getDeepestLevel() > deepest) {
+      deepest = stores_[k]->getDeepestLevel();
+    }
+    omp_unset_lock(&locks_[k]);
+  }
+  return deepest;
+}
+
+
+UInt ParNodeStore::getSize() const
+{
+  UInt size;
+#pragma omp atomic read
+  size = size_;
+  return size;
+}
+
+
+bool ParNodeStore::isEmpty() const
+{
+  return (0 == getSize());
+}
+
+
+UInt ParNodeStore::myStore_() const
+{
+  return omp_get_thread_num() % numStores_;
+}
+
+
+void ParNodeStore::pop()
+{
+  for (UInt k = 0; k < numStores_; ++k) {
+    if (sizes_[k] > 0) {
+      popFrom_(k);
+      return;
+    }
+  }
+}
+
+
+NodePtr ParNodeStore::popFrom_(UInt k)
+{
+  NodePtr node = NodePtr(); // NULL
+  double lb;
+
+  omp_set_lock(&locks_[k]);
+  if (!stores_[k]->isEmpty()) {
+    node = stores_[k]->top();
+    stores_[k]->pop();
+    // Exact for a heap ordered by bound. A stack has to be scanned, but only
+    // when the node leaving it may have held the smallest bound.
+    lb = lbs_[k];
+    if (stores_[k]->isEmpty()) {
+      lb = INFINITY;
+    } else if (node->getLb() <= lb) {
+      lb = stores_[k]->getBestLB();
+    }
+#pragma omp atomic write
+    lbs_[k] = lb;
+#pragma omp atomic write
+    sizes_[k] = stores_[k]->getSize();
+#pragma omp atomic
+    --size_;
+  }
+  omp_unset_lock(&locks_[k]);
+  return node;
+}
+
+
+void ParNodeStore::push(NodePtr n)
+{
+  UInt k = myStore_();
+  double lb = n->getLb();
+
+  omp_set_lock(&locks_[k]);
+  stores_[k]->push(n);
+  if (lb < lbs_[k]) {
+#pragma omp atomic write
+    lbs_[k] = lb;
+  }
+#pragma omp atomic write
+  sizes_[k] = stores_[k]->getSize();
+#pragma omp atomic
+  ++size_;
+  omp_unset_lock(&locks_[k]);
+}
+
+
+NodePtr ParNodeStore::take()
+{
+  UInt me = myStore_();
+  UInt k;
+  NodePtr node = popFrom_(me);
+
+  while (!node && getSize() > 0) {
+    k = victim_(me);
+    if (k == numStores_) {
+      // nodes are being pushed but are not visible yet.
+      break;
+    }
+    node = popFrom_(k);
+  }
+  return node; // can be NULL
+}
+
+
+NodePtr ParNodeStore::top() const
+{
+  for (UInt k = 0; k < numStores_; ++k) {
+    if (sizes_[k] > 0) {
+      return stores_[k]->top();
+    }
+  }
+  return NodePtr(); // NULL
+}
+
+
+UInt ParNodeStore::victim_(UInt k) const
+{
+  UInt best = numStores_;
+  UInt size;
+  double best_lb = INFINITY;
+  double lb;
+
+  for (UInt j = 0; j < numStores_; ++j) {
+    if (j == k) {
+      continue;
+    }
+#pragma omp atomic read
+    size = sizes_[j];
+#pragma omp atomic read
+    lb = lbs_[j];
+    if (size > 0 && (best == numStores_ || lb < best_lb)) {
+      best = j;
+      best_lb = lb;
+    }
+  }
+  return best;
+}
+
+
+void ParNodeStore::write(std::ostream &out) const
+{
+  for (UInt k = 0; k < numStores_; ++k) {
+    out << "sub-store " << k << ":" << std::endl;
+    stores_[k]->write(out);
+  }
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,142 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2024 The Minotaur Team.
+//
+
+/**
+ * \file ParNodeStore.h
+ * \brief Define the class ParNodeStore for storing active nodes of a
+ * branch-and-bound tree that is explored by several threads at once.
+ * \author The Minotaur Team
+ */
+
+
+#ifndef MINOTAURPARNODESTORE_H
+#define MINOTAURPARNODESTORE_H
+
+#include <omp.h>
+
+#include "Types.h"
+#include "ActiveNodeStore.h"
+
+namespace Minotaur {
+
+  /**
+   * \brief Active-node store shared by the threads of a parallel
+   * branch-and-bound.
+   *
+   * Every thread owns one sub-store (a NodeHeap for best-first searches, a
+   * NodeStack for depth-first search) guarded by its own lock. A thread
+   * pushes the children it creates into its own sub-store and takes nodes
+   * from it. When its sub-store runs dry it steals from the sub-store whose
+   * published lower bound is the smallest. Hence threads only contend when
+   * they work on the same sub-store.
+   *
+   * The lower bound and size of each sub-store are published through atomic
+   * variables so that getBestLB(), getSize() and isEmpty() never lock.
+   *
+   * top() and pop() are provided to satisfy ActiveNodeStore and may only be
+   * used when no other thread accesses the store. Concurrent callers must use
+   * take() instead.
+   */
+  class ParNodeStore : public ActiveNodeStore {
+  public:
+    /**
+     * \brief Constructor.
+     *
+     * \param[in] num_stores Number of sub-stores, usually the number of
+     * threads. Threads with id larger than this number share sub-stores.
+     * \param[in] order The search order. A NodeStack is used for each
+     * sub-store if it is DepthFirst, and a NodeHeap otherwise.
+     */
+    ParNodeStore(UInt num_stores, TreeSearchOrder order);
+
+    /// Destroy.
+    ~ParNodeStore();
+
+    /// Smallest lower bound published by the sub-stores.
+    double getBestLB() const;
+
+    /// Find the maximum depth of all active nodes.
+    UInt getDeepestLevel() const;
+
+    /// Get the number of active nodes in all sub-stores.
+    UInt getSize() const;
+
+    /// Return true if there are no active nodes in any sub-store.
+    bool isEmpty() const;
+
+    /// Remove the node returned by top(). Not thread-safe.
+    void pop();
+
+    /// Add a node to the sub-store of the calling thread.
+    void push(NodePtr n);
+
+    /**
+     * \brief Remove and return the best node of the calling thread's
+     * sub-store, stealing from other sub-stores if it is empty.
+     *
+     * Safe to call from several threads concurrently.
+     * \return The node removed, or NULL if all sub-stores are empty.
+     */
+    NodePtr take();
+
+    /// Best node of the first nonempty sub-store. Not thread-safe.
+    NodePtr top() const;
+
+    /// Display the active nodes of every sub-store.
+    void write(std::ostream &out) const;
+
+  private:
+    /// Lower bound of the nodes in each sub-store, INFINITY if empty.
+    double *lbs_;
+
+    /// One lock for each sub-store.
+    omp_lock_t *locks_;
+
+    /// Number of sub-stores.
+    UInt numStores_;
+
+    /// Total number of nodes in all sub-stores.
+    UInt size_;
+
+    /// Number of nodes in each sub-store.
+    UInt *sizes_;
+
+    /// The sub-stores.
+    std::vector<ActiveNodeStorePtr> stores_;
+
+    /// Return the sub-store of the calling thread.
+    UInt myStore_() const;
+
+    /**
+     * \brief Remove the best node from a sub-store.
+     *
+     * \param[in] k Index of the sub-store.
+     * \return The node removed, or NULL if the sub-store was empty.
+     */
+    NodePtr popFrom_(UInt k);
+
+    /**
+     * \brief Find the nonempty sub-store, other than k, with the smallest
+     * published lower bound.
+     *
+     * \return The index of the sub-store, or numStores_ if all are empty.
+     */
+    UInt victim_(UInt k) const;
+  };
+  typedef ParNodeStore* ParNodeStorePtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
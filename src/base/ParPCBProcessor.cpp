@@ -27,9 +27,11 @@
 #include "Logger.h"
 #include "Node.h"
 #include "Option.h"
+#include "Profiler.h"
 #include "ParCutMan.h"
 #include "Modification.h"
 #include "Relaxation.h"
+#include "Solution.h"
 #include "SolutionPool.h"
 #include "ParTreeManager.h"
 #include "WarmStart.h"
@@ -66,9 +68,11 @@ const std::string ParPCBProcessor::me_ = "ParPCBProcessor: ";
 ParPCBProcessor::ParPCBProcessor (EnvPtr env, EnginePtr engine,
                             HandlerVector handlers)
 : branches_(0),
+  brPool_(0),
   contOnErr_(false),
   cutMan_(0),
   //engineStatus_(EngineUnknownStatus),
+  env_(env),
   numSolutions_(0),
   //relaxation_(RelaxationPtr()),
   //ws_(WarmStartPtr())
@@ -80,6 +84,7 @@ ParPCBProcessor::ParPCBProcessor (EnvPtr env, EnginePtr engine,
   engine_ = engine;
   handlers_ = handlers;
   logger_ = env->getLogger();
+  prof_ = env->getProfiler();
   presFreq_ = env->getOptions()-> findInt("pres_freq")->getValue();
   stats_.bra = 0;
   stats_.inf = 0;
@@ -96,8 +101,7 @@ ParPCBProcessor::~ParPCBProcessor()
     delete cutMan_;
   }
   if (ws_) {
-    ws_->decrUseCnt();
-    if (0 == ws_->getUseCnt()) {
+    if (0 == ws_->decrUseCnt()) {
       delete ws_;
     }
   }
@@ -107,6 +111,9 @@ ParPCBProcessor::~ParPCBProcessor()
   if (branches_) {
     delete branches_;
   }
+  if (brPool_) {
+    delete brPool_;
+  }
   handlers_.clear();
 }
 
@@ -175,6 +182,7 @@ bool ParPCBProcessor::isFeasible_(NodePtr node, ConstSolutionPtr sol,
 
 bool ParPCBProcessor::presolveNode_(NodePtr node, SolutionPoolPtr s_pool) 
 {
+  ProfScope prof(prof_, "node_presolve");
   ModVector p_mods;      // Mods that are applied to the problem
   ModVector r_mods;      // Mods that are applied to the relaxation.
   bool is_inf = false;
@@ -239,6 +247,7 @@ void ParPCBProcessor::process(NodePtr node, RelaxationPtr rel,
                               DoubleVector pseudoUp, DoubleVector pseudoDown,
                               UInt nodesProc)
 {
+  ProfScope prof(prof_, "process_node");
   bool should_prune = true;
   bool should_resolve;
   BrancherStatus br_status;
@@ -246,6 +255,7 @@ void ParPCBProcessor::process(NodePtr node, RelaxationPtr rel,
   ModVector mods;
   SeparationStatus sep_status = SepaContinue;
   int iter = 0;
+  UInt n_sols;
 
   ++stats_.proc;
   relaxation_ = rel;
@@ -269,8 +279,7 @@ void ParPCBProcessor::process(NodePtr node, RelaxationPtr rel,
     should_resolve = false;
 
     if (ws_) {
-      ws_->decrUseCnt();
-      if (0 == ws_->getUseCnt()) {
+      if (0 == ws_->decrUseCnt()) {
         delete ws_;
       }
       ws_ = 0;
@@ -305,14 +314,19 @@ void ParPCBProcessor::process(NodePtr node, RelaxationPtr rel,
     if (iter == 1 && !node->getParent()) {
       // in root, in first iteration, run a heuristic. XXX: better management.
       for (HeurVector::iterator it=heurs_.begin(); it!=heurs_.end(); ++it) {
+        ProfScope ps(prof_, "heuristic");
         (*it)->solve(node, rel, s_pool);
       }
+      tightenBounds_(node, s_pool, sol, &sep_status);
     }
 
     // the node can not be pruned because of infeasibility or high cost.
     // continue processing.
-    tightenBounds_();
-    separate_(sol, node, s_pool, &sep_status);
+    if (!(!node->getParent() && iter == 1 && sep_status == SepaResolve)) {
+      // Do not do separate if we are in root and it is first iteration
+      // and we have resolved it by tightenBounds_()
+      separate_(sol, node, s_pool, &sep_status);
+    }
 
     if (sep_status == SepaPrune) {
       node->setStatus(NodeInfeasible);
@@ -327,18 +341,28 @@ void ParPCBProcessor::process(NodePtr node, RelaxationPtr rel,
       if (ws_) {
         ws_->incrUseCnt();
       }
+      // strong branching solves many relaxations. It uses the pool of this
+      // thread, so that other threads can use the shared pool meanwhile.
+      syncBrPool_(s_pool);
+      n_sols = brPool_->getNumSolsFound();
       if (brancher_->getName()=="ParReliabilityBrancher") {
         ParReliabilityBrancherPtr parRelBr;
+        ProfScope ps(prof_, "branch");
         parRelBr = dynamic_cast <ParReliabilityBrancher*> (brancher_);
-#pragma omp critical (solPool)
-        branches_ = parRelBr->findBranches(relaxation_, node, sol, s_pool,
+        branches_ = parRelBr->findBranches(relaxation_, node, sol, brPool_,
                                             br_status, mods, timesUp, timesDown,
                                             pseudoUp, pseudoDown, nodesProc);
       } else {
-#pragma omp critical (solPool)
-        branches_ = brancher_->findBranches(relaxation_, node, sol, s_pool,
+        ProfScope ps(prof_, "branch");
+        branches_ = brancher_->findBranches(relaxation_, node, sol, brPool_,
                                             br_status, mods);
       }
+      if (brPool_->getNumSolsFound() > n_sols) {
+        // a handler found a solution while strong branching.
+#pragma omp critical (solPool)
+        s_pool->addSolution(brPool_->getBestSolution());
+        ++numSolutions_;
+      }
 
       if (br_status==PrunedByBrancher) {
         should_prune = true;
@@ -381,6 +405,7 @@ void ParPCBProcessor::process(NodePtr node, RelaxationPtr rel,
 void ParPCBProcessor::separate_(ConstSolutionPtr sol, NodePtr node, 
                             SolutionPoolPtr s_pool, SeparationStatus *status) 
 {
+  ProfScope prof(prof_, "separate");
   ModVector mods;
   HandlerIterator h;
   SeparationStatus st = SepaContinue;
@@ -505,7 +530,6 @@ bool ParPCBProcessor::shouldPrune_(NodePtr node, double solval,
      if (node->getParent() &&
          node->getParent()->getLb() > solval+oATol_ &&
          node->getParent()->getLb() > solval+fabs(solval)*oRTol_ ) {
-#pragma omp critical (logger)
        logger_->msgStream(LogError) << me_ << "node lb lower than parent's lb. "
                                     << "Relaxation may not be convex or "
                                     << "engine has an issue."
@@ -557,6 +581,7 @@ bool ParPCBProcessor::shouldPrune_(NodePtr node, double solval,
 
 void ParPCBProcessor::solveRelaxation_() 
 {
+  ProfScope prof(prof_, "engine_solve");
   engineStatus_ = EngineError;
   engine_->solve();
   engineStatus_ = engine_->getStatus();
@@ -568,9 +593,50 @@ void ParPCBProcessor::solveRelaxation_()
 }
 
 
-void ParPCBProcessor::tightenBounds_() 
+void ParPCBProcessor::syncBrPool_(SolutionPoolPtr s_pool)
 {
+  SolutionPtr best;
+
+  if (!brPool_) {
+    brPool_ = (SolutionPoolPtr) new SolutionPool(env_, s_pool->getProblem(),
+                                                 1);
+  }
+#pragma omp critical (solPool)
+  {
+    best = s_pool->getBestSolution();
+    if (best && best->getObjValue() < brPool_->getBestSolutionValue()) {
+      brPool_->addSolution(best);
+    }
+  }
+}
 
+
+void ParPCBProcessor::tightenBounds_(NodePtr node, SolutionPoolPtr s_pool,
+                                     ConstSolutionPtr sol,
+                                     SeparationStatus *status)
+{
+  ModVector p_mods;      // Mods that are applied to the problem
+  ModVector r_mods;      // Mods that are applied to the relaxation.
+  bool is_feas;
+
+  for (HandlerIterator h = handlers_.begin(); h != handlers_.end(); ++h) {
+    is_feas = (*h)->postSolveRootNode(relaxation_, s_pool, sol, p_mods,
+                                      r_mods);
+    for (ModificationConstIterator m_iter=p_mods.begin();
+         m_iter!=p_mods.end(); ++m_iter) {
+      node->addPMod(*m_iter);
+    }
+    for (ModificationConstIterator m_iter=r_mods.begin();
+         m_iter!=r_mods.end(); ++m_iter) {
+      node->addRMod(*m_iter);
+    }
+    p_mods.clear();
+    r_mods.clear();
+
+    if (!(is_feas)) {
+      *status = SepaResolve;
+    }
+  }
 }
 
 
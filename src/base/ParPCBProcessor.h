@@ -24,6 +24,7 @@ namespace Minotaur {
 
   //class Engine;
   //class Problem;
+  class Profiler;
   class Solution;
   typedef const Solution* ConstSolutionPtr;
 
@@ -107,6 +108,14 @@ namespace Minotaur {
     /// Branches found by this processor for this node
     Branches branches_;
 
+    /**
+     * Pool of this thread that the brancher uses, so that strong branching
+     * runs outside the critical section of the shared pool. It holds a copy
+     * of the best solution of the shared pool. NULL until the first
+     * branching.
+     */
+    SolutionPoolPtr brPool_;
+
     /**
      * If true, we continue to search, if engine reports error. If false,
      * we assume that the relaxation is infeasible when engine returns error.
@@ -125,6 +134,9 @@ namespace Minotaur {
     /// Status of the engine
     EngineStatus engineStatus_;
 
+    /// Environment, used to create brPool_.
+    EnvPtr env_;
+
     /// All the handlers that are used for this processor
     HandlerVector handlers_;
 
@@ -137,6 +149,9 @@ namespace Minotaur {
     /// For logging.
     static const std::string me_;
 
+    /// Profiler of the environment.
+    Profiler *prof_;
+
     /// How frequently should node-presolve be called? If 1, then call at
     /// all nodes. If 0, then never. If 4, then every fourth node, etc.
     int presFreq_;
@@ -194,8 +209,22 @@ namespace Minotaur {
     void separate_(ConstSolutionPtr sol, NodePtr node, SolutionPoolPtr s_pool, 
                      SeparationStatus *status);
 
-    // Implement NodeProcessor::tightenBounds_()
-    virtual void tightenBounds_(); 
+    /**
+     * Copy the best solution of the shared pool to brPool_, if it is better
+     * than the one there. brPool_ is created if needed.
+     */
+    void syncBrPool_(SolutionPoolPtr s_pool);
+
+    /**
+     * Call postSolveRootNode() of each handler, e.g. for OBBT, after the
+     * first solve of the root relaxation. The modifications are stored in
+     * the root node, so that every thread applies them. Only QuadHandler and
+     * kPowHandler do anything there. The handlers of QGPar keep the default
+     * of Handler, which adds no modifications.
+     */
+    virtual void tightenBounds_(NodePtr node, SolutionPoolPtr s_pool,
+                                ConstSolutionPtr sol,
+                                SeparationStatus *status);
 
   };
 
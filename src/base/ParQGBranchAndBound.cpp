@@ -24,6 +24,7 @@
 #include "Brancher.h"
 #include "Constraint.h"
 #include "CutManager.h"
+#include "CutStore.h"
 #include "Environment.h"
 #include "Function.h"
 #include "Heuristic.h"
@@ -33,6 +34,7 @@
 #include "NodeProcessor.h"
 #include "NodeRelaxer.h"
 #include "Option.h"
+#include "Profiler.h"
 #include "ParCutMan.h"
 #include "ParPCBProcessor.h"
 #include "ParQGBranchAndBound.h"
@@ -55,7 +57,8 @@ using namespace Minotaur;
 const std::string ParQGBranchAndBound::me_ = "ParQGBranchAndBound: ";
 
 ParQGBranchAndBound::ParQGBranchAndBound()
-  : env_(0),
+  : cutStore_(0),
+    env_(0),
     nodePrcssr_(),
     nodeRlxr_(0),
     options_(0),
@@ -70,7 +73,8 @@ ParQGBranchAndBound::ParQGBranchAndBound()
 
 
 ParQGBranchAndBound::ParQGBranchAndBound(EnvPtr env, ProblemPtr p)
-  : env_(env),
+  : cutStore_(0),
+  env_(env),
   nodePrcssr_(0),
   nodeRlxr_(0),
   problem_(p),
@@ -80,6 +84,7 @@ ParQGBranchAndBound::ParQGBranchAndBound(EnvPtr env, ProblemPtr p)
 {
   timer_ = env->getNewTimer();
   tm_ = (ParTreeManagerPtr) new ParTreeManager(env);
+  cutStore_ = (CutStorePtr) new CutStore();
   options_ = (ParQGBabOptionsPtr) new ParQGBabOptions(env);
   logger_ = env->getLogger();
 }
@@ -106,6 +111,9 @@ ParQGBranchAndBound::~ParQGBranchAndBound()
   if (tm_) {
     delete tm_;
   }
+  if (cutStore_) {
+    delete cutStore_;
+  }
 }
 
 
@@ -269,7 +277,6 @@ bool ParQGBranchAndBound::shouldPrune_(NodePtr node)
   case (NodeOptimal):
     should_prune = true;
 #if SPEW
-#pragma omp critical (logger)
             logger_->msgStream(LogInfo) << me_ << "prune node (NodeOptimal) "
               << node->getId() << " score "
               << (long int)node->getTbScore() << " lb " << node->getLb() << " thread "
@@ -279,7 +286,6 @@ bool ParQGBranchAndBound::shouldPrune_(NodePtr node)
   case (NodeHitUb):
     should_prune = true;
 #if SPEW
-#pragma omp critical (logger)
             logger_->msgStream(LogInfo) << me_ << "prune node (NodeHitUb) "
               << node->getId() << " score "
               << (long int)node->getTbScore() << " lb " << node->getLb() << " thread "
@@ -289,7 +295,6 @@ bool ParQGBranchAndBound::shouldPrune_(NodePtr node)
     break;
   case (NodeInfeasible):
 #if SPEW
-#pragma omp critical (logger)
             logger_->msgStream(LogInfo) << me_ << "prune node (NodeInfeasible) "
               << node->getId() << " score "
               << (long int)node->getTbScore() << " lb " << node->getLb() << " thread "
@@ -389,7 +394,15 @@ void ParQGBranchAndBound::showStatus_(bool current_uncounted)
 void ParQGBranchAndBound::showParStatus_(UInt off, double treeLb,
                                        double WallTimeStart, UInt i)
 {
+  bool show = false;
+
+  // only one thread shows the status of an interval.
+#pragma omp critical (stats)
   if (timer_->query()-stats_->updateTime > options_->logInterval) {
+    stats_->updateTime = timer_->query();
+    show = true;
+  }
+  if (show) {
     //double lb = tm_->updateLb();
     logger_->msgStream(LogInfo) 
       << me_ 
@@ -403,7 +416,6 @@ void ParQGBranchAndBound::showParStatus_(UInt off, double treeLb,
       << " left = " << tm_->getActiveNodes()+off
       << " thread " << i
       << std::endl;
-    stats_->updateTime = timer_->query();
   }
 }
 
@@ -438,7 +450,7 @@ void ParQGBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
   UInt *nodesProcTh = new UInt[numThreads];
   //UInt iterCount = 1;
   std::vector<ParCutMan*> cutman(numThreads);
-  UInt *cutsIndex = new UInt[numThreads*numThreads]();
+  UInt *cutsIndex = new UInt[numThreads]();
   UInt numVars = 0;
   bool shouldRun = true;
 
@@ -446,7 +458,9 @@ void ParQGBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
 //#pragma omp parallel for
   for(UInt i = 0; i < numThreads; ++i) {
     cutman[i] = new ParCutMan(env_, problem_);
+    cutman[i]->setCutStore(cutStore_, i);
     nodePrcssr[i]->setCutManager(cutman[i]);
+    parNodeRlxr[i]->setCutStore(cutStore_);
     should_dive[i] = false;
     dived_prev[i] = false;
     should_prune[i] = false;
@@ -484,6 +498,7 @@ void ParQGBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
 
   // call heuristics before the root, if needed
   for (HeurVector::iterator it=preHeurs_.begin(); it!=preHeurs_.end(); ++it) {
+    ProfScope ps(env_->getProfiler(), "heuristic");
     (*it)->solve(current_node[0], rel[0], solPool_);
   }
   tm_->setUb(solPool_->getBestSolutionValue());
@@ -537,12 +552,9 @@ void ParQGBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
   {
     i = omp_get_thread_num();
     //UInt nodeCountThread = nodeCount;
-    FunctionPtr f;
-    VariablePtr v;
-    LinearFunctionPtr lf, lfnew;
     ParReliabilityBrancherPtr parRelBr;
-    UIntVector tmpTimesUp, tmpTimesDown, timesUp, timesDown, lastStrBranched;
-    DoubleVector tmpPseudoUp, tmpPseudoDown, pseudoUp, pseudoDown;
+    UIntVector timesUp, timesDown, lastStrBranched;
+    DoubleVector pseudoUp, pseudoDown;
     if (isParRel) {
       timesUp.resize(numVars,0);
       timesDown.resize(numVars,0);
@@ -554,32 +566,22 @@ void ParQGBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
     //while (nodeCountThread > 0 && shouldRun)
     while (nodeCountTh[i] > 0 && shouldRun) {
       if (current_node[i]) {
-#pragma omp critical (treeManager)
-        {
-          if (tm_->shouldPrune_(current_node[i])) {
-            parNodeRlxr[i]->reset(current_node[i], false);
+        if (tm_->shouldPrune_(current_node[i])) {
+          parNodeRlxr[i]->reset(current_node[i], false);
 #if SPEW
-            logger_->msgStream(LogInfo) << me_ << "prune node "
-              << current_node[i]->getId() << " thread "
-              << omp_get_thread_num() << std::endl;
+          logger_->msgStream(LogInfo) << me_ << "prune node "
+            << current_node[i]->getId() << " thread "
+            << omp_get_thread_num() << std::endl;
 #endif
-            tm_->pruneNode(current_node[i]);
+          tm_->pruneNode(current_node[i]);
 #pragma omp critical (current_node)
-            current_node[i] = NodePtr();
-          }
+          current_node[i] = NodePtr();
         }
       } else {
-#pragma omp critical (treeManager)
-        {
-          current_node[i] = tm_->getCandidate();
-          if (current_node[i]) {
-            tm_->removeActiveNode(current_node[i]);
-          }
-        }
+        current_node[i] = tm_->takeCandidate();
         if (current_node[i]) {
           nodesProcTh[i]++;
 #if SPEW
-#pragma omp critical (logger)
           logger_->msgStream(LogDebug) << me_ << "get node "
             << current_node[i]->getId() << " thread "
             << omp_get_thread_num() << std::endl;
@@ -589,7 +591,6 @@ void ParQGBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
       }
       if (current_node[i]) {
 #if SPEW
-#pragma omp critical (logger)
         logger_->msgStream(LogInfo) << me_ << "process node "
           << current_node[i]->getId() << " thread " << omp_get_thread_num() << std::endl;
           //<< me_ << "depth = " << current_node[i]->getDepth() << std::endl
@@ -600,36 +601,19 @@ void ParQGBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
         rel[i] = parNodeRlxr[i]->createNodeRelaxation(current_node[i],
                                                       dived_prev[i],
                                                       should_prune[i]);
-        // CAUTION: if parRel branching is not used, cuts are also not shared.
-        // Sharing pseudocosts must be separated from sharing cuts.
+        // add the cuts of other threads that were stored after the last node
+        // of this thread.
+        cutStore_->addNewToRel(rel[i], i, &cutsIndex[i]);
+        // CAUTION: if parRel branching is not used, pseudocosts are also not
+        // shared.
         for(UInt j = 0; j < numThreads; ++j) {
           if (i!=j) {
-            std::vector<ConstraintPtr > consVec = nodePrcssr[j]->getCutManager()->getPoolCons();
-            if (consVec.size() > 0) {
-              for (UInt k=cutsIndex[i*numThreads+j]; k < consVec.size(); ++k) {
-                lf = consVec[k]->getLinearFunction();
-                if (lf) {
-                  lfnew = (LinearFunctionPtr) new LinearFunction();
-                  for (VariableGroupConstIterator it=lf->termsBegin(); it!=lf->termsEnd();++it) {
-                    v = it->first;
-                    //transform the cut
-                    lfnew->addTerm(rel[i]->getRelaxationVar(rel[i]->getOriginalVar(v)),it->second); //rel[j] not needed
-                  }
-                  f = (FunctionPtr) new Function(lfnew);
-                  rel[i]->newConstraint(f, consVec[k]->getLb(),
-                                        consVec[k]->getUb(), consVec[k]->getName());
-                }
-              }
-              cutsIndex[i*numThreads+j] = consVec.size();
-              consVec.clear();
-            }
-        
             if (isParRel) {
               parRelBr = dynamic_cast <ParReliabilityBrancher*> (nodePrcssr[j]->getBrancher());
-              tmpTimesUp = parRelBr->getTimesUp();
-              tmpTimesDown = parRelBr->getTimesDown();
-              tmpPseudoUp = parRelBr->getPCUp();
-              tmpPseudoDown = parRelBr->getPCDown();
+              const UIntVector &tmpTimesUp = parRelBr->getTimesUp();
+              const UIntVector &tmpTimesDown = parRelBr->getTimesDown();
+              const DoubleVector &tmpPseudoUp = parRelBr->getPCUp();
+              const DoubleVector &tmpPseudoDown = parRelBr->getPCDown();
               for (UInt l=0; l < tmpTimesDown.size(); ++l) {
                 timesUp[l] += tmpTimesUp[l];
                 timesDown[l] += tmpTimesDown[l];
@@ -648,55 +632,39 @@ void ParQGBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
         }
 
 #if SPEW
-#pragma omp critical (logger)
         logger_->msgStream(LogDebug1) << me_ << "node "
           << current_node[i]->getId() << " lower bound = "
           << current_node[i]->getLb() << " thread "
           << omp_get_thread_num() << std::endl;
 #endif
         if (nodePrcssr[i]->foundNewSolution()) {
-#pragma omp critical (treeManager)
-          {
-            tm_->setUb(solPool_->getBestSolutionValue());
-          }
+          tm_->setUb(solPool_->getBestSolutionValue());
         }
         should_prune[i] = shouldPrune_(current_node[i]);
 
         if (should_prune[i]) {
 #if SPEW
-#pragma omp critical (logger)
           logger_->msgStream(LogInfo) << me_ << "prune node "
             << current_node[i]->getId() << " thread "
             << omp_get_thread_num() << std::endl;
 #endif
           parNodeRlxr[i]->reset(current_node[i], false);
-#pragma omp critical (treeManager)
-          {
-            tm_->pruneNode(current_node[i]);
-          }
+          tm_->pruneNode(current_node[i]);
 #pragma omp critical (current_node)
           current_node[i] = NodePtr();
-#pragma omp critical (treeManager)
-          {
-            new_node[i] = tm_->getCandidate();
-            if (new_node[i]) {
-              //getting and removing node must be in the same critical
-              //block otherwise some other thread might take the same node
-              tm_->removeActiveNode(new_node[i]);
-              nodesProcTh[i]++;
+          new_node[i] = tm_->takeCandidate();
+          if (new_node[i]) {
+            nodesProcTh[i]++;
 #if SPEW
-#pragma omp critical (logger)
-              logger_->msgStream(LogDebug) << me_ << "get node "
-                << new_node[i]->getId() << " (prune) thread "
-                << omp_get_thread_num() << std::endl;
+            logger_->msgStream(LogDebug) << me_ << "get node "
+              << new_node[i]->getId() << " (prune) thread "
+              << omp_get_thread_num() << std::endl;
 #endif
-            }
           }
           dived_prev[i] = false;
         } else {
           initialized[i] = true;
 #if SPEW
-#pragma omp critical (logger)
           logger_->msgStream(LogDebug) << me_ << "branch at node "
             << current_node[i]->getId() << " thread "
             << omp_get_thread_num() << std::endl;
@@ -709,39 +677,30 @@ void ParQGBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
           if (!branches[i]) {
             logger_->msgStream(LogDebug) << " NO BRANCHES \n";
           }
-#pragma omp critical (treeManager)
-          {
 #pragma omp critical (current_node)
-            new_node[i] = tm_->branch(branches[i], current_node[i], ws[i]);
+          new_node[i] = tm_->branch(branches[i], current_node[i], ws[i]);
 #if SPEW
-#pragma omp critical (logger)
-            logger_->msgStream(LogDebug) << me_ << "get node "
-              << new_node[i]->getId() << " (branch) thread " << omp_get_thread_num()
-              << std::endl;
+          logger_->msgStream(LogDebug) << me_ << "get node "
+            << new_node[i]->getId() << " (branch) thread " << omp_get_thread_num()
+            << std::endl;
 #endif
-          }
           assert((should_dive[i] && new_node[i])
                  || (!should_dive[i] && !new_node[i]));
           if (should_dive[i]) {
             dived_prev[i] = true;
           } else {
             parNodeRlxr[i]->reset(current_node[i], false);
-#pragma omp critical (treeManager)
-            {
-              new_node[i] = tm_->getCandidate(); // Can be NULL. The
-              // branches that were created could have large lb and tm
-              // might have eliminated them.
-              if (new_node[i]) {
-                tm_->removeActiveNode(new_node[i]);
+            new_node[i] = tm_->takeCandidate(); // Can be NULL. The
+            // branches that were created could have large lb and tm
+            // might have eliminated them.
+            if (new_node[i]) {
 #if SPEW
-#pragma omp critical (logger)
-                logger_->msgStream(LogDebug) << me_ << "get/remove node "
-                  << new_node[i]->getId() << " thread "
-                  << omp_get_thread_num() << std::endl;
+              logger_->msgStream(LogDebug) << me_ << "get/remove node "
+                << new_node[i]->getId() << " thread "
+                << omp_get_thread_num() << std::endl;
 #endif
-              }
-              dived_prev[i] = false;
             }
+            dived_prev[i] = false;
           }
         }
 #pragma omp critical (current_node)
@@ -749,10 +708,7 @@ void ParQGBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
       } // if (current_node[i]) ends
 
       //update lower bound
-#pragma omp critical (treeManager)
-      {
-        treeLbTh[i] = tm_->updateLb();
-      }
+      treeLbTh[i] = tm_->updateLb();
       minNodeLbTh[i] = INFINITY;
       for (UInt j=0; j < numThreads; ++j) {
 #pragma omp critical (current_node)
@@ -781,15 +737,9 @@ void ParQGBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
           }
         }
       }
-#pragma omp critical (logger)
-      {
-        showParStatus_(nodeCountTh[i], treeLbTh[i], wallTimeStart, i);
-      }
+      showParStatus_(nodeCountTh[i], treeLbTh[i], wallTimeStart, i);
       if (shouldStopPar_(wallTimeStart, treeLbTh[i])) {
-#pragma omp critical (treeManager)
-        {
-          tm_->updateLb();
-        }
+        tm_->updateLb();
       }
       // update stopping conditions
       if (nodeCountTh[i] == 0) {
@@ -819,7 +769,6 @@ void ParQGBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
         ////shouldRun = false;
       } else {
 #if SPEW
-#pragma omp critical (logger)
         //logger_->msgStream(LogInfo) << "nodesCount " << nodeCountThread << " thread " << i << std::endl;
         logger_->msgStream(LogDebug) << std::setprecision(8)
           << me_ << "lb = " << tm_->updateLb() << std::endl
@@ -854,6 +803,10 @@ void ParQGBranchAndBound::parsolveOppor(ParNodeIncRelaxerPtr parNodeRlxr[],
   delete[] dived_prev;
   delete[] should_prune;
   delete[] initialized;
+  // undo the modifications that are still applied to the relaxations.
+  for (UInt k = 0; k < numThreads; ++k) {
+    parNodeRlxr[k]->reset(NodePtr(), false);
+  }
   for (UInt j=0; j < numThreads; j++) {
     if (current_node[j]) {
       delete current_node[j]; current_node[j] = 0;
@@ -906,7 +859,7 @@ void ParQGBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
   std::vector<ParCutMan*> cutman(numThreads);
   //bool iterMode = env_->getOptions()->findBool("mcbnb_iter_mode")->getValue();
   UInt iterCount = 1;
-  UInt *cutsIndex = new UInt[numThreads*numThreads]();
+  UInt *cutsIndex = new UInt[numThreads]();
   UInt numVars = 0;
 
   //Time taken and nodes solved by each thread
@@ -921,7 +874,9 @@ void ParQGBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
   for(UInt i = 0; i < numThreads; ++i) {
     // declare cut manager
     cutman[i] = new ParCutMan(env_, problem_);
+    cutman[i]->setCutStore(cutStore_, i);
     nodePrcssr[i]->setCutManager(cutman[i]);
+    parNodeRlxr[i]->setCutStore(cutStore_);
     should_dive[i] = false;
     dived_prev[i] = false;
     should_prune[i] = false;
@@ -961,6 +916,7 @@ void ParQGBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
   rel[0] = parNodeRlxr[0]->getRelaxation();
   // call heuristics before the root, if needed
   for (HeurVector::iterator it=preHeurs_.begin(); it!=preHeurs_.end(); ++it) {
+    ProfScope ps(env_->getProfiler(), "heuristic");
     (*it)->solve(current_node[0], rel[0], solPool_);
   }
   tm_->setUb(solPool_->getBestSolutionValue());
@@ -1024,13 +980,10 @@ void ParQGBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
 #pragma omp for
       for(UInt i = 0; i < numThreads; ++i) {
         sTimeTh[i] = omp_get_wtime();
-        FunctionPtr f;
-        VariablePtr v;
-        LinearFunctionPtr lf, lfnew;
         //brancher related
         ParReliabilityBrancherPtr parRelBr;
-        UIntVector tmpTimesUp, tmpTimesDown, timesUp, timesDown, lastStrBranched;
-        DoubleVector tmpPseudoUp, tmpPseudoDown, pseudoUp, pseudoDown;
+        UIntVector timesUp, timesDown, lastStrBranched;
+        DoubleVector pseudoUp, pseudoDown;
         if (isParRel) {
           timesUp.resize(numVars,0);
           timesDown.resize(numVars,0);
@@ -1039,32 +992,22 @@ void ParQGBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
           lastStrBranched.resize(numVars,0);
         }
         if (current_node[i]) {
-#pragma omp critical (treeManager)
-          {
-            if (tm_->shouldPrune_(current_node[i])) {
-              parNodeRlxr[i]->reset(current_node[i], false);
+          if (tm_->shouldPrune_(current_node[i])) {
+            parNodeRlxr[i]->reset(current_node[i], false);
 #if SPEW
-              logger_->msgStream(LogInfo) << me_ << "prune node "
-                << current_node[i]->getId() << " thread "
-                << omp_get_thread_num() << std::endl;
+            logger_->msgStream(LogInfo) << me_ << "prune node "
+              << current_node[i]->getId() << " thread "
+              << omp_get_thread_num() << std::endl;
 #endif
-              tm_->pruneNode(current_node[i]);
-              current_node[i] = NodePtr();
-            }
+            tm_->pruneNode(current_node[i]);
+            current_node[i] = NodePtr();
           }
         } else {
-#pragma omp critical (treeManager)
-          {
-            current_node[i] = tm_->getCandidate();
-            if(current_node[i]) {
-              tm_->removeActiveNode(current_node[i]);
-            }
-          }
+          current_node[i] = tm_->takeCandidate();
           dived_prev[i] = false;
         }
         if (current_node[i]) {
 #if SPEW
-#pragma omp critical (logger)
           logger_->msgStream(LogInfo) << me_ << "process node "
             << current_node[i]->getId() << " thread " << omp_get_thread_num() << std::endl
             << me_ << "depth = " << current_node[i]->getDepth() << std::endl
@@ -1075,36 +1018,19 @@ void ParQGBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
           rel[i] = parNodeRlxr[i]->createNodeRelaxation(current_node[i],
                                                         dived_prev[i],
                                                         should_prune[i]);
-          // CAUTION: if parRel branching is not used, cuts are also not shared.
-          // Sharing pseudocosts must be separated from sharing cuts.
+          // add the cuts of other threads that were stored after the last node
+          // of this thread.
+          cutStore_->addNewToRel(rel[i], i, &cutsIndex[i]);
+          // CAUTION: if parRel branching is not used, pseudocosts are also not
+          // shared.
           for(UInt j = 0; j < numThreads; ++j) {
             if (i!=j) {
-              std::vector<ConstraintPtr > consVec = nodePrcssr[j]->getCutManager()->getPoolCons();
-              if (consVec.size() > 0) {
-                for (UInt k=cutsIndex[i*numThreads+j]; k < consVec.size(); ++k) {
-                  lf = consVec[k]->getLinearFunction();
-                  if (lf) {
-                    lfnew = (LinearFunctionPtr) new LinearFunction();
-                    for (VariableGroupConstIterator it=lf->termsBegin(); it!=lf->termsEnd();++it) {
-                      v = it->first;
-                      //transform the cut
-                      lfnew->addTerm(rel[i]->getRelaxationVar(rel[i]->getOriginalVar(v)),it->second); //rel[j] not needed
-                    }
-                    f = (FunctionPtr) new Function(lfnew);
-                    rel[i]->newConstraint(f, consVec[k]->getLb(),
-                                          consVec[k]->getUb(), consVec[k]->getName());
-                  }
-                }
-                cutsIndex[i*numThreads+j] = consVec.size();
-                consVec.clear();
-              }
-          
               if (isParRel) {
                 parRelBr = dynamic_cast <ParReliabilityBrancher*> (nodePrcssr[j]->getBrancher());
-                tmpTimesUp = parRelBr->getTimesUp();
-                tmpTimesDown = parRelBr->getTimesDown();
-                tmpPseudoUp = parRelBr->getPCUp();
-                tmpPseudoDown = parRelBr->getPCDown();
+                const UIntVector &tmpTimesUp = parRelBr->getTimesUp();
+                const UIntVector &tmpTimesDown = parRelBr->getTimesDown();
+                const DoubleVector &tmpPseudoUp = parRelBr->getPCUp();
+                const DoubleVector &tmpPseudoDown = parRelBr->getPCDown();
                 for (UInt l=0; l < tmpTimesDown.size(); ++l) {
                   timesUp[l] += tmpTimesUp[l];
                   timesDown[l] += tmpTimesDown[l];
@@ -1124,52 +1050,36 @@ void ParQGBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
           }
 
 #if SPEW
-#pragma omp critical (logger)
           logger_->msgStream(LogDebug1) << me_ << "node lower bound = " <<
             current_node[i]->getLb() << current_node[i]->getId() << " thread "
             << omp_get_thread_num()<< std::endl;
 #endif
           if (nodePrcssr[i]->foundNewSolution()) {
-#pragma omp critical (treeManager)
-            {
-              tm_->setUb(solPool_->getBestSolutionValue());
-            }
+            tm_->setUb(solPool_->getBestSolutionValue());
           }
           should_prune[i] = shouldPrune_(current_node[i]);
 
           if (should_prune[i]) {
 #if SPEW
-#pragma omp critical (logger)
             logger_->msgStream(LogInfo) << me_ << "prune node "
               << current_node[i]->getId() << " thread "
               << omp_get_thread_num() << std::endl;
 #endif
             parNodeRlxr[i]->reset(current_node[i], false);
-#pragma omp critical (treeManager)
-            {
-              tm_->pruneNode(current_node[i]);
-            }
+            tm_->pruneNode(current_node[i]);
             current_node[i] = NodePtr();
-#pragma omp critical (treeManager)
-            {
-              new_node[i] = tm_->getCandidate();
-              if (new_node[i]) {
+            new_node[i] = tm_->takeCandidate();
+            if (new_node[i]) {
 #if SPEW
-#pragma omp critical (logger)
-                logger_->msgStream(LogDebug) << me_ << "get node (prune) "
-                  << new_node[i]->getId() << " thread "
-                  << omp_get_thread_num() << std::endl;
+              logger_->msgStream(LogDebug) << me_ << "get node (prune) "
+                << new_node[i]->getId() << " thread "
+                << omp_get_thread_num() << std::endl;
 #endif
-                //getting and removing node must be in the same critical
-                //block otherwise some other thread might take the same node
-                tm_->removeActiveNode(new_node[i]);
-              }
             }
             dived_prev[i] = false;
           } else {
             initialized[i] = true;
 #if SPEW
-#pragma omp critical (logger)
             logger_->msgStream(LogDebug) << me_ << "branch at node "
               << current_node[i]->getId() << " thread "
               << omp_get_thread_num() << std::endl;
@@ -1182,38 +1092,29 @@ void ParQGBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
             if (!branches[i]) {
               logger_->msgStream(LogDebug) << " NO BRANCHES \n";
             }
-#pragma omp critical (treeManager)
-            {
-              new_node[i] = tm_->branch(branches[i], current_node[i], ws[i]);
+            new_node[i] = tm_->branch(branches[i], current_node[i], ws[i]);
 #if SPEW
-#pragma omp critical (logger)
-              logger_->msgStream(LogDebug) << me_ << "get node (branch) "
-                << new_node[i]->getId() << " thread " << omp_get_thread_num()
-                << std::endl;
+            logger_->msgStream(LogDebug) << me_ << "get node (branch) "
+              << new_node[i]->getId() << " thread " << omp_get_thread_num()
+              << std::endl;
 #endif
-            }
             assert((should_dive[i] && new_node[i])
                    || (!should_dive[i] && !new_node[i]));
             if (should_dive[i]) {
               dived_prev[i] = true;
             } else {
               parNodeRlxr[i]->reset(current_node[i], false);
-#pragma omp critical (treeManager)
-              {
-                new_node[i] = tm_->getCandidate(); // Can be NULL. The
-                // branches that were created could have large lb and tm
-                // might have eliminated them.
-                if (new_node[i]) {
-                  tm_->removeActiveNode(new_node[i]);
+              new_node[i] = tm_->takeCandidate(); // Can be NULL. The
+              // branches that were created could have large lb and tm
+              // might have eliminated them.
+              if (new_node[i]) {
 #if SPEW
-#pragma omp critical (logger)
-                  logger_->msgStream(LogDebug) << me_ << "get/remove node "
-                    << new_node[i]->getId() << " thread "
-                    << omp_get_thread_num() << std::endl;
+                logger_->msgStream(LogDebug) << me_ << "get/remove node "
+                  << new_node[i]->getId() << " thread "
+                  << omp_get_thread_num() << std::endl;
 #endif
-                }
-                dived_prev[i] = false;
               }
+              dived_prev[i] = false;
             }
           }
           current_node[i] = new_node[i];
@@ -1228,10 +1129,7 @@ void ParQGBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
         sTimeTh[i] = omp_get_wtime();
         //stopping condition at each thread
         nodeCountTh[i] = 0;
-#pragma omp critical (treeManager)
-        {
-          treeLbTh[i] = tm_->updateLb();
-        }
+        treeLbTh[i] = tm_->updateLb();
         minNodeLbTh[i] = INFINITY;
 
         for (UInt j=0; j < numThreads; ++j) {
@@ -1248,15 +1146,9 @@ void ParQGBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
         if (minNodeLbTh[i] < treeLbTh[i]) {
           treeLbTh[i] = minNodeLbTh[i];
         }
-#pragma omp critical (logger)
-        {
-          showParStatus_(nodeCountTh[i], treeLbTh[i], wallTimeStart, i);
-        }
+        showParStatus_(nodeCountTh[i], treeLbTh[i], wallTimeStart, i);
         if (shouldStopPar_(wallTimeStart, treeLbTh[i])) {
-#pragma omp critical (treeManager)
-          {
-            tm_->updateLb();
-          }
+          tm_->updateLb();
           shouldRunTh[i] = false;
         }
         wTimeTh[i] += omp_get_wtime() - sTimeTh[i];
@@ -1298,7 +1190,6 @@ void ParQGBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
             status_ = SolvedInfeasible; // TODO: get the right status
           }
 #if SPEW
-#pragma omp critical (logger)
           logger_->msgStream(LogDebug) << me_ << "all nodes have "
             << "been processed" << std::endl;
 #endif
@@ -1308,14 +1199,12 @@ void ParQGBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
         } else if (notRampedUp && (nodeCount == numThreads)) {
           tm_->updateLb();
           notRampedUp = false;
-#pragma omp critical (logger)
           logger_->msgStream(LogExtraInfo) << me_
             << "ramp-up time = "
             << getWallTime() - wallTimeStart << std::endl;
           //shouldRun = false;
         } else {
 #if SPEW
-#pragma omp critical (logger)
           logger_->msgStream(LogDebug) << std::setprecision(8)
             << me_ << "lb = " << tm_->updateLb() << std::endl 
             << me_ << "ub = " << tm_->getUb() << std::endl;
@@ -1355,6 +1244,10 @@ void ParQGBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
   delete[] dived_prev;
   delete[] should_prune;
   delete[] initialized;
+  // undo the modifications that are still applied to the relaxations.
+  for (UInt k = 0; k < numThreads; ++k) {
+    parNodeRlxr[k]->reset(NodePtr(), false);
+  }
   delete[] current_node;
   delete[] new_node;
   delete[] nodeCountTh;
@@ -1407,7 +1300,9 @@ void ParQGBranchAndBound::parsolveSync(ParNodeIncRelaxerPtr parNodeRlxr[],
   for(UInt i = 0; i < numThreads; ++i) {
     // declare cut manager
     cutman[i] = new ParCutMan(env_, problem_);
+    cutman[i]->setCutStore(cutStore_, i);
     nodePrcssr[i]->setCutManager(cutman[i]);
+    parNodeRlxr[i]->setCutStore(cutStore_);
     should_dive[i] = false;
     dived_prev[i] = false;
     should_prune[i] = false;
@@ -1447,6 +1342,7 @@ void ParQGBranchAndBound::parsolveSync(ParNodeIncRelaxerPtr parNodeRlxr[],
   numRelCons = rel[0]->getNumCons();
   // call heuristics before the root, if needed
   for (HeurVector::iterator it=preHeurs_.begin(); it!=preHeurs_.end(); ++it) {
+    ProfScope ps(env_->getProfiler(), "heuristic");
     (*it)->solve(current_node[0], rel[0], solPool_);
   }
   tm_->setUb(solPool_->getBestSolutionValue());
@@ -1504,36 +1400,28 @@ void ParQGBranchAndBound::parsolveSync(ParNodeIncRelaxerPtr parNodeRlxr[],
 #pragma omp for
       for(UInt i = 0; i < numThreads; ++i) {
         if (current_node[i]) {
-#pragma omp critical (treeManager)
-          {
-            if (tm_->shouldPrune_(current_node[i])) {
-              parNodeRlxr[i]->reset(current_node[i], false);
-              removeAddedCons(rel[i], numRelCons);
+          if (tm_->shouldPrune_(current_node[i])) {
+            parNodeRlxr[i]->reset(current_node[i], false);
+            removeAddedCons(rel[i], numRelCons);
 #if SPEW
-              logger_->msgStream(LogInfo) << me_ << "prune node "
-                << current_node[i]->getId() << " thread "
-                << omp_get_thread_num() << std::endl;
+            logger_->msgStream(LogInfo) << me_ << "prune node "
+              << current_node[i]->getId() << " thread "
+              << omp_get_thread_num() << std::endl;
 #endif
-              tm_->pruneNode(current_node[i]);
-              current_node[i] = NodePtr();
-            }
+            tm_->pruneNode(current_node[i]);
+            current_node[i] = NodePtr();
           }
         } else {
-#pragma omp critical (treeManager)
-          {
-            current_node[i] = tm_->getCandidate();
-            if (current_node[i]) {
+          current_node[i] = tm_->takeCandidate();
+          if (current_node[i]) {
 #if SPEW
-#pragma omp critical (logger)
-            logger_->msgStream(LogInfo) << "assign node "
-              << current_node[i]->getId() << " score "
-              << (long int)current_node[i]->getTbScore() << " lb "
-              << std::setprecision(9) << current_node[i]->getLb() << " thread "
-              << omp_get_thread_num() << std::endl;
+          logger_->msgStream(LogInfo) << "assign node "
+            << current_node[i]->getId() << " score "
+            << (long int)current_node[i]->getTbScore() << " lb "
+            << std::setprecision(9) << current_node[i]->getLb() << " thread "
+            << omp_get_thread_num() << std::endl;
 #endif
-              tm_->removeActiveNode(current_node[i]);
 
-            }
           }
           dived_prev[i] = false;
         }
@@ -1556,7 +1444,6 @@ void ParQGBranchAndBound::parsolveSync(ParNodeIncRelaxerPtr parNodeRlxr[],
                                                         dived_prev[i],
                                                         should_prune[i]);
 #if SPEW
-#pragma omp critical (logger)
           logger_->msgStream(LogInfo) << me_ << "process node "
             << current_node[i]->getId() << " score "
             << (long int)current_node[i]->getTbScore() << " lb "
@@ -1602,7 +1489,6 @@ void ParQGBranchAndBound::parsolveSync(ParNodeIncRelaxerPtr parNodeRlxr[],
         if (current_node[i]) {
           if (should_prune[i]) {
 #if SPEW
-#pragma omp critical (logger)
             logger_->msgStream(LogInfo) << me_ << "prune node "
               << current_node[i]->getId() << " score "
               << (long int)current_node[i]->getTbScore() << std::setprecision(9)
@@ -1612,12 +1498,9 @@ void ParQGBranchAndBound::parsolveSync(ParNodeIncRelaxerPtr parNodeRlxr[],
             parNodeRlxr[i]->reset(current_node[i], false);
             removeAddedCons(rel[i], numRelCons);
 
-#pragma omp critical (treeManager)
-            {
-              tm_->pruneNode(current_node[i]);
-              new_node[i] = NodePtr();
-              //current_node[i] = NodePtr();
-            }
+            tm_->pruneNode(current_node[i]);
+            new_node[i] = NodePtr();
+            //current_node[i] = NodePtr();
             dived_prev[i] = false;
 //#pragma omp critical (treeManager)
             //{
@@ -1631,7 +1514,6 @@ void ParQGBranchAndBound::parsolveSync(ParNodeIncRelaxerPtr parNodeRlxr[],
           } else {
             initialized[i] = true;
 #if SPEW
-#pragma omp critical (logger)
             logger_->msgStream(LogInfo) << me_ << "branch at node "
               << current_node[i]->getId() << " score "
               << (long int)current_node[i]->getTbScore() << std::setprecision(9)
@@ -1644,18 +1526,14 @@ void ParQGBranchAndBound::parsolveSync(ParNodeIncRelaxerPtr parNodeRlxr[],
             ws[i] = nodePrcssr[i]->getWarmStart();
             should_dive[i] = tm_->shouldDive();
             assert(branches[i]);
-#pragma omp critical (treeManager)
-            {
-              new_node[i] = tm_->branch(branches[i], current_node[i], ws[i]);
+            new_node[i] = tm_->branch(branches[i], current_node[i], ws[i]);
 #if SPEW
-#pragma omp critical (logger)
-              logger_->msgStream(LogInfo) << me_ << "get node "
-                << new_node[i]->getId() << " score "
-                << (long int)new_node[i]->getTbScore() << std::setprecision(9)
-                << " lb " << new_node[i]->getLb() << " (branch) thread "
-                << omp_get_thread_num() << std::endl;
+            logger_->msgStream(LogInfo) << me_ << "get node "
+              << new_node[i]->getId() << " score "
+              << (long int)new_node[i]->getTbScore() << std::setprecision(9)
+              << " lb " << new_node[i]->getLb() << " (branch) thread "
+              << omp_get_thread_num() << std::endl;
 #endif
-            }
             assert((should_dive[i] && new_node[i])
                    || (!should_dive[i] && !new_node[i]));
             if (should_dive[i]) {
@@ -1663,22 +1541,17 @@ void ParQGBranchAndBound::parsolveSync(ParNodeIncRelaxerPtr parNodeRlxr[],
             } else {
               parNodeRlxr[i]->reset(current_node[i], false);
               removeAddedCons(rel[i], numRelCons);
-#pragma omp critical (treeManager)
-              {
-                new_node[i] = tm_->getCandidate(); // Can be NULL. The
-                // branches that were created could have large lb and tm
-                // might have eliminated them.
-                if (new_node[i]) {
-                  tm_->removeActiveNode(new_node[i]);
+              new_node[i] = tm_->takeCandidate(); // Can be NULL. The
+              // branches that were created could have large lb and tm
+              // might have eliminated them.
+              if (new_node[i]) {
 #if SPEW
-#pragma omp critical (logger)
               logger_->msgStream(LogInfo) << me_ << "get node "
-                << new_node[i]->getId() << " score "
-                << (long int)new_node[i]->getTbScore() << " lb " <<
-                current_node[i]->getLb() << " (prune) thread "
-                << omp_get_thread_num() << std::endl;
+              << new_node[i]->getId() << " score "
+              << (long int)new_node[i]->getTbScore() << " lb " <<
+              current_node[i]->getLb() << " (prune) thread "
+              << omp_get_thread_num() << std::endl;
 #endif
-                }
               }
               dived_prev[i] = false;
             }
@@ -1718,7 +1591,6 @@ void ParQGBranchAndBound::parsolveSync(ParNodeIncRelaxerPtr parNodeRlxr[],
             status_ = SolvedInfeasible; // TODO: get the right status
           }
 #if SPEW
-#pragma omp critical (logger)
           logger_->msgStream(LogDebug) << me_ << "all nodes have "
             << "been processed" << std::endl;
 #endif
@@ -1727,7 +1599,6 @@ void ParQGBranchAndBound::parsolveSync(ParNodeIncRelaxerPtr parNodeRlxr[],
           shouldRun = false;
         } else {
 #if SPEW
-#pragma omp critical (logger)
           logger_->msgStream(LogDebug) << std::setprecision(8)
             << me_ << "lb = " << tm_->updateLb() << std::endl
             << me_ << "ub = " << tm_->getUb() << std::endl;
@@ -1750,6 +1621,10 @@ void ParQGBranchAndBound::parsolveSync(ParNodeIncRelaxerPtr parNodeRlxr[],
   delete[] dived_prev;
   delete[] should_prune;
   delete[] initialized;
+  // undo the modifications that are still applied to the relaxations.
+  for (UInt k = 0; k < numThreads; ++k) {
+    parNodeRlxr[k]->reset(NodePtr(), false);
+  }
   delete[] current_node;
   delete[] new_node;
   delete[] nodeCountTh;
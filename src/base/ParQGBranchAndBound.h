@@ -20,6 +20,7 @@ namespace Minotaur {
 
   struct  ParQGBabOptions;
   struct  ParQGBabStats;
+  class   CutStore;
   class   Engine;
   class   NodeProcessor;
   class   NodeRelaxer;
@@ -216,6 +217,12 @@ namespace Minotaur {
     }
 
   private:
+    /**
+     * Cuts added to the pools of the cut managers of all threads. Each
+     * thread adds the cuts of other threads to its relaxation from here.
+     */
+    CutStore *cutStore_;
+
     /// Pointer to the enviroment.
     EnvPtr env_;
 
@@ -32,6 +32,7 @@
 #include "Environment.h"
 #include "Function.h"
 #include "Logger.h"
+#include "NLPCache.h"
 #include "Node.h"
 #include "NonlinearFunction.h"
 #include "Objective.h"
@@ -57,6 +58,9 @@ ParQGHandler::ParQGHandler(EnvPtr env, ProblemPtr minlp, EnginePtr nlpe)
   nlCons_(0),
   nlpe_(nlpe),
   nlpStatus_(EngineUnknownStatus),
+  nlpCache_(0),
+  nlpVal_(INFINITY),
+  nlpX_(0),
   objVar_(VariablePtr()),
   oNl_(false),
   rel_(RelaxationPtr()),
@@ -64,6 +68,7 @@ ParQGHandler::ParQGHandler(EnvPtr env, ProblemPtr minlp, EnginePtr nlpe)
   node_(0)
 {
   intTol_ = env_->getOptions()->findDouble("int_tol")->getValue();
+  linCoeffTol_ = env_->getOptions()->findDouble("conCoeff_tol");
   solAbsTol_ = env_->getOptions()->findDouble("feasAbs_tol")->getValue();
   solRelTol_ = env_->getOptions()->findDouble("feasRel_tol")->getValue();
   objATol_ = env_->getOptions()->findDouble("solAbs_tol")->getValue();
@@ -162,19 +167,14 @@ void ParQGHandler::cutIntSol_(ConstSolutionPtr sol, CutManager *cutMan,
   const double *lpx = sol->getPrimal();
   relobj_ = (sol) ? sol->getObjValue() : -INFINITY;
 
-  fixInts_(lpx);           // Fix integer variables
-#pragma omp critical (fixedNLPSolve)
-  {
-    solveNLP_();
-  }
-  unfixInts_();            // Unfix integer variables
+  solveFixedNLP_(lpx);
   
   switch(nlpStatus_) {
   case (ProvenOptimal):
   case (ProvenLocalOptimal):
     {
       ++(stats_->nlpF);
-      double nlpval = nlpe_->getSolutionValue();
+      double nlpval = nlpVal_;
 #pragma omp critical (solPool)
       {
        updateUb_(s_pool, nlpval, sol_found);
@@ -183,9 +183,8 @@ void ParQGHandler::cutIntSol_(ConstSolutionPtr sol, CutManager *cutMan,
           (nlpval != 0 && (relobj_ >= nlpval-fabs(nlpval)*objRTol_))) {
           *status = SepaPrune;
       } else {
-        const double * nlpx = nlpe_->getSolution()->getPrimal();
-        cutToObj_(nlpx, lpx, cutMan, status);
-        cutToCons_(nlpx, lpx, cutMan, status);
+        cutToObj_(nlpX_, lpx, cutMan, status);
+        cutToCons_(nlpX_, lpx, cutMan, status);
       }
     }
     break;
@@ -194,8 +193,7 @@ void ParQGHandler::cutIntSol_(ConstSolutionPtr sol, CutManager *cutMan,
   case (ProvenObjectiveCutOff):
     {
       ++(stats_->nlpI);
-      const double * nlpx = nlpe_->getSolution()->getPrimal();
-      cutToCons_(nlpx, lpx, cutMan, status);
+      cutToCons_(nlpX_, lpx, cutMan, status);
     }
     break;
   case (EngineIterationLimit):
@@ -403,8 +401,7 @@ void ParQGHandler::linearAt_(FunctionPtr f, double fval, const double *x,
   int n = rel_->getNumVars();
   double *a = new double[n];
   VariableConstIterator vbeg = rel_->varsBegin(), vend = rel_->varsEnd();
-  const double linCoeffTol =
-    env_->getOptions()->findDouble("conCoeff_tol")->getValue();
+  const double linCoeffTol = linCoeffTol_->getValue();
 
   std::fill(a, a+n, 0.);
   f->evalGradient(x, a, error);
@@ -483,10 +480,10 @@ void ParQGHandler::cutsAtLpSol_(const double *lpx, CutManager *cutman,
             CutPtr cut = (CutPtr) new Cut(minlp_->getNumVars(),f, -INFINITY,
                                           cUb-c, false,false);
             cut->setCons(newcon);
-            if (node_) {
-              node_->addCutToPool(cut, rel_);
-            }
             cutman->addCutToPool(cut);
+            if (node_ && cut->getInfo()->storeId >= 0) {
+              node_->addCutToPool(cut->getInfo()->storeId);
+            }
             return;
           } else {
             delete lf;
@@ -526,10 +523,12 @@ void ParQGHandler::cutsAtLpSol_(const double *lpx, CutManager *cutman,
                                             -1.0*c, false,false);
               cut->setCons(newcon);
               if (node_) {
-                node_->addCutToPool(cut, rel_);
                 cut->setName_(sstm.str());
               }
               cutman->addCutToPool(cut);
+              if (node_ && cut->getInfo()->storeId >= 0) {
+                node_->addCutToPool(cut->getInfo()->storeId);
+              }
             } else {
               delete lf;
               lf = 0;
@@ -573,10 +572,10 @@ void ParQGHandler::addCut_(const double *nlpx, const double *lpx,
         CutPtr cut = (CutPtr) new Cut(minlp_->getNumVars(),f, -INFINITY,
                                       cUb-c, false,false);
         cut->setCons(newcon);
-        if (node_) {
-          node_->addCutToPool(cut, rel_);
-        }
         cutman->addCutToPool(cut);
+        if (node_ && cut->getInfo()->storeId >= 0) {
+          node_->addCutToPool(cut->getInfo()->storeId);
+        }
         return;
       } else {
         delete lf;
@@ -625,10 +624,10 @@ void ParQGHandler::cutToObj_(const double *nlpx, const double *lpx,
               CutPtr cut = (CutPtr) new Cut(rel_->getNumVars(),f, -INFINITY,
                                             -1.0*c, false,false);
               cut->setCons(newcon);
-              if (node_) {
-                node_->addCutToPool(cut, rel_);
-              }
               cutman->addCutToPool(cut);
+              if (node_ && cut->getInfo()->storeId >= 0) {
+                node_->addCutToPool(cut->getInfo()->storeId);
+              }
             } else {
               delete lf;
               lf = 0;
@@ -740,6 +739,44 @@ void ParQGHandler::separate(ConstSolutionPtr sol, NodePtr node, RelaxationPtr re
 }
 
 
+void ParQGHandler::setNLPCache(NLPCache *cache)
+{
+  nlpCache_ = cache;
+}
+
+
+void ParQGHandler::solveFixedNLP_(const double *x)
+{
+  // minlp_ is not modified at the nodes, so the NLP only depends on the
+  // values of the integer variables. Other threads may have solved it.
+  if (nlpCache_) {
+    NLPCache::getKey(minlp_, x, nlpKey_);
+    if (nlpCache_->find(nlpKey_, &nlpStatus_, &nlpVal_, nlpSol_)) {
+      nlpX_ = &(nlpSol_[0]);
+      return;
+    }
+  }
+
+  fixInts_(x);           // Fix integer variables
+#pragma omp critical (fixedNLPSolve)
+  {
+    solveNLP_();
+  }
+  unfixInts_();          // Unfix integer variables
+
+  nlpX_ = 0;
+  if (NLPCache::isCacheable(nlpStatus_)) {
+    nlpVal_ = nlpe_->getSolutionValue();
+    nlpX_ = nlpe_->getSolution()->getPrimal();
+    if (nlpCache_) {
+      nlpCache_->insert(nlpKey_, nlpStatus_, nlpVal_, nlpX_,
+                        minlp_->getNumVars());
+    }
+  }
+  return;
+}
+
+
 void ParQGHandler::solveNLP_()
 {
   nlpStatus_ = nlpe_->solve();
@@ -768,8 +805,7 @@ void ParQGHandler::updateUb_(SolutionPoolPtr s_pool, double nlpval,
 
   if ((bestval - objATol_ > nlpval) ||
         (bestval != 0 && (bestval - fabs(bestval)*objRTol_ > nlpval))) {
-    const double *x = nlpe_->getSolution()->getPrimal();
-    s_pool->addSolution(x, nlpval);
+    s_pool->addSolution(nlpX_, nlpval);
     *sol_found = true;
   }
   return;
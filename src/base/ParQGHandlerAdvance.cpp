@@ -32,6 +32,7 @@
 #include "Environment.h"
 #include "Function.h"
 #include "Logger.h"
+#include "NLPCache.h"
 #include "Node.h"
 #include "NonlinearFunction.h"
 #include "Objective.h"
@@ -59,6 +60,9 @@ ParQGHandlerAdvance::ParQGHandlerAdvance(EnvPtr env, ProblemPtr minlp,
   nlCons_(0),
   nlpe_(nlpe),
   nlpStatus_(EngineUnknownStatus),
+  nlpCache_(0),
+  nlpVal_(INFINITY),
+  nlpX_(0),
   solC_(0),
   objVar_(VariablePtr()),
   oNl_(false),
@@ -73,6 +77,7 @@ ParQGHandlerAdvance::ParQGHandlerAdvance(EnvPtr env, ProblemPtr minlp,
   lastNodeId_(-1)
 {
   intTol_ = env_->getOptions()->findDouble("int_tol")->getValue();
+  linCoeffTol_ = env_->getOptions()->findDouble("conCoeff_tol");
   solAbsTol_ = env_->getOptions()->findDouble("feasAbs_tol")->getValue();
   solRelTol_ = env_->getOptions()->findDouble("feasRel_tol")->getValue();
   objAbsTol_ = env_->getOptions()->findDouble("solAbs_tol")->getValue();
@@ -198,7 +203,7 @@ void ParQGHandlerAdvance::cutIntSol_(const double *lpx, CutManager *cutMan,
   case (ProvenLocalOptimal):
     {
       ++(stats_->nlpF);
-      double nlpval = nlpe_->getSolutionValue();
+      double nlpval = nlpVal_;
 #pragma omp critical (solPool)
       {
         updateUb_(s_pool, nlpval, sol_found);
@@ -207,9 +212,8 @@ void ParQGHandlerAdvance::cutIntSol_(const double *lpx, CutManager *cutMan,
           (nlpval != 0 && (relobj_ >= nlpval-fabs(nlpval)*objRelTol_))) {
           *status = SepaPrune;
       } else {
-        const double * nlpx = nlpe_->getSolution()->getPrimal();
-        cutToObj_(nlpx, lpx, cutMan, status);
-        cutToCons_(nlpx, lpx, cutMan, status);
+        cutToObj_(nlpX_, lpx, cutMan, status);
+        cutToCons_(nlpX_, lpx, cutMan, status);
       }
     }
     break;
@@ -218,8 +222,7 @@ void ParQGHandlerAdvance::cutIntSol_(const double *lpx, CutManager *cutMan,
   case (ProvenObjectiveCutOff):
     {
       ++(stats_->nlpI);
-      const double * nlpx = nlpe_->getSolution()->getPrimal();
-      cutToCons_(nlpx, lpx, cutMan, status);
+      cutToCons_(nlpX_, lpx, cutMan, status);
     }
     break;
   case (EngineIterationLimit):
@@ -433,8 +436,7 @@ void ParQGHandlerAdvance::linearAt_(FunctionPtr f, double fval, const double *x,
   int n = rel_->getNumVars();
   double *a = new double[n];
   VariableConstIterator vbeg = rel_->varsBegin(), vend = rel_->varsEnd();
-  const double linCoeffTol =
-    env_->getOptions()->findDouble("conCoeff_tol")->getValue();
+  const double linCoeffTol = linCoeffTol_->getValue();
 
   std::fill(a, a+n, 0.);
   f->evalGradient(x, a, error);
@@ -1023,13 +1025,8 @@ void ParQGHandlerAdvance::separate(ConstSolutionPtr sol, NodePtr node, Relaxatio
 
   bool isIntFeas = isIntFeas_(x);
   if (isIntFeas) {
-    fixInts_(x);            // Fix integer variables
     relobj_ = (sol) ? sol->getObjValue() : -INFINITY;
-# pragma omp critical (fixedNLPSolve)
-    {
-      solveNLP_();            // solve fixed NLP
-    }
-    unfixInts_();            // Unfix integer variables
+    solveFixedNLP_(x);
     cutIntSol_(x, cutMan, s_pool, sol_found, status);
   } else {
      if (maxVioPer_) {
@@ -1385,6 +1382,44 @@ void ParQGHandlerAdvance::ECPTypeCut_(const double *lpx, CutManager *cutman, Con
 }
 
 
+void ParQGHandlerAdvance::setNLPCache(NLPCache *cache)
+{
+  nlpCache_ = cache;
+}
+
+
+void ParQGHandlerAdvance::solveFixedNLP_(const double *x)
+{
+  // minlp_ is not modified at the nodes, so the NLP only depends on the
+  // values of the integer variables. Other threads may have solved it.
+  if (nlpCache_) {
+    NLPCache::getKey(minlp_, x, nlpKey_);
+    if (nlpCache_->find(nlpKey_, &nlpStatus_, &nlpVal_, nlpSol_)) {
+      nlpX_ = &(nlpSol_[0]);
+      return;
+    }
+  }
+
+  fixInts_(x);            // Fix integer variables
+# pragma omp critical (fixedNLPSolve)
+  {
+    solveNLP_();            // solve fixed NLP
+  }
+  unfixInts_();            // Unfix integer variables
+
+  nlpX_ = 0;
+  if (NLPCache::isCacheable(nlpStatus_)) {
+    nlpVal_ = nlpe_->getSolutionValue();
+    nlpX_ = nlpe_->getSolution()->getPrimal();
+    if (nlpCache_) {
+      nlpCache_->insert(nlpKey_, nlpStatus_, nlpVal_, nlpX_,
+                        minlp_->getNumVars());
+    }
+  }
+  return;
+}
+
+
 void ParQGHandlerAdvance::solveNLP_()
 {
   nlpStatus_ = nlpe_->solve();
@@ -1412,11 +1447,12 @@ void ParQGHandlerAdvance::updateUb_(SolutionPoolPtr s_pool, double nlpval,
   double bestval = s_pool->getBestSolutionValue();
   if ((bestval - objAbsTol_ > nlpval) ||
         (bestval != 0 && (bestval - fabs(bestval)*objRelTol_ > nlpval))) {
-    const double *x = nlpe_->getSolution()->getPrimal();
-    s_pool->addSolution(x, nlpval);
+    s_pool->addSolution(nlpX_, nlpval);
     *sol_found = true;
 
-    if ((maxVioPer_ > 0) && (nlCons_.size() > 0)) {
+    // duals are not cached, they are known only if the NLP was solved.
+    if ((maxVioPer_ > 0) && (nlCons_.size() > 0) &&
+        nlpX_ != nlpSol_.data()) {
       dualBasedCons_(nlpe_->getSolution());
     }
   }
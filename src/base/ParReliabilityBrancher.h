@@ -69,7 +69,7 @@ public:
   UInt getIterLim();
 
   /// Return the vector of last strong branching information of candidates.
-  UIntVector getLastStrBranched() {return lastStrBranched_;}
+  const UIntVector& getLastStrBranched() const {return lastStrBranched_;}
 
   // base class function.
   std::string getName() const;
@@ -78,25 +78,25 @@ public:
    * Return the vector of pseudocosts of up-branchings upto this node in
    * the parental chain (direct ancestors only).
    */
-  DoubleVector getPCUp() const { return pseudoUp_; }
+  const DoubleVector& getPCUp() const { return pseudoUp_; }
 
   /**
    * Return the vector of pseudocosts of down-branchings upto this node in
    * the parental chain (direct ancestors only).
    */
-  DoubleVector getPCDown() const { return pseudoDown_; }
+  const DoubleVector& getPCDown() const { return pseudoDown_; }
   
   /**
    * Return the vector of number of down-branchings of a variable upto this
    * in the parental chain (direct ancestors only).
    */
-  UIntVector getTimesDown() const { return timesDown_; }
+  const UIntVector& getTimesDown() const { return timesDown_; }
 
   /**
    * Return the vector of number of up-branchings of a variable upto this
    * node in the parental chain (direct ancestors only).
    */
-  UIntVector getTimesUp() const { return timesUp_; }
+  const UIntVector& getTimesUp() const { return timesUp_; }
 
   /// Return the threshhold value.
   UInt getThresh() const;
@@ -17,12 +17,13 @@
 #include "BrCand.h"
 #include "Environment.h"
 #include "Node.h"
-#include "NodeHeap.h"
-#include "NodeStack.h"
+#include "NodeFile.h"
 #include "Operations.h"
 #include "Option.h"
+#include "ParNodeStore.h"
 #include "Timer.h"
 #include "ParTreeManager.h"
+#include "WarmStartStore.h"
 
 using namespace Minotaur;
 
@@ -32,6 +33,8 @@ ParTreeManager::ParTreeManager(EnvPtr env)
   cutOff_(INFINITY),
   doVbc_(false),
   etol_(1e-6),
+  nodeFile_(0),
+  nodeFileLimit_(0),
   size_(0),
   timer_(0)
 {
@@ -46,20 +49,21 @@ ParTreeManager::ParTreeManager(EnvPtr env)
      assert (!"search strategy must be defined!");
   }
 
-  switch (searchType_) {
-   case (DepthFirst):
-     activeNodes_ = (NodeStackPtr) new NodeStack();
-     break;
-   case (BestFirst):
-   case (BestThenDive):
-     activeNodes_ = (NodeHeapPtr) new NodeHeap(NodeHeap::Value);
-     break;
-   default:
-     assert (!"search strategy must be defined!");
+  // one sub-store for each thread, see ParNodeStore.
+  int threads = env->getOptions()->findInt("threads")->getValue();
+  activeNodes_ = (ParNodeStorePtr) new ParNodeStore((threads > 1) ? threads : 1,
+                                                    searchType_);
+
+  // nodes are read back from the file in the order of the heap, so it is
+  // not used in depth first search.
+  nodeFileLimit_ = env->getOptions()->findInt("node_file_limit")->getValue();
+  if (nodeFileLimit_ > 0 && searchType_ != DepthFirst) {
+    nodeFile_ = (NodeFilePtr) new NodeFile();
   }
 
   aNode_ = NodePtr();
   cutOff_ = env->getOptions()->findDouble("obj_cut_off")->getValue();
+  wsStore_ = (WarmStartStorePtr) new WarmStartStore(env);
   tbRule_ = env->getOptions()->findString("tb_rule")->getValue();
   s = env->getOptions()->findString("vbc_file")->getValue();
   if (s!="") {
@@ -84,6 +88,10 @@ ParTreeManager::~ParTreeManager()
 {
   clearAll();
   delete activeNodes_;
+  if (nodeFile_) {
+    delete nodeFile_;
+  }
+  delete wsStore_;
   if (doVbc_) {
     vbcFile_.close();
     delete timer_;
@@ -93,7 +101,7 @@ ParTreeManager::~ParTreeManager()
 
 bool ParTreeManager::anyActiveNodesLeft()
 {
-  return !activeNodes_->isEmpty();
+  return !activeNodes_->isEmpty() || (nodeFile_ && !nodeFile_->isEmpty());
 }
 
 
@@ -102,10 +110,17 @@ NodePtr ParTreeManager::branch(Branches branches, NodePtr node, WarmStartPtr ws)
   BranchPtr branch_p;
   NodePtr new_cand = NodePtr(); // NULL
   NodePtr child;
+  NodePtrVector children;
   bool is_first = false;
   if (searchType_ == DepthFirst || searchType_ == BestThenDive) {
     is_first = true;
   }
+  if (ws && !branches->empty()) {
+    wsStore_->add(ws);
+  }
+  // Link all children to the node before any of them becomes visible to
+  // other threads. Otherwise a thread pruning the first child could find the
+  // node childless and remove it while we are still branching.
   for (BranchConstIterator br_iter=branches->begin(); br_iter!=branches->end();
       ++br_iter) {
     branch_p = *br_iter;
@@ -113,28 +128,34 @@ NodePtr ParTreeManager::branch(Branches branches, NodePtr node, WarmStartPtr ws)
     child->setLb(node->getLb());
     child->setTbScore(node->getTbScore());
     child->setDepth(node->getDepth()+1);
+#pragma omp critical (treeNodes)
     node->addChild(child);
+    children.push_back(child);
+  }
+  for (NodePtrIterator it=children.begin(); it!=children.end(); ++it) {
+    child = *it;
+    // We make a copy of the pointer to warm-start, not the full copy of the
+    // warm-start.
+    child->setWarmStart(ws);
     if (is_first) {
-      child->setWarmStart(ws);
       insertCandidate_(child, true);
       is_first = false;
       new_cand = child;
     } else {
-      // We make a copy of the pointer to warm-start, not the full copy of the
-      // warm-start.
-      child->setWarmStart(ws);
       insertCandidate_(child);
     }
   }
   if (doVbc_) {
-    vbcFile_ << toClockTime(timer_->query()) << " P " << node->getId()+1 << " "
-             << VbcSolved << std::endl;
-    if (new_cand) {
-      vbcFile_ << toClockTime(timer_->query()) << " P "
-               << new_cand->getId()+1 << " " << VbcSolving << std::endl;
+#pragma omp critical (vbcFile)
+    {
+      vbcFile_ << toClockTime(timer_->query()) << " P " << node->getId()+1
+               << " " << VbcSolved << std::endl;
+      if (new_cand) {
+        vbcFile_ << toClockTime(timer_->query()) << " P "
+                 << new_cand->getId()+1 << " " << VbcSolving << std::endl;
+      }
     }
   }
-  aNode_ = new_cand; // can be NULL
   return new_cand;
 }
 
@@ -148,6 +169,14 @@ void ParTreeManager::clearAll()
     //removeNodeAndUp_(aNode_);
     aNode_ = 0;
   }
+  // nodes in the file are created again, one at a time, so that their
+  // parents are removed.
+  while (nodeFile_ && false==nodeFile_->isEmpty()) {
+    n = nodeFile_->read();
+    if (n) {
+      removeNodeAndUp_(n);
+    }
+  }
   while (false==activeNodes_->isEmpty()) {
     n = activeNodes_->top();
     removeNodeAndUp_(n);
@@ -158,7 +187,11 @@ void ParTreeManager::clearAll()
 
 UInt ParTreeManager::getActiveNodes() const
 {
-  return activeNodes_->getSize();
+  UInt n = activeNodes_->getSize();
+  if (nodeFile_) {
+    n += nodeFile_->getSize();
+  }
+  return n;
 }
 
 
@@ -167,6 +200,7 @@ NodePtr ParTreeManager::getCandidate()
   NodePtr node = NodePtr(); // NULL
   //aNode_.reset();
   aNode_ = 0;
+  readNodeFile_();
   while (activeNodes_->getSize() > 0) {
     node = activeNodes_->top();
     if (shouldPrune_(node)) {
@@ -174,6 +208,7 @@ NodePtr ParTreeManager::getCandidate()
       pruneNode(node);
       //node.reset(); // NULL
       node = 0;
+      readNodeFile_();
     } else {
       if (doVbc_) {
         vbcFile_ << toClockTime(timer_->query()) << " P " << node->getId()+1
@@ -189,7 +224,10 @@ NodePtr ParTreeManager::getCandidate()
 
 double ParTreeManager::getCutOff()
 {
-  return cutOff_;
+  double cutoff;
+#pragma omp atomic read
+  cutoff = cutOff_;
+  return cutoff;
 }
 
 
@@ -199,12 +237,14 @@ double ParTreeManager::getPerGap()
   // so that if one has a ub, she can say that the solution can not be more
   // than gap% away from the current ub.
   double gap = 0.0;
-  if (bestUpperBound_ >= INFINITY) {
+  double lb = getLb();
+  double ub = getUb();
+  if (ub >= INFINITY) {
     gap = INFINITY;
-  } else if ((bestUpperBound_ > etol_) && (fabs(bestLowerBound_) < etol_)) {
+  } else if ((ub > etol_) && (fabs(lb) < etol_)) {
     gap = 100.0;
   } else {
-    gap = (bestUpperBound_ - bestLowerBound_)/(fabs(bestUpperBound_)+etol_) 
+    gap = (ub - lb)/(fabs(ub)+etol_) 
       * 100.0;
     if (gap<0.0) {
       gap = 0.0;
@@ -220,12 +260,13 @@ double ParTreeManager::getPerGapPar(double treeLb)
   // than gap% away from the current ub.
   //assert(bestLowerBound_ >= treeLb - etol_);
   double gap = 0.0;
-  if (bestUpperBound_ >= INFINITY) {
+  double ub = getUb();
+  if (ub >= INFINITY) {
     gap = INFINITY;
   } else if (fabs(treeLb) < etol_) {
     gap = 100.0;
   } else {
-    gap = (bestUpperBound_ - treeLb)/(fabs(bestUpperBound_)+etol_) 
+    gap = (ub - treeLb)/(fabs(ub)+etol_) 
       * 100.0;
     if (gap<0.0) {
       gap = 0.0;
@@ -237,7 +278,10 @@ double ParTreeManager::getPerGapPar(double treeLb)
 
 double ParTreeManager::getLb()
 {
-  return bestLowerBound_;
+  double lb;
+#pragma omp atomic read
+  lb = bestLowerBound_;
+  return lb;
 }
 
 
@@ -249,16 +293,23 @@ UInt ParTreeManager::getSize() const
 
 double ParTreeManager::getUb()
 {
-  return bestUpperBound_;
+  double ub;
+#pragma omp atomic read
+  ub = bestUpperBound_;
+  return ub;
 }
 
 
 void ParTreeManager::insertCandidate_(NodePtr node, bool pop_now)
 {
+  UInt id;
+
   assert(size_>0);
+#pragma omp atomic capture
+  id = size_++;
 
   // set node id and depth
-  node->setId(size_);
+  node->setId(id);
   node->setDepth(node->getParent()->getDepth()+1);
   if (tbRule_ == "twoChild") {
     bool dir = node->getBranch()->getBrCand()->getDir();
@@ -281,19 +332,29 @@ void ParTreeManager::insertCandidate_(NodePtr node, bool pop_now)
     node->setTbScore(node->getParent()->getTbScore());
   }
 
-  ++size_;
-
-  // add node to the heap/stack of active nodes. If pop_now is true, the node
-  // is processed right after creating it; we don't
-  // want to keep it in activeNodes (e.g. while diving)
-  if (!pop_now) {
-    activeNodes_->push(node);
-  } 
   if (doVbc_) {
+#pragma omp critical (vbcFile)
     vbcFile_ << toClockTime(timer_->query()) << " N "
       << node->getParent()->getId()+1 << " " << node->getId()+1
       << " " << VbcActive << std::endl;
   }
+
+  // add node to the heap/stack of active nodes. If pop_now is true, the node
+  // is processed right after creating it; we don't
+  // want to keep it in activeNodes (e.g. while diving). If there are too
+  // many active nodes, the node is written to the file and deleted. The
+  // file changes the list of children of the parent, which is shared with
+  // siblings.
+  if (!pop_now) {
+    bool written = false;
+    if (nodeFile_ && activeNodes_->getSize() >= nodeFileLimit_) {
+#pragma omp critical (treeNodes)
+      written = nodeFile_->write(node);
+    }
+    if (!written) {
+      activeNodes_->push(node);
+    }
+  } 
 }
 
 
@@ -321,6 +382,28 @@ void ParTreeManager::pruneNode(NodePtr node)
 }
 
 
+void ParTreeManager::readNodeFile_()
+{
+  if (!nodeFile_ || nodeFile_->isEmpty() ||
+      (!activeNodes_->isEmpty() &&
+       nodeFile_->getBestLB() >= activeNodes_->getBestLB())) {
+    return;
+  }
+#pragma omp critical (treeNodes)
+  {
+    // another thread may have emptied the file meanwhile. A node that can
+    // not be read is skipped, and the next one is read.
+    while (!nodeFile_->isEmpty()) {
+      NodePtr n = nodeFile_->read();
+      if (n) {
+        activeNodes_->push(n);
+        break;
+      }
+    }
+  }
+}
+
+
 void ParTreeManager::removeActiveNode(NodePtr node)
 {
   if (doVbc_) {
@@ -368,6 +451,7 @@ void ParTreeManager::removeNode_(NodePtr node)
         } else {
           c = VbcSubInf;
         }
+#pragma omp critical (vbcFile)
         vbcFile_ << toClockTime(timer_->query()) << " P " << node->getId()+1 << " " 
                  << c << std::endl;
       }
@@ -375,37 +459,56 @@ void ParTreeManager::removeNode_(NodePtr node)
       assert (!"Current node is not in its parent's list of children!");
     }
   }
-  delete node;
+  if (node->markRemoved()) {
+    delete node;
+  }
 }
 
 
 void ParTreeManager::removeNodeAndUp_(NodePtr node)
 {
-  NodePtr parent = node->getParent();
-
-  // remove the given node
-  removeNode_(node);
+  // siblings may be removed by different threads at the same time, and they
+  // share the list of children of their parent.
+#pragma omp critical (treeNodes)
+  {
+    NodePtr parent = node->getParent();
 
-  // remove the ancestors of the given node, if they have no children left
-  while (parent && parent->getNumChildren()==0) {
-    node = parent;
-    parent = node->getParent();
+    // remove the given node
     removeNode_(node);
+
+    // remove the ancestors of the given node, if they have no children left
+    while (parent && parent->getNumChildren()==0) {
+      node = parent;
+      parent = node->getParent();
+      removeNode_(node);
+    }
   }
 }
 
 
 void ParTreeManager::setCutOff(double value)
 {
-  cutOff_ = value;
+#pragma omp critical (tmBound)
+  {
+#pragma omp atomic write
+    cutOff_ = value;
+  }
 }
 
 
 void ParTreeManager::setUb(double value)
 {
-  bestUpperBound_ = value;
-  if (value < cutOff_) {
-    cutOff_ = value;
+  // Threads may publish their incumbents out of order. Keep the best.
+#pragma omp critical (tmBound)
+  {
+    if (value < bestUpperBound_) {
+#pragma omp atomic write
+      bestUpperBound_ = value;
+    }
+    if (value < cutOff_) {
+#pragma omp atomic write
+      cutOff_ = value;
+    }
   }
 }
 
@@ -422,8 +525,10 @@ bool ParTreeManager::shouldDive()
 bool ParTreeManager::shouldPrune_(NodePtr node)
 {
   double lb = node->getLb();
-  if (lb > cutOff_ - etol_ || 
-      fabs(bestUpperBound_-lb)/(fabs(bestUpperBound_)+etol_)*100 < etol_) {
+  double cutoff = getCutOff();
+  double ub = getUb();
+  if (lb > cutoff - etol_ || 
+      fabs(ub-lb)/(fabs(ub)+etol_)*100 < etol_) {
     node->setStatus(NodeHitUb);
     return true;
   }
@@ -431,12 +536,46 @@ bool ParTreeManager::shouldPrune_(NodePtr node)
 }
 
 
+NodePtr ParTreeManager::takeCandidate()
+{
+  NodePtr node;
+
+  readNodeFile_();
+  node = activeNodes_->take();
+  while (node && shouldPrune_(node)) {
+    pruneNode(node);
+    readNodeFile_();
+    node = activeNodes_->take();
+  }
+  if (node && doVbc_) {
+#pragma omp critical (vbcFile)
+    vbcFile_ << toClockTime(timer_->query()) << " P " << node->getId()+1
+             << " " << VbcSolving << std::endl;
+  }
+  return node; // can be NULL
+}
+
+
 double ParTreeManager::updateLb()
 {
-  // this could be an expensive operation. Try to avoid it.
-  bestLowerBound_ = activeNodes_->getBestLB();
+  // reads the bounds published by the sub-stores, it does not lock.
+  double lb = activeNodes_->getBestLB();
+  if (nodeFile_ && nodeFile_->getBestLB() < lb) {
+    lb = nodeFile_->getBestLB();
+  }
+
+#pragma omp atomic write
+  bestLowerBound_ = lb;
+  return lb;
+}
 
-  return bestLowerBound_;
+
+void ParTreeManager::writeStats(std::ostream &out) const
+{
+  wsStore_->writeStats(out);
+  if (nodeFile_) {
+    nodeFile_->writeStats(out);
+  }
 }
 
 
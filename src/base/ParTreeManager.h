@@ -20,12 +20,24 @@
 
 namespace Minotaur {
   
-  class ActiveNodeStore;
+  class NodeFile;
+  class ParNodeStore;
   class WarmStart;
-  typedef ActiveNodeStore* ActiveNodeStorePtr;
+  class WarmStartStore;
+  typedef NodeFile* NodeFilePtr;
+  typedef ParNodeStore* ParNodeStorePtr;
   typedef WarmStart* WarmStartPtr;
-
-  /// Base class for managing the branch-and-bound tree. 
+  typedef WarmStartStore* WarmStartStorePtr;
+
+  /**
+   * \brief Manage the branch-and-bound tree explored by several threads.
+   *
+   * Active nodes are kept in a ParNodeStore, so that threads taking and
+   * inserting nodes do not wait for each other. Only publishing a new
+   * incumbent (setUb(), setCutOff()) and unlinking nodes from the tree are
+   * serialized. branch(), pruneNode(), takeCandidate() and updateLb() may be
+   * called concurrently. getCandidate() and removeActiveNode() may not.
+   */
   class ParTreeManager {
 
   public:
@@ -105,7 +117,8 @@ namespace Minotaur {
      * It may prune some of the nodes if their lower bound is more than the
      * upper bound.  \return the best candidate found. If no candidate is
      * found, it returns NULL. The candidate is not removed from the storage.
-     * It is removed only when removeActiveNode() is called.
+     * It is removed only when removeActiveNode() is called. Not thread-safe,
+     * use takeCandidate() when several threads are running.
      */
     NodePtr getCandidate();
 
@@ -142,9 +155,9 @@ namespace Minotaur {
     /** 
      * \brief Set the best known objective function value.
      *
-     * The function does NOT check if the given value is better than the
-     * previous. So care should be taken to pass only the best known value. It
-     * also updates the cutoff value that is used to prune nodes.
+     * The value is ignored if it is not better than the current one, since
+     * threads may report their incumbents out of order. It also updates the
+     * cutoff value that is used to prune nodes.
      * \param[in] value The best known upper bound.
      */
     void setUb(double value);
@@ -152,6 +165,17 @@ namespace Minotaur {
     /// Return true if the tree-manager recommends diving. False otherwise.
     bool shouldDive();
 
+    /**
+     * \brief Remove and return the best candidate of the calling thread.
+     *
+     * Nodes that can be pruned because of their bound are pruned on the way.
+     * The node is taken from the calling thread's part of the active-node
+     * store, or stolen from another thread if that part is empty.
+     * \return the candidate removed from storage, or NULL if no active nodes
+     * are left.
+     */
+    NodePtr takeCandidate();
+
     /** 
      * \brief Recalculate and return the lower bound of the tree.
      *
@@ -163,11 +187,14 @@ namespace Minotaur {
      */
     double updateLb();
 
+    /// Write statistics about the warm starts and the file of nodes.
+    void writeStats(std::ostream &out) const;
+
   private:
     /// Set of nodes that are still active (those who need to be processed).
-    ActiveNodeStorePtr activeNodes_;
+    ParNodeStorePtr activeNodes_;
 
-    /// An active node that is not in the ActiveNodeStore. One such node may
+    /// An active node that is not in the ParNodeStore. One such node may
     /// exist. When we are diving. It must be deleted in the end.
     NodePtr aNode_;
 
@@ -189,6 +216,16 @@ namespace Minotaur {
     /// Tolerance for pruning nodes on the basis of bounds.
     const double etol_;
 
+    /**
+     * Active nodes written to a file when there are too many of them in
+     * memory. NULL if node_file_limit is 0 or the search is depth first.
+     */
+    NodeFilePtr nodeFile_;
+
+    /// Number of active nodes in memory above which new nodes are written to
+    /// nodeFile_.
+    UInt nodeFileLimit_;
+
     /// The search order: depth first, best first or something else.
     TreeSearchOrder searchType_;
 
@@ -207,6 +244,9 @@ namespace Minotaur {
     /// File name to store tree information for vbc.
     std::ofstream vbcFile_;
 
+    /// Warm starts linked to open nodes.
+    WarmStartStorePtr wsStore_;
+
     /// Check if the node can be pruned because of its bound.
     bool shouldPrune_(NodePtr node);
 
@@ -218,6 +258,13 @@ namespace Minotaur {
      */
     void insertCandidate_(NodePtr node, bool pop_now = false);
 
+    /**
+     * \brief Read the best node of nodeFile_ into the active nodes if its
+     * bound is better than that of the active nodes in memory, or if there
+     * are none. Thread-safe.
+     */
+    void readNodeFile_();
+
     /**
      * \brief Remove a node from the tree. Ancestors are removed if their
      * single child is removed.
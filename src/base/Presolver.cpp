@@ -21,6 +21,7 @@
 #include "QuadraticFunction.h"
 #include "Objective.h"
 #include "Option.h"
+#include "Profiler.h"
 #include "PreMod.h"
 #include "Presolver.h"
 #include "Problem.h"
@@ -90,6 +91,7 @@ void Presolver::standardize()
 
 SolveStatus Presolver::solve()
 {
+  ProfScope prof(env_->getProfiler(), "presolve");
   SolveStatus h_status;
   bool changed = true;
   bool stop = false;
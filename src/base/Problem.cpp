@@ -19,16 +19,23 @@
 #include "Environment.h"
 #include "MinotaurConfig.h"
 #include "Operations.h"
+#include "Option.h"
 #include "Problem.h"
+#include "SharedDAG.h"
 
 using namespace Minotaur;
 const std::string Problem::me_ = "Problem: ";
 
+/// Id of the last problem created, see Problem::getId().
+static UInt lastProblemId = 0;
+
 Problem::Problem(EnvPtr env)
   : cons_(0),
     consModed_(false),
+    dag_(0),
     debugSol_(0),
     engine_(0),
+    evalThreads_(1),
     hessian_(0),
     jacobian_(0),
     nativeDer_(false),
@@ -40,10 +47,19 @@ Problem::Problem(EnvPtr env)
     obj_(0),
     size_(0),
     vars_(0),
+    id_(0),
+    structVersion_(0),
+    varIndexVersion_(0),
     varsModed_(false)
 
 {
+  int n = env->getOptions()->findInt("eval_threads")->getValue();
+
+#pragma omp atomic capture
+  id_ = ++lastProblemId;
   logger_ = env->getLogger();
+  evalThreads_ = (n > 1) ? n : 1;
+  shareDAG_ = env->getOptions()->findBool("shared_dag")->getValue();
 }
 
 Problem::~Problem()
@@ -75,6 +91,9 @@ Problem::~Problem()
   if(engine_) {
     engine_->clear();
   }
+  if(dag_) {
+    delete dag_;
+  }
   if(hessian_) {
     delete hessian_;
   }
@@ -123,6 +142,7 @@ void Problem::addToObj(double c)
 void Problem::addToCons(ConstraintPtr cons, double c)
 {
   cons->add_(c);
+  ++structVersion_;
 }
 
 void Problem::calculateSize(bool shouldRedo)
@@ -268,6 +288,7 @@ void Problem::changeConstraint(ConstraintPtr con, NonlinearFunctionPtr nlf)
     (*vit)->inConstraint_(con);
   }
   consModed_ = true;
+  ++structVersion_;
 }
 
 void Problem::changeConstraint(ConstraintPtr con, LinearFunctionPtr lf,
@@ -300,6 +321,7 @@ void Problem::changeConstraint(ConstraintPtr con, LinearFunctionPtr lf,
     (*vit)->inConstraint_(con);
   }
   consModed_ = true;
+  ++structVersion_;
 }
 
 void Problem::changeObj(FunctionPtr f, double cb)
@@ -314,6 +336,7 @@ void Problem::changeObj(FunctionPtr f, double cb)
   }
   obj_ = (ObjectivePtr) new Objective(f, cb, Minimize, name);
   consModed_ = true;
+  ++structVersion_;
 }
 
 int Problem::checkConVars() const
@@ -1310,6 +1333,7 @@ void Problem::delMarkedCons()
 
     cons_ = copycons;
     consModed_ = true;
+    ++structVersion_;
     numDCons_ = 0;
   }
 }
@@ -1346,6 +1370,16 @@ void Problem::delMarkedVars(bool keep)
     }
     vars_ = copyvars;
 
+    // frozen arrays of functions have the old indices.
+    ++varIndexVersion_;
+    ++structVersion_;
+    for(ConstraintIterator it = cons_.begin(); it != cons_.end(); ++it) {
+      (*it)->getFunction()->freeze();
+    }
+    if(obj_ && obj_->getFunction()) {
+      obj_->getFunction()->freeze();
+    }
+
     varsModed_ = true;
     numDVars_ = 0;
   }
@@ -1683,6 +1717,7 @@ void Problem::negateObj()
   if(hessian_) {
     hessian_->negateObj();
   }
+  ++structVersion_;
 }
 
 VariablePtr Problem::newBinaryVariable()
@@ -1722,6 +1757,7 @@ ConstraintPtr Problem::newConstraint(FunctionPtr f, double lb, double ub,
     engine_->addConstraint(c);
   }
   consModed_ = true;
+  ++structVersion_;
   return c;
 }
 
@@ -1855,6 +1891,7 @@ VariablePtr Problem::newVariable(double lb, double ub, VariableType vtype,
   ++nextVId_;
   vars_.push_back(v);
   varsModed_ = true;
+  ++structVersion_;
   return v;
 }
 
@@ -1963,6 +2000,7 @@ void Problem::reverseSense(ConstraintPtr cons)
 {
   cons->reverseSense_();
   consModed_ = true;
+  ++structVersion_;
 }
 
 void Problem::setDebugSol(const DoubleVector& x)
@@ -2045,8 +2083,22 @@ void Problem::setNativeDer()
     delete hessian_;
     hessian_ = 0;
   }
+  if(dag_) {
+    delete dag_;
+    dag_ = 0;
+  }
   jacobian_ = (JacobianPtr) new Jacobian(cons_, vars_.size());
+  jacobian_->setNumThreads(evalThreads_);
   hessian_ = (HessianOfLagPtr) new HessianOfLag(this);
+  hessian_->setNumThreads(evalThreads_);
+  if(shareDAG_) {
+    // the graphs are compiled when the hessian is set up.
+    dag_ = new SharedDAG();
+    dag_->addProblem(this);
+    jacobian_->setDAG(dag_);
+    hessian_->setDAG(dag_);
+    dag_->writeStats(logger_->msgStream(LogDebug));
+  }
 }
 
 void Problem::setVarType(VariablePtr var, VariableType type)
@@ -2083,6 +2135,7 @@ void Problem::setVarType(VariablePtr var, VariableType type)
   }
   var->setType_(type);
   varsModed_ = true;
+  ++structVersion_;
 }
 
 void Problem::subst(VariablePtr out, VariablePtr in, double rat)
@@ -27,6 +27,8 @@
 
 namespace Minotaur {
 
+  class SharedDAG;
+
   /**
    * \brief The Problem that needs to be solved.
    *
@@ -237,6 +239,21 @@ namespace Minotaur {
     /// Return a pointer to the objective Function
     virtual ObjectivePtr getObjective() const;
 
+    /**
+     * \brief Return the number of times constraints, variables or the
+     * objective were added, deleted or changed. Bound changes are not
+     * counted. Copies of the problem compare it with the value they saw last
+     * to find if they must be rebuilt.
+     */
+    UInt getStructVersion() const { return structVersion_; }
+
+    /**
+     * \brief Return an id that no other problem created by this process
+     * has. Unlike the address of a problem, it is not reused after the
+     * problem is freed.
+     */
+    UInt getId() const { return id_; }
+
     /// Return the value of objective function at given point x.
     double getObjValue(const double *x, int *err) const;
 
@@ -249,6 +266,13 @@ namespace Minotaur {
     /// Return a pointer to the variable with a given index
     virtual VariablePtr getVariable(UInt index) const;
 
+    /**
+     * \brief Return the number of times the variables of this problem were
+     * renumbered. Objects that cache indices of variables compare it with
+     * the value they saw last to find if the cache is stale.
+     */
+    UInt getVarIndexVersion() const { return varIndexVersion_; }
+
     /**
      * \brief Return true if the derivative is available through Minotaur's own
      * routines for storing nonlinear functions.
@@ -605,6 +629,12 @@ namespace Minotaur {
      */
     bool consModed_;
 
+    /**
+     * DAG shared by the computational graphs of the native Jacobian and
+     * Hessian (option shared_dag). NULL if not used.
+     */
+    SharedDAG *dag_;
+
     /**
      * \brief A solution to be used for debugging against accidentally cutting of
      * feasible points.
@@ -614,6 +644,12 @@ namespace Minotaur {
     /// Engine that must be updated if problem is loaded to it, could be null 
     Engine* engine_;
 
+    /**
+     * Number of threads used to evaluate the native Jacobian and Hessian
+     * (option eval_threads).
+     */
+    UInt evalThreads_;
+
     /// Pointer to the hessian of the lagrangean. Could be NULL.
     HessianOfLagPtr hessian_;
 
@@ -623,6 +659,9 @@ namespace Minotaur {
     /// Pointer to the log manager. All output messages are sent to it.
     LoggerPtr logger_;
 
+    /// If true, build a shared DAG in setNativeDer().
+    bool shareDAG_;
+
     /// For logging
     static const std::string me_;
 
@@ -665,6 +704,15 @@ namespace Minotaur {
      */
     VarVector varsRem_;
 
+    /// Id of this problem, see getId().
+    UInt id_;
+
+    /// Number of changes to the structure, see getStructVersion().
+    UInt structVersion_;
+
+    /// Number of times the variables were renumbered.
+    UInt varIndexVersion_;
+
     /// True if variables delete, added or their bounds changed.
     bool varsModed_;
 
@@ -0,0 +1,280 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+/**
+ * \file Profiler.cpp
+ * \brief Implement the methods of Profiler class.
+ * \author The Minotaur Team
+ */
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <map>
+
+#include "MinotaurConfig.h"
+#include "Profiler.h"
+
+#if USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace Minotaur {
+  /// A scope recorded by a Profiler.
+  struct ProfEvent {
+    const char *name;
+    double start;
+    double end;
+  };
+
+  /// A scope that is still open.
+  struct ProfOpen {
+    const char *name;
+    double start;
+
+    /// Time spent in nested scopes that are closed.
+    double child;
+  };
+
+  /// Totals of the scopes with one name.
+  struct ProfStat {
+    UInt calls;
+    double total;
+    double self;
+  };
+
+  /// Data of one thread of a Profiler.
+  struct ProfThread {
+    /// Finished scopes, a ring buffer.
+    std::vector<ProfEvent> ring;
+
+    /// Number of scopes ever written to ring.
+    size_t written;
+
+    /// Stack of open scopes.
+    std::vector<ProfOpen> open;
+
+    /// Totals by name. Names are compared by address.
+    std::map<const char *, ProfStat> stats;
+  };
+}
+
+using namespace Minotaur;
+
+const std::string Profiler::me_ = "Profiler: ";
+
+/// Threads with a larger OpenMP thread number are not recorded.
+static const UInt profMaxThreads = 256;
+
+
+Profiler::Profiler()
+  : capacity_(100000),
+    on_(false),
+    start_(std::chrono::steady_clock::now()),
+    threads_(profMaxThreads, (ProfThread *) 0)
+{
+}
+
+
+Profiler::~Profiler()
+{
+  for (UInt i=0; i<threads_.size(); ++i) {
+    delete threads_[i];
+  }
+}
+
+
+void Profiler::begin(const char *name)
+{
+  ProfThread *t = thread_();
+  ProfOpen o;
+
+  if (t) {
+    o.name = name;
+    o.start = now_();
+    o.child = 0.0;
+    t->open.push_back(o);
+  }
+}
+
+
+void Profiler::clear()
+{
+  for (UInt i=0; i<threads_.size(); ++i) {
+    delete threads_[i];
+    threads_[i] = 0;
+  }
+  start_ = std::chrono::steady_clock::now();
+}
+
+
+void Profiler::end()
+{
+  ProfThread *t = thread_();
+  ProfStat *st;
+  ProfEvent e;
+  double dur;
+
+  if (!t || t->open.empty()) {
+    return;
+  }
+  e.name = t->open.back().name;
+  e.start = t->open.back().start;
+  e.end = now_();
+  dur = e.end - e.start;
+
+  st = &(t->stats[e.name]); // zero-initialized if new
+  ++(st->calls);
+  st->total += dur;
+  st->self += dur - t->open.back().child;
+  t->open.pop_back();
+  if (!t->open.empty()) {
+    t->open.back().child += dur;
+  }
+
+  if (!t->ring.empty()) {
+    t->ring[t->written % t->ring.size()] = e;
+    ++(t->written);
+  }
+}
+
+
+double Profiler::now_() const
+{
+  return std::chrono::duration<double>
+    (std::chrono::steady_clock::now() - start_).count();
+}
+
+
+void Profiler::setCapacity(UInt n)
+{
+  capacity_ = n;
+}
+
+
+ProfThread* Profiler::thread_()
+{
+  UInt i = 0;
+
+#if USE_OPENMP
+  if (omp_get_active_level() > 1) {
+    return 0;
+  }
+  i = omp_get_thread_num();
+#endif
+  if (i >= profMaxThreads) {
+    return 0;
+  }
+  // only thread i creates threads_[i].
+  if (!threads_[i]) {
+    threads_[i] = new ProfThread();
+    threads_[i]->ring.resize(capacity_);
+    threads_[i]->written = 0;
+  }
+  return threads_[i];
+}
+
+
+void Profiler::writeFlat(std::ostream &out) const
+{
+  typedef std::map<std::string, ProfStat> StatMap;
+  std::vector<std::pair<double, std::string> > order;
+  StatMap all, one;
+  const ProfThread *t;
+  size_t dropped;
+
+  for (UInt i=0; i<=threads_.size(); ++i) {
+    if (i<threads_.size()) {
+      t = threads_[i];
+      if (!t || t->stats.empty()) {
+        continue;
+      }
+      // names with the same text but different addresses are merged.
+      one.clear();
+      for (std::map<const char *, ProfStat>::const_iterator
+           it=t->stats.begin(); it!=t->stats.end(); ++it) {
+        ProfStat &s = one[it->first];
+        ProfStat &a = all[it->first];
+        s.calls += it->second.calls;
+        s.total += it->second.total;
+        s.self  += it->second.self;
+        a.calls += it->second.calls;
+        a.total += it->second.total;
+        a.self  += it->second.self;
+      }
+      dropped = (t->written > t->ring.size()) ?
+        t->written - t->ring.size() : 0;
+      out << me_ << "thread " << i << ", scopes not in the trace = "
+        << dropped << std::endl;
+    } else if (all.empty()) {
+      break;
+    } else {
+      one.swap(all);
+      out << me_ << "all threads" << std::endl;
+    }
+
+    order.clear();
+    for (StatMap::const_iterator it=one.begin(); it!=one.end(); ++it) {
+      order.push_back(std::make_pair(-it->second.self, it->first));
+    }
+    std::sort(order.begin(), order.end());
+    out << me_ << std::setw(24) << std::left << "scope" << std::right
+      << std::setw(10) << "calls" << std::setw(12) << "total (s)"
+      << std::setw(12) << "self (s)" << std::endl;
+    for (UInt k=0; k<order.size(); ++k) {
+      const ProfStat &s = one[order[k].second];
+      out << me_ << std::setw(24) << std::left << order[k].second
+        << std::right << std::setw(10) << s.calls << std::fixed
+        << std::setprecision(4) << std::setw(12) << s.total
+        << std::setw(12) << s.self << std::endl;
+    }
+  }
+}
+
+
+void Profiler::writeTrace(std::ostream &out) const
+{
+  const ProfThread *t;
+  const ProfEvent *e;
+  size_t first, n;
+  bool comma = false;
+
+  out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [" << std::endl;
+  out << std::fixed << std::setprecision(3);
+  for (UInt i=0; i<threads_.size(); ++i) {
+    t = threads_[i];
+    if (!t || 0==t->written) {
+      continue;
+    }
+    out << (comma ? ",\n" : "")
+      << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": "
+      << i << ", \"args\": {\"name\": \"thread " << i << "\"}}";
+    comma = true;
+
+    // oldest first.
+    n = std::min(t->written, t->ring.size());
+    first = (t->written > t->ring.size()) ? t->written % t->ring.size() : 0;
+    for (size_t k=0; k<n; ++k) {
+      e = &(t->ring[(first+k) % t->ring.size()]);
+      out << ",\n{\"name\": \"" << e->name << "\", \"ph\": \"X\", "
+        << "\"pid\": 1, \"tid\": " << i << ", \"ts\": " << e->start*1e6
+        << ", \"dur\": " << (e->end-e->start)*1e6 << "}";
+    }
+  }
+  out << std::endl << "]}" << std::endl;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
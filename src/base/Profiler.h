@@ -0,0 +1,168 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+/**
+ * \file Profiler.h
+ * \brief Declare the classes Profiler and ProfScope that record how much
+ * wall time each thread spends in the phases of a solve.
+ * \author The Minotaur Team
+ */
+
+#ifndef MINOTAURPROFILER_H
+#define MINOTAURPROFILER_H
+
+#include <chrono>
+
+#include "Types.h"
+
+namespace Minotaur {
+
+  struct ProfThread;
+
+  /**
+   * \brief A hierarchical profiler of named scopes.
+   *
+   * Code is profiled by putting a ProfScope on the stack. Scopes may be
+   * nested. Each thread has its own stack of open scopes, its own ring
+   * buffer of finished scopes and its own totals per name, so threads do
+   * not lock each other while the profiler is on. Times are wall times
+   * measured with a steady clock, so they are right for each thread also
+   * when several threads run at once.
+   *
+   * When the ring buffer of a thread is full, its oldest scopes are
+   * overwritten. The totals are never lost: writeFlat() shows, for each
+   * thread and name, the number of calls, the total time and the self time,
+   * i.e. the time not spent in nested scopes. writeTrace() writes the scopes
+   * still in the buffers in the Chrome trace-event format, which can be
+   * loaded in chrome://tracing or Perfetto.
+   *
+   * The profiler is off by default, and then a ProfScope costs one test.
+   * Threads are identified by their OpenMP thread number. Scopes in nested
+   * parallel regions are not recorded.
+   */
+  class Profiler {
+  public:
+    /// Create a profiler that is off.
+    Profiler();
+
+    /// Destroy.
+    ~Profiler();
+
+    /**
+     * \brief Open a scope on the stack of the calling thread. Use
+     * ProfScope instead.
+     *
+     * \param [in] name Name of the scope. It must remain valid as long as
+     * the profiler, e.g. a string literal. Scopes are added up by name.
+     */
+    void begin(const char *name);
+
+    /// Delete all recorded scopes and totals. No scope may be open.
+    void clear();
+
+    /// Close the scope opened last by the calling thread.
+    void end();
+
+    /// Return true if scopes are being recorded.
+    bool isOn() const { return on_; }
+
+    /**
+     * \brief Set the number of scopes kept for each thread. Threads that
+     * already recorded scopes keep their old capacity.
+     */
+    void setCapacity(UInt n);
+
+    /// Switch recording on or off. Open scopes are still closed when off.
+    void setOn(bool on) { on_ = on; }
+
+    /// Write the totals of each thread and of all threads as a table.
+    void writeFlat(std::ostream &out) const;
+
+    /// Write the recorded scopes as a Chrome trace-event JSON document.
+    void writeTrace(std::ostream &out) const;
+
+  private:
+    /// Number of scopes kept for each thread.
+    UInt capacity_;
+
+    /// For logging.
+    static const std::string me_;
+
+    /// True if scopes are recorded.
+    bool on_;
+
+    /// Time at which the profiler was created or cleared.
+    std::chrono::steady_clock::time_point start_;
+
+    /// Data of each thread, by thread number. NULL if not used yet.
+    std::vector<ProfThread *> threads_;
+
+    /// Seconds since start_.
+    double now_() const;
+
+    /// Data of the calling thread, or NULL if it must not record.
+    ProfThread* thread_();
+
+    /// Copying is not allowed.
+    Profiler(const Profiler &);
+
+    /// Assignment is not allowed.
+    Profiler& operator=(const Profiler &);
+  };
+  typedef Profiler* ProfilerPtr;
+
+
+  /**
+   * \brief Record the time from construction to destruction of this object
+   * as a scope of a Profiler, if the profiler is on. E.g.
+   *
+   * {
+   *   ProfScope ps(env_->getProfiler(), "engine_solve");
+   *   engine_->solve();
+   * }
+   */
+  class ProfScope {
+  public:
+    /// Open a scope with the given name, if prof is not NULL and on.
+    ProfScope(ProfilerPtr prof, const char *name)
+      : prof_((prof && prof->isOn()) ? prof : 0)
+    {
+      if (prof_) {
+        prof_->begin(name);
+      }
+    }
+
+    /// Close the scope.
+    ~ProfScope()
+    {
+      if (prof_) {
+        prof_->end();
+      }
+    }
+
+  private:
+    /// The profiler, NULL if the scope is not recorded.
+    ProfilerPtr prof_;
+
+    /// Copying is not allowed.
+    ProfScope(const ProfScope &);
+
+    /// Assignment is not allowed.
+    ProfScope& operator=(const ProfScope &);
+  };
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,227 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+/**
+ * \file PseudoCosts.cpp
+ * \brief Implement the methods of PseudoCosts class.
+ * \author The Minotaur Team
+ */
+
+#include <algorithm>
+
+#include "MinotaurConfig.h"
+#include "PseudoCosts.h"
+
+namespace Minotaur {
+  /// A node of the trie used by PseudoCosts.
+  struct PCostTrie {
+    /// Number of versions and trie nodes that point to this one.
+    int cnt;
+
+    /// For a leaf, bit i is set if rec[i] holds a record.
+    UInt has;
+
+    /// Children of an internal node, NULL for a leaf.
+    PCostTrie **kid;
+
+    /// Records of a leaf, NULL for an internal node.
+    PCostRecord *rec;
+  };
+}
+
+using namespace Minotaur;
+
+/// Number of bits of the index used at each level.
+static const UInt pcBits = 4;
+
+/// Number of children of a trie node.
+static const UInt pcWidth = 1 << pcBits;
+
+
+/// Return true if index fits in a trie with depth levels above the leaves.
+static bool pcFits(UInt index, UInt depth)
+{
+  UInt bits = (depth+1)*pcBits;
+  return (bits >= 8*sizeof(UInt) || 0 == (index >> bits));
+}
+
+
+static PCostTrie* pcNewTrie(bool is_leaf)
+{
+  PCostTrie *t = new PCostTrie();
+  t->cnt = 1;
+  t->has = 0;
+  if (is_leaf) {
+    t->kid = 0;
+    t->rec = new PCostRecord[pcWidth];
+  } else {
+    t->kid = new PCostTrie*[pcWidth];
+    std::fill(t->kid, t->kid+pcWidth, (PCostTrie *) 0);
+    t->rec = 0;
+  }
+  return t;
+}
+
+
+static void pcShare(PCostTrie *t)
+{
+  if (t) {
+#pragma omp atomic
+    ++t->cnt;
+  }
+}
+
+
+static void pcRelease(PCostTrie *t)
+{
+  int cnt;
+
+  if (!t) {
+    return;
+  }
+#pragma omp atomic capture
+  cnt = --t->cnt;
+  if (0 == cnt) {
+    if (t->kid) {
+      for (UInt k=0; k<pcWidth; ++k) {
+        pcRelease(t->kid[k]);
+      }
+      delete [] t->kid;
+    }
+    delete [] t->rec;
+    delete t;
+  }
+}
+
+
+/**
+ * Return a trie node with the same contents as t that the caller may change.
+ * It is t itself if the caller is its only user, otherwise a copy that
+ * shares the children of t. The caller's reference to t is given up.
+ */
+static PCostTrie* pcOwn(PCostTrie *t)
+{
+  PCostTrie *c;
+  int cnt;
+
+#pragma omp atomic read
+  cnt = t->cnt;
+  if (1 == cnt) {
+    return t;
+  }
+  c = pcNewTrie(0 == t->kid);
+  c->has = t->has;
+  if (t->kid) {
+    for (UInt k=0; k<pcWidth; ++k) {
+      c->kid[k] = t->kid[k];
+      pcShare(c->kid[k]);
+    }
+  } else {
+    std::copy(t->rec, t->rec+pcWidth, c->rec);
+  }
+  pcRelease(t);
+  return c;
+}
+
+
+PseudoCosts::PseudoCosts()
+  : depth_(0),
+    root_(0),
+    size_(0)
+{
+}
+
+
+PseudoCosts::PseudoCosts(const PseudoCosts *pc)
+  : depth_(0),
+    root_(0),
+    size_(0)
+{
+  if (pc) {
+    depth_ = pc->depth_;
+    root_ = pc->root_;
+    size_ = pc->size_;
+    pcShare(root_);
+  }
+}
+
+
+PseudoCosts::~PseudoCosts()
+{
+  pcRelease(root_);
+}
+
+
+const PCostRecord* PseudoCosts::find(UInt index) const
+{
+  const PCostTrie *t = root_;
+  UInt i;
+
+  if (!t || !pcFits(index, depth_)) {
+    return 0;
+  }
+  for (UInt d=depth_; d>0; --d) {
+    t = t->kid[(index >> (d*pcBits)) & (pcWidth-1)];
+    if (!t) {
+      return 0;
+    }
+  }
+  i = index & (pcWidth-1);
+  return ((t->has >> i) & 1) ? t->rec+i : 0;
+}
+
+
+void PseudoCosts::set(UInt index, const PCostRecord &rec)
+{
+  PCostTrie *t;
+  UInt i, k;
+
+  if (!root_) {
+    depth_ = 0;
+    while (!pcFits(index, depth_)) {
+      ++depth_;
+    }
+    root_ = pcNewTrie(0 == depth_);
+  }
+  // the old root becomes the first child of a new root. Its reference
+  // moves with it.
+  while (!pcFits(index, depth_)) {
+    t = pcNewTrie(false);
+    t->kid[0] = root_;
+    root_ = t;
+    ++depth_;
+  }
+
+  root_ = pcOwn(root_);
+  t = root_;
+  for (UInt d=depth_; d>0; --d) {
+    k = (index >> (d*pcBits)) & (pcWidth-1);
+    if (t->kid[k]) {
+      t->kid[k] = pcOwn(t->kid[k]);
+    } else {
+      t->kid[k] = pcNewTrie(1 == d);
+    }
+    t = t->kid[k];
+  }
+  i = index & (pcWidth-1);
+  if (0 == ((t->has >> i) & 1)) {
+    t->has |= (1u << i);
+    ++size_;
+  }
+  t->rec[i] = rec;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
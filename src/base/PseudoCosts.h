@@ -0,0 +1,118 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+/**
+ * \file PseudoCosts.h
+ * \brief Declare the class PseudoCosts that stores pseudocosts of branching
+ * candidates that are shared by nodes of the tree.
+ * \author The Minotaur Team
+ */
+
+#ifndef MINOTAURPSEUDOCOSTS_H
+#define MINOTAURPSEUDOCOSTS_H
+
+#include "Types.h"
+
+namespace Minotaur {
+
+  /// Pseudocost statistics of one branching candidate.
+  struct PCostRecord {
+    /// Average change in objective per unit change when branching down.
+    double down;
+
+    /// Average change in objective per unit change when branching up.
+    double up;
+
+    /// Number of down-branchings that were used in down.
+    UInt timesDown;
+
+    /// Number of up-branchings that were used in up.
+    UInt timesUp;
+
+    /// When the candidate was last strong-branched on.
+    UInt lastStrBranched;
+  };
+
+  struct PCostTrie;
+
+  /**
+   * \brief One version of the pseudocosts of branching candidates, indexed
+   * by the pseudocost index of the candidate.
+   *
+   * The records are kept in a persistent radix trie with 16 children per
+   * level. A new version made from an old one shares the whole trie, so
+   * copying the pseudocosts of a parent to a child takes constant time and
+   * memory. set() copies only the parts of the trie on the path to the
+   * record that are also used by other versions, i.e. about a kilobyte
+   * for each changed record. Versions are never affected by changes to
+   * other versions.
+   *
+   * Trie nodes are reference counted atomically, so versions sharing them
+   * may be used and destroyed by different threads. A single version must
+   * not be changed by two threads at once.
+   */
+  class PseudoCosts {
+  public:
+    /// Create an empty version.
+    PseudoCosts();
+
+    /**
+     * \brief Create a version with the same records as another one.
+     *
+     * \param [in] pc The version to copy. May be NULL, then the new version
+     * is empty.
+     */
+    PseudoCosts(const PseudoCosts *pc);
+
+    /// Destroy. Trie nodes not used by other versions are freed.
+    ~PseudoCosts();
+
+    /**
+     * \brief Find the record of a candidate.
+     *
+     * \param [in] index The pseudocost index of the candidate.
+     * \return The record, or NULL if there is none. The pointer is valid
+     * until this version is changed or destroyed.
+     */
+    const PCostRecord* find(UInt index) const;
+
+    /// Number of candidates with a record.
+    UInt getSize() const { return size_; }
+
+    /// Add or replace the record of candidate index.
+    void set(UInt index, const PCostRecord &rec);
+
+  private:
+    /// Number of levels of the trie above the leaves.
+    UInt depth_;
+
+    /// Root of the trie, NULL if there are no records.
+    PCostTrie *root_;
+
+    /// Number of records.
+    UInt size_;
+
+    /// Copy constructor is not allowed, use the pointer constructor.
+    PseudoCosts(const PseudoCosts &);
+
+    /// Assignment is not allowed.
+    PseudoCosts& operator=(const PseudoCosts &);
+  };
+  typedef PseudoCosts* PseudoCostsPtr;
+  typedef const PseudoCosts* ConstPseudoCostsPtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
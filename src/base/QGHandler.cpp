@@ -27,6 +27,7 @@
 #include "Environment.h"
 #include "Function.h"
 #include "Logger.h"
+#include "NLPCache.h"
 #include "Node.h"
 #include "NonlinearFunction.h"
 #include "Objective.h"
@@ -51,12 +52,16 @@ QGHandler::QGHandler(EnvPtr env, ProblemPtr minlp, EnginePtr nlpe)
     nlCons_(0),
     nlpe_(nlpe),
     nlpStatus_(EngineUnknownStatus),
+    nlpCache_(0),
+    nlpVal_(INFINITY),
+    nlpX_(0),
     objVar_(VariablePtr()),
     oNl_(false),
     rel_(RelaxationPtr()),
     relobj_(0.0)
 {
   intTol_ = env_->getOptions()->findDouble("int_tol")->getValue();
+  linCoeffTol_ = env_->getOptions()->findDouble("conCoeff_tol");
   solAbsTol_ = env_->getOptions()->findDouble("feasAbs_tol")->getValue();
   solRelTol_ = env_->getOptions()->findDouble("feasRel_tol")->getValue();
   objATol_ = env_->getOptions()->findDouble("solAbs_tol")->getValue();
@@ -147,31 +152,27 @@ void QGHandler::cutIntSol_(ConstSolutionPtr sol, CutManager* cutMan,
   const double* lpx = sol->getPrimal();
   relobj_ = (sol) ? sol->getObjValue() : -INFINITY;
 
-  fixInts_(lpx); // Fix integer variables
-  solveNLP_();
-  unfixInts_(); // Unfix integer variables
+  solveFixedNLP_(lpx);
 
   switch(nlpStatus_) {
   case(ProvenOptimal):
   case(ProvenLocalOptimal): {
     ++(stats_->nlpF);
-    double nlpval = nlpe_->getSolutionValue();
+    double nlpval = nlpVal_;
     updateUb_(s_pool, nlpval, sol_found);
     if((relobj_ >= nlpval - objATol_) ||
        (nlpval != 0 && (relobj_ >= nlpval - fabs(nlpval) * objRTol_))) {
       *status = SepaPrune;
     } else {
-      const double* nlpx = nlpe_->getSolution()->getPrimal();
-      cutToObj_(nlpx, lpx, cutMan, status);
-      cutToCons_(nlpx, lpx, cutMan, status);
+      cutToObj_(nlpX_, lpx, cutMan, status);
+      cutToCons_(nlpX_, lpx, cutMan, status);
     }
   } break;
   case(ProvenInfeasible):
   case(ProvenLocalInfeasible):
   case(ProvenObjectiveCutOff): {
     ++(stats_->nlpI);
-    const double* nlpx = nlpe_->getSolution()->getPrimal();
-    cutToCons_(nlpx, lpx, cutMan, status);
+    cutToCons_(nlpX_, lpx, cutMan, status);
   } break;
   case(EngineIterationLimit):
     ++(stats_->nlpIL);
@@ -336,8 +337,7 @@ void QGHandler::linearAt_(FunctionPtr f, double fval, const double* x,
   int n = rel_->getNumVars();
   double* a = new double[n];
   VariableConstIterator vbeg = rel_->varsBegin(), vend = rel_->varsEnd();
-  const double linCoeffTol =
-      env_->getOptions()->findDouble("conCoeff_tol")->getValue();
+  const double linCoeffTol = linCoeffTol_->getValue();
 
   std::fill(a, a + n, 0.);
   f->evalGradient(x, a, error);
@@ -624,6 +624,39 @@ void QGHandler::separate(ConstSolutionPtr sol, NodePtr, RelaxationPtr rel,
   return;
 }
 
+void QGHandler::setNLPCache(NLPCache* cache)
+{
+  nlpCache_ = cache;
+}
+
+void QGHandler::solveFixedNLP_(const double* x)
+{
+  // minlp_ is not modified at the nodes, so the NLP only depends on the
+  // values of the integer variables.
+  if(nlpCache_) {
+    NLPCache::getKey(minlp_, x, nlpKey_);
+    if(nlpCache_->find(nlpKey_, &nlpStatus_, &nlpVal_, nlpSol_)) {
+      nlpX_ = &(nlpSol_[0]);
+      return;
+    }
+  }
+
+  fixInts_(x); // Fix integer variables
+  solveNLP_();
+  unfixInts_(); // Unfix integer variables
+
+  nlpX_ = 0;
+  if(NLPCache::isCacheable(nlpStatus_)) {
+    nlpVal_ = nlpe_->getSolutionValue();
+    nlpX_ = nlpe_->getSolution()->getPrimal();
+    if(nlpCache_) {
+      nlpCache_->insert(nlpKey_, nlpStatus_, nlpVal_, nlpX_,
+                        minlp_->getNumVars());
+    }
+  }
+  return;
+}
+
 void QGHandler::solveNLP_()
 {
   nlpStatus_ = nlpe_->solve();
@@ -651,8 +684,7 @@ void QGHandler::updateUb_(SolutionPoolPtr s_pool, double nlpval,
 
   if((bestval - objATol_ > nlpval) ||
      (bestval != 0 && (bestval - fabs(bestval) * objRTol_ > nlpval))) {
-    const double* x = nlpe_->getSolution()->getPrimal();
-    s_pool->addSolution(x, nlpval);
+    s_pool->addSolution(nlpX_, nlpval);
     *sol_found = true;
   }
   return;
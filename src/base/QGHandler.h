@@ -25,6 +25,8 @@
 
 namespace Minotaur {
 
+class NLPCache;
+
 struct QGStats {
   size_t nlpS;      /// Number of nlps solved.
   size_t nlpF;      /// Number of nlps feasible.
@@ -51,6 +53,9 @@ private:
   /// Tolerance for checking integrality (should be obtained from env).
   double intTol_;
 
+  /// Option conCoeff_tol, read for every linearization.
+  DoubleOptionPtr linCoeffTol_;
+
   /// Log.
   LoggerPtr logger_;
 
@@ -72,6 +77,21 @@ private:
   /// Status of the NLP/QP engine.
   EngineStatus nlpStatus_;
 
+  /// Cache of the results of NLPs with fixed integer variables. Not owned.
+  NLPCache *nlpCache_;
+
+  /// Key of the last NLP with fixed integer variables in nlpCache_.
+  DoubleVector nlpKey_;
+
+  /// Primal solution of the last NLP, if it was found in nlpCache_.
+  DoubleVector nlpSol_;
+
+  /// Objective value of the last NLP with fixed integer variables.
+  double nlpVal_;
+
+  /// Primal solution of the last NLP with fixed integer variables.
+  const double *nlpX_;
+
   /**
    * The variable corresponding to the objective function. It is a part of
    * all linearizations of the objective function and it appears in the
@@ -173,6 +193,13 @@ public:
                 CutManager *cutman, SolutionPoolPtr s_pool, ModVector &p_mods,
                 ModVector &r_mods, bool *sol_found, SeparationStatus *status);
  
+  /**
+   * \brief Set the cache of the results of NLPs with fixed integer
+   * variables. The handler does not delete it, and it can be shared with
+   * the handlers of other threads. If cache is NULL, all NLPs are solved.
+   */
+  void setNLPCache(NLPCache *cache);
+
   /// Show statistics.
   void writeStats(std::ostream &out) const;
 
@@ -252,6 +279,14 @@ private:
    */
   void relax_(bool *is_inf);
 
+  /**
+   * Get the status, the objective value and the solution of the NLP
+   * obtained by fixing the integer variables at their values in x, in
+   * nlpStatus_, nlpVal_ and nlpX_. The NLP is solved only if it is not
+   * found in nlpCache_.
+   */
+  void solveFixedNLP_(const double *x);
+
   /// Solve the nlp.
   void solveNLP_();
 
@@ -259,8 +294,8 @@ private:
   void unfixInts_();
 
   /**
-   * Update the upper bound. XXX: Needs proper integration with
-   * Minotaur's Handler design. 
+   * Update the upper bound with the solution nlpX_ of the last NLP. XXX:
+   * Needs proper integration with Minotaur's Handler design.
    */
   void updateUb_(SolutionPoolPtr s_pool, double nlpval, bool *sol_found);
 
@@ -33,6 +33,7 @@
 #include "Environment.h"
 #include "Function.h"
 #include "Logger.h"
+#include "NLPCache.h"
 #include "Node.h"
 #include "NonlinearFunction.h"
 #include "QuadraticFunction.h"
@@ -60,6 +61,9 @@ QGHandlerAdvance::QGHandlerAdvance(EnvPtr env, ProblemPtr minlp, EnginePtr nlpe)
   nlpe_(nlpe),
   lpe_(EnginePtr()),
   nlpStatus_(EngineUnknownStatus),
+  nlpCache_(0),
+  nlpVal_(INFINITY),
+  nlpX_(0),
   solC_(0),
   objVar_(VariablePtr()),
   oNl_(false),
@@ -80,6 +84,7 @@ QGHandlerAdvance::QGHandlerAdvance(EnvPtr env, ProblemPtr minlp, EnginePtr nlpe)
   prCutGen_(0)
 {
   intTol_ = env_->getOptions()->findDouble("int_tol")->getValue();
+  linCoeffTol_ = env_->getOptions()->findDouble("conCoeff_tol");
   solAbsTol_ = env_->getOptions()->findDouble("feasAbs_tol")->getValue();
   solRelTol_ = env_->getOptions()->findDouble("feasRel_tol")->getValue();
   objAbsTol_ = env_->getOptions()->findDouble("solAbs_tol")->getValue();
@@ -790,13 +795,13 @@ void QGHandlerAdvance::cutIntSol_(const double *lpx, CutManager *cutMan,
   case (ProvenLocalOptimal):
     {
       ++(stats_->nlpF);
-      double nlpval = nlpe_->getSolutionValue();
+      double nlpval = nlpVal_;
       updateUb_(s_pool, nlpval, sol_found);
       if ((relobj_ >= nlpval-objAbsTol_) ||
           (nlpval != 0 && (relobj_ >= nlpval-fabs(nlpval)*objRelTol_))) {
           *status = SepaPrune;
       } else {
-        const double * nlpx = nlpe_->getSolution()->getPrimal();
+        const double * nlpx = nlpX_;
         // Gradient inequalities to nonlinear objective and cons
         for (CCIter it = nlCons_.begin(); it != nlCons_.end(); ++it) {
           gradientIneq_(nlpx, lpx, cutMan, status, *it, 0);
@@ -887,7 +892,7 @@ void QGHandlerAdvance::cutIntSol_(const double *lpx, CutManager *cutMan,
   case (ProvenObjectiveCutOff):
     {
       ++(stats_->nlpI);
-      const double * nlpx = nlpe_->getSolution()->getPrimal();
+      const double * nlpx = nlpX_;
       for (CCIter it = nlCons_.begin(); it != nlCons_.end(); ++it) {
         gradientIneq_(nlpx, lpx, cutMan, status, *it, 0);
       }
@@ -1257,8 +1262,7 @@ void QGHandlerAdvance::linearAt_(FunctionPtr f, double fval, const double *x,
   int n = rel_->getNumVars();
   double *a = new double[n];
   VariableConstIterator vbeg = rel_->varsBegin(), vend = rel_->varsEnd();
-  const double linCoeffTol =
-    env_->getOptions()->findDouble("conCoeff_tol")->getValue();
+  const double linCoeffTol = linCoeffTol_->getValue();
 
   std::fill(a, a+n, 0.);
   f->evalGradient(x, a, error);
@@ -2243,20 +2247,8 @@ void QGHandlerAdvance::separate(ConstSolutionPtr sol, NodePtr node,
   }
 
   if (isIntFeas_(x)) {
-    fixInts_(x);            // Fix integer variables
     relobj_ = (sol) ? sol->getObjValue() : -INFINITY;
-
-    //// For modifying PR constraints
-    if (prCutGen_) {
-      // Modifying PR amenable constraints when variables are fixed 
-      prModNLP_(x); 
-    } else {
-      solveNLP_();            // solve NLP
-    }
-      
-    //solveNLP_();            // solve NLP
-    undoMods_();            // Unfix integer variables
- 
+    solveFixedNLP_(x);
     cutIntSol_(x, cutMan, s_pool, sol_found, status);
 
   } else {
@@ -3025,6 +3017,49 @@ void QGHandlerAdvance::ECPTypeCut_(const double *lpx, CutManager *,
 }
 
 
+void QGHandlerAdvance::setNLPCache(NLPCache *cache)
+{
+  nlpCache_ = cache;
+}
+
+
+void QGHandlerAdvance::solveFixedNLP_(const double *x)
+{
+  // minlp_ is not modified at the nodes, so the NLP only depends on the
+  // values of the integer variables. The changes of prModNLP_() also
+  // depend only on the values of binary variables.
+  if (nlpCache_) {
+    NLPCache::getKey(minlp_, x, nlpKey_);
+    if (nlpCache_->find(nlpKey_, &nlpStatus_, &nlpVal_, nlpSol_)) {
+      nlpX_ = &(nlpSol_[0]);
+      return;
+    }
+  }
+
+  fixInts_(x);            // Fix integer variables
+
+  //// For modifying PR constraints
+  if (prCutGen_) {
+    // Modifying PR amenable constraints when variables are fixed 
+    prModNLP_(x); 
+  } else {
+    solveNLP_();            // solve NLP
+  }
+  undoMods_();            // Unfix integer variables
+
+  nlpX_ = 0;
+  if (NLPCache::isCacheable(nlpStatus_)) {
+    nlpVal_ = nlpe_->getSolutionValue();
+    nlpX_ = nlpe_->getSolution()->getPrimal();
+    if (nlpCache_) {
+      nlpCache_->insert(nlpKey_, nlpStatus_, nlpVal_, nlpX_,
+                        minlp_->getNumVars());
+    }
+  }
+  return;
+}
+
+
 void QGHandlerAdvance::solveNLP_()
 {
   ++(stats_->nlpS);
@@ -3053,8 +3088,7 @@ void QGHandlerAdvance::updateUb_(SolutionPoolPtr s_pool, double nlpval,
 
   if ((bestval - objAbsTol_ > nlpval) ||
         (bestval != 0 && (bestval - fabs(bestval)*objRelTol_ > nlpval))) {
-    const double *x = nlpe_->getSolution()->getPrimal();
-    s_pool->addSolution(x, nlpval);
+    s_pool->addSolution(nlpX_, nlpval);
     *sol_found = true;
 
     //if (maxVioPer_ && (nlCons_.size() > 0)) {
@@ -28,6 +28,7 @@
 #include "Engine.h"
 #include "Environment.h"
 #include "Function.h"
+#include "LPEngine.h"
 #include "LinBil.h"
 #include "LinMods.h"
 #include "LinearFunction.h"
@@ -76,6 +77,10 @@ QuadHandler::QuadHandler(EnvPtr env, ProblemPtr problem)
   defaultUb_ = -1e12;
   doQT_ = false;
   simplexCut_ = 0;
+  objCutOff_ = env->getOptions()->findDouble("obj_cut_off");
+  simplexCutOpt_ = env->getOptions()->findBool("simplex_cut");
+  obbtThreads_ = std::max(env->getOptions()->findInt("obbt_threads")->getValue(),
+                          1);
 }
 
 QuadHandler::QuadHandler(EnvPtr env, ProblemPtr problem, ProblemPtr orig_p)
@@ -98,6 +103,10 @@ QuadHandler::QuadHandler(EnvPtr env, ProblemPtr problem, ProblemPtr orig_p)
   defaultUb_ = -1e12;
   doQT_ = false;
   simplexCut_ = 0;
+  objCutOff_ = env->getOptions()->findDouble("obj_cut_off");
+  simplexCutOpt_ = env->getOptions()->findBool("simplex_cut");
+  obbtThreads_ = std::max(env->getOptions()->findInt("obbt_threads")->getValue(),
+                          1);
 }
 
 QuadHandler::~QuadHandler()
@@ -118,6 +127,10 @@ QuadHandler::~QuadHandler()
   if(bte_) {
     delete bte_;
   }
+  for(UInt i = 0; i < obbtEngines_.size(); ++i) {
+    delete obbtEngines_[i];
+  }
+  obbtEngines_.clear();
 
   if(simplexCut_) {
     delete simplexCut_;
@@ -1456,7 +1469,11 @@ bool QuadHandler::postSolveRootNode(RelaxationPtr rel, SolutionPoolPtr s_pool,
     }
   }
   ub = s_pool->getBestSolutionValue();
-  is_inf = tightenLP_(rel, ub, &lchanged, p_mods, r_mods);
+  if(obbtThreads_ > 1) {
+    is_inf = tightenLPPar_(rel, ub, x, &lchanged, p_mods, r_mods);
+  } else {
+    is_inf = tightenLP_(rel, ub, &lchanged, p_mods, r_mods);
+  }
   if(is_inf) {
     logger_->msgStream(LogError)
         << me_ << "WARNING: OBBT returns infeasibility after "
@@ -1629,7 +1646,7 @@ void QuadHandler::separate(ConstSolutionPtr sol, NodePtr node,
   }
 
   if((!simplexCut_) &&
-     (env_->getOptions()->findBool("simplex_cut")->getValue())) {
+     (simplexCutOpt_->getValue())) {
     simplexCut_ = (SimplexQuadCutGenPtr) new SimplexQuadCutGen(
         env_, p_, cute_, s_pool->getBestSolutionValue());
   }
@@ -2017,11 +2034,12 @@ bool QuadHandler::calcVarBnd_(RelaxationPtr rel, VariablePtr v, double a,
   return false;
 }
 
-double QuadHandler::getBndByLP_(bool& is_inf)
+double QuadHandler::getBndByLP_(LPEnginePtr e, bool& is_inf)
 {
   double b;
   EngineStatus lpStatus;
-  lpStatus = bte_->solve();
+  lpStatus = e->solve();
+#pragma omp atomic
   ++bStats_.nLP;
   is_inf = false;
 
@@ -2029,7 +2047,7 @@ double QuadHandler::getBndByLP_(bool& is_inf)
   case(ProvenOptimal):
   case(EngineIterationLimit):
   case(ProvenUnbounded):
-    b = bte_->getSolution()->getObjValue();
+    b = e->getSolution()->getObjValue();
     break;
   case(ProvenInfeasible):
   case(ProvenObjectiveCutOff):
@@ -2155,24 +2173,18 @@ void QuadHandler::setItmpFromSol_(const double* x)
   }
 }
 
-bool QuadHandler::tightenLP_(RelaxationPtr rel, double bestSol, bool* changed,
-                             ModVector& p_mods, ModVector& r_mods)
+ProblemPtr QuadHandler::getOBBTProblem_(RelaxationPtr rel, double bestSol)
 {
   ObjectivePtr obj;
-  LinearFunctionPtr lflp = 0;
-  FunctionPtr flp = 0, f;
+  FunctionPtr flp, f;
   ProblemPtr lp;
-  VariablePtr v;
-  double lb, ub, cub;
-  bool is_inf;
-  bool c1;
+  double cub;
   int err;
-  UInt itmp;
 
   lp = rel->clone(env_);
 
   obj = lp->getObjective();
-  cub = env_->getOptions()->findDouble("obj_cut_off")->getValue();
+  cub = objCutOff_->getValue();
   cub = std::min(cub, bestSol);
   if(cub < INFINITY) {
     f = obj->getFunction();
@@ -2182,7 +2194,22 @@ bool QuadHandler::tightenLP_(RelaxationPtr rel, double bestSol, bool* changed,
       lp->newConstraint(flp, -INFINITY, cub - obj->getConstant());
     }
   }
+  return lp;
+}
 
+bool QuadHandler::tightenLP_(RelaxationPtr rel, double bestSol, bool* changed,
+                             ModVector& p_mods, ModVector& r_mods)
+{
+  LinearFunctionPtr lflp = 0;
+  FunctionPtr flp = 0;
+  ProblemPtr lp;
+  VariablePtr v;
+  double lb, ub;
+  bool is_inf;
+  bool c1;
+  UInt itmp;
+
+  lp = getOBBTProblem_(rel, bestSol);
   bte_->load(lp);
 
   for(VariableConstIterator vit = lp->varsBegin(); vit != lp->varsEnd();
@@ -2199,7 +2226,7 @@ bool QuadHandler::tightenLP_(RelaxationPtr rel, double bestSol, bool* changed,
       lflp->addTerm(v, 1.0);
       flp = (FunctionPtr) new Function(lflp);
       lp->changeObj(flp, 0.0);
-      lb = getBndByLP_(is_inf);
+      lb = getBndByLP_(bte_, is_inf);
       if(is_inf) {
         continue;
       }
@@ -2212,7 +2239,7 @@ bool QuadHandler::tightenLP_(RelaxationPtr rel, double bestSol, bool* changed,
       lflp->addTerm(v, -1.0);
       flp = (FunctionPtr) new Function(lflp);
       lp->changeObj(flp, 0.0);
-      ub = -getBndByLP_(is_inf);
+      ub = -getBndByLP_(bte_, is_inf);
       if(is_inf) {
         continue;
       }
@@ -2236,6 +2263,190 @@ bool QuadHandler::tightenLP_(RelaxationPtr rel, double bestSol, bool* changed,
   return false;
 }
 
+bool QuadHandler::tightenLPPar_(RelaxationPtr rel, double bestSol,
+                                const double* x, bool* changed,
+                                ModVector& p_mods, ModVector& r_mods)
+{
+  std::vector<std::pair<double, UInt> > order;
+  std::vector<std::pair<UInt, BoundType> > lptasks;
+  std::vector<ProblemPtr> lps;
+  std::vector<DoubleVector> sols;
+  UIntVector batch, infs;
+  DoubleVector lbs, ubs, vals;
+  VariablePtr v;
+  double lb, ub, range, score, xval;
+  UInt itmp, ncands, nt, next, j;
+  UInt n = p_->getNumVars();
+  bool is_inf = false;
+  bool c1;
+
+  // most promising first: the bound to be tightened is far from x.
+  for(VariableConstIterator vit = p_->varsBegin(); vit != p_->varsEnd();
+      ++vit) {
+    v = *vit;
+    itmp = v->getItmp();
+    if(itmp == 0) {
+      continue;
+    }
+    lb = v->getLb();
+    ub = v->getUb();
+    range = ub - lb;
+    xval = x[v->getIndex()];
+    if(range < INFINITY) {
+      score = 0.0;
+      if(itmp == 1 || itmp == 3) {
+        score = (xval - lb) / range;
+      }
+      if(itmp == 2 || itmp == 3) {
+        score = std::max(score, (ub - xval) / range);
+      }
+    } else {
+      score = INFINITY;
+    }
+    order.push_back(std::make_pair(-score, v->getIndex()));
+  }
+  ncands = order.size();
+  if(0 == ncands) {
+    return false;
+  }
+  std::sort(order.begin(), order.end());
+
+  // one LP for each bound, the lower bound of a variable first.
+  for(UInt i = 0; i < ncands; ++i) {
+    j = order[i].second;
+    itmp = p_->getVariable(j)->getItmp();
+    if(itmp == 1 || itmp == 3) {
+      lptasks.push_back(std::make_pair(j, Lower));
+    }
+    if(itmp == 2 || itmp == 3) {
+      lptasks.push_back(std::make_pair(j, Upper));
+    }
+  }
+
+  nt = std::min(obbtThreads_, ncands);
+  while(obbtEngines_.size() < nt) {
+    EnginePtr e = bte_->emptyCopy();
+    LPEnginePtr lpe = dynamic_cast<LPEnginePtr>(e);
+    if(!lpe) {
+      if(e) {
+        delete e;
+      }
+      logger_->msgStream(LogInfo)
+          << me_ << "engine " << bte_->getName() << " can not be copied. "
+          << "Using one thread for OBBT." << std::endl;
+      obbtThreads_ = 1;
+      return tightenLP_(rel, bestSol, changed, p_mods, r_mods);
+    }
+    obbtEngines_.push_back(lpe);
+  }
+
+  // cloning is not thread-safe. The objective of each copy is set by
+  // calling changeObj of its engine directly, so the copy keeps an empty
+  // objective with no constant.
+  for(UInt t = 0; t < nt; ++t) {
+    lps.push_back(getOBBTProblem_(rel, bestSol));
+    lps[t]->changeObj(
+        (FunctionPtr) new Function((LinearFunctionPtr) new LinearFunction()),
+        0.0);
+    obbtEngines_[t]->load(lps[t]);
+  }
+
+  lbs.resize(n, -INFINITY);
+  ubs.resize(n, INFINITY);
+  vals.resize(nt);
+  infs.resize(nt);
+  sols.resize(nt);
+  next = 0;
+  while(next < lptasks.size()) {
+    // pick the next nt LPs that are still needed. The choice depends only
+    // on the results of earlier rounds, never on the timing of threads.
+    batch.clear();
+    for(; next < lptasks.size() && batch.size() < nt; ++next) {
+      itmp = p_->getVariable(lptasks[next].first)->getItmp();
+      if(Lower == lptasks[next].second ? (itmp == 1 || itmp == 3)
+                                       : (itmp == 2 || itmp == 3)) {
+        batch.push_back(next);
+      }
+    }
+    if(batch.empty()) {
+      break;
+    }
+
+#pragma omp parallel for num_threads(batch.size()) schedule(static, 1)
+    for(UInt t = 0; t < batch.size(); ++t) {
+      LPEnginePtr e = obbtEngines_[t];
+      VariablePtr lv = lps[t]->getVariable(lptasks[batch[t]].first);
+      LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+      FunctionPtr f = (FunctionPtr) new Function(lf);
+      bool inf;
+
+      if(Lower == lptasks[batch[t]].second) {
+        lf->addTerm(lv, 1.0);
+        e->changeObj(f, 0.0);
+        vals[t] = getBndByLP_(e, inf);
+      } else {
+        lf->addTerm(lv, -1.0);
+        e->changeObj(f, 0.0);
+        vals[t] = -getBndByLP_(e, inf);
+      }
+      infs[t] = (inf) ? 1 : 0;
+      if(!inf) {
+        const double *sol = e->getSolution()->getPrimal();
+        sols[t].assign(sol, sol + n);
+      }
+      delete f;
+    }
+
+    // use the results in the order of the LPs, as tightenLP_ does.
+    for(UInt t = 0; t < batch.size(); ++t) {
+      if(1 == infs[t]) {
+        continue;
+      }
+      j = lptasks[batch[t]].first;
+      v = p_->getVariable(j);
+      itmp = v->getItmp();
+      if(Lower == lptasks[batch[t]].second) {
+        lbs[j] = vals[t];
+        if(itmp == 3) {
+          v->setItmp(2);
+        } else if(itmp == 1) {
+          v->setItmp(0);
+        }
+      } else {
+        ubs[j] = vals[t];
+        if(itmp == 3) {
+          v->setItmp(1);
+        } else if(itmp == 2) {
+          v->setItmp(0);
+        }
+      }
+      setItmpFromSol_(&(sols[t][0]));
+    }
+  }
+
+  for(UInt t = 0; t < nt; ++t) {
+    obbtEngines_[t]->clear();
+    delete lps[t];
+  }
+
+  // apply in the order of variables, independent of the schedule.
+  for(j = 0; j < n; ++j) {
+    if(lbs[j] <= -INFINITY && ubs[j] >= INFINITY) {
+      continue;
+    }
+    c1 = false;
+    if(updatePBounds_(p_->getVariable(j), lbs[j], ubs[j], rel, true, &c1,
+                      p_mods, r_mods) < 0) {
+      is_inf = true;
+      break;
+    }
+    if(c1 == true) {
+      *changed = true;
+    }
+  }
+  return is_inf;
+}
+
 bool QuadHandler::getQfLfBnds_(LinearFunctionPtr lf, QuadraticFunctionPtr qf,
                                double& implLb, double& implUb,
                                DoubleVector& fwdLb, DoubleVector& fwdUb,
@@ -2381,7 +2592,7 @@ bool QuadHandler::tightenQuad_(bool* changed)
   UInt count_inf_lb = 0, count_inf_ub = 0;
 
   obj = p_->getObjective();
-  cub = env_->getOptions()->findDouble("obj_cut_off")->getValue() -
+  cub = objCutOff_->getValue() -
       obj->getConstant();
   clb = -INFINITY;
 
@@ -2921,7 +3132,7 @@ bool QuadHandler::tightenSimple_(bool* changed)
   UInt count_inf_lb = 0, count_inf_ub = 0;
 
   obj = p_->getObjective();
-  cub = env_->getOptions()->findDouble("obj_cut_off")->getValue() -
+  cub = objCutOff_->getValue() -
       obj->getConstant();
   clb = -INFINITY;
 
@@ -217,12 +217,21 @@ class QuadHandler : public Handler {
 
   EnvPtr env_;
 
+  /// Option obj_cut_off, read whenever bounds are tightened.
+  DoubleOptionPtr objCutOff_;
+
   /// Logger.
   LoggerPtr logger_;
 
   /// Bound tightening LP engine
   LPEnginePtr bte_;
 
+  /// Copies of bte_ used by the threads of parallel OBBT.
+  std::vector<LPEnginePtr> obbtEngines_;
+
+  /// Number of threads for OBBT at the root (option obbt_threads).
+  UInt obbtThreads_;
+
   /// Cut generation LP engine
   LPEnginePtr cute_;
 
@@ -250,6 +259,9 @@ class QuadHandler : public Handler {
   /// Relative feasibility tolerance
   double rTol_;
 
+  /// Option simplex_cut, read in every call to separate.
+  BoolOptionPtr simplexCutOpt_;
+
   /// Simplex Cut generater
   SimplexQuadCutGenPtr simplexCut_;
 
@@ -368,7 +380,13 @@ class QuadHandler : public Handler {
    * \param[in] e The engine where lp is loaded
    * \param[out] is_inf True if the lp is infeasible.
    */
-  double getBndByLP_(bool &is_inf);
+  double getBndByLP_(LPEnginePtr e, bool &is_inf);
+
+  /**
+   * \brief Copy the relaxation for OBBT, and add the objective cut off as a
+   * constraint if it is finite.
+   */
+  ProblemPtr getOBBTProblem_(RelaxationPtr rel, double bestSol);
 
   /**
    * \brief Get bounds of a lf of a constraint
@@ -602,6 +620,24 @@ class QuadHandler : public Handler {
   bool tightenLP_(RelaxationPtr rel, double bestSol, bool *changed,
                   ModVector &p_mods, ModVector &r_mods);
 
+  /**
+   * \brief Same as tightenLP_, but the LPs are solved by obbtThreads_
+   * threads, each with its own copy of the LP and of bte_.
+   *
+   * Variables are processed in decreasing order of the distance of x from
+   * the bounds to be tightened, relative to the width of the domain. The
+   * LPs are solved in rounds of obbtThreads_, one per thread. Before each
+   * round, the LPs still needed are picked from the values of itmp left by
+   * the previous rounds. After a round, the results are used in the order
+   * of the LPs to update itmp through setItmpFromSol_. Thus the LPs solved
+   * and the bounds found do not depend on the timing of the threads. The
+   * bounds are applied in the order of the variables once all LPs are
+   * solved. Falls back to tightenLP_ if bte_ cannot be copied.
+   * \param[in] x The solution of the relaxation at the root.
+   */
+  bool tightenLPPar_(RelaxationPtr rel, double bestSol, const double *x,
+                     bool *changed, ModVector &p_mods, ModVector &r_mods);
+
   /**
    * \brief Bound tightening of the problem by considering linear and quadratic
    * terms simultaneously. Returns true if the problem is found to be
@@ -34,6 +34,7 @@ using namespace Minotaur;
 
 QuadraticFunction::QuadraticFunction() 
   : etol_(1e-8),
+    frozen_(false),
     hCoeffs_(0),
     hFirst_(0),
     hOff_(0),
@@ -48,6 +49,7 @@ QuadraticFunction::QuadraticFunction()
 QuadraticFunction::QuadraticFunction(UInt nz, double *vals, UInt *irow,
                                      UInt *jcol, VariableConstIterator vbeg)
 : etol_(1e-8),
+  frozen_(false),
   hCoeffs_(0),
   hFirst_(0),
   hOff_(0),
@@ -72,6 +74,7 @@ QuadraticFunction::QuadraticFunction(UInt nz, double *vals, UInt *irow,
 QuadraticFunction::QuadraticFunction(double* vals, VariableConstIterator vbeg,
                                     VariableConstIterator vend)
 : etol_(1e-8),
+  frozen_(false),
   hCoeffs_(0),
   hFirst_(0),
   hOff_(0),
@@ -135,6 +138,12 @@ QuadraticFunctionPtr QuadraticFunction::cloneWithVars(VariableConstIterator vbeg
 double QuadraticFunction::eval(const std::vector<double> &x) const
 {
    double sum = 0.0;
+   if (frozen_) {
+     for (UInt i=0; i<fVal_.size(); ++i) {
+       sum += fVal_[i] * x[fFirst_[i]] * x[fSecond_[i]];
+     }
+     return sum;
+   }
    for(VariablePairGroupConstIterator it = begin(); it != end(); ++it) {
       sum += it->second * x[it->first.first->getIndex()] * 
         x[it->first.second->getIndex()];
@@ -146,6 +155,12 @@ double QuadraticFunction::eval(const std::vector<double> &x) const
 double QuadraticFunction::eval(const double *x) const
 {
    double sum = 0.0;
+   if (frozen_) {
+     for (UInt i=0; i<fVal_.size(); ++i) {
+       sum += fVal_[i] * x[fFirst_[i]] * x[fSecond_[i]];
+     }
+     return sum;
+   }
    for(VariablePairGroupConstIterator it = begin(); it != end(); ++it) {
       sum += it->second * x[it->first.first->getIndex()] * 
         x[it->first.second->getIndex()];
@@ -161,15 +176,27 @@ void QuadraticFunction::computeBounds(double *l, double *u){
   double lb = 0;
   double ub = 0;
   double m;
-  for (VariablePairGroupConstIterator it = begin(); it != end(); ++it) {
-      a = it->second * (it->first.first -> getLb()) * 
-        (it->first.second -> getLb());
-      b = it->second * (it->first.first -> getLb()) * 
-        (it->first.second -> getUb());
-      c = it->second * (it->first.first -> getUb()) * 
-        (it->first.second -> getLb());
-      d = it->second * (it->first.first -> getUb()) * 
-        (it->first.second -> getUb());
+  ConstVariablePtr v1, v2;
+  double w;
+  UInt n = frozen_ ? fVal_.size() : terms_.size();
+  VariablePairGroupConstIterator it = terms_.begin();
+
+  // may be called by several threads, so it does not freeze.
+  for (UInt i=0; i<n; ++i) {
+      if (frozen_) {
+        v1 = fVars_[i].first;
+        v2 = fVars_[i].second;
+        w = fVal_[i];
+      } else {
+        v1 = it->first.first;
+        v2 = it->first.second;
+        w = it->second;
+        ++it;
+      }
+      a = w * (v1 -> getLb()) * (v2 -> getLb());
+      b = w * (v1 -> getLb()) * (v2 -> getUb());
+      c = w * (v1 -> getUb()) * (v2 -> getLb());
+      d = w * (v1 -> getUb()) * (v2 -> getUb());
       m = std::min(a,b); m = std::min(m,c); m = std::min(m,d);
       lb += m;
       m = std::max(a,b); m = std::max(m,c); m = std::max(m,d);
@@ -300,6 +327,13 @@ void QuadraticFunction::evalGradient(const double *x, double *grad_f)
 {
   assert (grad_f);
   if (x) {
+    if (frozen_) {
+      for (UInt i=0; i<fVal_.size(); ++i) {
+        grad_f[fFirst_[i]]  += fVal_[i] * x[fSecond_[i]];
+        grad_f[fSecond_[i]] += fVal_[i] * x[fFirst_[i]];
+      }
+      return;
+    }
     for(VariablePairGroupConstIterator it = terms_.begin(); it != terms_.end(); ++it) {
       grad_f[it->first.first->getIndex()] +=  it->second * 
         x[it->first.second->getIndex()];
@@ -312,6 +346,13 @@ void QuadraticFunction::evalGradient(const double *x, double *grad_f)
 void QuadraticFunction::evalGradient(const std::vector<double> & x, 
     std::vector<double> & grad_f)
 {
+  if (frozen_) {
+    for (UInt i=0; i<fVal_.size(); ++i) {
+      grad_f[fFirst_[i]]  += fVal_[i] * x[fSecond_[i]];
+      grad_f[fSecond_[i]] += fVal_[i] * x[fFirst_[i]];
+    }
+    return;
+  }
   for(VariablePairGroupConstIterator it = terms_.begin(); it != terms_.end(); ++it) {
     grad_f[it->first.first->getIndex()] +=  it->second * 
       x[it->first.second->getIndex()];
@@ -320,6 +361,7 @@ void QuadraticFunction::evalGradient(const std::vector<double> & x,
   }
 }
 
+
 QfVector QuadraticFunction::findSubgraphs()
 {
   QfVector qf_vector;
@@ -496,17 +538,51 @@ void QuadraticFunction::finalHessStor(const LTHessStor *stor)
 
 void QuadraticFunction::fillJac(const double *x, double *values, int *) 
 {
+  // jacOff_ and jacInd_ were created from the frozen arrays in prepJac().
   UInt i=0;
-  for (VariablePairGroupConstIterator it = terms_.begin(); it != terms_.end(); 
-      ++it) {
-    values[jacOff_[i]] += it->second * x[jacInd_[i]];
+  for (UInt j=0; j<fVal_.size(); ++j) {
+    values[jacOff_[i]] += fVal_[j] * x[jacInd_[i]];
     ++i;
-    values[jacOff_[i]] += it->second * x[jacInd_[i]];
+    values[jacOff_[i]] += fVal_[j] * x[jacInd_[i]];
     ++i;
   }
 }
 
 
+void QuadraticFunction::freeze()
+{
+  // pairs of indices of variables and position of the term in terms_.
+  std::vector<std::pair<std::pair<UInt, UInt>, UInt> > order;
+  std::vector<ConstVariablePair> vars;
+  DoubleVector vals;
+  UInt i = 0;
+
+  order.reserve(terms_.size());
+  vars.reserve(terms_.size());
+  vals.reserve(terms_.size());
+  for (VariablePairGroupConstIterator it = terms_.begin(); it != terms_.end();
+       ++it, ++i) {
+    order.push_back(std::make_pair(std::make_pair(
+            it->first.first->getIndex(), it->first.second->getIndex()), i));
+    vars.push_back(it->first);
+    vals.push_back(it->second);
+  }
+  std::sort(order.begin(), order.end());
+
+  fFirst_.resize(order.size());
+  fSecond_.resize(order.size());
+  fVal_.resize(order.size());
+  fVars_.resize(order.size());
+  for (i=0; i<order.size(); ++i) {
+    fFirst_[i]  = order[i].first.first;
+    fSecond_[i] = order[i].first.second;
+    fVars_[i]   = vars[order[i].second];
+    fVal_[i]    = vals[order[i].second];
+  }
+  frozen_ = true;
+}
+
+
 void QuadraticFunction::getVars(VariableSet *vars)
 {
   for (VarIntMap::const_iterator it=varFreq_.begin(); it!= varFreq_.end();
@@ -521,6 +597,7 @@ void QuadraticFunction::addTerm(VariablePair vp, const double weight)
 {
   assert (vp.first->getId() <= vp.second->getId());
   if (fabs(weight) >= etol_) {
+    frozen_ = false;
     terms_.insert(std::make_pair(vp, weight));
     varFreq_[vp.first] += 1;
     varFreq_[vp.second] += 1;
@@ -541,6 +618,7 @@ void QuadraticFunction::incTerm(ConstVariablePair vp, const double a)
 {
   if (fabs(a) > etol_) {
     VariablePairGroupIterator it = terms_.find(vp);
+    frozen_ = false;
     if (it == terms_.end()) {
       varFreq_[vp.first] += 1;
       varFreq_[vp.second] += 1;
@@ -628,6 +706,7 @@ bool QuadraticFunction::hasVar(ConstVariablePtr v) const
 void QuadraticFunction::removeVar(VariablePtr v, double val, 
     LinearFunctionPtr lf) 
 {
+  frozen_ = false;
   for (VariablePairGroupIterator it = terms_.begin(); it != terms_.end();) {
     if (it->first.first == v && it->first.first == it->first.second) {
       terms_.erase(it++);
@@ -750,6 +829,9 @@ void QuadraticFunction::prepJac(VarSetConstIter vbeg, VarSetConstIter vend)
   VarIntMap omap;
   std::map<ConstVariablePtr, UInt>::iterator vit;
 
+  if (!frozen_) {
+    freeze();
+  }
   i=0;
   for (VarSetConstIter it=vbeg; it!=vend; ++it, ++i) {
     vit = varFreq_.find(*it);
@@ -757,17 +839,16 @@ void QuadraticFunction::prepJac(VarSetConstIter vbeg, VarSetConstIter vend)
       omap[*it] = i;
     }
   }
-  jacOff_.resize(2*terms_.size());
-  jacInd_.resize(2*terms_.size());
+  jacOff_.resize(2*fVal_.size());
+  jacInd_.resize(2*fVal_.size());
 
   i=0;
-  for (VariablePairGroupIterator it = terms_.begin(); it != terms_.end(); 
-      ++it) {
-    jacOff_[i] = omap[it->first.first];
-    jacInd_[i] = it->first.second->getIndex();
+  for (UInt j=0; j<fVal_.size(); ++j) {
+    jacOff_[i] = omap[fVars_[j].first];
+    jacInd_[i] = fSecond_[j];
     ++i;
-    jacOff_[i] = omap[it->first.second];
-    jacInd_[i] = it->first.first->getIndex();
+    jacOff_[i] = omap[fVars_[j].second];
+    jacInd_[i] = fFirst_[j];
     ++i;
   }
 }
@@ -910,6 +991,7 @@ void QuadraticFunction::subst(VariablePtr out, VariablePtr in, double rat)
   if (vit==varFreq_.end()) {
     return;
   }
+  frozen_ = false;
 
   for (VariablePairGroupIterator it = terms_.begin(); it != terms_.end();){
     if (it->first.first == out || it->first.second==out) {
@@ -983,6 +1065,7 @@ void QuadraticFunction::add(ConstQuadraticFunctionPtr q2)
 
 
 void QuadraticFunction::multiply(const double c) {
+  frozen_ = false;
   if (fabs(c) < 1e-7) {
     terms_.clear();
     varFreq_.clear();
@@ -263,6 +263,19 @@ namespace Minotaur {
        */
       QfVector findSubgraphs();
 
+      /**
+       * \brief Copy the terms into contiguous coordinate (COO) arrays sorted
+       * by the indices of the variables.
+       *
+       * Evaluation routines use these arrays instead of walking the map of
+       * terms. The arrays are discarded whenever the function is modified or
+       * the index of a variable changes; until freeze() is called again, the
+       * map is used. prepJac() calls this function, and so does
+       * Problem::delMarkedVars() after it renumbers the variables. Not
+       * thread-safe.
+       */
+      void freeze();
+
       void prepJac(VarSetConstIter vbeg, VarSetConstIter vend);
       void prepHess();
 
@@ -300,6 +313,21 @@ namespace Minotaur {
       /// Tolerance below which a coefficient is deemed zero
       const double etol_;
 
+      /// Indices of the first variables of the frozen terms.
+      UIntVector fFirst_;
+
+      /// Indices of the second variables of the frozen terms.
+      UIntVector fSecond_;
+
+      /// Coefficients of the frozen terms.
+      DoubleVector fVal_;
+
+      /// Variable pairs of the frozen terms.
+      std::vector<ConstVariablePair> fVars_;
+
+      /// True if the frozen arrays have the same terms as terms_.
+      bool frozen_;
+
       double *hCoeffs_;
       UInt *hFirst_;
       UInt *hOff_;
@@ -10,10 +10,17 @@
  * \author Ashutosh Mahajan, IIT Bombay
  */
 
-#include <iomanip>
-#include <sstream>
-#include <fstream>
+#include <cctype>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iomanip>
+#include <strings.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "MinotaurConfig.h"
 #include "Environment.h"
@@ -21,14 +28,274 @@
 #include "LinearFunction.h"
 #include "Logger.h"
 #include "Operations.h"
+#include "Option.h"
 #include "Problem.h"
 #include "Reader.h"
 
+namespace Minotaur {
+  /// A word of a file. It is not terminated by NUL.
+  struct MpsWord {
+    const char *s;
+    UInt len;
+  };
+
+  /**
+   * Contents of a file, memory-mapped if possible and read into memory
+   * otherwise.
+   */
+  class MpsFile {
+  public:
+    MpsFile() : data_(0), map_(0), size_(0) {}
+    ~MpsFile();
+
+    /// Return false if the file can not be read.
+    bool open(const std::string &fname);
+
+    const char* begin() const { return data_; }
+    const char* end() const { return data_+size_; }
+
+  private:
+    std::vector<char> copy_;
+    const char *data_;
+    void *map_;
+    size_t size_;
+  };
+
+  /**
+   * Names interned in an open addressing hash table. The names are not
+   * copied, they must stay in memory while the table is used.
+   */
+  class MpsNames {
+  public:
+    MpsNames() : mask_(0) {}
+
+    /// Add a name that is not in the table and return its position.
+    UInt add(const MpsWord &w);
+
+    /// Return the position of a name, or -1 if it is not in the table.
+    int find(const MpsWord &w) const;
+
+    std::string getName(UInt i) const
+    { return std::string(words_[i].s, words_[i].len); }
+
+    UInt getSize() const { return words_.size(); }
+
+  private:
+    UInt mask_;
+    std::vector<int> slots_;
+    std::vector<MpsWord> words_;
+
+    static size_t hash_(const MpsWord &w);
+  };
+
+  /// A line of the COLUMNS section, with the row names and numbers parsed.
+  struct MpsColLine {
+    /// Number of words, at most 6.
+    UInt nw;
+
+    /// Row of each pair, -1 if undeclared.
+    int row[2];
+
+    /// Number of each pair.
+    double val[2];
+
+    /// True if the number of each pair could be parsed.
+    bool ok[2];
+  };
+}
+
 using namespace Minotaur;
 const std::string Reader::me_ = "Reader: ";
 
-Reader::Reader(EnvPtr env) 
-: env_(env) 
+/// Lines of the COLUMNS section that are parsed together.
+static const UInt mpsBlock = 65536;
+
+
+MpsFile::~MpsFile()
+{
+  if (map_) {
+    munmap(map_, size_);
+  }
+}
+
+
+bool MpsFile::open(const std::string &fname)
+{
+  struct stat st;
+  int fd = ::open(fname.c_str(), O_RDONLY);
+
+  if (fd<0) {
+    return false;
+  }
+  if (0==fstat(fd, &st) && S_ISREG(st.st_mode) && st.st_size>0) {
+    size_ = st.st_size;
+    map_ = mmap(0, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (MAP_FAILED==map_) {
+      map_ = 0;
+    } else {
+      madvise(map_, size_, MADV_SEQUENTIAL);
+      data_ = (const char*) map_;
+    }
+  }
+  ::close(fd);
+
+  if (!map_) {
+    // pipes, empty files, or no memory for a mapping.
+    std::ifstream fs(fname.c_str(), std::ios::binary);
+    if (!fs.is_open()) {
+      return false;
+    }
+    copy_.assign(std::istreambuf_iterator<char>(fs),
+                 std::istreambuf_iterator<char>());
+    size_ = copy_.size();
+    data_ = copy_.empty() ? 0 : &(copy_[0]);
+  }
+  return true;
+}
+
+
+UInt MpsNames::add(const MpsWord &w)
+{
+  size_t h;
+  UInt i = words_.size();
+
+  if (2*(words_.size()+1) > slots_.size()) {
+    // grow to keep the table at most half full.
+    slots_.assign(slots_.empty() ? 1024 : 2*slots_.size(), -1);
+    mask_ = slots_.size()-1;
+    for (UInt j=0; j<words_.size(); ++j) {
+      for (h=hash_(words_[j]) & mask_; slots_[h]>=0; h=(h+1) & mask_) {
+      }
+      slots_[h] = j;
+    }
+  }
+  for (h=hash_(w) & mask_; slots_[h]>=0; h=(h+1) & mask_) {
+  }
+  slots_[h] = i;
+  words_.push_back(w);
+  return i;
+}
+
+
+int MpsNames::find(const MpsWord &w) const
+{
+  const MpsWord *u;
+
+  if (slots_.empty()) {
+    return -1;
+  }
+  for (size_t h=hash_(w) & mask_; slots_[h]>=0; h=(h+1) & mask_) {
+    u = &(words_[slots_[h]]);
+    if (u->len==w.len && 0==memcmp(u->s, w.s, w.len)) {
+      return slots_[h];
+    }
+  }
+  return -1;
+}
+
+
+size_t MpsNames::hash_(const MpsWord &w)
+{
+  size_t h = 14695981039346656037ULL;
+
+  for (UInt i=0; i<w.len; ++i) {
+    h = (h ^ (unsigned char) w.s[i]) * 1099511628211ULL;
+  }
+  return h;
+}
+
+
+/// True if w is the string s.
+static bool mpsIs(const MpsWord &w, const char *s)
+{
+  return (w.len==strlen(s) && 0==memcmp(w.s, s, w.len));
+}
+
+
+/**
+ * Parse a number. Return false if w is neither a decimal number nor "inf"
+ * or "infinity" in any case, with an optional sign. strtod alone would
+ * also accept "nan" and hexadecimal numbers.
+ */
+static bool mpsNum(const MpsWord &w, double *d)
+{
+  char buf[64];
+  char *end;
+  UInt s = 0;
+
+  if (0==w.len || w.len>=sizeof(buf)) {
+    return false;
+  }
+  if ('+'==w.s[0] || '-'==w.s[0]) {
+    s = 1;
+  }
+  if ((3==w.len-s && 0==strncasecmp(w.s+s, "inf", 3)) ||
+      (8==w.len-s && 0==strncasecmp(w.s+s, "infinity", 8))) {
+    *d = ('-'==w.s[0]) ? -INFINITY : INFINITY;
+    return true;
+  }
+  for (UInt i=0; i<w.len; ++i) {
+    if (!isdigit((unsigned char) w.s[i]) && '.'!=w.s[i] && '+'!=w.s[i] &&
+        '-'!=w.s[i] && 'e'!=w.s[i] && 'E'!=w.s[i]) {
+      return false;
+    }
+  }
+  memcpy(buf, w.s, w.len);
+  buf[w.len] = '\0';
+  *d = strtod(buf, &end);
+  return (end==buf+w.len);
+}
+
+
+/// Find the end of the line that starts at b.
+static const char* mpsEol(const char *b, const char *eof)
+{
+  const char *e = (const char*) memchr(b, '\n', eof-b);
+  return e ? e : eof;
+}
+
+
+/**
+ * Split the line [b, e) into words. At most maxw words are stored in w. The
+ * return value is the number of words, but at most maxw+1.
+ */
+static UInt mpsSplit(const char *b, const char *e, MpsWord *w, UInt maxw)
+{
+  UInt nw = 0;
+  const char *c;
+
+  while (b<e) {
+    if (' '==*b || '\t'==*b || '\r'==*b || '\f'==*b || '\v'==*b) {
+      ++b;
+      continue;
+    }
+    if (nw==maxw) {
+      return maxw+1;
+    }
+    for (c=b; c<e && ' '!=*c && '\t'!=*c && '\r'!=*c && '\f'!=*c && '\v'!=*c;
+         ++c) {
+    }
+    w[nw].s = b;
+    w[nw].len = c-b;
+    ++nw;
+    b = c;
+  }
+  return nw;
+}
+
+
+/// True if the line that starts at b with first word w starts a section.
+static bool mpsIsSection(const char *b, const MpsWord &w)
+{
+  return (w.s==b && (mpsIs(w, "NAME") || mpsIs(w, "ROWS") ||
+                     mpsIs(w, "COLUMNS") || mpsIs(w, "RHS") ||
+                     mpsIs(w, "RANGES") || mpsIs(w, "BOUNDS") ||
+                     mpsIs(w, "ENDATA")));
+}
+
+
+Reader::Reader(EnvPtr env)
+: env_(env)
 {
   logger_ = env->getLogger();
 }
@@ -41,247 +308,327 @@ Reader::~Reader()
 
 ProblemPtr Reader::readMps(std::string fname, int &err)
 {
-  std::ifstream fs;
-  std::string line, word, word2, word3, word4;
-  std::string rhsid="";
-  std::string rangeid="";
-  std::string bndid="";
+  MpsFile file;
+  MpsWord w[6], rhsid, rangeid, bndid;
+  UInt nw;
+  const char *b, *e, *eof;
   ProblemPtr p = 0;
-  std::istringstream iss;
-  int lcnt, m, n, r;
-  bool comment;
+  int lcnt, m, n, r, c;
   VariableType vtype = Continuous;
   std::vector<LinearFunctionPtr> lfs;
   std::vector<char> rowtypes;
-  std::vector<std::string> rownamesvec;
   std::vector<double> rowrhs, rowranges;
-  std::string objname;
-  std::map<std::string,int> rownames;
-  std::map<std::string,int> colnames;
-  VariablePtr v;
+  MpsNames rownames, colnames;
+  DoubleVector collb, colub;
+  std::vector<VariableType> coltypes;
+  VarVector vars;
+  UIntVector erow, ecol; // row and column of each coefficient
+  DoubleVector eval;     // coefficients in the order they were read
+  UIntVector rstart, epos;
+  std::vector<const char*> lb_blk, le_blk; // lines of a block of COLUMNS
+  std::vector<MpsColLine> cl_blk;
+  int lcnt0, threads;
+  MpsWord lastcol;
+  int lastc = -1;
   FunctionPtr f;
   double dval, lb, ub;
-  std::string::size_type echars; // size of string
 
   int section = 0; // 0: None, 1: NAME, 2: ROWS, 3: COLUMNS, 4: RHS,
                    // 5: RANGES, 6: BOUNDS, 7: ENDDATA
 
   err = 0;
-  fs.open(fname.c_str());
-  if (!fs.is_open()) {
+  if (!file.open(fname)) {
     logger_->errStream() << me_ << "could not open file " << fname
       << " for reading" << std::endl;
     err = 1;
     return 0;
-  } 
+  }
 
-  logger_->msgStream(LogInfo) << me_ << "reading MPS file " << fname 
+  logger_->msgStream(LogInfo) << me_ << "reading MPS file " << fname
     << std::endl;
 
   p = new Problem(env_);
+  threads = env_->getOptions()->findInt("threads")->getValue();
+  threads = (threads > 1) ? threads : 1;
 
+  rhsid.s = rangeid.s = bndid.s = lastcol.s = 0;
+  rhsid.len = rangeid.len = bndid.len = lastcol.len = 0;
   vtype = Continuous;
   m = n = 0;
   lcnt = 0;
-  while (0==err && 7!=section && std::getline(fs, line)) {
-    iss.clear();   // deletes only flags internal to iss
-    iss.str(line); // convert line into ifstream
+  b = file.begin();
+  eof = file.end();
+  while (0==err && 7!=section && b<eof) {
+    e = mpsEol(b, eof);
     ++lcnt;
+    nw = mpsSplit(b, e, w, 5);
 
-    // std::cout << line <<  std::endl;
-
-    if (!(iss >> word)) {
+    if (0==nw) {
+      b = e+1;
       continue; // empty line
     }
 
-    comment = false;
-    if ('*'==word[0]) {
-      comment = true;
+    if ('*'==w[0].s[0]) {
+      b = e+1;
       continue; // ignore line, because it is a comment
     }
 
     // check if a new section starts
-    if (line[0] == word[0]) { // we have no white space in the beginning
-      if (word=="NAME") {
+    if (mpsIsSection(b, w[0])) { // we have no white space in the beginning
+      if (mpsIs(w[0], "NAME")) {
         section = 1;
-        continue;
-      } else if (word=="ROWS") {
+      } else if (mpsIs(w[0], "ROWS")) {
         section = 2;
-        continue;
-      } else if (word=="COLUMNS") {
+      } else if (mpsIs(w[0], "COLUMNS")) {
         section = 3;
-        continue;
-      } else if (word=="RHS") {
+      } else if (mpsIs(w[0], "RHS")) {
         section = 4;
-        continue;
-      } else if (word=="RANGES") {
+      } else if (mpsIs(w[0], "RANGES")) {
         section = 5;
-        continue;
-      } else if (word=="BOUNDS") {
+      } else if (mpsIs(w[0], "BOUNDS")) {
         section = 6;
-        continue;
-      } else if (word=="ENDATA") {
+      } else {
         section = 7;
-        continue;
       }
+      b = e+1;
+      continue;
     }
 
     // we are in an existing section
     switch (section) {
     case(0):
-      if (!comment) {
-        logger_->errStream() << me_ << "error while parsing the MPS file in line " << lcnt
-          << std::endl << line  <<  std::endl;
-        err = 10;
-      }
+      logger_->errStream() << me_ << "error while parsing the MPS file in line " << lcnt
+        << std::endl << std::string(b, e)  <<  std::endl;
+      err = 10;
       break;
     case(1): // NAME can be ignored for now
       break;
     case(2): // ROWS
-      if (word[0] == 'N' || word[0] == 'G' || word[0] == 'L'
-          || word[0] == 'E' ) {
-        rowtypes.push_back(word[0]);
+      if (w[0].s[0] == 'N' || w[0].s[0] == 'G' || w[0].s[0] == 'L'
+          || w[0].s[0] == 'E' ) {
+        rowtypes.push_back(w[0].s[0]);
         rowrhs.push_back(INFINITY);
         rowranges.push_back(INFINITY);
 
-        if (!(iss>>word)) { // read the next word
+        if (nw<2) { // read the next word
           logger_->errStream() << me_ << "ERROR: Missing row name in line " << lcnt
             << std::endl;
           err = 10;
-        } else if (rownames.find(word)==rownames.end()) {
-          rownames[word] = m;
-          rownamesvec.push_back(word);
+        } else if (rownames.find(w[1])<0) {
+          rownames.add(w[1]);
           lfs.push_back(new LinearFunction());
           ++m;
         } else {
-          logger_->errStream() << me_ << "ERROR: Row " << word 
+          logger_->errStream() << me_ << "ERROR: Row "
+            << std::string(w[1].s, w[1].len)
             << " seen more than once in the ROWS section of MPS file "
             << std::endl;
           err = 10;
         }
 
-        if (0==err && (iss>>word)) { // check for eol
-          logger_->errStream() << me_ << "ERROR: line " << lcnt 
-            << " should have ended before " << word << std::endl;
+        if (0==err && nw>2) { // check for eol
+          logger_->errStream() << me_ << "ERROR: line " << lcnt
+            << " should have ended before "
+            << std::string(w[2].s, w[2].len) << std::endl;
           err = 10;
         }
       } else {
-        logger_->errStream() << me_ << "Unexpected word " << word
+        logger_->errStream() << me_ << "Unexpected word "
+          << std::string(w[0].s, w[0].len)
           << " in line " << lcnt << std::endl;
         err = 10;
       }
       break;
     case(3): // COLUMNS
-      // Read the next two words. Every line must have 3 or 5 words
-      if (!(iss >> word2)  || !(iss >> word3)) {
-        logger_->errStream() << me_ << "ERROR: not enough fields in column "
-          << "line " << lcnt  << std::endl;
-        err = 10;
-        break;
-      } 
+      // Collect a block of lines up to the next section, parse their numbers
+      // and row names in parallel, and then add the columns in order.
+      lb_blk.clear();
+      le_blk.clear();
+      lcnt0 = lcnt;
+      while (b<eof && lb_blk.size()<mpsBlock) {
+        e = mpsEol(b, eof);
+        nw = mpsSplit(b, e, w, 1);
+        if (nw>0 && mpsIsSection(b, w[0])) {
+          break;
+        }
+        lb_blk.push_back(b);
+        le_blk.push_back(e);
+        b = e+1;
+      }
+      cl_blk.resize(lb_blk.size());
+#pragma omp parallel for num_threads(threads) schedule(static) if (threads>1) private(w)
+      for (UInt i=0; i<lb_blk.size(); ++i) {
+        MpsColLine *cl = &(cl_blk[i]);
+        cl->nw = mpsSplit(lb_blk[i], le_blk[i], w, 5);
+        for (UInt k=0; k<2; ++k) {
+          cl->row[k] = -1;
+          cl->ok[k] = false;
+          if (cl->nw>2*k+2 && '*'!=w[0].s[0]) {
+            cl->row[k] = rownames.find(w[2*k+1]);
+            cl->ok[k] = mpsNum(w[2*k+2], &(cl->val[k]));
+          }
+        }
+      }
 
-      if (word2 == "'MARKER'") {
-        if (word3 == "'INTORG'") {
-          if (Integer==vtype) {
-            logger_->errStream() << me_ << "ERROR: 'INTORG' seen within " 
-              << "'INTORG' section, line " << lcnt << std::endl;
-            err = 10;
+      for (UInt i=0; 0==err && i<lb_blk.size(); ++i) {
+        const MpsColLine *cl = &(cl_blk[i]);
+        lcnt = lcnt0+i;
+        if (0==cl->nw) {
+          continue; // empty line
+        }
+        mpsSplit(lb_blk[i], le_blk[i], w, 5);
+        if ('*'==w[0].s[0]) {
+          continue; // comment
+        }
+        // Read the next two words. Every line must have 3 or 5 words
+        if (cl->nw<3) {
+          logger_->errStream() << me_ << "ERROR: not enough fields in column "
+            << "line " << lcnt  << std::endl;
+          err = 10;
+          break;
+        }
+
+        if (mpsIs(w[1], "'MARKER'")) {
+          if (mpsIs(w[2], "'INTORG'")) {
+            if (Integer==vtype) {
+              logger_->errStream() << me_ << "ERROR: 'INTORG' seen within "
+                << "'INTORG' section, line " << lcnt << std::endl;
+              err = 10;
+            } else {
+              vtype = Integer;
+            }
+          } else if (mpsIs(w[2], "'INTEND'")) {
+            if (Continuous==vtype) {
+              logger_->errStream() << me_ << "ERROR: 'INTEND' seen outside "
+                << "'INTORG' section, line " << lcnt << std::endl;
+              err = 10;
+            } else {
+              vtype = Continuous;
+            }
           } else {
-            vtype = Integer;
-          }
-        } else if (word3 == "'INTEND'") {
-          if (Continuous==vtype) {
-            logger_->errStream() << me_ << "ERROR: 'INTEND' seen outside " 
-              << "'INTORG' section, line " << lcnt << std::endl;
+            logger_->errStream() << me_ << "ERROR: Unknown marker "
+              << std::string(w[2].s, w[2].len)
+              << " in line " << lcnt << std::endl;
             err = 10;
-          } else {
-            vtype = Continuous;
           }
-        } else {
-          logger_->errStream() << me_ << "ERROR: Unknown marker " << word3
-            << " in line " << lcnt << std::endl;
-          err = 10;
-        }
-      } else if (rownames.find(word2)==rownames.end()) {
-          logger_->errStream() << me_ << "ERROR: rowname " << word2
+          continue;
+        } else if (cl->row[0]<0) {
+          logger_->errStream() << me_ << "ERROR: rowname "
+            << std::string(w[1].s, w[1].len)
             << " in line " << lcnt << " undeclared " << std::endl;
-          break;
-      } else {
-        if (colnames.find(word)==colnames.end()) {
-          v = p->newVariable(0, INFINITY, vtype, word);
-          colnames[word] = n;
+          continue;
+        }
+
+        // consecutive lines usually have the same column.
+        if (lastc>=0 && w[0].len==lastcol.len &&
+            0==memcmp(w[0].s, lastcol.s, w[0].len)) {
+          c = lastc;
+        } else if ((c = colnames.find(w[0]))<0) {
+          c = colnames.add(w[0]);
+          collb.push_back(0.0);
+          colub.push_back(INFINITY);
+          coltypes.push_back(vtype);
           ++n;
-        } else {
-          v = p->getVariable(colnames[word]); 
         }
-        dval = std::stod(word3, &echars);
-        r = rownames[word2];
-        lfs[r]->incTerm(v,dval);
+        lastc = c;
+        lastcol = w[0];
+        if (false==cl->ok[0]) {
+          logger_->errStream() << me_ << "ERROR: bad number "
+            << std::string(w[2].s, w[2].len) << " in line " << lcnt
+            << std::endl;
+          err = 10;
+          break;
+        }
+        erow.push_back(cl->row[0]);
+        ecol.push_back(c);
+        eval.push_back(cl->val[0]);
 
         // we may have two more terms (but not one)
-        if (iss >> word2) {
-          if (!(iss >> word3)) {
+        if (cl->nw>3) {
+          if (cl->nw<5) {
             logger_->errStream() << me_ << "ERROR: not enough fields in column "
               << "line " << lcnt << std::endl;
             err = 10;
             break;
-          } else if (rownames.find(word2)==rownames.end()) {
-            logger_->errStream() << me_ << "ERROR: rowname " << word2
+          } else if (cl->row[1]<0) {
+            logger_->errStream() << me_ << "ERROR: rowname "
+              << std::string(w[3].s, w[3].len)
               << " in line " << lcnt << " undeclared " << std::endl;
             err = 10;
             break;
+          } else if (false==cl->ok[1]) {
+            logger_->errStream() << me_ << "ERROR: bad number "
+              << std::string(w[4].s, w[4].len) << " in line " << lcnt
+              << std::endl;
+            err = 10;
+            break;
           }
-          dval = std::stod(word3, &echars);
-          r = rownames[word2];
-          lfs[r]->incTerm(v,dval);
+          erow.push_back(cl->row[1]);
+          ecol.push_back(c);
+          eval.push_back(cl->val[1]);
         }
       }
-      break;
+      lcnt = lcnt0+lb_blk.size()-1;
+      // b is at the line after the block already.
+      continue;
     case(4): // RHS
-      if (rhsid=="") {
-        rhsid = word;
-      } else if (word != rhsid) {
-        logger_->msgStream(LogError) << me_ << rhsid << " ignored in line " 
+      if (0==rhsid.len) {
+        rhsid = w[0];
+      } else if (w[0].len!=rhsid.len || memcmp(w[0].s, rhsid.s, rhsid.len)) {
+        logger_->msgStream(LogError) << me_
+          << std::string(rhsid.s, rhsid.len) << " ignored in line "
           << lcnt << std::endl;
         break;
       }
-      if (!(iss >> word2)  || !(iss >> word3)) {
+      if (nw<3) {
         logger_->errStream() << me_ << "ERROR: not enough fields in column "
           << "line " << lcnt << std::endl;
         err = 10;
         break;
-      } else if (rownames.find(word2)==rownames.end()) {
-        logger_->errStream() << me_ << "ERROR: rowname " << word2
+      } else if ((r = rownames.find(w[1]))<0) {
+        logger_->errStream() << me_ << "ERROR: rowname "
+          << std::string(w[1].s, w[1].len)
           << " in line " << lcnt << " undeclared " << std::endl;
         break;
+      } else if (!mpsNum(w[2], &dval)) {
+        logger_->errStream() << me_ << "ERROR: bad number "
+          << std::string(w[2].s, w[2].len) << " in line " << lcnt
+          << std::endl;
+        err = 10;
+        break;
       } else {
-        dval = std::stod(word3, &echars);
-        r = rownames[word2];
         if (rowrhs[r] != INFINITY) { // if previously set, warn
-          logger_->msgStream(LogExtraInfo) << me_ 
-            << "Warning: overwriting rhs for row " << word2 << " in line " 
+          logger_->msgStream(LogExtraInfo) << me_
+            << "Warning: overwriting rhs for row "
+            << std::string(w[1].s, w[1].len) << " in line "
             << lcnt << std::endl;
         }
         rowrhs[r] = dval;
 
         // we may have two more terms (but not one)
-        if (iss >> word2) {
-          if (!(iss >> word3)) {
+        if (nw>3) {
+          if (nw<5) {
             logger_->errStream() << me_ << "ERROR: not enough fields in rhs "
               << "line " << lcnt << std::endl;
             err = 10;
             break;
-          } else if (rownames.find(word2)==rownames.end()) {
-            logger_->errStream() << me_ << "ERROR: rowname " << word2
+          } else if ((r = rownames.find(w[3]))<0) {
+            logger_->errStream() << me_ << "ERROR: rowname "
+              << std::string(w[3].s, w[3].len)
               << " in line " << lcnt << " undeclared " << std::endl;
             err = 10;
             break;
+          } else if (!mpsNum(w[4], &dval)) {
+            logger_->errStream() << me_ << "ERROR: bad number "
+              << std::string(w[4].s, w[4].len) << " in line " << lcnt
+              << std::endl;
+            err = 10;
+            break;
           }
-          dval = std::stod(word3, &echars);
-          r = rownames[word2];
           if (rowrhs[r] != INFINITY) { // if previously set, warn
-            logger_->msgStream(LogExtraInfo) << me_ 
-              << "Warning: overwriting rhs for row " << word2 << " in line " 
+            logger_->msgStream(LogExtraInfo) << me_
+              << "Warning: overwriting rhs for row "
+              << std::string(w[3].s, w[3].len) << " in line "
               << lcnt << std::endl;
           }
           rowrhs[r] = dval;
@@ -289,51 +636,65 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
       }
       break;
     case(5): // RANGES
-      if (rangeid=="") {
-        rangeid = word;
-      } else if (word != rangeid) {
-        logger_->msgStream(LogError) << me_ << rangeid << " ignored in line " 
+      if (0==rangeid.len) {
+        rangeid = w[0];
+      } else if (w[0].len!=rangeid.len ||
+                 memcmp(w[0].s, rangeid.s, rangeid.len)) {
+        logger_->msgStream(LogError) << me_
+          << std::string(rangeid.s, rangeid.len) << " ignored in line "
           << lcnt << std::endl;
         break;
       }
-      if (!(iss >> word2)  || !(iss >> word3)) {
+      if (nw<3) {
         logger_->errStream() << me_ << "ERROR: not enough fields in ranges "
           << "line " << lcnt << std::endl;
         err = 10;
         break;
-      } else if (rownames.find(word2)==rownames.end()) {
-        logger_->errStream() << me_ << "ERROR: rowname " << word2
+      } else if ((r = rownames.find(w[1]))<0) {
+        logger_->errStream() << me_ << "ERROR: rowname "
+          << std::string(w[1].s, w[1].len)
           << " in line " << lcnt << " undeclared " << std::endl;
         break;
+      } else if (!mpsNum(w[2], &dval)) {
+        logger_->errStream() << me_ << "ERROR: bad number "
+          << std::string(w[2].s, w[2].len) << " in line " << lcnt
+          << std::endl;
+        err = 10;
+        break;
       } else {
-        dval = std::stod(word3, &echars);
-        r = rownames[word2];
         if (rowranges[r] != INFINITY) { // warn
-          logger_->msgStream(LogExtraInfo) << me_ 
-            << "Warning: overwriting range for row " << word2 << " in line " 
+          logger_->msgStream(LogExtraInfo) << me_
+            << "Warning: overwriting range for row "
+            << std::string(w[1].s, w[1].len) << " in line "
             << lcnt << std::endl;
         }
         rowranges[r] = dval;
       }
 
       // we may have two more terms (but not one)
-      if (iss >> word2) {
-        if (!(iss >> word3)) {
+      if (nw>3) {
+        if (nw<5) {
           logger_->errStream() << me_ << "ERROR: not enough fields in ranges "
             << "line " << lcnt << std::endl;
           err = 10;
           break;
-        } else if (rownames.find(word2)==rownames.end()) {
-          logger_->errStream() << me_ << "ERROR: rowname " << word2
+        } else if ((r = rownames.find(w[3]))<0) {
+          logger_->errStream() << me_ << "ERROR: rowname "
+            << std::string(w[3].s, w[3].len)
             << " in line " << lcnt << " undeclared " << std::endl;
           err = 10;
           break;
+        } else if (!mpsNum(w[4], &dval)) {
+          logger_->errStream() << me_ << "ERROR: bad number "
+            << std::string(w[4].s, w[4].len) << " in line " << lcnt
+            << std::endl;
+          err = 10;
+          break;
         }
-        dval = std::stod(word3, &echars);
-        r = rownames[word2];
         if (rowranges[r] != INFINITY) { // warn
-          logger_->msgStream(LogExtraInfo) << me_ 
-            << "Warning: overwriting range for row " << word2 << " in line " 
+          logger_->msgStream(LogExtraInfo) << me_
+            << "Warning: overwriting range for row "
+            << std::string(w[3].s, w[3].len) << " in line "
             << lcnt << std::endl;
         }
         rowranges[r] = dval;
@@ -346,64 +707,71 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
       // UP BND x1 40
       // UP BND x1 50
       // then the ub of x1 is set to 50.
-      if (!(iss >> word2)  || !(iss >> word3)) {
+      if (nw<3) {
         logger_->errStream() << me_ << "ERROR: not enough fields in BOUNDS "
           << "line " << lcnt << std::endl;
         err = 10;
         break;
-      } else if (bndid=="") {
-        bndid = word2;
-      } else if (word2 != bndid) {
-        logger_->msgStream(LogError) << me_ << "Warning: " << bndid 
+      } else if (0==bndid.len) {
+        bndid = w[1];
+      } else if (w[1].len!=bndid.len || memcmp(w[1].s, bndid.s, bndid.len)) {
+        logger_->msgStream(LogError) << me_ << "Warning: "
+          << std::string(bndid.s, bndid.len)
           << " ignored in line " << lcnt << std::endl;
         break;
-      } else if (colnames.find(word3)==colnames.end()) {
-        logger_->errStream() << me_ << "ERROR: column name " << word2
+      }
+      if ((c = colnames.find(w[2]))<0) {
+        logger_->errStream() << me_ << "ERROR: column name "
+          << std::string(w[1].s, w[1].len)
           << " in line " << lcnt << " undeclared " << std::endl;
         err = 10;
         break;
       }
 
       dval = INFINITY;
-      if (iss >> word4) {
-        dval = std::stod(word4, &echars);
-      } else if (word3=="LO" || word3=="UP" || word3=="FX") {
-        logger_->msgStream(LogError) << me_ << "ERROR: " << word3 
+      if (nw>3) {
+        if (!mpsNum(w[3], &dval)) {
+          logger_->errStream() << me_ << "ERROR: bad number "
+            << std::string(w[3].s, w[3].len) << " in line " << lcnt
+            << std::endl;
+          err = 10;
+          break;
+        }
+      } else if (mpsIs(w[0], "LO") || mpsIs(w[0], "UP") ||
+                 mpsIs(w[0], "FX")) {
+        logger_->msgStream(LogError) << me_ << "ERROR: "
+          << std::string(w[0].s, w[0].len)
           << " key requires a number in line " << lcnt << std::endl;
         err = 10;
         break;
       }
-      v = p->getVariable(colnames[word3]);
-      if (word=="LO") {
-        p->changeBound(v, Lower, dval);
-      } else if (word=="UP") {
-        if (dval < 0.0) {
-          if (v->getLb() == 0.0) {
-            p->changeBound(v, -INFINITY, dval);
-          } else {
-            p->changeBound(v, Upper, dval);
-          }
-        } else {
-          p->changeBound(v, Upper, dval);
+      if (mpsIs(w[0], "LO")) {
+        collb[c] = dval;
+      } else if (mpsIs(w[0], "UP")) {
+        if (dval < 0.0 && collb[c] == 0.0) {
+          collb[c] = -INFINITY;
         }
-      } else if (word=="FX") {
-        p->changeBound(v, dval, dval);
-      } else if (word=="FR") {
-        p->changeBound(v, -INFINITY, INFINITY);
-      } else if (word=="MI") {
-        p->changeBound(v, Lower, -INFINITY);
-      } else if (word=="PL") {
-        p->changeBound(v, Upper, INFINITY);
-      } else if (word=="BV") {
-        p->setVarType(v, Binary);
-      } else if (word=="LI") {
-        p->setVarType(v, Integer);
-        p->changeBound(v, Lower, dval);
-      } else if (word=="UI") {
-        p->setVarType(v, Integer);
-        p->changeBound(v, Upper, dval);
+        colub[c] = dval;
+      } else if (mpsIs(w[0], "FX")) {
+        collb[c] = colub[c] = dval;
+      } else if (mpsIs(w[0], "FR")) {
+        collb[c] = -INFINITY;
+        colub[c] = INFINITY;
+      } else if (mpsIs(w[0], "MI")) {
+        collb[c] = -INFINITY;
+      } else if (mpsIs(w[0], "PL")) {
+        colub[c] = INFINITY;
+      } else if (mpsIs(w[0], "BV")) {
+        coltypes[c] = Binary;
+      } else if (mpsIs(w[0], "LI")) {
+        coltypes[c] = Integer;
+        collb[c] = dval;
+      } else if (mpsIs(w[0], "UI")) {
+        coltypes[c] = Integer;
+        colub[c] = dval;
       } else {
-        logger_->errStream() << me_ << "ERROR: unknown bound type " << word
+        logger_->errStream() << me_ << "ERROR: unknown bound type "
+          << std::string(w[0].s, w[0].len)
           << " in line " << lcnt << std::endl;
         err = 10;
         break;
@@ -414,8 +782,34 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
     default:
       break;
     }
+    b = e+1;
+  }
+
+  // variables in the order in which their columns were first seen.
+  vars.reserve(n);
+  for (c=0; c<n; ++c) {
+    vars.push_back(p->newVariable(collb[c], colub[c], coltypes[c],
+                                  colnames.getName(c)));
+  }
+
+  // sort coefficients by row, keeping the order in which they were read, so
+  // that repeated coefficients are added in the same order.
+  rstart.assign(m+1, 0);
+  for (UInt i=0; i<erow.size(); ++i) {
+    ++rstart[erow[i]+1];
+  }
+  for (r=0; r<m; ++r) {
+    rstart[r+1] += rstart[r];
+  }
+  epos.resize(erow.size());
+  for (UInt i=0; i<erow.size(); ++i) {
+    epos[rstart[erow[i]]++] = i;
+  }
+  for (UInt i=0, k=0; k<(UInt) m; ++k) {
+    for (; i<rstart[k]; ++i) {
+      lfs[k]->incTerm(vars[ecol[epos[i]]], eval[epos[i]]);
+    }
   }
-  fs.close();
 
   // put all cons in p
   for (int i=0; i<m; ++i) {
@@ -455,14 +849,14 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
       break;
     }
     if (rowtypes[i] != 'N') {
-      p->newConstraint(f,lb,ub,rownamesvec[i]);
+      p->newConstraint(f,lb,ub,rownames.getName(i));
     } else if (p->getObjective()) {
-      logger_->msgStream(LogError) << me_ << "Warning: ignored objective " 
-        << rownamesvec[i] << std::endl;
+      logger_->msgStream(LogError) << me_ << "Warning: ignored objective "
+        << rownames.getName(i) << std::endl;
       delete f; f = 0;
     } else {
       lb = (rowrhs[i] == INFINITY)?0.0:-rowrhs[i];
-      p->newObjective(f, lb, Minimize, rownamesvec[i]);
+      p->newObjective(f, lb, Minimize, rownames.getName(i));
     }
   }
 
@@ -475,65 +869,77 @@ ProblemPtr Reader::readMps(std::string fname, int &err)
 int Reader::readSol(ProblemPtr p, std::string sname)
 {
   int err = 0;
-  int lcnt = 0, vcnt = 0;
-  std::ifstream fs;
-  std::istringstream iss;
-  std::string line, word, word2;
-  std::string rhsid="";
+  int lcnt = 0, vcnt;
+  MpsFile file;
+  MpsNames vnames;
+  MpsWord w[2];
+  UInt nw;
+  const char *b, *e, *eof;
   DoubleVector x(p->getNumVars(),0.0);
   std::vector<std::string> names;
-  std::string::size_type echars; // size of string
-  bool found = false;
   double dval;
 
-  fs.open(sname.c_str());
-  if (!fs.is_open()) {
+  if (!file.open(sname)) {
     logger_->errStream() << me_ << "could not open file " << sname
       << " for reading" << std::endl;
     return 1;
-  } 
+  }
 
-  logger_->msgStream(LogInfo) << me_ << "reading solution file " << sname 
+  logger_->msgStream(LogInfo) << me_ << "reading solution file " << sname
     << std::endl;
 
-  while (0==err && std::getline(fs, line)) {
-    iss.clear();   // deletes only flags internal to iss
-    iss.str(line); // convert line into ifstream
-    ++lcnt;
+  // the table points to these names. If two variables have the same name,
+  // the first one gets the value.
+  names.reserve(p->getNumVars());
+  for (VariableConstIterator it=p->varsBegin(); it!=p->varsEnd(); ++it) {
+    names.push_back((*it)->getName());
+  }
+  for (UInt i=0; i<names.size(); ++i) {
+    w[0].s = names[i].c_str();
+    w[0].len = names[i].size();
+    if (vnames.find(w[0])<0) {
+      vnames.add(w[0]);
+    } else {
+      // keep the positions in the table equal to the variable indices.
+      w[0].len = 0;
+      vnames.add(w[0]);
+    }
+  }
 
-    // std::cout << line <<  std::endl;
+  b = file.begin();
+  eof = file.end();
+  while (0==err && b<eof) {
+    e = mpsEol(b, eof);
+    ++lcnt;
+    nw = mpsSplit(b, e, w, 2);
+    b = e+1;
 
-    if (!(iss >> word)) {
+    if (0==nw) {
       continue; // empty line
     }
 
-    if ('#'==word[0]) {
+    if ('#'==w[0].s[0]) {
       continue; // ignore line, because it is a comment
     }
 
-    if (!(iss >> word2)) {
+    if (nw<2) {
       logger_->errStream() << me_ << "ERROR: not enough fields in line "
         << lcnt << " of " << sname << std::endl;
       err = 1;
-    } else {
+    } else if (!mpsNum(w[1], &dval)) {
+      logger_->errStream() << me_ << "ERROR: bad number "
+        << std::string(w[1].s, w[1].len) << " in line " << lcnt << " of "
+        << sname << std::endl;
+      err = 1;
+    } else if ((vcnt = vnames.find(w[0]))<0) {
       // word = name-of-variable, and word2 = value
-      dval = std::stod(word2, &echars);
-      found = false;
-      vcnt = 0;
-      for (VariableConstIterator it=p->varsBegin(); it!=p->varsEnd(); ++it) {
-        if ((*it)->getName() == word) {
-          found = true;
-          x[vcnt] = dval;
-          break;
-        }
-        ++vcnt;
-      }
-      if (false==found) {
-        logger_->msgStream(LogError) << "Variable " << word 
-                                     << " not found in the solution file "
-                                     << sname << std::endl;
-        err = 1;
-      }
+      logger_->msgStream(LogError) << "Variable "
+                                   << std::string(w[0].s, w[0].len)
+                                   << " not found in the solution file "
+                                   << sname << std::endl;
+      err = 1;
+    } else {
+      x[vcnt] = dval;
     }
   }
 
@@ -544,3 +950,14 @@ int Reader::readSol(ProblemPtr p, std::string sname)
   return err;
 }
 
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
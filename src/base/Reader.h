@@ -28,6 +28,12 @@ namespace Minotaur {
    * \brief Read an LP or MILP instance from an MPS file
    *
    * MPS files are read following the CPLEX 12.8 documentation
+   *
+   * The file is memory-mapped and split into words in place. Row and column
+   * names are kept in hash tables that point into the file. The lines of the
+   * COLUMNS section are parsed in blocks by up to "threads" threads, and
+   * the coefficients are collected in arrays. Variables and constraints are
+   * created only after the whole file has been read.
    */
   class Reader {
   public:
@@ -13,7 +13,6 @@
 #include <algorithm>
 #include <cmath>
 #include <iomanip>
-#include <omp.h>
 
 #include "BrCand.h"
 #include "BrVarCand.h"
@@ -33,6 +32,7 @@
 #include "SolutionPool.h"
 #include "Timer.h"
 #include "Variable.h"
+#include "WarmStart.h"
 
 //#define SPEW 1
 
@@ -42,6 +42,7 @@ const std::string ReliabilityBrancher::me_ = "reliability brancher: ";
 
 ReliabilityBrancher::ReliabilityBrancher(EnvPtr env, HandlerVector& handlers)
   : engine_(EnginePtr()), // NULL
+    env_(env),
     eTol_(1e-6),
     handlers_(handlers), // Create a copy, the vector is not too big
     init_(false),
@@ -49,7 +50,9 @@ ReliabilityBrancher::ReliabilityBrancher(EnvPtr env, HandlerVector& handlers)
     maxIterations_(25),
     maxStrongCands_(20),
     minNodeDist_(50),
+    numThreads_(1),
     rel_(RelaxationPtr()), // NULL
+    strSrc_(0),
     status_(NotModifiedByBrancher),
     thresh_(4),
     trustCutoff_(true),
@@ -68,10 +71,28 @@ ReliabilityBrancher::ReliabilityBrancher(EnvPtr env, HandlerVector& handlers)
 
 ReliabilityBrancher::~ReliabilityBrancher()
 {
+  for(UInt i = 0; i < strEngines_.size(); ++i) {
+    strEngines_[i]->clear();
+    if(strRels_[i]) {
+      delete strRels_[i];
+    }
+    delete strEngines_[i];
+  }
   delete stats_;
   delete timer_;
 }
 
+void ReliabilityBrancher::clearStrRels_()
+{
+  for(UInt t = 0; t < strRels_.size(); ++t) {
+    if(strRels_[t]) {
+      strEngines_[t]->clear();
+      delete strRels_[t];
+      strRels_[t] = 0;
+    }
+  }
+}
+
 BrCandPtr ReliabilityBrancher::findBestCandidate_(const double objval,
                                                   double cutoff, NodePtr node)
 {
@@ -99,14 +120,50 @@ BrCandPtr ReliabilityBrancher::findBestCandidate_(const double objval,
   // now do strong branching on unreliable candidates
   if(unrelCands_.size() > 0) {
     BrCandVIter it;
-    engine_->enableStrBrSetup();
-    engine_->setIterationLimit(maxIterations_); // TODO: make limit dynamic.
-    cnt = 0;
+    DoubleVector obj_up, obj_down;
+    std::vector<EngineStatus> st_up, st_down;
+    bool par = false;
+    UInt nt = 0, batch_end = 0;
+
     maxcnt = (node->getDepth() > maxDepth_) ? 0 : maxStrongCands_;
+    maxcnt = std::min(maxcnt, (UInt)unrelCands_.size());
+    if(numThreads_ > 1 && maxcnt > 1) {
+      nt = std::min(numThreads_, maxcnt);
+      par = startStrongBranchPar_(nt);
+    }
+    if(par) {
+      obj_up.resize(maxcnt);
+      obj_down.resize(maxcnt);
+      st_up.resize(maxcnt);
+      st_down.resize(maxcnt);
+    } else {
+      engine_->enableStrBrSetup();
+      engine_->setIterationLimit(maxIterations_); // TODO: make limit dynamic.
+    }
+    cnt = 0;
     for(it = unrelCands_.begin(); it != unrelCands_.end() && cnt < maxcnt;
         ++it, ++cnt) {
       cand = *it;
-      strongBranch_(cand, change_up, change_down, status_up, status_down);
+      if(par) {
+        if(cnt == batch_end) {
+          // solve the next nt candidates at once, and then use the results
+          // in the same order as in the serial case. We stop after the
+          // batch in which a candidate prunes the node or changes bounds.
+          batch_end = std::min(cnt + nt, maxcnt);
+          strongBranchPar_(cnt, batch_end, obj_up, obj_down, st_up, st_down);
+        }
+        change_up = obj_up[cnt];
+        change_down = obj_down[cnt];
+        status_up = st_up[cnt];
+        status_down = st_down[cnt];
+      } else {
+        timer_->start();
+        strongBranch_(cand, engine_, rel_, change_up, change_down, status_up,
+                      status_down);
+        stats_->strTime += timer_->query();
+        timer_->stop();
+        stats_->strBrCalls += 2;
+      }
       change_up = std::max(change_up - objval, 0.0);
       change_down = std::max(change_down - objval, 0.0);
       useStrongBranchInfo_(cand, maxchange, change_up, change_down, status_up,
@@ -129,8 +186,15 @@ BrCandPtr ReliabilityBrancher::findBestCandidate_(const double objval,
         }
       }
     }
-    engine_->resetIterationLimit();
-    engine_->disableStrBrSetup();
+    if(par) {
+      for(UInt t = 0; t < nt; ++t) {
+        strEngines_[t]->resetIterationLimit();
+        strEngines_[t]->disableStrBrSetup();
+      }
+    } else {
+      engine_->resetIterationLimit();
+      engine_->disableStrBrSetup();
+    }
     if(NotModifiedByBrancher == status_) {
       // get score of remaining unreliable candidates as well.
       for(; it != unrelCands_.end(); ++it) {
@@ -404,6 +468,15 @@ void ReliabilityBrancher::setTrustCutoff(bool val)
 
 void ReliabilityBrancher::setEngine(EnginePtr engine)
 {
+  // copies of the old engine and what they loaded are not used again.
+  clearStrRels_();
+  for(UInt t = 0; t < strEngines_.size(); ++t) {
+    delete strEngines_[t];
+  }
+  strEngines_.clear();
+  strRels_.clear();
+  strVersions_.clear();
+  strSrc_ = 0;
   engine_ = engine;
 }
 
@@ -412,6 +485,11 @@ void ReliabilityBrancher::setIterLim(UInt k)
   maxIterations_ = k;
 }
 
+void ReliabilityBrancher::setNumThreads(UInt k)
+{
+  numThreads_ = std::max(k, (UInt)1);
+}
+
 void ReliabilityBrancher::setMaxDepth(UInt k)
 {
   maxDepth_ = k;
@@ -466,43 +544,157 @@ bool ReliabilityBrancher::shouldPrune_(const double& chcutoff,
   return false;
 }
 
-void ReliabilityBrancher::strongBranch_(BrCandPtr cand, double& obj_up,
+void ReliabilityBrancher::strongBranch_(BrCandPtr cand, EnginePtr engine,
+                                        RelaxationPtr rel, double& obj_up,
                                         double& obj_down,
                                         EngineStatus& status_up,
                                         EngineStatus& status_down)
 {
   HandlerPtr h = cand->getHandler();
-  ModificationPtr mod;
-
-  // first do down.
-  mod = h->getBrMod(cand, x_, rel_, DownBranch);
-  mod->applyToProblem(rel_);
+  ModificationPtr mod, rmod;
+
+  // first do down. Handlers create modifications for rel_. Translate them if
+  // we are solving a copy.
+#pragma omp critical(relBrMod)
+  {
+    mod = h->getBrMod(cand, x_, rel_, DownBranch);
+    rmod = (rel == rel_) ? mod : mod->toRel(rel_, rel);
+  }
+  rmod->applyToProblem(rel);
   //std::cout << "down relax ******\n";
-  //rel_->write(std::cout);
+  //rel->write(std::cout);
 
-  timer_->start();
-  status_down = engine_->solve();
-  stats_->strTime += timer_->query();
-  timer_->stop();
-  ++(stats_->strBrCalls);
-  obj_down = engine_->getSolutionValue();
-  mod->undoToProblem(rel_);
+  status_down = engine->solve();
+  obj_down = engine->getSolutionValue();
+  rmod->undoToProblem(rel);
+  if(rmod != mod) {
+    delete rmod;
+  }
   delete mod;
 
   // now go up.
-  mod = h->getBrMod(cand, x_, rel_, UpBranch);
-  mod->applyToProblem(rel_);
+#pragma omp critical(relBrMod)
+  {
+    mod = h->getBrMod(cand, x_, rel_, UpBranch);
+    rmod = (rel == rel_) ? mod : mod->toRel(rel_, rel);
+  }
+  rmod->applyToProblem(rel);
   //std::cout << "up relax ******\n";
-  //rel_->write(std::cout);
+  //rel->write(std::cout);
+
+  status_up = engine->solve();
+  obj_up = engine->getSolutionValue();
+  rmod->undoToProblem(rel);
+  if(rmod != mod) {
+    delete rmod;
+  }
+  delete mod;
+}
+
+bool ReliabilityBrancher::startStrongBranchPar_(UInt nt)
+{
+  WarmStartPtr ws;
+  UInt version = rel_->getStructVersion();
+
+  while(strEngines_.size() < nt) {
+    EnginePtr e = engine_->emptyCopy();
+    if(!e) {
+      logger_->msgStream(LogInfo)
+          << me_ << "engine " << engine_->getName() << " can not be copied. "
+          << "Using one thread for strong branching." << std::endl;
+      numThreads_ = 1;
+      return false;
+    }
+    strEngines_.push_back(e);
+    strRels_.push_back(0);
+    strVersions_.push_back(0);
+  }
+
+  // a new relaxation may be at the address of a freed one, so its id is
+  // compared.
+  if(strSrc_ != rel_->getId()) {
+    clearStrRels_();
+    strSrc_ = rel_->getId();
+  }
 
   timer_->start();
-  status_up = engine_->solve();
+  ws = engine_->getWarmStartCopy();
+#pragma omp parallel for num_threads(nt) schedule(static, 1)
+  for(UInt t = 0; t < nt; ++t) {
+    EnginePtr e = strEngines_[t];
+
+    if(!strRels_[t] || strVersions_[t] != version) {
+      // constraints or variables of rel_ changed. Load a fresh copy.
+      e->clear();
+      if(strRels_[t]) {
+        delete strRels_[t];
+      }
+      strRels_[t] = (RelaxationPtr) new Relaxation(rel_, env_);
+      strRels_[t]->prepareForSolve();
+      e->load(strRels_[t]);
+      strVersions_[t] = version;
+    } else {
+      syncStrRel_(strRels_[t]);
+    }
+    if(ws) {
+      e->loadFromWarmStart(ws);
+    }
+    e->enableStrBrSetup();
+    e->setIterationLimit(maxIterations_);
+  }
+  if(ws) {
+    delete ws;
+  }
   stats_->strTime += timer_->query();
   timer_->stop();
-  ++(stats_->strBrCalls);
-  obj_up = engine_->getSolutionValue();
-  mod->undoToProblem(rel_);
-  delete mod;
+  return true;
+}
+
+void ReliabilityBrancher::strongBranchPar_(UInt first, UInt last,
+                                           DoubleVector& obj_up,
+                                           DoubleVector& obj_down,
+                                           std::vector<EngineStatus>& status_up,
+                                           std::vector<EngineStatus>& status_down)
+{
+  timer_->start();
+#pragma omp parallel for num_threads(last - first) schedule(static, 1)
+  for(UInt i = first; i < last; ++i) {
+    UInt t = i - first;
+    strongBranch_(unrelCands_[i], strEngines_[t], strRels_[t], obj_up[i],
+                  obj_down[i], status_up[i], status_down[i]);
+  }
+  stats_->strTime += timer_->query();
+  timer_->stop();
+  stats_->strBrCalls += 2 * (last - first);
+}
+
+void ReliabilityBrancher::syncStrRel_(RelaxationPtr rel)
+{
+  VariableConstIterator vit, cvit;
+  ConstraintConstIterator cit, ccit;
+  VariablePtr v, cv;
+  ConstraintPtr c, cc;
+
+  // the engine is told about each change through the problem.
+  for(vit = rel_->varsBegin(), cvit = rel->varsBegin();
+      vit != rel_->varsEnd(); ++vit, ++cvit) {
+    v = *vit;
+    cv = *cvit;
+    if(v->getLb() != cv->getLb() || v->getUb() != cv->getUb()) {
+      rel->changeBound(cv, v->getLb(), v->getUb());
+    }
+  }
+  for(cit = rel_->consBegin(), ccit = rel->consBegin();
+      cit != rel_->consEnd(); ++cit, ++ccit) {
+    c = *cit;
+    cc = *ccit;
+    if(c->getLb() != cc->getLb()) {
+      rel->changeBound(cc, Lower, c->getLb());
+    }
+    if(c->getUb() != cc->getUb()) {
+      rel->changeBound(cc, Upper, c->getUb());
+    }
+  }
 }
 
 void ReliabilityBrancher::updateAfterSolve(NodePtr node, ConstSolutionPtr sol)
@@ -89,6 +89,16 @@ public:
    */
   void setIterLim(UInt k);
 
+  /**
+   * \brief Set the number of threads used in strong branching.
+   *
+   * If k is more than one, candidates are strong-branched concurrently,
+   * each thread using its own copy of the engine (see Engine::emptyCopy())
+   * and of the relaxation. The engine must be thread-safe.
+   * \param[in] k The new number of threads.
+   */
+  void setNumThreads(UInt k);
+
   /**
    * \brief Set the depth at which we stop strong branching.
    *
@@ -120,6 +130,9 @@ public:
 
 private:
 
+  /// Unload and free the copies of the relaxation used in strong branching.
+  void clearStrRels_();
+
   /**
    * \brief Find the variable that was selected for branching.
    * 
@@ -189,14 +202,55 @@ private:
   /** 
    * \brief Do strong branching on candidate.
    * \param[in] cand Candidate for strong branching.
+   * \param[in] engine Engine used to solve the relaxation.
+   * \param[in] rel Relaxation loaded into the engine. It is either rel_ or
+   * a copy of it.
    * \param[out] obj_up objective value estimate in up branch.
    * \param[out] obj_down objective value estimate in down branch.
    * \param[out] status_up engine status in up branch.
    * \param[out] status_down engine status in down branch.
    */
-  void strongBranch_(BrCandPtr cand, double & obj_up, double & obj_down, 
+  void strongBranch_(BrCandPtr cand, EnginePtr engine, RelaxationPtr rel,
+                     double & obj_up, double & obj_down, 
                      EngineStatus & status_up, EngineStatus & status_down);
 
+  /**
+   * \brief Prepare the engines used in parallel strong branching at this
+   * node.
+   *
+   * Copies of rel_ are kept from node to node. A copy is rebuilt only if
+   * constraints, variables or the objective of rel_ were changed since it
+   * was made. Otherwise only the changed bounds are copied, and the engine
+   * is updated through the bound changes. The warm start of engine_ is then
+   * loaded into each engine.
+   * \param[in] nt Number of threads to prepare.
+   * \return False if the engine can not be copied. Nothing is prepared in
+   * that case.
+   */
+  bool startStrongBranchPar_(UInt nt);
+
+  /**
+   * \brief Do strong branching on a batch of unreliable candidates
+   * concurrently.
+   *
+   * Thread t solves the candidate first+t with the t-th engine, so that
+   * results do not depend on scheduling. rel_ and engine_ are not modified.
+   * startStrongBranchPar_() must be called before.
+   * \param[in] first Index in unrelCands_ of the first candidate.
+   * \param[in] last One more than the index of the last candidate.
+   * \param[out] obj_up Objective values in up branches.
+   * \param[out] obj_down Objective values in down branches.
+   * \param[out] status_up Engine status in up branches.
+   * \param[out] status_down Engine status in down branches.
+   */
+  void strongBranchPar_(UInt first, UInt last, DoubleVector & obj_up,
+                        DoubleVector & obj_down,
+                        std::vector<EngineStatus> & status_up,
+                        std::vector<EngineStatus> & status_down);
+
+  /// Copy the bounds of variables and constraints of rel_ to a copy of it.
+  void syncStrRel_(RelaxationPtr rel);
+
   /**
    * \brief Update Pseudocost based on the new costs.
    *
@@ -252,6 +306,9 @@ private:
   /// The engine used for strong branching.
   EnginePtr engine_;
 
+  /// Environment, used to create copies of the relaxation.
+  EnvPtr env_;
+
   /// Tolerance for avoiding division by zero.
   const double eTol_;
 
@@ -294,6 +351,9 @@ private:
   /// Modifications that can be applied to the problem.
   ModVector mods_;
 
+  /// Number of threads used in strong branching.
+  UInt numThreads_;
+
   /// Vector of pseudocosts for rounding down.
   DoubleVector pseudoDown_;
 
@@ -309,6 +369,19 @@ private:
   /// Statistics.
   RelBrStats * stats_;
 
+  /// Engines used by each thread in parallel strong branching.
+  std::vector<EnginePtr> strEngines_;
+
+  /// Copies of relaxation loaded into strEngines_.
+  std::vector<RelaxationPtr> strRels_;
+
+  /// Id of the relaxation from which strRels_ were copied, see
+  /// Problem::getId(). 0 if none were.
+  UInt strSrc_;
+
+  /// Structure version of the relaxation when each of strRels_ was copied.
+  UIntVector strVersions_;
+
   /// Status of problem after using this brancher.
   BrancherStatus status_;
 
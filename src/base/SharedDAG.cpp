@@ -0,0 +1,334 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+/**
+ * \file SharedDAG.cpp
+ * \brief Implement the methods of SharedDAG class.
+ * \author The Minotaur Team
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include "MinotaurConfig.h"
+#include "CGraph.h"
+#include "CNode.h"
+#include "Constraint.h"
+#include "Function.h"
+#include "Objective.h"
+#include "Problem.h"
+#include "SharedDAG.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string SharedDAG::me_ = "SharedDAG: ";
+
+size_t SharedDAGKeyHash::operator()(const UIntVector &key) const
+{
+  size_t h = 14695981039346656037ULL;
+
+  for (UIntVector::const_iterator it=key.begin(); it!=key.end(); ++it) {
+    h = (h ^ *it) * 1099511628211ULL;
+  }
+  return h;
+}
+
+
+/// Children of a CNode, from left to right.
+static void dagKids(const CNode *node, std::vector<const CNode*> *kids)
+{
+  if (node->getListL()) {
+    for (CNode **c=node->getListL(); c<node->getListR(); ++c) {
+      kids->push_back(*c);
+    }
+  } else if (1==node->numChild()) {
+    kids->push_back(node->getL());
+  } else if (2==node->numChild()) {
+    kids->push_back(node->getL());
+    kids->push_back(node->getR());
+  }
+}
+
+
+/// Key of the node of a constant.
+static void dagConstKey(double val, UIntVector *key)
+{
+  UInt w[2];
+
+  memcpy(w, &val, sizeof(double));
+  key->resize(3);
+  (*key)[0] = OpNum;
+  (*key)[1] = w[0];
+  (*key)[2] = w[1];
+}
+
+
+/// Key of the node of an operation. The children of the key start at 1.
+static void dagOpKey(OpCode op, const UInt *kids, UInt nkids,
+                     UIntVector *key)
+{
+  key->assign(1, op);
+  key->insert(key->end(), kids, kids+nkids);
+  if ((OpPlus==op || OpMult==op) && 2==nkids && (*key)[1]>(*key)[2]) {
+    std::swap((*key)[1], (*key)[2]);
+  }
+}
+
+
+/// Key of the node of a variable.
+static void dagVarKey(UInt vind, UIntVector *key)
+{
+  key->resize(2);
+  (*key)[0] = OpVar;
+  (*key)[1] = vind;
+}
+
+
+SharedDAG::SharedDAG()
+  : nVars_(0),
+    refs_(0),
+    valid_(false)
+{
+  cStart_.push_back(0);
+}
+
+
+SharedDAG::~SharedDAG()
+{
+  std::set<CGraphPtr> graphs;
+
+  // CGraph::setDAG() calls unlink(), which must not change the set we are
+  // iterating over.
+  graphs.swap(graphs_);
+  for (std::set<CGraphPtr>::iterator it=graphs.begin(); it!=graphs.end();
+       ++it) {
+    (*it)->setDAG(0);
+  }
+}
+
+
+UInt SharedDAG::add(const CNode *node)
+{
+  std::map<const CNode*, UInt> done;
+
+  return add_(node, &done);
+}
+
+
+UInt SharedDAG::add_(const CNode *node, std::map<const CNode*, UInt> *done)
+{
+  std::map<const CNode*, UInt>::iterator it = done->find(node);
+  const OpCode op = node->getOp();
+  std::vector<const CNode*> cnodes;
+  UIntVector kids;
+  UInt id;
+
+  if (it!=done->end()) {
+    return it->second;
+  }
+  if (OpVar==op) {
+    id = addVar(node->getV()->getIndex());
+  } else if (OpNum==op || OpInt==op) {
+    id = addConst(node->getVal());
+  } else {
+    dagKids(node, &cnodes);
+    for (UInt i=0; i<cnodes.size(); ++i) {
+      kids.push_back(add_(cnodes[i], done));
+    }
+    id = addOp(op, kids.empty() ? 0 : &(kids[0]), kids.size());
+  }
+  (*done)[node] = id;
+  return id;
+}
+
+
+UInt SharedDAG::addConst(double val)
+{
+  UIntVector key;
+
+  dagConstKey(val, &key);
+  return find_(key, OpNum, 0, 0, val, 0);
+}
+
+
+UInt SharedDAG::addOp(OpCode op, const UInt *kids, UInt nkids)
+{
+  UIntVector key;
+
+  assert(OpVar!=op && OpNum!=op && OpInt!=op);
+  dagOpKey(op, kids, nkids, &key);
+  return find_(key, op, &(key[1]), nkids, 0.0, 0);
+}
+
+
+void SharedDAG::addProblem(ProblemPtr p)
+{
+  NonlinearFunctionPtr nlf;
+  CGraphPtr cg;
+
+  if (p->getObjective() && p->getObjective()->getFunction()) {
+    nlf = p->getObjective()->getFunction()->getNonlinearFunction();
+    cg = dynamic_cast <CGraph*> (nlf);
+    if (cg && cg->isCompiled()) {
+      cg->setDAG(this);
+    }
+  }
+  for (ConstraintConstIterator it=p->consBegin(); it!=p->consEnd(); ++it) {
+    nlf = (*it)->getFunction()->getNonlinearFunction();
+    cg = dynamic_cast <CGraph*> (nlf);
+    if (cg && cg->isCompiled()) {
+      cg->setDAG(this);
+    }
+  }
+}
+
+
+UInt SharedDAG::addVar(UInt vind)
+{
+  UIntVector key;
+
+  dagVarKey(vind, &key);
+  nVars_ = std::max(nVars_, vind+1);
+  return find_(key, OpVar, 0, 0, 0.0, vind);
+}
+
+
+void SharedDAG::eval(const double *x)
+{
+  const UInt n = op_.size();
+  const UInt *c, *cend;
+  double *val;
+  int err = 0;
+
+  if (valid_ && 0==memcmp(x, x_.data(), nVars_*sizeof(double))) {
+    return;
+  }
+  valid_ = false;
+  x_.assign(x, x+nVars_);
+  val_.resize(n);
+  val = val_.data();
+  errno = 0; // declared in cerrno
+  for (UInt k=0; k<n; ++k) {
+    switch (op_[k]) {
+    case (OpVar):
+      val[k] = x[vInd_[k]];
+      break;
+    case (OpNum):
+      val[k] = cVal_[k];
+      break;
+    default:
+      c = &(child_[0])+cStart_[k];
+      cend = &(child_[0])+cStart_[k+1];
+      val[k] = CGraph::evalOp(op_[k], val, c, cend, &err);
+      if (0!=err) {
+        return;
+      }
+    }
+  }
+  valid_ = (0==errno);
+}
+
+
+UInt SharedDAG::find_(const UIntVector &key, OpCode op, const UInt *kids,
+                      UInt nkids, double val, UInt vind)
+{
+  std::unordered_map<UIntVector, UInt, SharedDAGKeyHash>::iterator it;
+  UInt id = op_.size();
+
+  it = table_.find(key);
+  if (it!=table_.end()) {
+    return it->second;
+  }
+  table_[key] = id;
+  op_.push_back(op);
+  child_.insert(child_.end(), kids, kids+nkids);
+  cStart_.push_back(child_.size());
+  cVal_.push_back(val);
+  vInd_.push_back(vind);
+  valid_ = false;
+  return id;
+}
+
+
+bool SharedDAG::find(const CNode *node, UInt *id) const
+{
+  std::map<const CNode*, UInt> done;
+
+  return lookup_(node, &done, id);
+}
+
+
+void SharedDAG::link(CGraphPtr cg, UInt nrefs)
+{
+  graphs_.insert(cg);
+  refs_ += nrefs;
+}
+
+
+bool SharedDAG::lookup_(const CNode *node,
+                        std::map<const CNode*, UInt> *done, UInt *id) const
+{
+  std::map<const CNode*, UInt>::iterator it = done->find(node);
+  std::unordered_map<UIntVector, UInt, SharedDAGKeyHash>::const_iterator tit;
+  const OpCode op = node->getOp();
+  std::vector<const CNode*> cnodes;
+  UIntVector kids, key;
+
+  if (it!=done->end()) {
+    *id = it->second;
+    return true;
+  }
+  if (OpVar==op) {
+    dagVarKey(node->getV()->getIndex(), &key);
+  } else if (OpNum==op || OpInt==op) {
+    dagConstKey(node->getVal(), &key);
+  } else {
+    dagKids(node, &cnodes);
+    kids.resize(cnodes.size());
+    for (UInt i=0; i<cnodes.size(); ++i) {
+      if (!lookup_(cnodes[i], done, &(kids[i]))) {
+        return false;
+      }
+    }
+    dagOpKey(op, kids.empty() ? 0 : &(kids[0]), kids.size(), &key);
+  }
+  tit = table_.find(key);
+  if (tit==table_.end()) {
+    return false;
+  }
+  *id = tit->second;
+  (*done)[node] = *id;
+  return true;
+}
+
+
+void SharedDAG::unlink(CGraphPtr cg)
+{
+  graphs_.erase(cg);
+}
+
+
+void SharedDAG::writeStats(std::ostream &out) const
+{
+  out << me_ << "graphs linked           = " << graphs_.size() << std::endl
+      << me_ << "tape entries linked     = " << refs_ << std::endl
+      << me_ << "distinct nodes          = " << op_.size() << std::endl;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
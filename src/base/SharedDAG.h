@@ -0,0 +1,199 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+/**
+ * \file SharedDAG.h
+ * \brief Declare the class SharedDAG, a graph of expressions in which every
+ * distinct subexpression is stored only once.
+ * \author The Minotaur Team
+ */
+
+#ifndef MINOTAURSHAREDDAG_H
+#define MINOTAURSHAREDDAG_H
+
+#include <map>
+#include <set>
+#include <unordered_map>
+
+#include "Types.h"
+#include "OpCode.h"
+
+namespace Minotaur {
+
+  class CGraph;
+  class CNode;
+  class Problem;
+  typedef CGraph* CGraphPtr;
+  typedef Problem* ProblemPtr;
+
+  /// Hash function for the keys of the nodes of a SharedDAG.
+  struct SharedDAGKeyHash {
+    size_t operator()(const UIntVector &key) const;
+  };
+
+  /**
+   * \brief A directed acyclic graph of expressions built by hash-consing:
+   * a node is added only if no node with the same operation and the same
+   * children exists. Two structurally identical subexpressions therefore get
+   * the same node, and finding a subexpression takes constant time per node.
+   * Variables are identified by their index and constants by their exact
+   * value. The two children of OpPlus and OpMult are sorted, since the
+   * values of these operations do not depend on their order.
+   *
+   * Compiled CGraphs of a problem can be linked to the DAG
+   * (CGraph::setDAG()). eval() then evaluates every shared subexpression
+   * once, and a linked graph that is evaluated at the same point with its
+   * own workspace copies the values of its tape from the DAG instead of
+   * computing them. The values are exactly those that the graph would
+   * compute. If the evaluation of the DAG fails anywhere, all graphs
+   * evaluate themselves.
+   *
+   * A SharedDAG is not thread safe. eval() must not be called while a
+   * linked graph is evaluated.
+   */
+  class SharedDAG {
+  public:
+    /// Create an empty DAG.
+    SharedDAG();
+
+    /// Destroy. Linked graphs are unlinked.
+    ~SharedDAG();
+
+    /**
+     * \brief Add an expression given by a tree of CNodes.
+     *
+     * \param [in] node The root of the expression.
+     * \return The DAG node of the expression.
+     */
+    UInt add(const CNode *node);
+
+    /// Return the node of a constant, adding it if required.
+    UInt addConst(double val);
+
+    /**
+     * \brief Return the node of an operation, adding it if required.
+     *
+     * \param [in] op The operation. It must not be OpVar, OpNum or OpInt.
+     * \param [in] kids The nodes of the children, from left to right.
+     * \param [in] nkids The number of children.
+     */
+    UInt addOp(OpCode op, const UInt *kids, UInt nkids);
+
+    /// Return the node of the variable with index vind, adding it if required.
+    UInt addVar(UInt vind);
+
+    /**
+     * \brief Link the compiled graphs of the objective and the constraints
+     * of a problem.
+     *
+     * Graphs that are not compiled are skipped.
+     */
+    void addProblem(ProblemPtr p);
+
+    /**
+     * \brief Evaluate all nodes at a point. Nothing is done if the DAG is
+     * already evaluated at this point.
+     *
+     * \param [in] x The point. It must have values of all variables added to
+     * the DAG.
+     */
+    void eval(const double *x);
+
+    /**
+     * \brief Find the node of an expression without adding anything.
+     *
+     * \param [in] node The root of the expression.
+     * \param [out] id The DAG node of the expression, if it is found.
+     * \return False if the expression, or a part of it, is not in the DAG.
+     */
+    bool find(const CNode *node, UInt *id) const;
+
+    /// Number of nodes.
+    UInt getNumNodes() const { return op_.size(); }
+
+    /**
+     * \brief The point at which the values were computed, or NULL if they
+     * are not valid.
+     */
+    const double* getPoint() const { return (valid_ ? x_.data() : 0); }
+
+    /// Value of each node at getPoint().
+    const double* getValues() const { return val_.data(); }
+
+    /// Used by CGraph::setDAG(). Use that method instead.
+    void link(CGraphPtr cg, UInt nrefs);
+
+    /// Used by CGraph::setDAG(). Use that method instead.
+    void unlink(CGraphPtr cg);
+
+    /// Display statistics.
+    void writeStats(std::ostream &out) const;
+
+  private:
+    /// Children of node i are child_[cStart_[i]] to child_[cStart_[i+1]-1].
+    UIntVector child_;
+
+    /// See child_.
+    UIntVector cStart_;
+
+    /// Value of each constant node. Zero for other nodes.
+    DoubleVector cVal_;
+
+    /// Graphs linked to the DAG.
+    std::set<CGraphPtr> graphs_;
+
+    /// For logging.
+    static const std::string me_;
+
+    /// One more than the largest index of a variable in the DAG.
+    UInt nVars_;
+
+    /// Operation of each node.
+    std::vector<OpCode> op_;
+
+    /// Number of tape entries of the linked graphs.
+    UInt refs_;
+
+    /// Node of each key.
+    std::unordered_map<UIntVector, UInt, SharedDAGKeyHash> table_;
+
+    /// True if val_ holds the values at x_.
+    bool valid_;
+
+    /// Value of each node.
+    DoubleVector val_;
+
+    /// Index of the variable of each variable node. Zero for other nodes.
+    UIntVector vInd_;
+
+    /// The point at which the DAG was last evaluated.
+    DoubleVector x_;
+
+    /// Add the node with the given key if it is new, return its node.
+    UInt find_(const UIntVector &key, OpCode op, const UInt *kids,
+               UInt nkids, double val, UInt vind);
+
+    /// Recursive part of add(), with nodes already added in done.
+    UInt add_(const CNode *node, std::map<const CNode*, UInt> *done);
+
+    /// Recursive part of find(), with nodes already found in done.
+    bool lookup_(const CNode *node, std::map<const CNode*, UInt> *done,
+                 UInt *id) const;
+  };
+  typedef SharedDAG* SharedDAGPtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -12,6 +12,7 @@
  * Implement the base class Solution. 
  */
 
+#include <cassert>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
@@ -145,6 +146,94 @@ void Solution::setDualOfVars(const double *dualX)
 }
 
 
+void Solution::setNumCons(UInt m)
+{
+  if (m != m_ && dualCons_) {
+    delete [] dualCons_;
+    dualCons_ = 0;
+  }
+  m_ = m;
+}
+
+
+size_t Solution::getMemSize() const
+{
+  size_t nvals = 0;
+  if (x_) {
+    nvals += n_;
+  }
+  if (dualCons_) {
+    nvals += m_;
+  }
+  if (dualX_) {
+    nvals += n_;
+  }
+  return sizeof(Solution) + nvals*sizeof(double);
+}
+
+
+bool Solution::diffFrom(ConstSolutionPtr ref, UIntVector *inds,
+                        DoubleVector *vals) const
+{
+  std::vector<double *> arrs, rarrs;
+  UIntVector sizes, rsizes;
+  UInt off = 0;
+
+  getArrays_(&arrs, &sizes);
+  ref->getArrays_(&rarrs, &rsizes);
+  if (sizes != rsizes) {
+    return false;
+  }
+  inds->clear();
+  vals->clear();
+  for (UInt a=0; a<arrs.size(); ++a) {
+    if ((0==arrs[a]) != (0==rarrs[a])) {
+      return false;
+    }
+    if (arrs[a]) {
+      for (UInt i=0; i<sizes[a]; ++i) {
+        if (arrs[a][i] != rarrs[a][i]) {
+          inds->push_back(off+i);
+          vals->push_back(arrs[a][i]);
+        }
+      }
+    }
+    off += sizes[a];
+  }
+  return true;
+}
+
+
+void Solution::getArrays_(std::vector<double *> *arrs,
+                          UIntVector *sizes) const
+{
+  arrs->push_back(x_);
+  sizes->push_back(n_);
+  arrs->push_back(dualCons_);
+  sizes->push_back(m_);
+  arrs->push_back(dualX_);
+  sizes->push_back(n_);
+}
+
+
+void Solution::setDiff(const UIntVector &inds, const DoubleVector &vals)
+{
+  std::vector<double *> arrs;
+  UIntVector sizes;
+  UInt a = 0, off = 0;
+
+  getArrays_(&arrs, &sizes);
+  for (UInt i=0; i<inds.size(); ++i) {
+    while (inds[i] >= off+sizes[a]) {
+      off += sizes[a];
+      ++a;
+    }
+    assert(arrs[a]);
+    arrs[a][inds[i]-off] = vals[i];
+  }
+}
+
+
 void Solution::write(std::ostream &out) const
 {
   writePrimal(out);
@@ -55,6 +55,15 @@ namespace Minotaur {
     /// Copy values of dual variables of variables.
     virtual void setDualOfVars(const double *vals);
 
+    /**
+     * \brief Change the number of constraints.
+     *
+     * Used when constraints are added to or deleted from the problem and
+     * the solution is reused. The old duals of constraints are dropped if
+     * the number changes.
+     */
+    void setNumCons(UInt m);
+
     /// Set a new solution value.
     virtual void setObjValue(double new_val) {objValue_ = new_val;};
 
@@ -73,6 +82,27 @@ namespace Minotaur {
     /// Return a pointer to the solution.
     virtual const double * getDualOfVars() const {return dualX_;};
 
+    /**
+     * \brief Find the values of this solution that differ from those of
+     * ref.
+     *
+     * The values of all arrays of the solution (primal values, duals of
+     * constraints, duals of variables and any others of a derived class)
+     * are numbered one after the other.
+     * \param [in] ref The solution to compare with.
+     * \param [out] inds Positions of the values that differ.
+     * \param [out] vals The values of this solution at inds.
+     * \return False if ref does not have arrays of the same sizes.
+     */
+    bool diffFrom(ConstSolutionPtr ref, UIntVector *inds,
+                  DoubleVector *vals) const;
+
+    /// Approximate number of bytes used by the solution.
+    virtual size_t getMemSize() const;
+
+    /// Overwrite the values at positions inds, numbered as in diffFrom().
+    void setDiff(const UIntVector &inds, const DoubleVector &vals);
+
     /// Write to a stream.
     virtual void write(std::ostream &out) const;
 
@@ -111,6 +141,13 @@ namespace Minotaur {
 
     /// Complementarity.
     double comple_;
+
+    /**
+     * Append the arrays of values of the solution, NULL or not, and their
+     * sizes, in the order used by diffFrom().
+     */
+    virtual void getArrays_(std::vector<double *> *arrs,
+                            UIntVector *sizes) const;
   };
 }
 #endif
@@ -79,6 +79,9 @@ namespace Minotaur {
      */
     SolutionPtr getBestSolution();
 
+    /// Problem whose solutions are stored.
+    ProblemPtr getProblem() const { return problem_; }
+
     /**
      * Get a solution with the best objective function value. Return NULL if
      * the pool is empty.
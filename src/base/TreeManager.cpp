@@ -14,10 +14,13 @@
 
 #include "MinotaurConfig.h"
 #include "Branch.h"
+#include "NodeFile.h"
 #include "NodeHeap.h"
 #include "NodeStack.h"
 #include "Operations.h"
+#include "Option.h"
 #include "TreeManager.h"
+#include "WarmStartStore.h"
 
 using namespace Minotaur;
     
@@ -28,6 +31,8 @@ TreeManager::TreeManager(EnvPtr env)
   cutOff_(INFINITY),
   doVbc_(false),
   etol_(1e-6),
+  nodeFile_(0),
+  nodeFileLimit_(0),
   size_(0),
   timer_(0)
 {
@@ -54,8 +59,16 @@ TreeManager::TreeManager(EnvPtr env)
      assert (!"search strategy must be defined!");
   }
 
+  // nodes are read back from the file in the order of the heap, so it is
+  // not used in depth first search.
+  nodeFileLimit_ = env->getOptions()->findInt("node_file_limit")->getValue();
+  if (nodeFileLimit_ > 0 && searchType_ != DepthFirst) {
+    nodeFile_ = (NodeFilePtr) new NodeFile();
+  }
+
   aNode_ = NodePtr();
   cutOff_ = env->getOptions()->findDouble("obj_cut_off")->getValue();
+  wsStore_ = (WarmStartStorePtr) new WarmStartStore(env);
   s = env->getOptions()->findString("vbc_file")->getValue();
   if (s!="") {
     vbcFile_.open(s.c_str());
@@ -79,6 +92,10 @@ TreeManager::~TreeManager()
 {
   clearAll();
   delete activeNodes_;
+  if (nodeFile_) {
+    delete nodeFile_;
+  }
+  delete wsStore_;
   if (doVbc_) {
     vbcFile_.close();
     delete timer_;
@@ -88,7 +105,7 @@ TreeManager::~TreeManager()
 
 bool TreeManager::anyActiveNodesLeft()
 {
-  return !activeNodes_->isEmpty();
+  return !activeNodes_->isEmpty() || (nodeFile_ && !nodeFile_->isEmpty());
 }
 
 
@@ -102,6 +119,9 @@ NodePtr TreeManager::branch(Branches branches, NodePtr node, WarmStartPtr ws)
   if (searchType_ == DepthFirst || searchType_ == BestThenDive) {
     is_first = true;
   }
+  if (ws && !branches->empty()) {
+    wsStore_->add(ws);
+  }
   for (BranchConstIterator br_iter=branches->begin(); br_iter!=branches->end();
       ++br_iter) {
     branch_p = *br_iter;
@@ -143,6 +163,14 @@ void TreeManager::clearAll()
   if (aNode_) {
     removeNodeAndUp_(aNode_);
   }
+  // nodes in the file are created again, one at a time, so that their
+  // parents are removed.
+  while (nodeFile_ && false==nodeFile_->isEmpty()) {
+    n = nodeFile_->read();
+    if (n) {
+      removeNodeAndUp_(n);
+    }
+  }
   while (false==activeNodes_->isEmpty()) {
     n = activeNodes_->top();
     removeNodeAndUp_(n);
@@ -153,7 +181,11 @@ void TreeManager::clearAll()
 
 UInt TreeManager::getActiveNodes() const
 {
-  return activeNodes_->getSize();
+  UInt n = activeNodes_->getSize();
+  if (nodeFile_) {
+    n += nodeFile_->getSize();
+  }
+  return n;
 }
 
 
@@ -162,6 +194,7 @@ NodePtr TreeManager::getCandidate()
   NodePtr node = NodePtr(); // NULL
   //aNode_.reset();
   aNode_ = 0;
+  readNodeFile_();
   while (activeNodes_->getSize() > 0) {
     node = activeNodes_->top();
     if (shouldPrune_(node)) {
@@ -169,6 +202,7 @@ NodePtr TreeManager::getCandidate()
       pruneNode(node);
       //node.reset(); // NULL
       node = 0;
+      readNodeFile_();
     } else {
       if (doVbc_) {
         vbcFile_ << toClockTime(timer_->query()) << " P " << node->getId()+1
@@ -237,17 +271,22 @@ void TreeManager::insertCandidate_(NodePtr node, bool pop_now)
 
   ++size_;
 
-  // add node to the heap/stack of active nodes. If pop_now is true, the node
-  // is processed right after creating it; we don't
-  // want to keep it in activeNodes (e.g. while diving)
-  if (!pop_now) {
-    activeNodes_->push(node);
-  } 
   if (doVbc_) {
     vbcFile_ << toClockTime(timer_->query()) << " N "
       << node->getParent()->getId()+1 << " " << node->getId()+1
       << " " << VbcActive << std::endl;
   }
+
+  // add node to the heap/stack of active nodes. If pop_now is true, the node
+  // is processed right after creating it; we don't
+  // want to keep it in activeNodes (e.g. while diving). If there are too
+  // many active nodes, the node is written to the file and deleted.
+  if (!pop_now) {
+    if (!nodeFile_ || activeNodes_->getSize() < nodeFileLimit_ ||
+        !nodeFile_->write(node)) {
+      activeNodes_->push(node);
+    }
+  } 
 }
 
 
@@ -275,6 +314,22 @@ void TreeManager::pruneNode(NodePtr node)
 }
 
 
+void TreeManager::readNodeFile_()
+{
+  NodePtr n;
+
+  // a node that can not be read is skipped, and the next one is read.
+  while (nodeFile_ && !nodeFile_->isEmpty() && (activeNodes_->isEmpty() ||
+         nodeFile_->comesBefore(activeNodes_->top()))) {
+    n = nodeFile_->read();
+    if (n) {
+      activeNodes_->push(n);
+      break;
+    }
+  }
+}
+
+
 void TreeManager::removeActiveNode(NodePtr node)
 {
   if (doVbc_) {
@@ -329,7 +384,9 @@ void TreeManager::removeNode_(NodePtr node)
       assert (!"Current node is not in its parent's list of children!");
     }
   } 
-  delete node;
+  if (node->markRemoved()) {
+    delete node;
+  }
 }
 
 
@@ -389,11 +446,23 @@ double TreeManager::updateLb()
 {
   // this could be an expensive operation. Try to avoid it.
   bestLowerBound_ = activeNodes_->getBestLB();
+  if (nodeFile_ && nodeFile_->getBestLB() < bestLowerBound_) {
+    bestLowerBound_ = nodeFile_->getBestLB();
+  }
 
   return bestLowerBound_;
 }
 
 
+void TreeManager::writeStats(std::ostream &out) const
+{
+  wsStore_->writeStats(out);
+  if (nodeFile_) {
+    nodeFile_->writeStats(out);
+  }
+}
+
+
 // Local Variables: 
 // mode: c++ 
 // eval: (c-set-style "k&r") 
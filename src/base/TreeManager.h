@@ -25,6 +25,11 @@
 
 namespace Minotaur {
   
+  class NodeFile;
+  class WarmStartStore;
+  typedef NodeFile* NodeFilePtr;
+  typedef WarmStartStore* WarmStartStorePtr;
+
   /// Base class for managing the branch-and-bound tree. 
   class TreeManager {
 
@@ -150,6 +155,9 @@ namespace Minotaur {
      */
     double updateLb();
 
+    /// Write statistics about the warm starts and the file of nodes.
+    void writeStats(std::ostream &out) const;
+
   private:
     /// Set of nodes that are still active (those who need to be processed).
     ActiveNodeStorePtr activeNodes_; 
@@ -176,6 +184,16 @@ namespace Minotaur {
     /// Tolerance for pruning nodes on the basis of bounds.
     const double etol_;
 
+    /**
+     * Active nodes written to a file when there are too many of them in
+     * memory. NULL if node_file_limit is 0 or the search is depth first.
+     */
+    NodeFilePtr nodeFile_;
+
+    /// Number of active nodes in memory above which new nodes are written to
+    /// nodeFile_.
+    UInt nodeFileLimit_;
+
     /// The search order: depth first, best first or something else.
     TreeSearchOrder searchType_;
 
@@ -191,6 +209,9 @@ namespace Minotaur {
     /// File name to store tree information for vbc.
     std::ofstream vbcFile_;
 
+    /// Warm starts linked to open nodes.
+    WarmStartStorePtr wsStore_;
+
     /// Check if the node can be pruned because of its bound.
     bool shouldPrune_(NodePtr node);
 
@@ -202,6 +223,12 @@ namespace Minotaur {
      */
     void insertCandidate_(NodePtr node, bool pop_now = false);
 
+    /**
+     * \brief Read the best node of nodeFile_ into the active nodes if it comes
+     * before the best active node in memory, or if there is none.
+     */
+    void readNodeFile_();
+
     /**
      * \brief Remove a node from the tree. Ancestors are removed if their
      * single child is removed.
@@ -49,6 +49,16 @@ VarBoundMod::~VarBoundMod()
 }
 
 
+ModificationPtr VarBoundMod::copyByIndex(ProblemPtr p) const
+{
+  VarBoundModPtr mod = (VarBoundModPtr) new VarBoundMod(
+                                        p->getVariable(var_->getIndex()),
+                                        lu_, newVal_);
+  mod->oldVal_ = oldVal_;
+  return mod;
+}
+
+
 ModificationPtr VarBoundMod::fromRel(RelaxationPtr rel, ProblemPtr) const
 {
   VarBoundModPtr mod = (VarBoundModPtr) new VarBoundMod(
@@ -132,6 +142,18 @@ VarBoundMod2::~VarBoundMod2()
 }
 
 
+ModificationPtr VarBoundMod2::copyByIndex(ProblemPtr p) const
+{
+  VarBoundMod2Ptr mod = (VarBoundMod2Ptr) new VarBoundMod2(
+                                          p->getVariable(var_->getIndex()),
+                                          newLb_, newUb_);
+  mod->oldLb_ = oldLb_;
+  mod->oldUb_ = oldUb_;
+
+  return mod;
+}
+
+
 ModificationPtr VarBoundMod2::fromRel(RelaxationPtr rel, ProblemPtr) const
 {
   VarBoundMod2Ptr mod = (VarBoundMod2Ptr) new VarBoundMod2(
@@ -35,6 +35,9 @@ class VarBoundMod : public Modification {
   /// Destroy.
   ~VarBoundMod();
 
+  // base class method.
+  ModificationPtr copyByIndex(ProblemPtr p) const;
+
   // base class method.
   ModificationPtr fromRel(RelaxationPtr, ProblemPtr) const;
 
@@ -92,6 +95,9 @@ class VarBoundMod2 : public Modification {
   // Implement Modification::applyToProblem().
   void applyToProblem(ProblemPtr problem);
 
+  // base class method.
+  ModificationPtr copyByIndex(ProblemPtr p) const;
+
   // base class method.
   ModificationPtr fromRel(RelaxationPtr, ProblemPtr) const;
 
@@ -15,6 +15,8 @@
 #ifndef MINOTAURWARMSTART_H
 #define MINOTAURWARMSTART_H
 
+#include <cstdio>
+
 #include "Types.h"
 
 namespace Minotaur {
@@ -33,14 +35,16 @@ namespace Minotaur {
   // has only one child and we decide to process it next, then we don't need
   // to save warm start information for that node.
   //
-  // For now we save complete warm-start information on each active node. A more
-  // memory efficient method is to save warm-start information for each node
-  // by just storing the differences from the parent.
-  // However, the benefits of saving the complete information are:
-  //  -# Ease of coding.
-  //  -# We can delete warm-start information of a node when it is processed.
-  //  Thus, we have at most `A' nodes that have warm-start information saved
-  //  on them, where `A' is the total number of active nodes in the tree.
+  // The warm start of a node is shared by all its children. A
+  // WarmStartStore may further replace the information by its difference
+  // from a reference warm start (see makeDiff()), and drop the information
+  // of the oldest warm starts when they use too much memory (see
+  // dropInfo()). An engine rebuilds the full information from a difference
+  // when the warm start is loaded.
+  //
+  // We delete warm-start information of a node when it is processed.
+  // Thus, we have at most `A' warm starts saved on the nodes, where `A' is
+  // the total number of active nodes in the tree.
   // */
   class WarmStart {
     public:
@@ -50,22 +54,84 @@ namespace Minotaur {
       /// Destroy
       virtual ~WarmStart() {} ;
       
-      virtual void decrUseCnt()
-      {--cnt_;} ;
+      /// Decrease the use count by one and return the new count.
+      virtual int decrUseCnt()
+      {
+        int cnt;
+#pragma omp atomic capture
+        cnt = --cnt_;
+        return cnt;
+      } ;
+
+      /**
+       * \brief Drop the warm-start information to save memory.
+       *
+       * hasInfo() returns false afterwards. The default implementation
+       * keeps everything.
+       */
+      virtual void dropInfo() {} ;
+
+      /// Approximate number of bytes used by this warm start.
+      virtual size_t getMemSize() const
+      {return sizeof(WarmStart);} ;
 
       virtual int getUseCnt()
-      {return cnt_;} ;
-      
+      {
+        int cnt;
+#pragma omp atomic read
+        cnt = cnt_;
+        return cnt;
+      } ;
+
       /// Return true if warm start information is initialized, false
       /// otherwise.
       virtual bool hasInfo() = 0;
 
       virtual void incrUseCnt()
-      {++cnt_;} ;
-      
+      {
+#pragma omp atomic
+        ++cnt_;
+      } ;
+
+      /**
+       * \brief Store only the difference of this warm start from ref.
+       *
+       * If it succeeds, this warm start increments the use count of ref and
+       * reads ref when it is loaded, so ref must not be changed afterwards.
+       * The default implementation does nothing.
+       *
+       * \param [in] ref The reference warm start, of the same type as this
+       * one, that is not a difference itself.
+       * \return True if the difference is stored, false if this warm start is
+       * left as it was, e.g. because the difference is not much smaller.
+       */
+      virtual bool makeDiff(WarmStart *) {return false;} ;
+
+      /**
+       * \brief Read the information written by writeInfo() into a new warm
+       * start of the same type as this one.
+       *
+       * Only the type of this warm start is used, not its information. The
+       * default implementation reads nothing.
+       * \param [in] f File positioned where writeInfo() wrote.
+       * \return The new warm start, or NULL if it could not be read.
+       */
+      virtual WarmStart* readNew(FILE *) const {return 0;} ;
+
       /// Write to an output stream
       virtual void write(std::ostream &out) const = 0;
 
+      /**
+       * \brief Write the full warm-start information to a binary file, so
+       * that it can be read back by readNew() after this warm start is
+       * deleted. A difference is written as the full information.
+       *
+       * The default implementation writes nothing.
+       * \param [in] f File positioned where the information is written.
+       * \return True if the information is written, false otherwise.
+       */
+      virtual bool writeInfo(FILE *) const {return false;} ;
+
     protected:
       /**
        * Warm start information can be stored at different nodes of the
@@ -0,0 +1,196 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+/**
+ * \file WarmStartStore.cpp
+ * \brief Implement the methods of WarmStartStore class.
+ * \author The Minotaur Team
+ */
+
+#include <algorithm>
+#include <iostream>
+
+#include "MinotaurConfig.h"
+#include "Environment.h"
+#include "Option.h"
+#include "WarmStart.h"
+#include "WarmStartStore.h"
+
+using namespace Minotaur;
+
+const std::string WarmStartStore::me_ = "WarmStartStore: ";
+const UInt WarmStartStore::minSweep_ = 64;
+
+WarmStartStore::WarmStartStore(EnvPtr env)
+  : memUsed_(0),
+    refDiffs_(0),
+    ref_(0),
+    statAdded_(0),
+    statDiffs_(0),
+    statDropped_(0),
+    statRefs_(0),
+    sweepAt_(minSweep_)
+{
+  double mb = env->getOptions()->findDouble("ws_mem_budget")->getValue();
+
+  budget_ = (mb > 0.0) ? (size_t) (mb*1048576.0) : 0;
+  useDiff_ = env->getOptions()->findBool("ws_diff")->getValue();
+}
+
+
+WarmStartStore::~WarmStartStore()
+{
+  clear();
+}
+
+
+void WarmStartStore::add(WarmStartPtr ws)
+{
+  if (!ws) {
+    return;
+  }
+#pragma omp critical (wsStore)
+  {
+    ++statAdded_;
+    if (useDiff_ && ref_ && ws->makeDiff(ref_)) {
+      ++statDiffs_;
+      ++refDiffs_;
+      keep_(ws);
+    } else if (useDiff_) {
+      // The store keeps a use count on the reference, so that later warm
+      // starts can be differences from it. The differences keep their own
+      // use counts on an old reference.
+      if (ref_ && 0 == refDiffs_ && budget_ > 0) {
+        append_(ref_);
+      } else if (ref_) {
+        release_(ref_);
+      }
+      ws->incrUseCnt();
+      ref_ = ws;
+      refDiffs_ = 0;
+      ++statRefs_;
+    } else {
+      keep_(ws);
+    }
+    enforceBudget_();
+  }
+}
+
+
+void WarmStartStore::append_(WarmStartPtr ws)
+{
+  size_t sz = ws->getMemSize();
+
+  list_.push_back(ws);
+  sizes_.push_back(sz);
+  memUsed_ += sz;
+}
+
+
+void WarmStartStore::clear()
+{
+#pragma omp critical (wsStore)
+  {
+    for (std::deque<WarmStartPtr>::iterator it=list_.begin();
+         it!=list_.end(); ++it) {
+      release_(*it);
+    }
+    list_.clear();
+    sizes_.clear();
+    memUsed_ = 0;
+    if (ref_) {
+      release_(ref_);
+      ref_ = 0;
+    }
+    refDiffs_ = 0;
+  }
+}
+
+
+void WarmStartStore::enforceBudget_()
+{
+  WarmStartPtr ws;
+
+  if (0 == budget_) {
+    return;
+  }
+
+  // Warm starts that only the store uses are released once the list has
+  // doubled since the last sweep, so that they do not pile up behind an
+  // old warm start that is still in use.
+  if (list_.size() >= sweepAt_ || memUsed_ > budget_) {
+    sweep_();
+    sweepAt_ = std::max(minSweep_, 2*(UInt) list_.size());
+  }
+  // Go a little below the budget so that the next few calls do not have to
+  // sweep again.
+  while (!list_.empty() && memUsed_ > budget_ - budget_/10) {
+    ws = list_.front();
+    ws->dropInfo();
+    memUsed_ -= sizes_.front();
+    release_(ws);
+    list_.pop_front();
+    sizes_.pop_front();
+    ++statDropped_;
+  }
+}
+
+
+void WarmStartStore::keep_(WarmStartPtr ws)
+{
+  if (budget_ > 0) {
+    ws->incrUseCnt();
+    append_(ws);
+  }
+}
+
+
+void WarmStartStore::release_(WarmStartPtr ws)
+{
+  if (0 == ws->decrUseCnt()) {
+    delete ws;
+  }
+}
+
+
+void WarmStartStore::sweep_()
+{
+  UInt j = 0;
+
+  for (UInt i=0; i<list_.size(); ++i) {
+    if (1 == list_[i]->getUseCnt()) {
+      memUsed_ -= sizes_[i];
+      release_(list_[i]);
+    } else {
+      list_[j] = list_[i];
+      sizes_[j] = sizes_[i];
+      ++j;
+    }
+  }
+  list_.resize(j);
+  sizes_.resize(j);
+}
+
+
+void WarmStartStore::writeStats(std::ostream &out) const
+{
+  out << me_ << "warm starts saved       = " << statAdded_ << std::endl
+      << me_ << "stored as differences   = " << statDiffs_ << std::endl
+      << me_ << "references used         = " << statRefs_ << std::endl
+      << me_ << "dropped for memory      = " << statDropped_ << std::endl;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,150 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+/**
+ * \file WarmStartStore.h
+ * \brief Declare the class WarmStartStore that limits the memory used by
+ * warm starts of open nodes.
+ * \author The Minotaur Team
+ */
+
+#ifndef MINOTAURWARMSTARTSTORE_H
+#define MINOTAURWARMSTARTSTORE_H
+
+#include <deque>
+
+#include "Types.h"
+
+namespace Minotaur {
+
+  class Environment;
+  class WarmStart;
+  typedef Environment* EnvPtr;
+  typedef WarmStart* WarmStartPtr;
+
+  /**
+   * \brief Keep track of the warm starts saved on open nodes of the tree.
+   *
+   * The tree manager gives the store every warm start that it links to the
+   * children of a node. The store then
+   *  -# tries to replace the warm start by its difference from a reference
+   *  warm start (WarmStart::makeDiff()). If that fails, the warm start
+   *  becomes the new reference, so the reference follows the search.
+   *  -# if there is a budget (option ws_mem_budget), keeps one use count on
+   *  the warm start, in the order they were added. When the warm starts use
+   *  more than the budget, the information of the oldest ones is dropped
+   *  (WarmStart::dropInfo()). Their nodes are then solved from whatever the
+   *  engine has loaded.
+   *
+   * Without a budget, the store keeps a use count only on the reference, so
+   * a warm start is deleted once its nodes are processed. With a budget,
+   * warm starts that only the store uses any more are released whenever the
+   * list doubles in size. References that other warm starts are a
+   * difference from are never dropped and are not counted in the budget.
+   *
+   * All public methods are thread safe. They, and everything else that
+   * reads the information of a warm start that the store may drop (e.g.
+   * Engine::loadFromWarmStart() in ParNodeIncRelaxer), run in the critical
+   * section wsStore.
+   */
+  class WarmStartStore {
+  public:
+    /// Constructor. Reads options ws_diff and ws_mem_budget.
+    WarmStartStore(EnvPtr env);
+
+    /// Destroy.
+    ~WarmStartStore();
+
+    /**
+     * \brief Add the warm start of a node that has just been branched upon.
+     *
+     * \param [in] ws The warm start. It must not be used as a reference or
+     * loaded into an engine before this call.
+     */
+    void add(WarmStartPtr ws);
+
+    /// Release all warm starts.
+    void clear();
+
+    /// Approximate bytes used by the warm starts in the store.
+    size_t getMemUsed() const { return memUsed_; }
+
+    /// Display statistics.
+    void writeStats(std::ostream &out) const;
+
+  private:
+    /// Budget in bytes, 0 if there is none.
+    size_t budget_;
+
+    /// Warm starts in the store, oldest first. Empty if there is no budget.
+    std::deque<WarmStartPtr> list_;
+
+    /// Bytes used by the warm starts in the store.
+    size_t memUsed_;
+
+    /// For logging.
+    static const std::string me_;
+
+    /// Smallest size of list_ at which it is swept.
+    static const UInt minSweep_;
+
+    /// Number of differences made against the current reference.
+    UInt refDiffs_;
+
+    /// The reference warm start. NULL if differences are not made.
+    WarmStartPtr ref_;
+
+    /// Size of each warm start in list_ when it was added.
+    std::deque<size_t> sizes_;
+
+    /// Number of warm starts added.
+    UInt statAdded_;
+
+    /// Number of warm starts stored as differences.
+    UInt statDiffs_;
+
+    /// Number of warm starts whose information was dropped.
+    UInt statDropped_;
+
+    /// Number of times the reference changed.
+    UInt statRefs_;
+
+    /// Size of list_ at which it is swept next.
+    UInt sweepAt_;
+
+    /// True if warm starts should be stored as differences.
+    bool useDiff_;
+
+    /// Put ws at the end of list_.
+    void append_(WarmStartPtr ws);
+
+    /// Sweep list_ if it has grown, and drop the information of the oldest
+    /// warm starts until under budget.
+    void enforceBudget_();
+
+    /// Keep a use count on ws in list_ if there is a budget.
+    void keep_(WarmStartPtr ws);
+
+    /// Decrement the use count of ws and delete it if unused.
+    void release_(WarmStartPtr ws);
+
+    /// Release all warm starts in list_ that only the store uses.
+    void sweep_();
+  };
+  typedef WarmStartStore* WarmStartStorePtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
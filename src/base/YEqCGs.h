@@ -15,12 +15,18 @@
 #define MINOTAURYEQCG_H
 
 #include "Types.h"
-#include "OpCode.h"
+#include "SharedDAG.h"
 
 namespace Minotaur {
 class CGraph;
 typedef CGraph* CGraphPtr;
 
+/**
+ * \brief Auxiliary variables of nonlinear functions, found by the structure
+ * of their computational graphs. Graphs are hash-consed in a SharedDAG, so
+ * a lookup takes time proportional to the size of the graph, however many
+ * variables are stored.
+ */
 class YEqCGs {
 public:
   YEqCGs();
@@ -28,11 +34,11 @@ public:
   void insert(VariablePtr auxvar, CGraphPtr cg);
 
 private:
-  DoubleVector hash_;
-  DoubleVector rand_;
-  VarVector y_;
-  std::vector<CGraphPtr> cg_;
-  double evalHash_(const CNode* node, UInt rank);
+  /// Expressions of all inserted graphs.
+  SharedDAG dag_;
+
+  /// Auxiliary variable of the output node of each inserted graph.
+  std::unordered_map<UInt, VariablePtr> y_;
 };
 }
 #endif
@@ -15,13 +15,18 @@
 #define MINOTAURYEQUCGS_H
 
 #include "Types.h"
-#include "OpCode.h"
+#include "SharedDAG.h"
 
 namespace Minotaur {
 class CGraph;
-class CNode;
 typedef CGraph* CGraphPtr;
 
+/**
+ * \brief Auxiliary variables of univariate nonlinear functions, found by the
+ * structure of their computational graphs. Graphs are hash-consed in a
+ * SharedDAG, so a lookup takes time proportional to the size of the graph,
+ * however many variables are stored.
+ */
 class YEqUCGs {
 public:
   YEqUCGs();
@@ -30,13 +35,11 @@ public:
   void insert(VariablePtr auxvar, CGraphPtr cg);
 
 private:
-  std::vector<CGraphPtr> cg_;
-  DoubleVector hash_;
-  std::vector<OpCode> op_;
-  DoubleVector rand_;
-  VarVector x_;
-  VarVector y_;
-  double evalHash_(const CNode* node, UInt rank);
+  /// Expressions of all inserted graphs.
+  SharedDAG dag_;
+
+  /// Auxiliary variable of the output node of each inserted graph.
+  std::unordered_map<UInt, VariablePtr> y_;
 };
 }
 #endif
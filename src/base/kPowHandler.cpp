@@ -77,6 +77,7 @@ kPowHandler::kPowHandler(EnvPtr env, ProblemPtr problem, ProblemPtr orig_p)
   defaultLb_ = 1e12;
   defaultUb_ = -1e12;
   doQT_ = false;
+  objCutOff_ = env->getOptions()->findDouble("obj_cut_off");
 }
 
 kPowHandler::~kPowHandler()
@@ -1729,7 +1730,7 @@ bool kPowHandler::tightenLP_(RelaxationPtr rel, double bestSol, bool* changed,
   lp = rel->clone(env_);
 
   obj = lp->getObjective();
-  cub = env_->getOptions()->findDouble("obj_cut_off")->getValue();
+  cub = objCutOff_->getValue();
   cub = std::min(cub, bestSol);
   if(cub < INFINITY) {
     f = obj->getFunction();
@@ -1938,7 +1939,7 @@ bool kPowHandler::tightenkPow_(bool* changed)
   UInt count_inf_lb = 0, count_inf_ub = 0;
 
   obj = p_->getObjective();
-  cub = env_->getOptions()->findDouble("obj_cut_off")->getValue() -
+  cub = objCutOff_->getValue() -
       obj->getConstant();
   clb = -INFINITY;
 
@@ -2478,7 +2479,7 @@ bool kPowHandler::tightenSimple_(bool* changed)
   UInt count_inf_lb = 0, count_inf_ub = 0;
 
   obj = p_->getObjective();
-  cub = env_->getOptions()->findDouble("obj_cut_off")->getValue() -
+  cub = objCutOff_->getValue() -
       obj->getConstant();
   clb = -INFINITY;
 
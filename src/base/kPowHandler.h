@@ -207,6 +207,9 @@ class kPowHandler : public Handler {
 
   EnvPtr env_;
 
+  /// Option obj_cut_off, read whenever bounds are tightened.
+  DoubleOptionPtr objCutOff_;
+
   /// Logger.
   LoggerPtr logger_;
 
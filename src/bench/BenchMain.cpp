@@ -0,0 +1,702 @@
+//
+//    Minotaur -- It's only 1/2 bull
+//
+//    (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+/**
+ * \file BenchMain.cpp
+ * \brief Micro-benchmarks of the derivative, relaxation and tree kernels.
+ * \author The Minotaur Team
+ *
+ * Each kernel is run a few times to warm up and to find how many calls take
+ * about rep_ms milliseconds. It is then timed over several repetitions of
+ * that many calls. The median and the minimum time per call of the
+ * repetitions are written as JSON, one record per problem and kernel, along
+ * with the git version of the build, so that results of different commits
+ * can be compared.
+ *
+ * Usage: minotaur-bench [-o file.json] [-r reps] [-s scale] [-t rep_ms]
+ *        [instance_dir]
+ *
+ * Synthetic problems are always generated, their sizes are multiplied by
+ * scale. .nl files in instance_dir are benchmarked too if the library was
+ * built with the AMPL interface.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "MinotaurConfig.h"
+#include "CGraph.h"
+#include "CNode.h"
+#include "Constraint.h"
+#include "CutMan2.h"
+#include "Environment.h"
+#include "Function.h"
+#include "HessianOfLag.h"
+#include "Jacobian.h"
+#include "LinearFunction.h"
+#include "Logger.h"
+#include "Node.h"
+#include "NodeHeap.h"
+#include "Objective.h"
+#include "Option.h"
+#include "Problem.h"
+#include "QuadraticFunction.h"
+#include "Solution.h"
+#include "Variable.h"
+#include "Version.h"
+
+#ifdef USE_MINOTAUR_AMPL_INTERFACE
+#include "AMPLInterface.h"
+#endif
+
+using namespace Minotaur;
+
+namespace {
+
+  /// A piece of code to be timed. run() is one call.
+  class BenchKernel {
+  public:
+    virtual ~BenchKernel() {}
+    virtual void run() = 0;
+  };
+
+
+  /// Result of timing one kernel on one problem.
+  struct BenchResult {
+    std::string problem;
+    std::string kernel;
+    UInt size;
+    UInt calls;
+    UInt reps;
+    double nsMedian;
+    double nsMin;
+  };
+
+
+  /// Settings from the command line.
+  struct BenchOpts {
+    std::string dir;
+    std::string out;
+    UInt reps;
+    double repMs;
+    double scale;
+  };
+
+
+  /// Evaluate all compiled graphs of a problem.
+  class CGEvalKernel : public BenchKernel {
+  public:
+    CGEvalKernel(std::vector<CGraphPtr> *cgs, const double *x)
+      : cgs_(cgs), err_(0), x_(x) {}
+    void run() {
+      for (UInt i=0; i<cgs_->size(); ++i) {
+        (*cgs_)[i]->eval(x_, &err_);
+      }
+    }
+    int getErr() const { return err_; }
+  private:
+    std::vector<CGraphPtr> *cgs_;
+    int err_;
+    const double *x_;
+  };
+
+
+  /// Evaluate the gradients of all compiled graphs of a problem.
+  class CGGradKernel : public BenchKernel {
+  public:
+    CGGradKernel(std::vector<CGraphPtr> *cgs, const double *x, double *g)
+      : cgs_(cgs), err_(0), g_(g), x_(x) {}
+    void run() {
+      for (UInt i=0; i<cgs_->size(); ++i) {
+        (*cgs_)[i]->evalGradient(x_, g_, &err_);
+      }
+    }
+  private:
+    std::vector<CGraphPtr> *cgs_;
+    int err_;
+    double *g_;
+    const double *x_;
+  };
+
+
+  /// Fill the values of the hessian of the lagrangian.
+  class HessKernel : public BenchKernel {
+  public:
+    HessKernel(HessianOfLagPtr h, const double *x, const double *mult,
+               double *vals)
+      : err_(0), h_(h), mult_(mult), vals_(vals), x_(x) {}
+    void run() { h_->fillRowColValues(x_, 1.0, mult_, vals_, &err_); }
+  private:
+    int err_;
+    HessianOfLagPtr h_;
+    const double *mult_;
+    double *vals_;
+    const double *x_;
+  };
+
+
+  /// Fill the values of the jacobian.
+  class JacKernel : public BenchKernel {
+  public:
+    JacKernel(JacobianPtr j, const double *x, double *vals)
+      : err_(0), j_(j), vals_(vals), x_(x) {}
+    void run() { j_->fillRowColValues(x_, vals_, &err_); }
+  private:
+    int err_;
+    JacobianPtr j_;
+    double *vals_;
+    const double *x_;
+  };
+
+
+  /// Evaluate a linear function.
+  class LinEvalKernel : public BenchKernel {
+  public:
+    LinEvalKernel(LinearFunctionPtr lf, const double *x)
+      : lf_(lf), sum_(0.0), x_(x) {}
+    void run() { sum_ += lf_->eval(x_); }
+  private:
+    LinearFunctionPtr lf_;
+    double sum_;
+    const double *x_;
+  };
+
+
+  /// Evaluate the gradient of a quadratic function.
+  class QfGradKernel : public BenchKernel {
+  public:
+    QfGradKernel(QuadraticFunctionPtr qf, const double *x, double *g)
+      : g_(g), qf_(qf), x_(x) {}
+    void run() { qf_->evalGradient(x_, g_); }
+  private:
+    double *g_;
+    QuadraticFunctionPtr qf_;
+    const double *x_;
+  };
+
+
+  /// Push all nodes into a heap and pop them again. Counts one call per node.
+  class HeapKernel : public BenchKernel {
+  public:
+    HeapKernel(std::vector<NodePtr> *nodes)
+      : heap_(NodeHeap::Value), nodes_(nodes) {}
+    void run() {
+      for (UInt i=0; i<nodes_->size(); ++i) {
+        heap_.push((*nodes_)[i]);
+      }
+      while (!heap_.isEmpty()) {
+        heap_.pop();
+      }
+    }
+  private:
+    NodeHeap heap_;
+    std::vector<NodePtr> *nodes_;
+  };
+
+
+  /// Score the cuts in the pool of a cut manager.
+  class PoolKernel : public BenchKernel {
+  public:
+    PoolKernel(CutMan2 *cm, ProblemPtr rel, ConstSolutionPtr sol)
+      : cm_(cm), rel_(rel), sol_(sol) {}
+    void run() { cm_->updatePool(rel_, sol_); }
+  private:
+    CutMan2 *cm_;
+    ProblemPtr rel_;
+    ConstSolutionPtr sol_;
+  };
+
+
+  double benchNow()
+  {
+    return std::chrono::duration<double>
+      (std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+
+  /**
+   * Time a kernel. per_call is the number of evaluations done by one call of
+   * run(), the times are reported per evaluation.
+   */
+  void benchTime(const std::string &problem, const std::string &kernel,
+                 UInt size, BenchKernel *k, UInt per_call,
+                 const BenchOpts &opts, std::vector<BenchResult> *results)
+  {
+    BenchResult r;
+    DoubleVector ns;
+    UInt calls = 0;
+    double t0, t;
+
+    // warm up, and find how many calls fill one repetition.
+    t0 = benchNow();
+    do {
+      k->run();
+      ++calls;
+      t = benchNow()-t0;
+    } while (t < 0.2e-3*opts.repMs);
+    calls = std::max(1.0, floor(calls*opts.repMs*1e-3/t));
+
+    for (UInt i=0; i<opts.reps; ++i) {
+      t0 = benchNow();
+      for (UInt j=0; j<calls; ++j) {
+        k->run();
+      }
+      t = benchNow()-t0;
+      ns.push_back(t*1e9/((double) calls*per_call));
+    }
+    std::sort(ns.begin(), ns.end());
+
+    r.problem = problem;
+    r.kernel = kernel;
+    r.size = size;
+    r.calls = calls*per_call;
+    r.reps = opts.reps;
+    r.nsMedian = ns[ns.size()/2];
+    r.nsMin = ns[0];
+    results->push_back(r);
+    std::cout << std::setw(24) << std::left << problem << " "
+      << std::setw(14) << kernel << std::right << " size " << std::setw(9)
+      << size << "  " << std::setw(12) << std::fixed << std::setprecision(1)
+      << r.nsMedian << " ns/eval" << std::endl;
+  }
+
+
+  /// A point within the bounds of the variables, close to 0.5.
+  void benchPoint(ProblemPtr p, DoubleVector *x)
+  {
+    VariablePtr v;
+
+    x->resize(p->getNumVars());
+    for (UInt i=0; i<p->getNumVars(); ++i) {
+      v = p->getVariable(i);
+      (*x)[i] = std::min(std::max(0.5+0.01*(i%7), v->getLb()), v->getUb());
+    }
+  }
+
+
+  /// Benchmark the derivative kernels on a problem.
+  void benchProblem(const std::string &name, ProblemPtr p,
+                    const BenchOpts &opts,
+                    std::vector<BenchResult> *results)
+  {
+    std::vector<CGraphPtr> cgs;
+    std::vector<QuadraticFunctionPtr> qfs;
+    std::vector<FunctionPtr> fs;
+    DoubleVector x, g, mult, vals;
+    CGraphPtr cg;
+    UInt nnodes = 0;
+
+    p->setNativeDer();
+    benchPoint(p, &x);
+    g.assign(p->getNumVars(), 0.0);
+    mult.assign(p->getNumCons(), 1.0);
+
+    if (p->getObjective() && p->getObjective()->getFunction()) {
+      fs.push_back(p->getObjective()->getFunction());
+    }
+    for (ConstraintConstIterator it=p->consBegin(); it!=p->consEnd(); ++it) {
+      fs.push_back((*it)->getFunction());
+    }
+    for (UInt i=0; i<fs.size(); ++i) {
+      cg = dynamic_cast <CGraph*> (fs[i]->getNonlinearFunction());
+      if (cg) {
+        cgs.push_back(cg);
+        nnodes += cg->getNumNodes();
+      }
+      if (fs[i]->getQuadraticFunction()) {
+        qfs.push_back(fs[i]->getQuadraticFunction());
+      }
+    }
+
+    if (!cgs.empty()) {
+      CGEvalKernel ek(&cgs, &(x[0]));
+      ek.run();
+      if (ek.getErr()) {
+        std::cout << name << ": skipped, functions can not be evaluated at"
+          << " the benchmark point" << std::endl;
+        return;
+      }
+      benchTime(name, "cgraph_eval", nnodes, &ek, 1, opts, results);
+
+      CGGradKernel gk(&cgs, &(x[0]), &(g[0]));
+      benchTime(name, "cgraph_grad", nnodes, &gk, 1, opts, results);
+    }
+
+    if (!qfs.empty()) {
+      for (UInt i=0; i<qfs.size(); ++i) {
+        QfGradKernel qk(qfs[i], &(x[0]), &(g[0]));
+        benchTime(name, "quad_grad", qfs[i]->getNumTerms(), &qk, 1, opts,
+                  results);
+      }
+    }
+
+    if (p->getHessian() && p->getHessian()->getNumNz()>0) {
+      vals.assign(p->getHessian()->getNumNz(), 0.0);
+      HessKernel hk(p->getHessian(), &(x[0]),
+                    mult.empty() ? 0 : &(mult[0]), &(vals[0]));
+      benchTime(name, "hessian", vals.size(), &hk, 1, opts, results);
+    }
+
+    if (p->getJacobian() && p->getJacobian()->getNumNz()>0) {
+      vals.assign(p->getJacobian()->getNumNz(), 0.0);
+      JacKernel jk(p->getJacobian(), &(x[0]), &(vals[0]));
+      benchTime(name, "jacobian", vals.size(), &jk, 1, opts, results);
+    }
+  }
+
+
+  ProblemPtr benchNewProblem(EnvPtr env, UInt n)
+  {
+    ProblemPtr p = new Problem(env);
+
+    for (UInt i=0; i<n; ++i) {
+      p->newVariable(-10.0, 10.0, Continuous);
+    }
+    return p;
+  }
+
+
+  /// min x'Qx with a dense Q.
+  ProblemPtr benchDenseQP(EnvPtr env, UInt n)
+  {
+    ProblemPtr p = benchNewProblem(env, n);
+    QuadraticFunctionPtr qf = new QuadraticFunction();
+
+    for (UInt i=0; i<n; ++i) {
+      for (UInt j=i; j<n; ++j) {
+        qf->addTerm(p->getVariable(i), p->getVariable(j),
+                    1.0/(1.0+i+j));
+      }
+    }
+    p->newObjective(new Function(0, qf), 0.0, Minimize);
+    return p;
+  }
+
+
+  /// min x'Qx with a tridiagonal Q.
+  ProblemPtr benchSparseQP(EnvPtr env, UInt n)
+  {
+    ProblemPtr p = benchNewProblem(env, n);
+    QuadraticFunctionPtr qf = new QuadraticFunction();
+
+    for (UInt i=0; i<n; ++i) {
+      qf->addTerm(p->getVariable(i), p->getVariable(i), 2.0);
+      if (i+1<n) {
+        qf->addTerm(p->getVariable(i), p->getVariable(i+1), -1.0);
+      }
+    }
+    p->newObjective(new Function(0, qf), 0.0, Minimize);
+    return p;
+  }
+
+
+  /// An objective that is a chain of depth nested operations on 100 vars.
+  ProblemPtr benchDeepTree(EnvPtr env, UInt depth)
+  {
+    const UInt n = 100;
+    ProblemPtr p = benchNewProblem(env, n);
+    CGraphPtr cg = new CGraph();
+    CNode *t = cg->newNode(p->getVariable(0));
+
+    for (UInt k=1; k<=depth; ++k) {
+      t = cg->newNode(OpMult, t, cg->newNode(p->getVariable(k%n)));
+      t = cg->newNode(OpSin, t, 0);
+      t = cg->newNode(OpPlus, t, cg->newNode(p->getVariable((7*k)%n)));
+    }
+    cg->setOut(t);
+    cg->finalize();
+    p->newObjective(new Function(cg), 0.0, Minimize);
+    return p;
+  }
+
+
+  /// An objective that is a sum of n products in one OpSumList.
+  ProblemPtr benchSumList(EnvPtr env, UInt n)
+  {
+    ProblemPtr p = benchNewProblem(env, n);
+    CGraphPtr cg = new CGraph();
+    std::vector<CNode *> kids(n);
+
+    for (UInt i=0; i<n; ++i) {
+      kids[i] = cg->newNode(OpMult, cg->newNode(p->getVariable(i)),
+                            cg->newNode(p->getVariable((i+1)%n)));
+    }
+    cg->setOut(cg->newNode(OpSumList, &(kids[0]), n));
+    cg->finalize();
+    p->newObjective(new Function(cg), 0.0, Minimize);
+    return p;
+  }
+
+
+  /// m constraints exp(0.1 x_i x_{i+1}) + x_{i+2}^2 <= 10.
+  ProblemPtr benchNlCons(EnvPtr env, UInt m)
+  {
+    ProblemPtr p = benchNewProblem(env, m+2);
+    CGraphPtr cg;
+    CNode *t;
+
+    for (UInt i=0; i<m; ++i) {
+      cg = new CGraph();
+      t = cg->newNode(OpMult, cg->newNode(p->getVariable(i)),
+                      cg->newNode(p->getVariable(i+1)));
+      t = cg->newNode(OpMult, cg->newNode(0.1), t);
+      t = cg->newNode(OpExp, t, 0);
+      t = cg->newNode(OpPlus, t,
+                      cg->newNode(OpSqr, cg->newNode(p->getVariable(i+2)),
+                                  0));
+      cg->setOut(t);
+      cg->finalize();
+      p->newConstraint(new Function(cg), -INFINITY, 10.0);
+    }
+    return p;
+  }
+
+
+  void benchLinear(EnvPtr env, UInt n, const BenchOpts &opts,
+                   std::vector<BenchResult> *results)
+  {
+    ProblemPtr p = benchNewProblem(env, n);
+    LinearFunctionPtr lf = new LinearFunction();
+    DoubleVector x;
+
+    for (UInt i=0; i<n; i+=3) {
+      lf->addTerm(p->getVariable(i), 1.0+(i%5));
+    }
+    lf->freeze();
+    benchPoint(p, &x);
+
+    LinEvalKernel k(lf, &(x[0]));
+    benchTime("linear", "linear_eval", lf->getNumTerms(), &k, 1, opts,
+              results);
+    delete lf;
+    delete p;
+  }
+
+
+  void benchNodeHeap(UInt n, const BenchOpts &opts,
+                     std::vector<BenchResult> *results)
+  {
+    std::vector<NodePtr> nodes(n);
+
+    srand(1);
+    for (UInt i=0; i<n; ++i) {
+      nodes[i] = new Node();
+      nodes[i]->setId(i);
+      nodes[i]->setDepth(i%50);
+      nodes[i]->setLb(rand()/(double) RAND_MAX);
+    }
+
+    HeapKernel k(&nodes);
+    benchTime("node_heap", "push_pop", n, &k, n, opts, results);
+    for (UInt i=0; i<n; ++i) {
+      delete nodes[i];
+    }
+  }
+
+
+  /**
+   * Fill the pool of a cut manager with linear cuts a'x <= 1 and time
+   * updatePool at a point that violates all of them a little, so that the
+   * pool does not change between calls.
+   */
+  void benchCutPool(EnvPtr env, UInt ncuts, const BenchOpts &opts,
+                    std::vector<BenchResult> *results)
+  {
+    const UInt n = 1000, nz = 20;
+    ProblemPtr empty = new Problem(env);
+    ProblemPtr rel = benchNewProblem(env, n);
+    CutMan2 *cm = new CutMan2(env, empty);
+    SolutionPtr sol;
+    LinearFunctionPtr lf;
+    DoubleVector x(n, 1.02/nz), y;
+
+    srand(1);
+    for (UInt i=0; i<ncuts; ++i) {
+      lf = new LinearFunction();
+      for (UInt j=0; j<nz; ++j) {
+        lf->incTerm(rel->getVariable((i*nz+j*37)%n), 1.0);
+      }
+      cm->addCut(rel, new Function(lf), -INFINITY, 1.0, true, false);
+    }
+
+    // cuts that are never active leave the relaxation for the pool.
+    for (UInt i=0; i<500 && cm->getNumEnabledCuts()>5; ++i) {
+      y.assign(rel->getNumCons()+ncuts, 0.0);
+      sol = new Solution(0.0, &(x[0]), rel);
+      sol->setDualOfCons(&(y[0]));
+      cm->updateRel(sol, rel);
+      delete sol;
+    }
+
+    sol = new Solution(0.0, &(x[0]), rel);
+    PoolKernel k(cm, rel, sol);
+    benchTime("cut_pool", "update_pool", cm->getNumDisabledCuts(), &k, 1,
+              opts, results);
+    delete sol;
+    delete cm;
+    delete rel;
+    delete empty;
+  }
+
+
+#ifdef USE_MINOTAUR_AMPL_INTERFACE
+  void benchInstances(EnvPtr env, const BenchOpts &opts,
+                      std::vector<BenchResult> *results)
+  {
+    DIR *dir = opendir(opts.dir.c_str());
+    struct dirent *ent;
+    std::vector<std::string> files;
+    MINOTAUR_AMPL::AMPLInterfacePtr iface;
+    ProblemPtr p;
+
+    if (!dir) {
+      std::cerr << "minotaur-bench: can not open " << opts.dir << std::endl;
+      return;
+    }
+    while ((ent = readdir(dir))) {
+      std::string f = ent->d_name;
+      if (f.size()>3 && f.compare(f.size()-3, 3, ".nl")==0) {
+        files.push_back(f);
+      }
+    }
+    closedir(dir);
+    std::sort(files.begin(), files.end());
+
+    env->getOptions()->findBool("use_native_cgraph")->setValue(true);
+    for (UInt i=0; i<files.size(); ++i) {
+      iface = new MINOTAUR_AMPL::AMPLInterface(env, "minotaur-bench");
+      p = iface->readInstance(opts.dir + "/" + files[i]);
+      if (p) {
+        benchProblem(files[i], p, opts, results);
+        delete p;
+      }
+      delete iface;
+    }
+  }
+#endif
+
+
+  void benchWrite(std::ostream &out, const BenchOpts &opts,
+                  const std::vector<BenchResult> &results)
+  {
+    out << "{" << std::endl
+      << "  \"version\": \"" << MINOTAUR_GIT_VERSION << "\"," << std::endl
+      << "  \"scale\": " << opts.scale << "," << std::endl
+      << "  \"rep_ms\": " << opts.repMs << "," << std::endl
+      << "  \"results\": [" << std::endl;
+    out << std::setprecision(6);
+    for (UInt i=0; i<results.size(); ++i) {
+      const BenchResult &r = results[i];
+      out << "    {\"problem\": \"" << r.problem << "\", \"kernel\": \""
+        << r.kernel << "\", \"size\": " << r.size << ", \"calls\": "
+        << r.calls << ", \"reps\": " << r.reps << ", \"ns_per_eval\": "
+        << r.nsMedian << ", \"ns_per_eval_min\": " << r.nsMin
+        << ", \"evals_per_s\": " << 1e9/r.nsMedian << "}"
+        << (i+1<results.size() ? "," : "") << std::endl;
+    }
+    out << "  ]" << std::endl << "}" << std::endl;
+  }
+
+
+  void benchUsage()
+  {
+    std::cerr << "usage: minotaur-bench [-o file.json] [-r reps] [-s scale]"
+      << " [-t rep_ms] [instance_dir]" << std::endl;
+  }
+}
+
+
+int main(int argc, char** argv)
+{
+  EnvPtr env = (EnvPtr) new Environment();
+  std::vector<BenchResult> results;
+  std::ofstream out;
+  BenchOpts opts;
+  double s;
+
+  opts.out = "bench.json";
+  opts.reps = 7;
+  opts.repMs = 20.0;
+  opts.scale = 1.0;
+  for (int i=1; i<argc; ++i) {
+    if (0==strcmp(argv[i], "-o") && i+1<argc) {
+      opts.out = argv[++i];
+    } else if (0==strcmp(argv[i], "-r") && i+1<argc) {
+      opts.reps = std::max(1, atoi(argv[++i]));
+    } else if (0==strcmp(argv[i], "-s") && i+1<argc) {
+      opts.scale = std::max(1e-3, atof(argv[++i]));
+    } else if (0==strcmp(argv[i], "-t") && i+1<argc) {
+      opts.repMs = std::max(1e-2, atof(argv[++i]));
+    } else if ('-'!=argv[i][0]) {
+      opts.dir = argv[i];
+    } else {
+      benchUsage();
+      delete env;
+      return 1;
+    }
+  }
+  env->getLogger()->setMaxLevel(LogNone);
+  s = opts.scale;
+
+  ProblemPtr p;
+  p = benchDenseQP(env, (UInt) ceil(200*s));
+  benchProblem("qp_dense", p, opts, &results);
+  delete p;
+  p = benchSparseQP(env, (UInt) ceil(100000*s));
+  benchProblem("qp_sparse", p, opts, &results);
+  delete p;
+  p = benchDeepTree(env, (UInt) ceil(5000*s));
+  benchProblem("deep_tree", p, opts, &results);
+  delete p;
+  p = benchSumList(env, (UInt) ceil(5000*s));
+  benchProblem("sum_list", p, opts, &results);
+  delete p;
+  p = benchNlCons(env, (UInt) ceil(10000*s));
+  benchProblem("nl_cons", p, opts, &results);
+  delete p;
+  benchLinear(env, (UInt) ceil(300000*s), opts, &results);
+  benchNodeHeap((UInt) ceil(100000*s), opts, &results);
+  benchCutPool(env, (UInt) ceil(2000*s), opts, &results);
+
+  if (!opts.dir.empty()) {
+#ifdef USE_MINOTAUR_AMPL_INTERFACE
+    benchInstances(env, opts, &results);
+#else
+    std::cerr << "minotaur-bench: built without the AMPL interface, .nl "
+      << "files in " << opts.dir << " are skipped" << std::endl;
+#endif
+  }
+
+  out.open(opts.out.c_str());
+  if (!out.is_open()) {
+    std::cerr << "minotaur-bench: can not write " << opts.out << std::endl;
+    delete env;
+    return 1;
+  }
+  benchWrite(out, opts, results);
+  out.close();
+  delete env;
+  return 0;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
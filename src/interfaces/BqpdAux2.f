@@ -23,6 +23,10 @@ c     ********************************************************************
      * nprofs,lc,lc1,li,li1,lm,lm1,lp,lp1,lq,lq1,lr,lr1,ls,ls1,lt,lt1
       common /vstepc/     vstep
       common /wsc/        kk, ll, kkk, lll, maxwk, maxiwk
+!$omp threadprivate(/bqpdc/, /bqpd_count/, /cpname/, /densec/, /epsc/,
+!$omp&  /factorc/, /hessc/, /iprintc/, /kkll_maxc_/, /minorc/, /mxm1c/,
+!$omp&  /noutc/, /QPtolc/, /refactorc/, /repc/, /scalec/, /sparsec/,
+!$omp&  /vstepc/, /wsc/)
 
 
       print *, 'writing wsc'
@@ -69,6 +73,9 @@ c     ********************************************************************
       common /hessc/      phl, phr, phc
       common /minorc/     c
       common /scalec/     scale_mode, phe
+!$omp threadprivate(/bqpdc/, /epsc/, /vstepc/, /repc/, /refactorc/,
+!$omp&  /wsc/, /alphac/, /sparsec/, /factorc/, /hessc/, /minorc/,
+!$omp&  /scalec/)
       irh1  = 0
       na    = 0
       na1   = 0
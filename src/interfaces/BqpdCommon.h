@@ -0,0 +1,78 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+/**
+ * \file BqpdCommon.h
+ * \brief Declare the copy of the common blocks of bqpd kept by engines that
+ * use bqpd, and the functions that load and save it.
+ * \author The Minotaur Team
+ *
+ * This header is used by both BqpdEngine and FilterSQPEngine. It does not
+ * declare anything that is also declared in BqpdEngineTypes.h or
+ * FilterSQPEngineTypes.h, so that both can be included with it.
+ */
+
+#ifndef MINOTAURBQPDCOMMON_H
+#define MINOTAURBQPDCOMMON_H
+
+#if 1 // on linux, with g77, this works.
+
+typedef double real;
+typedef int    fint;
+#define getcommon getcommon_
+#define setcommon setcommon_
+
+#else  // if we are on some other architecture, use some other defines etc.
+
+#endif // end of if 1.
+
+namespace Minotaur {
+  /**
+   * \brief Values of the variables in the common blocks of bqpd. bqpd keeps
+   * its state between calls in common blocks, which are global. Each engine
+   * that uses bqpd keeps its own copy. It is loaded before bqpd is called
+   * and saved after the call, see loadBqpdCommon() and saveBqpdCommon().
+   *
+   * This lets several engines be used one after another without
+   * overwriting each other's warm starts. If libbqpd and libfiltersqp are
+   * built with OpenMP and their common blocks declared threadprivate
+   * (cmake option BQPD_THREADPRIVATE, which defines
+   * MINOTAUR_BQPD_THREADPRIVATE), each thread has its own common blocks
+   * and engines in different threads solve concurrently. Otherwise the
+   * common blocks are shared by all threads, and the load, the call and the
+   * save are done in "omp critical (bqpdCommon)".
+   */
+  struct BqpdCommon {
+    fint  ic[76];    /// Integer variables.
+    float rc[8];     /// Single precision variables.
+    real  dc[4];     /// Double precision variables.
+    char  pname[10]; /// Name of the problem.
+  };
+}
+
+/// Copy c to the common blocks of bqpd.
+void loadBqpdCommon(Minotaur::BqpdCommon *c);
+
+/// Copy the common blocks of bqpd to c.
+void saveBqpdCommon(Minotaur::BqpdCommon *c);
+
+extern "C" {
+  void getcommon(fint *ic, float *rc, real *dc, char *pc, long pc_len);
+  void setcommon(fint *ic, float *rc, real *dc, char *pc, long pc_len);
+}
+
+#endif // ifndef MINOTAURBQPDCOMMON_H
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -16,7 +16,9 @@
 
 // #define SPEW 1
 
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
 #include <iomanip>
 #include <iostream>
 #include <string.h> // for memset
@@ -31,6 +33,7 @@
 #include "LinearFunction.h"
 #include "Logger.h"
 #include "Objective.h"
+#include "Operations.h"
 #include "Option.h"
 #include "QuadraticFunction.h"
 #include "Problem.h"
@@ -43,11 +46,25 @@ using namespace Minotaur;
 
 const std::string BqpdEngine::me_ = "BqpdEngine: ";
 
+void loadBqpdCommon(BqpdCommon *c)
+{
+  setcommon(c->ic, c->rc, c->dc, c->pname, 10);
+}
+
+
+void saveBqpdCommon(BqpdCommon *c)
+{
+  getcommon(c->ic, c->rc, c->dc, c->pname, 10);
+}
+
+
 BqpdEngine::BqpdEngine(EnvPtr env)
   : bndChanges_(0),
     bndRelaxed_(false),
     bTol_(1e-9),
     chkPt_(0),
+    chkPtCommon_(0),
+    common_(0),
     consModed_(false),
     dualCons_(0),
     dualX_(0),
@@ -57,6 +74,7 @@ BqpdEngine::BqpdEngine(EnvPtr env)
     maxIterLimit_(1000),
     prevStrBr_(false),
     resolveError_(true),
+    rowsModed_(false),
     sol_(0),
     strBr_(false),
     timer_(0)
@@ -76,6 +94,16 @@ BqpdEngine::BqpdEngine(EnvPtr env)
   stats_->strIters = 0;
   problem_ = ProblemPtr(); // NULL
 
+  // start from the current values, as if no other engine used bqpd.
+  common_ = new BqpdCommon();
+  chkPtCommon_ = new BqpdCommon();
+#if !defined(MINOTAUR_BQPD_THREADPRIVATE)
+#pragma omp critical (bqpdCommon)
+#endif
+  {
+    saveBqpdCommon(common_);
+  }
+
   assert(wsMode_<7 && wsMode_>0);
 }
 
@@ -105,12 +133,24 @@ BqpdEngine::~BqpdEngine()
   if (dualCons_) {
     delete [] dualCons_;
   }
+  if (common_) {
+    delete common_;
+  }
+  if (chkPtCommon_) {
+    delete chkPtCommon_;
+  }
 }
 
 
 void BqpdEngine::addConstraint(ConstraintPtr)
 {
-  consModed_ = true;
+  // new constraints are always at the end of problem_, so rowMap_ does not
+  // change.
+  rowsModed_ = true;
+  if (true==strBr_ && chkPt_) {
+    delete chkPt_;
+    chkPt_ = 0;
+  }
 }
 
 
@@ -180,9 +220,25 @@ void BqpdEngine::load_()
   }
   mxwk    = 21*n + 8*m + mlp + lh1 + kmax*(kmax+9)/2 + mxwk0;
   mxiwk   = 13*n + 4*m + mlp + lh1 + kmax + 113 + mxiwk0;
-  setwsc(&mxwk, &mxiwk, &kk0, &ll0);
+#if !defined(MINOTAUR_BQPD_THREADPRIVATE)
+#pragma omp critical (bqpdCommon)
+#endif
+  {
+    loadBqpdCommon(common_);
+    setwsc(&mxwk, &mxiwk, &kk0, &ll0);
+    saveBqpdCommon(common_);
+  }
 
-  sol_ = (SolutionPtr) new Solution(INFINITY, 0, problem_);
+  if (sol_ && false==consModed_) {
+    // only rows were added or deleted. Callers may still hold sol_ from the
+    // last solve, so keep it.
+    sol_->setNumCons(m);
+  } else {
+    if (sol_) {
+      delete sol_;
+    }
+    sol_ = (SolutionPtr) new Solution(INFINITY, 0, problem_);
+  }
   if (dualX_) {
     delete [] dualX_;
     delete [] dualCons_;
@@ -190,6 +246,10 @@ void BqpdEngine::load_()
   dualX_ = new double[n];
   dualCons_ = new double[m];
   fStart_ = new BqpdData(n, m, kmax, maxa, lh1, problem_->getNumJacNnzs());
+  rowMap_.resize(m);
+  for (int i=0; i<m; ++i) {
+    rowMap_[i] = i;
+  }
 
 #if SPEW
   logger_->msgStream(LogDebug2) << me_ << "maxa = " << maxa << std::endl;
@@ -197,9 +257,83 @@ void BqpdEngine::load_()
 }
 
 
-void BqpdEngine::removeCons(std::vector<ConstraintPtr> &)
+bool BqpdEngine::loadRows_()
 {
-  consModed_ = true;
+  BqpdData *old = fStart_;
+  int n = old->n;
+  int na = n-old->k;   // number of active constraints in old.
+  int nact = 0;        // number of active constraints in fStart_.
+  int neq = 0;         // number of active equality constraints.
+  int nm, i, j, r;
+  bool is_ws = false;
+  std::vector<bool> active;
+  IntVector old_map;
+
+  // load_() resets rowMap_ for the new rows.
+  old_map.swap(rowMap_);
+  fStart_ = 0;
+  load_();
+  setGradient_();
+  setHessian_();
+  setConsBounds_();
+
+  if (n==(int) fStart_->n && EngineError!=status_ &&
+      ProvenInfeasible!=status_) {
+    nm = fStart_->n+fStart_->m;
+    active.resize(nm, false);
+    for (i=0; i<na; ++i) {
+      j = abs(old->ls[i]);
+      if (j>n) {
+        r = old_map[j-n-1];
+        if (r<0) {
+          continue;
+        }
+        j = n+r+1;
+      }
+      fStart_->ls[nact] = (old->ls[i] > 0) ? j : -j;
+      active[j-1] = true;
+      if (i<old->peq) {
+        ++neq;
+      }
+      ++nact;
+    }
+    fStart_->k = n-nact;
+    if (fStart_->k <= fStart_->kmax) {
+      j = nact;
+      for (i=0; i<nm; ++i) {
+        if (false==active[i]) {
+          fStart_->ls[j] = i+1;
+          ++j;
+        }
+      }
+      fStart_->peq = neq;
+      std::copy(old->x, old->x+n, fStart_->x);
+      is_ws = true;
+    }
+  }
+  if (false==is_ws) {
+    fStart_->k = 0;
+    setInitialPoint_();
+  }
+  delete old;
+  return is_ws;
+}
+
+
+void BqpdEngine::removeCons(std::vector<ConstraintPtr> &delcons)
+{
+  if (fStart_ && false==consModed_) {
+    UIntVector dels;
+
+    // indices of the deleted constraints are still the old ones here.
+    for (std::vector<ConstraintPtr>::iterator it=delcons.begin();
+         it!=delcons.end(); ++it) {
+      dels.push_back((*it)->getIndex());
+    }
+    std::sort(dels.begin(), dels.end());
+    renumberRows(rowMap_, dels);
+  }
+  rowsModed_ = true;
   if (true==strBr_ && chkPt_) {
     delete chkPt_;
     chkPt_ = 0;
@@ -380,6 +514,17 @@ EngineStatus BqpdEngine::solve()
     setInitialPoint_();
     // set bounds on constraints.
     setConsBounds_();
+  } else if (rowsModed_ == true) {
+    // cuts were added or deleted. Keep the active set and let bqpd
+    // refactorize, instead of starting from scratch.
+    timer_->start();
+    if (loadRows_()) {
+      mode = 2;
+    } else {
+      mode = 1;
+    }
+    stats_->cTime += timer_->query();
+    timer_->stop();
   } else if (chkPt_) {
     mode = wsMode_;
   } else if (false == bndRelaxed_ && bndChanges_ < 3) {
@@ -390,6 +535,7 @@ EngineStatus BqpdEngine::solve()
     mode = wsMode_;
   }
   consModed_ = false;
+  rowsModed_ = false;
   bndRelaxed_ = false;
   bndChanges_ = 0;
 
@@ -429,7 +575,7 @@ EngineStatus BqpdEngine::solve()
 
   if (chkPt_) {
     timer_->start();
-    restorecommon();
+    *common_ = *chkPtCommon_;
     if (fStart_) {
       fStart_->copyFrom(chkPt_);
     } else {
@@ -472,11 +618,18 @@ void BqpdEngine::solve_(int mode, double &f)
   // solve QP by calling bqpd. x contains the final solution. f contains
   // the objective value.
   timer_->start();
-  bqpd_(&n, &m, &(fStart_->k), &(fStart_->kmax), fStart_->a, fStart_->la,
-        fStart_->x, fStart_->bl, fStart_->bu, &f, &fmin, fStart_->g,
-        fStart_->r, fStart_->w, fStart_->e, fStart_->ls, fStart_->alp,
-        fStart_->lp, &mlp, &(fStart_->peq), fStart_->ws, fStart_->lws, &mode,
-        &ifail, fStart_->info, &iprint, &nout);
+#if !defined(MINOTAUR_BQPD_THREADPRIVATE)
+#pragma omp critical (bqpdCommon)
+#endif
+  {
+    loadBqpdCommon(common_);
+    bqpd_(&n, &m, &(fStart_->k), &(fStart_->kmax), fStart_->a, fStart_->la,
+          fStart_->x, fStart_->bl, fStart_->bu, &f, &fmin, fStart_->g,
+          fStart_->r, fStart_->w, fStart_->e, fStart_->ls, fStart_->alp,
+          fStart_->lp, &mlp, &(fStart_->peq), fStart_->ws, fStart_->lws,
+          &mode, &ifail, fStart_->info, &iprint, &nout);
+    saveBqpdCommon(common_);
+  }
 
 #if SPEW
   logger_->msgStream(LogDebug2) 
@@ -754,7 +907,7 @@ void BqpdEngine::enableStrBrSetup()
   if (wsMode_>2) {
     timer_->start();
     chkPt_ = fStart_->clone();
-    savecommon();
+    *chkPtCommon_ = *common_;
     stats_->cTime += timer_->query();
     timer_->stop();
   }
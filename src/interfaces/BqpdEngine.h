@@ -20,6 +20,7 @@ namespace Minotaur {
   class   Environment;
   class   Problem;
   class   Solution;
+  struct  BqpdCommon;
   typedef Environment* EnvPtr;
   typedef Problem* ProblemPtr;
   typedef Solution* SolutionPtr;
@@ -154,6 +155,17 @@ namespace Minotaur {
     /// Checkpoint copy of fStart_.
     BqpdData *chkPt_;
 
+    /// Checkpoint copy of common_.
+    BqpdCommon *chkPtCommon_;
+
+    /**
+     * Values of the common blocks of bqpd for this engine. They are loaded
+     * before each call to bqpd, so that several engines can be used in the
+     * same process. Calls from different threads are serialized, they do
+     * not run concurrently.
+     */
+    BqpdCommon *common_;
+
     /// If a constraint is modified, this is set to true. 
     bool consModed_;
 
@@ -196,6 +208,18 @@ namespace Minotaur {
      */
     bool resolveError_;
 
+    /**
+     * For each constraint in fStart_, its index in problem_ or -1 if it has
+     * been deleted after the last load.
+     */
+    IntVector rowMap_;
+
+    /**
+     * If constraints are only added or deleted since the last solve, this
+     * is set to true. The active set of the last solve is then kept.
+     */
+    bool rowsModed_;
+
     /// Solution found by the engine. 
     SolutionPtr sol_;
 
@@ -217,6 +241,18 @@ namespace Minotaur {
     /// Allocate the data structures for Bqpd.
     void load_();
 
+    /**
+     * \brief Reload the data after constraints were added or deleted, and
+     * copy the point and the active set of the last solve.
+     *
+     * Active constraints that were deleted are dropped from the active set.
+     * New constraints are inactive. The Solution object of the last solve
+     * is kept.
+     * \returns True if the active set was copied and bqpd can be started in
+     * mode 2, false if it must be started from scratch.
+     */
+    bool loadRows_();
+
     /// Copy constraint bounds from the problem.
     void setConsBounds_();
 
@@ -14,6 +14,7 @@
 
 #include <stdint.h>
 
+#include "BqpdCommon.h"
 #include "Types.h"
 
 #ifndef MINOTAURBQPDENGINETYPES_H
@@ -28,8 +29,6 @@ typedef int    fint;
 #define gdotx gdotx_
 #define setwsc setwsc_
 #define writewsc writewsc_
-#define restorecommon restorecommon_
-#define savecommon savecommon_
 #define defaultcommon defaultcommon_
 
 #else  // if we are on some other architecture, use some other defines etc.
@@ -47,8 +46,6 @@ extern "C" {
   /// copy storage map for bqpd
   void setwsc(fint *mxws0, fint *mxlws0, fint *kk0, fint *ll0);
   void writewsc();
-  void restorecommon();
-  void savecommon();
   void defaultcommon();
 
   /// compute v=G.x (Hessian vector product); G stored in ws&lws
@@ -18,6 +18,7 @@
 #include <iomanip>
 
 #include "MinotaurConfig.h"
+#include "BqpdCommon.h"
 #include "Constraint.h"
 #include "Environment.h"
 #include "FilterSQPEngine.h"
@@ -140,30 +141,57 @@ void hessian(real *x, fint *, fint *, fint *phase, real *lam,
 
 
 FilterSQPWarmStart::FilterSQPWarmStart()
-  : sol_(SolutionPtr()) // NULL
+  : ref_(0),
+    sol_(SolutionPtr()) // NULL
 {
 }
 
 
 FilterSQPWarmStart::~FilterSQPWarmStart()
 {
-  if (sol_) {
-    delete sol_;
-  }
+  dropInfo();
 }
 
 
 // copy
 FilterSQPWarmStart::FilterSQPWarmStart(ConstFilterWSPtr warmSt)
+  : ref_(0)
 {
   if (warmSt && warmSt->sol_) {
     sol_ = (SolutionPtr) new Solution(warmSt->sol_);
+  } else if (warmSt && warmSt->ref_) {
+    sol_ = (SolutionPtr) new Solution(warmSt->ref_->sol_);
+    sol_->setDiff(warmSt->diffInds_, warmSt->diffVals_);
   } else {
     sol_ = 0;
   }
 }
  
 
+void FilterSQPWarmStart::dropInfo()
+{
+  if (sol_) {
+    delete sol_;
+    sol_ = 0;
+  }
+  if (ref_) {
+    if (0 == ref_->decrUseCnt()) {
+      delete ref_;
+    }
+    ref_ = 0;
+    UIntVector().swap(diffInds_);
+    DoubleVector().swap(diffVals_);
+  }
+}
+
+
+size_t FilterSQPWarmStart::getMemSize() const
+{
+  return sizeof(FilterSQPWarmStart) + (sol_ ? sol_->getMemSize() : 0) +
+    diffInds_.size()*(sizeof(UInt)+sizeof(double));
+}
+
+
 SolutionPtr FilterSQPWarmStart::getPoint()
 {
   return sol_;
@@ -172,13 +200,37 @@ SolutionPtr FilterSQPWarmStart::getPoint()
 
 bool FilterSQPWarmStart::hasInfo()
 {
-  if (sol_ && sol_->getPrimal()) {
+  if ((sol_ && sol_->getPrimal()) || ref_) {
     return true;
   }
   return false;
 }
 
 
+bool FilterSQPWarmStart::makeDiff(WarmStartPtr ref)
+{
+  FilterSQPWarmStart *ref2 = dynamic_cast<FilterSQPWarmStart *>(ref);
+  UIntVector inds;
+  DoubleVector vals;
+
+  if (!ref2 || ref2 == this || ref_ || !sol_ || !sol_->getPrimal() ||
+      !ref2->sol_) {
+    return false;
+  }
+  if (!sol_->diffFrom(ref2->sol_, &inds, &vals) ||
+      2*inds.size()*(sizeof(UInt)+sizeof(double)) > sol_->getMemSize()) {
+    return false;
+  }
+  diffInds_.swap(inds);
+  diffVals_.swap(vals);
+  ref_ = ref2;
+  ref_->incrUseCnt();
+  delete sol_;
+  sol_ = 0;
+  return true;
+}
+
+
 void FilterSQPWarmStart::setPoint(SolutionPtr sol)
 {
   sol_ = sol;
@@ -188,7 +240,12 @@ void FilterSQPWarmStart::setPoint(SolutionPtr sol)
 void FilterSQPWarmStart::write(std::ostream &out) const
 {
   out << "FilterSQP warm start information:"  << std::endl;
-  sol_->write(out);
+  if (sol_) {
+    sol_->write(out);
+  } else if (ref_) {
+    out << diffInds_.size() << " values differ from a reference"
+      << std::endl;
+  }
 }
 
 
@@ -198,6 +255,7 @@ FilterSQPEngine::FilterSQPEngine(EnvPtr env)
   bTol_(1e-9),
   bu_(0),
   c_(0),
+  common_(0),
   consChanged_(true),
   cstype_(0),
   env_(env),
@@ -239,11 +297,22 @@ FilterSQPEngine::FilterSQPEngine(EnvPtr env)
   stats_->strTime  = 0;
   stats_->iters    = 0;
   stats_->strIters = 0;
+
+  common_ = new BqpdCommon();
+#if !defined(MINOTAUR_BQPD_THREADPRIVATE)
+#pragma omp critical (bqpdCommon)
+#endif
+  {
+    saveBqpdCommon(common_);
+  }
 }
 
 
 FilterSQPEngine::~FilterSQPEngine()
 {
+  if (common_) {
+    delete common_;
+  }
   if (c_) {
     freeStorage_();
     c_ = 0;
@@ -964,10 +1033,18 @@ EngineStatus FilterSQPEngine::solve()
   // solve NLP by calling filter. x contains the final solution. f contains
   // the objective value.
   timer_->start();
-  filtersqp_(&n, &m, &kmax, &maxa, &maxf, &mlp, &mxwk, &mxiwk,
-	       &iprint, &nout, &ifail, &rho, x_, c_, &f, &fmin, bl_,
-	       bu_, s_, a_, la_, ws_, lws2_, lam_, cstype_, &user, iuser,
-	       &iterLimit_, istat_, rstat_, cstype_len);
+  // filterSQP and bqpd keep their state in global common blocks.
+#if !defined(MINOTAUR_BQPD_THREADPRIVATE)
+#pragma omp critical (bqpdCommon)
+#endif
+  {
+    loadBqpdCommon(common_);
+    filtersqp_(&n, &m, &kmax, &maxa, &maxf, &mlp, &mxwk, &mxiwk,
+               &iprint, &nout, &ifail, &rho, x_, c_, &f, &fmin, bl_,
+               bu_, s_, a_, la_, ws_, lws2_, lam_, cstype_, &user, iuser,
+               &iterLimit_, istat_, rstat_, cstype_len);
+    saveBqpdCommon(common_);
+  }
   consChanged_ = false;
 
 #if SPEW
@@ -23,6 +23,7 @@ namespace Minotaur {
   class   Problem;
   class   Solution;
   class   Timer;
+  struct  BqpdCommon;
   typedef Environment* EnvPtr;
   typedef FilterSQPWarmStart* FilterWSPtr;
   typedef const FilterSQPWarmStart* ConstFilterWSPtr;
@@ -44,18 +45,35 @@ namespace Minotaur {
     /// Default constructor
     FilterSQPWarmStart(); 
 
-    /// Copy constructor. Creates a full copy, not just copies pointers.
+    /**
+     * Copy constructor. Creates a full copy, not just copies pointers. If
+     * warm_st is a difference, the full solution is rebuilt from its
+     * reference.
+     */
     FilterSQPWarmStart(ConstFilterWSPtr warm_st);
 
     /// Destroy
     ~FilterSQPWarmStart();
 
-    /// Get solution.
+    /// Free the starting solution. Implement WarmStart::dropInfo().
+    void dropInfo();
+
+    // Implement WarmStart::getMemSize().
+    size_t getMemSize() const;
+
+    /// Get solution. NULL if the warm start is a difference.
     SolutionPtr getPoint();
 
     // Implement WarmStart::hasInfo().
     bool hasInfo();
 
+    /**
+     * Implement WarmStart::makeDiff(). Only the values that differ from
+     * those of ref are kept. It is done only if they need at most half the
+     * memory of the solution.
+     */
+    bool makeDiff(WarmStartPtr ref);
+
     /**
      * Overwrite the primal and dual values of warm-start. Sometimes, the
      * warm-start data is initialized and needs to be updated. This
@@ -68,6 +86,15 @@ namespace Minotaur {
     void write(std::ostream &out) const;
 
   private:
+    /// Positions of the values that differ from those of ref_.
+    UIntVector diffInds_;
+
+    /// Values at diffInds_.
+    DoubleVector diffVals_;
+
+    /// The warm start that the difference is from. NULL if not used.
+    FilterSQPWarmStart *ref_;
+
     /// The starting solution that is used to warm-start.
     SolutionPtr sol_;
   };
@@ -206,6 +233,12 @@ namespace Minotaur {
     /// values of constraint functions
     double *c_;
 
+    /**
+     * Values of the common blocks of bqpd, which is used by filterSQP, for
+     * this engine. They are loaded before each call to filterSQP.
+     */
+    BqpdCommon *common_;
+
     /**
      * If true, reallocate space in the next solve. Important, if
      * constraints or objectives have changed.
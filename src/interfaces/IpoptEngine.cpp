@@ -143,6 +143,31 @@ void IpoptSolution::setDualOfVars(const double *lower, const double *upper)
 }
 
 
+void IpoptSolution::getArrays_(std::vector<double *> *arrs,
+                               UIntVector *sizes) const
+{
+  Solution::getArrays_(arrs, sizes);
+  arrs->push_back(dualXLow_);
+  sizes->push_back(n_);
+  arrs->push_back(dualXUp_);
+  sizes->push_back(n_);
+}
+
+
+size_t IpoptSolution::getMemSize() const
+{
+  size_t bytes = Solution::getMemSize() + sizeof(IpoptSolution) -
+    sizeof(Solution);
+  if (dualXLow_) {
+    bytes += n_*sizeof(double);
+  }
+  if (dualXUp_) {
+    bytes += n_*sizeof(double);
+  }
+  return bytes;
+}
+
+
 void IpoptSolution::write(std::ostream &out) const
 {
   const double *d;
@@ -184,16 +209,21 @@ void IpoptSolution::write(std::ostream &out) const
 // ----------------------------------------------------------------------- //
 
 IpoptWarmStart::IpoptWarmStart()
-: sol_(0)
+: ref_(0),
+  sol_(0)
 {
 }
 
 
 /// Copy constructor. Creates a full copy, not just copies pointers.
 IpoptWarmStart::IpoptWarmStart(ConstIpoptWarmStartPtr ws)
+: ref_(0)
 {
   if (ws && ws->sol_) {
     sol_ = (IpoptSolPtr) new IpoptSolution(ws->sol_);
+  } else if (ws && ws->ref_) {
+    sol_ = (IpoptSolPtr) new IpoptSolution(ws->ref_->sol_);
+    sol_->setDiff(ws->diffInds_, ws->diffVals_);
   } else {
     sol_ = 0;
   }
@@ -201,13 +231,35 @@ IpoptWarmStart::IpoptWarmStart(ConstIpoptWarmStartPtr ws)
 
 
 IpoptWarmStart::~IpoptWarmStart()
+{
+  dropInfo();
+}
+
+
+void IpoptWarmStart::dropInfo()
 {
   if (sol_) {
     delete sol_;
+    sol_ = 0;
+  }
+  if (ref_) {
+    if (0 == ref_->decrUseCnt()) {
+      delete ref_;
+    }
+    ref_ = 0;
+    UIntVector().swap(diffInds_);
+    DoubleVector().swap(diffVals_);
   }
 }
 
 
+size_t IpoptWarmStart::getMemSize() const
+{
+  return sizeof(IpoptWarmStart) + (sol_ ? sol_->getMemSize() : 0) +
+    diffInds_.size()*(sizeof(UInt)+sizeof(double));
+}
+
+
 IpoptSolPtr IpoptWarmStart::getPoint()
 {
   return sol_;
@@ -217,7 +269,7 @@ IpoptSolPtr IpoptWarmStart::getPoint()
 bool IpoptWarmStart::hasInfo()
 {
   // return true if warm start carries a starting solution
-  if (sol_ && sol_->getPrimal()) {
+  if ((sol_ && sol_->getPrimal()) || ref_) {
     return true;
   } else {
     return false;
@@ -225,6 +277,30 @@ bool IpoptWarmStart::hasInfo()
 }
 
 
+bool IpoptWarmStart::makeDiff(WarmStartPtr ref)
+{
+  IpoptWarmStartPtr ref2 = dynamic_cast<IpoptWarmStart *>(ref);
+  UIntVector inds;
+  DoubleVector vals;
+
+  if (!ref2 || ref2 == this || ref_ || !sol_ || !sol_->getPrimal() ||
+      !ref2->sol_) {
+    return false;
+  }
+  if (!sol_->diffFrom(ref2->sol_, &inds, &vals) ||
+      2*inds.size()*(sizeof(UInt)+sizeof(double)) > sol_->getMemSize()) {
+    return false;
+  }
+  diffInds_.swap(inds);
+  diffVals_.swap(vals);
+  ref_ = ref2;
+  ref_->incrUseCnt();
+  delete sol_;
+  sol_ = 0;
+  return true;
+}
+
+
 void IpoptWarmStart::setPoint(IpoptSolPtr sol)
 {
   sol_ = sol;
@@ -234,7 +310,12 @@ void IpoptWarmStart::setPoint(IpoptSolPtr sol)
 void IpoptWarmStart::write(std::ostream &out) const
 {
   out << "Ipopt warm start information:"  << std::endl;
-  sol_->write(out);
+  if (sol_) {
+    sol_->write(out);
+  } else if (ref_) {
+    out << diffInds_.size() << " values differ from a reference"
+      << std::endl;
+  }
 }
 
 
@@ -860,8 +941,18 @@ IpoptFunInterface::IpoptFunInterface(Minotaur::EnvPtr env,
                                      Minotaur::IpoptSolPtr sol)
 : bOff_(1e-9),
   bTol_(1e-6),
+  gErr_(0),
+  gOk_(false),
+  gradErr_(0),
+  gradOk_(false),
+  jacErr_(0),
+  jacOk_(false),
+  objErr_(0),
+  objOk_(false),
+  objVal_(0.0),
   problem_(problem),
-  sol_(sol)
+  sol_(sol),
+  xxOk_(false)
 {
   evalWithinBnds_ = env->getOptions()->findBool("eval_within_bnds")->getValue();
   logger_ = env->getLogger();
@@ -897,6 +988,10 @@ bool IpoptFunInterface::get_bounds_info(Index n, Number* x_l, Number* x_u,
   assert(n == (int) problem_->getNumVars());
   assert(m == (int) problem_->getNumCons());
 
+  // Called at the start of every solve. The problem may have been modified
+  // since the last one, so nothing evaluated then can be reused.
+  newPoint_();
+
   // variable bounds
   Minotaur::VariablePtr vPtr;
   Minotaur::VariableConstIterator vIter;
@@ -1020,120 +1115,101 @@ bool IpoptFunInterface::get_starting_point(Index n, bool init_x, Number* x,
 }
 
 
-bool IpoptFunInterface::eval_f(Index n, const Number* x, bool, Number& obj_value)
+bool IpoptFunInterface::eval_f(Index n, const Number* x, bool new_x,
+                               Number& obj_value)
 {
-  int error = 0;
-  double *ex = 0; // it will be assigned to xx if evalWithinBnds_ is true,
-                  // otherwise to x.
-  double *xx = 0;
+  const double *ex = getPoint_(x, n, new_x);
 
-  if (evalWithinBnds_) {
-    xx = pullXToBnds_(x, n);
-    ex = xx;
-  } else {
-    ex = (double *) x;
+  if (!objOk_) {
+    objErr_ = 0;
+    // return the value of the objective function
+    objVal_ = problem_->getObjValue(ex, &objErr_);
+    objOk_ = true;
   }
-  // return the value of the objective function
-  obj_value = problem_->getObjValue(ex, &error);
-  return (0==error);
+  obj_value = objVal_;
+  return (0==objErr_);
 }
 
 
-bool IpoptFunInterface::eval_g(Index n, const Number* x, bool, Index, Number* g)
+bool IpoptFunInterface::eval_g(Index n, const Number* x, bool new_x, Index m,
+                               Number* g)
 {
   // return the value (activity) of the constraints: g(x)
   Minotaur::ConstraintConstIterator cIter;
   Minotaur::ConstraintPtr cPtr;
   Minotaur::UInt i=0;
-  int error = 0, e = 0;
-  double *ex = 0; // it will be assigned to xx if evalWithinBnds_ is true,
-                  // otherwise to x.
-  double *xx = 0;
-
-  if (evalWithinBnds_) {
-    xx = pullXToBnds_(x, n);
-    ex = xx;
-  } else {
-    ex = (double *) x;
-  }
-  for (cIter=problem_->consBegin(); cIter!=problem_->consEnd(); ++cIter) {
-    cPtr = *cIter;
-    e = 0;
-    g[i] = cPtr->getActivity(ex, &e);
-    if (e!=0) {
-      error=1;
+  int e = 0;
+  const double *ex = getPoint_(x, n, new_x);
+
+  if (!gOk_) {
+    g_.resize(m);
+    gErr_ = 0;
+    for (cIter=problem_->consBegin(); cIter!=problem_->consEnd(); ++cIter) {
+      cPtr = *cIter;
+      e = 0;
+      g_[i] = cPtr->getActivity(ex, &e);
+      if (e!=0) {
+        gErr_=1;
 #if SPEW
-      logger_->msgStream(Minotaur::LogDebug)
-        << "IpoptFunInterface: error in evaluating constraint\n";
-      cPtr->write(logger_->msgStream(Minotaur::LogDebug));
+        logger_->msgStream(Minotaur::LogDebug)
+          << "IpoptFunInterface: error in evaluating constraint\n";
+        cPtr->write(logger_->msgStream(Minotaur::LogDebug));
 #endif
+      }
+      ++i;
     }
-    ++i;
-  }
-
-  if (xx) {
-    delete [] xx ;
+    gOk_ = true;
   }
+  std::copy(g_.begin(), g_.end(), g);
 
-  return (0==error);
+  return (0==gErr_);
 }
 
 
-bool IpoptFunInterface::eval_grad_f(Index n, const Number* x, bool, 
+bool IpoptFunInterface::eval_grad_f(Index n, const Number* x, bool new_x, 
                                     Number* grad_f)
 {
   // return the gradient of the objective function grad_{x} f(x)
 
-  int error = 0;
   Minotaur::ObjectivePtr o;
-  double *ex = NULL; // it will be assigned to xx if evalWithinBnds_ is true,
-                     // otherwise to x.
-  double *xx = NULL;
-
-  std::fill(grad_f, grad_f+n, 0);
-
-  if (evalWithinBnds_) {
-    xx = pullXToBnds_(x, n);
-    ex = xx;
-  } else {
-    ex = (double *) x;
-  }
-
-  o = problem_->getObjective();
-  if (o) {
-    o->evalGradient(ex, (double *)grad_f, &error);
-  }
-
-  if (xx) {
-    delete [] xx ;
+  const double *ex = getPoint_(x, n, new_x);
+
+  if (!gradOk_) {
+    grad_.assign(n, 0.0);
+    gradErr_ = 0;
+    o = problem_->getObjective();
+    if (o && n>0) {
+      o->evalGradient(ex, &grad_[0], &gradErr_);
+    }
+    gradOk_ = true;
   }
+  std::copy(grad_.begin(), grad_.end(), grad_f);
 
   //for (int i=0; i<n; ++i) {
   //  std::cout << "grad obj [" << i << "] = " << grad_f[i] << std::endl;
   //}
-  return (0==error);
+  return (0==gradErr_);
 }
 
 
-bool IpoptFunInterface::eval_h(Index n, const Number* x, bool, Number obj_factor, 
-                               Index, const Number* lambda, bool, Index,
+bool IpoptFunInterface::eval_h(Index n, const Number* x, bool new_x,
+                               Number obj_factor, Index,
+                               const Number* lambda, bool, Index,
                                Index* iRow, Index* jCol, Number* values)
 {
   int error = 0;
-  double *ex = NULL; // it will be assigned to xx if evalWithinBnds_ is true,
-                     // otherwise to x.
-  double *xx = NULL;
+  const double *ex = NULL; // it will be assigned to xx_ if evalWithinBnds_
+                           // is true, otherwise to x.
 
   if (x==0 && lambda==0 && values==0) {
     problem_->getHessian()->fillRowColIndices((Minotaur::UInt *)iRow,
         (Minotaur::UInt *)jCol);
   } else if (x!=0 && lambda!=0 && values!=0) {
-    if (evalWithinBnds_) {
-      xx = pullXToBnds_(x, n);
-      ex = xx;
-    } else {
-      ex = (double *) x;
-    }
+    // the multipliers change more often than x, so the values are not
+    // cached. Only the point is reused. Each compiled function keeps the
+    // values of its tape at the last point, so the forward sweeps done by
+    // eval_f, eval_g etc. at this point are not repeated.
+    ex = getPoint_(x, n, new_x);
     problem_->getHessian()->fillRowColValues(ex, 
         (double) obj_factor, (double *) lambda, 
         (double *)values, &error);
@@ -1144,9 +1220,6 @@ bool IpoptFunInterface::eval_h(Index n, const Number* x, bool, Number obj_factor
     //for (int i=0; i<problem_->getHessian()->getNumNz(); ++i) {
     //  std::cout << std::setprecision(8) << "h["<<i<<"] = "<<values[i] << std::endl;
     //}
-    if (xx) {
-      delete [] xx ;
-    }
   } else {
     assert (!"one of x, lambda and values is NULL!");
   }
@@ -1154,15 +1227,13 @@ bool IpoptFunInterface::eval_h(Index n, const Number* x, bool, Number obj_factor
 }
 
 
-bool IpoptFunInterface::eval_jac_g(Index n, const Number* x, bool, Index, 
-                                   Index, Index* iRow, Index *jCol, 
-                                   Number* values)
+bool IpoptFunInterface::eval_jac_g(Index n, const Number* x, bool new_x,
+                                   Index, Index nele_jac, Index* iRow,
+                                   Index *jCol, Number* values)
 {
   int error = 0;
-  double *ex = NULL; // it will be assigned to xx if evalWithinBnds_ is true,
-                     // otherwise to x.
-  double *xx = NULL;
-
+  const double *ex = NULL; // it will be assigned to xx_ if evalWithinBnds_
+                           // is true, otherwise to x.
 
   if (values == 0) {
     // return the structure of the jacobian of the constraints
@@ -1170,24 +1241,27 @@ bool IpoptFunInterface::eval_jac_g(Index n, const Number* x, bool, Index,
         (Minotaur::UInt *) jCol);
   }
   else {
-    if (evalWithinBnds_) {
-      xx = pullXToBnds_(x, n);
-      ex = xx;
-    } else {
-      ex = (double *) x;
-    }
-    // return the values of the jacobian of the constraints
-    problem_->getJacobian()->fillRowColValues((double *) ex, 
-        (double *) values, &error);
-    if (xx) {
-      delete [] xx ;
+    ex = getPoint_(x, n, new_x);
+    if (!jacOk_) {
+      // return the values of the jacobian of the constraints
+      jac_.assign(nele_jac, 0.0);
+      jacErr_ = 0;
+      if (nele_jac>0) {
+        problem_->getJacobian()->fillRowColValues((double *) ex, &jac_[0],
+                                                  &jacErr_);
+      }
+      jacOk_ = true;
     }
+    std::copy(jac_.begin(), jac_.end(), values);
+    error = jacErr_;
   }
   if (error!=0) {
     logger_->msgStream(Minotaur::LogError) << "IpoptFunInterface: " 
       << "error in evaluating jacobian. Setting eval_within_bnds to True."
       << std::endl;
     evalWithinBnds_ = true;
+    // values cached so far were computed at the unclamped point.
+    newPoint_();
   }
 
   return (0==error);
@@ -1215,19 +1289,45 @@ double IpoptFunInterface::getSolutionValue() const
 }
 
 
-double* IpoptFunInterface::pullXToBnds_(const Number* x, Index n)
+const double* IpoptFunInterface::getPoint_(const Number* x, Index n,
+                                           bool new_x)
+{
+  if (new_x) {
+    newPoint_();
+  }
+  if (!evalWithinBnds_) {
+    return x;
+  }
+  if (!xxOk_) {
+    pullXToBnds_(x, n);
+    xxOk_ = true;
+  }
+  return (n>0) ? &xx_[0] : x;
+}
+
+
+void IpoptFunInterface::newPoint_()
+{
+  gOk_ = false;
+  gradOk_ = false;
+  jacOk_ = false;
+  objOk_ = false;
+  xxOk_ = false;
+}
+
+
+void IpoptFunInterface::pullXToBnds_(const Number* x, Index n)
 {
-  double *xx = new double[n];
+  xx_.resize(n);
   for (int ii=0; ii<n; ++ii) {
     if (x[ii]<problem_->getVariable(ii)->getLb()) {
-      xx[ii] = problem_->getVariable(ii)->getLb();
+      xx_[ii] = problem_->getVariable(ii)->getLb();
     } else if (x[ii]>problem_->getVariable(ii)->getUb()) {
-      xx[ii] = problem_->getVariable(ii)->getUb();
+      xx_[ii] = problem_->getVariable(ii)->getUb();
     } else {
-      xx[ii] = x[ii];
+      xx_[ii] = x[ii];
     }
   }
-  return xx;
 }
 
 } // namespace Ipopt
@@ -91,6 +91,9 @@ namespace Minotaur {
      */
     const double * getUpperDualOfVars() const {return dualXUp_;};
 
+    // base class
+    size_t getMemSize() const;
+
     // base class
     void setDualOfVars(const double *) { assert(!"implement me!"); };
 
@@ -100,6 +103,10 @@ namespace Minotaur {
     /// Write to an output.
     void write(std::ostream &out) const;
 
+  protected:
+    // base class method. Duals of lower and upper bounds come last.
+    void getArrays_(std::vector<double *> *arrs, UIntVector *sizes) const;
+
   private:
     /// dual of lower bounds.
     double *dualXLow_;
@@ -119,18 +126,35 @@ namespace Minotaur {
     /// Default constructor
     IpoptWarmStart();
 
-    /// Copy constructor. Creates a full copy, not just copies pointers.
+    /**
+     * Copy constructor. Creates a full copy, not just copies pointers. If
+     * ws is a difference, the full solution is rebuilt from its reference.
+     */
     IpoptWarmStart(ConstIpoptWarmStartPtr ws);
 
     /// Destroy
     ~IpoptWarmStart();
 
-    /// Return the soluton that can be used as starting point.
+    /// Free the starting solution. Implement WarmStart::dropInfo().
+    void dropInfo();
+
+    // Implement WarmStart::getMemSize().
+    size_t getMemSize() const;
+
+    /// Return the soluton that can be used as starting point. NULL if the
+    /// warm start is a difference (see makeDiff()).
     IpoptSolPtr getPoint();
 
     // Implement WarmStart::hasInfo().
     bool hasInfo();
 
+    /**
+     * Implement WarmStart::makeDiff(). Only the values that differ from
+     * those of ref are kept. It is done only if they need at most half the
+     * memory of the solution.
+     */
+    bool makeDiff(WarmStartPtr ref);
+
     /**
      * Overwrite the primal and dual values of warm-start. Sometimes, the
      * warm-start data is initialized and needs to be updated. This
@@ -143,6 +167,15 @@ namespace Minotaur {
     void write(std::ostream &out) const;
 
   private:
+    /// Positions of the values that differ from those of ref_.
+    UIntVector diffInds_;
+
+    /// Values at diffInds_.
+    DoubleVector diffVals_;
+
+    /// The warm start that the difference is from. NULL if not used.
+    IpoptWarmStartPtr ref_;
+
     /// The starting solution that is used to warm-start.
     IpoptSolPtr sol_;
   };
@@ -122,9 +122,45 @@ namespace Ipopt {
     /// function and derivative evaluations
     bool evalWithinBnds_;
 
+    /// Constraint activities at the current point.
+    Minotaur::DoubleVector g_;
+
+    /// Error returned while evaluating g_.
+    int gErr_;
+
+    /// True if g_ has been evaluated at the current point.
+    bool gOk_;
+
+    /// Gradient of the objective at the current point.
+    Minotaur::DoubleVector grad_;
+
+    /// Error returned while evaluating grad_.
+    int gradErr_;
+
+    /// True if grad_ has been evaluated at the current point.
+    bool gradOk_;
+
+    /// Values of the Jacobian at the current point.
+    Minotaur::DoubleVector jac_;
+
+    /// Error returned while evaluating jac_.
+    int jacErr_;
+
+    /// True if jac_ has been evaluated at the current point.
+    bool jacOk_;
+
     /// Where to put logs.
     Minotaur::LoggerPtr logger_;
 
+    /// Error returned while evaluating objVal_.
+    int objErr_;
+
+    /// True if objVal_ has been evaluated at the current point.
+    bool objOk_;
+
+    /// Objective value at the current point.
+    double objVal_;
+
     /// Problem that is being solved.
     Minotaur::ProblemPtr problem_;
 
@@ -136,6 +172,30 @@ namespace Ipopt {
      */
     Minotaur::IpoptSolPtr sol_;
 
+    /// The current point pulled within bounds, if evalWithinBnds_ is true.
+    Minotaur::DoubleVector xx_;
+
+    /// True if xx_ has been computed from the current point.
+    bool xxOk_;
+
+    /**
+     * \brief Return the point at which functions and derivatives are
+     * evaluated.
+     *
+     * Ipopt passes new_x=false when x is the same as in the previous call.
+     * Values computed at the previous point are discarded only when new_x
+     * is true, so that the objective, constraints, and their derivatives
+     * are evaluated only once at each iterate.
+     * \param[in] x array of coordinates of the current point.
+     * \param[in] n size of x.
+     * \param[in] new_x The flag passed by Ipopt.
+     * \return x, or xx_ if evalWithinBnds_ is true.
+     */
+    const double *getPoint_(const Number* x, Index n, bool new_x);
+
+    /// Discard all values computed at the current point.
+    void newPoint_();
+
     /**
      * If x violates the lower or upperbounds on the variables, then function
      * evaluation or derivatives may give error (e.g. (x1)^1.852). It may be
@@ -143,10 +203,10 @@ namespace Ipopt {
      * function does this. 
      * \param[in] x array of coordinates of the currect point.
      * \param[in] n size of x.
-     * \param[out] A new array of size n with values same as x if it is in
-     * bounds and bounds if any is violated.
+     * The result is saved in xx_: values same as x if it is in bounds and
+     * bounds if any is violated.
      */
-    double *pullXToBnds_(const Number* x, Index n);
+    void pullXToBnds_(const Number* x, Index n);
   };
 }
 #endif
@@ -23,6 +23,7 @@
 #endif
 #include "coin/CoinPackedMatrix.hpp"
 #include "coin/CoinWarmStart.hpp"
+#include "coin/CoinWarmStartBasis.hpp"
 #include "coin/CoinWarmStartDual.hpp"
 
 #undef F77_FUNC_
@@ -52,17 +53,36 @@ const std::string OsiLPEngine::me_ = "OsiLPEngine: ";
 // ----------------------------------------------------------------------- //
 // ----------------------------------------------------------------------- //
 
-OsiLPWarmStart::OsiLPWarmStart() : coinWs_(0), mustDelete_(true) {}
+OsiLPWarmStart::OsiLPWarmStart()
+    : coinWs_(0), diff_(0), diffBytes_(0), mustDelete_(true), ref_(0) {}
 
-OsiLPWarmStart::~OsiLPWarmStart() {
+OsiLPWarmStart::~OsiLPWarmStart() { dropInfo(); }
+
+size_t OsiLPWarmStart::basisBytes_(int nstruct, int nartif) {
+  // CoinWarmStartBasis packs 16 statuses of two bits each in an int.
+  return 4 * ((nstruct + 15) / 16 + (nartif + 15) / 16);
+}
+
+void OsiLPWarmStart::dropInfo() {
   if (coinWs_ && mustDelete_) {
     delete coinWs_;
-    coinWs_ = 0;
+  }
+  coinWs_ = 0;
+  if (diff_) {
+    delete diff_;
+    diff_ = 0;
+    diffBytes_ = 0;
+  }
+  if (ref_) {
+    if (0 == ref_->decrUseCnt()) {
+      delete ref_;
+    }
+    ref_ = 0;
   }
 }
 
 bool OsiLPWarmStart::hasInfo() {
-  if (coinWs_) {
+  if (coinWs_ || diff_) {
     return true;
   } else {
     return false;
@@ -71,13 +91,127 @@ bool OsiLPWarmStart::hasInfo() {
 
 CoinWarmStart *OsiLPWarmStart::getCoinWarmStart() const { return coinWs_; }
 
-void OsiLPWarmStart::setCoinWarmStart(CoinWarmStart *coin_ws,
-                                      bool must_delete) {
+size_t OsiLPWarmStart::getMemSize() const {
+  size_t bytes = sizeof(OsiLPWarmStart) + diffBytes_;
+  const CoinWarmStartBasis *basis;
+  const CoinWarmStartDual *dual;
+
   if (coinWs_ && mustDelete_) {
+    basis = dynamic_cast<const CoinWarmStartBasis *>(coinWs_);
+    dual = dynamic_cast<const CoinWarmStartDual *>(coinWs_);
+    if (basis) {
+      bytes += sizeof(CoinWarmStartBasis) +
+               basisBytes_(basis->getNumStructural(),
+                           basis->getNumArtificial());
+    } else if (dual) {
+      bytes += sizeof(CoinWarmStartDual) + dual->size() * sizeof(double);
+    }
+  }
+  return bytes;
+}
+
+bool OsiLPWarmStart::isDiff() const { return (0 != diff_); }
+
+bool OsiLPWarmStart::makeDiff(WarmStartPtr ref) {
+  OsiLPWarmStartPtr ref2 = dynamic_cast<OsiLPWarmStart *>(ref);
+  const CoinWarmStartBasis *basis;
+  const CoinWarmStartBasis *rbasis;
+  int nstruct, nartif;
+  size_t nchanged = 0;
+  size_t bytes;
+
+  if (!ref2 || ref2 == this || diff_ || !coinWs_ || !ref2->coinWs_) {
+    return false;
+  }
+  basis = dynamic_cast<const CoinWarmStartBasis *>(coinWs_);
+  rbasis = dynamic_cast<const CoinWarmStartBasis *>(ref2->coinWs_);
+  if (!basis || !rbasis) {
+    return false;
+  }
+  nstruct = basis->getNumStructural();
+  nartif = basis->getNumArtificial();
+  if (nstruct != rbasis->getNumStructural() ||
+      nartif != rbasis->getNumArtificial()) {
+    return false;
+  }
+  for (int i = 0; i < nstruct; ++i) {
+    if (basis->getStructStatus(i) != rbasis->getStructStatus(i)) {
+      ++nchanged;
+    }
+  }
+  for (int i = 0; i < nartif; ++i) {
+    if (basis->getArtifStatus(i) != rbasis->getArtifStatus(i)) {
+      ++nchanged;
+    }
+  }
+
+  // The difference keeps an index and a value, 8 bytes, for each changed
+  // word of 16 statuses. Each changed status is counted as a word, so this
+  // is an upper bound.
+  bytes = 8 * nchanged;
+  if (4 * bytes > basisBytes_(nstruct, nartif)) {
+    return false;
+  }
+  diff_ = basis->generateDiff(rbasis);
+  diffBytes_ = bytes;
+  ref_ = ref2;
+  ref_->incrUseCnt();
+  if (mustDelete_) {
     delete coinWs_;
-    coinWs_ = 0;
   }
+  coinWs_ = 0;
+  return true;
+}
+
+CoinWarmStart *OsiLPWarmStart::newCoinWarmStart() const {
+  CoinWarmStart *coin_ws = 0;
+
+  if (diff_) {
+    coin_ws = ref_->coinWs_->clone();
+    coin_ws->applyDiff(diff_);
+  } else if (coinWs_) {
+    coin_ws = coinWs_->clone();
+  }
+  return coin_ws;
+}
+
+WarmStartPtr OsiLPWarmStart::readNew(FILE *f) const {
+  int head[3];
+  size_t sbytes, abytes;
+  CoinWarmStart *coin_ws = 0;
+  OsiLPWarmStartPtr ws;
+
+  // see writeInfo() for the layout.
+  if (1 != fread(head, sizeof(head), 1, f)) {
+    return 0;
+  }
+  if (1 == head[0]) {
+    sbytes = basisBytes_(head[1], 0);
+    abytes = basisBytes_(0, head[2]);
+    std::vector<char> sstat(sbytes + 1), astat(abytes + 1);
+    if ((sbytes > 0 && 1 != fread(&sstat[0], sbytes, 1, f)) ||
+        (abytes > 0 && 1 != fread(&astat[0], abytes, 1, f))) {
+      return 0;
+    }
+    coin_ws = new CoinWarmStartBasis(head[1], head[2], &sstat[0], &astat[0]);
+  } else if (2 == head[0]) {
+    std::vector<double> dual(head[1] + 1);
+    if (head[1] > 0 &&
+        1 != fread(&dual[0], sizeof(double) * head[1], 1, f)) {
+      return 0;
+    }
+    coin_ws = new CoinWarmStartDual(head[1], &dual[0]);
+  }
+  ws = (OsiLPWarmStartPtr) new OsiLPWarmStart();
+  if (coin_ws) {
+    ws->setCoinWarmStart(coin_ws, true);
+  }
+  return ws;
+}
 
+void OsiLPWarmStart::setCoinWarmStart(CoinWarmStart *coin_ws,
+                                      bool must_delete) {
+  dropInfo();
   coinWs_ = coin_ws;
   mustDelete_ = must_delete;
 }
@@ -89,6 +223,47 @@ void OsiLPWarmStart::setDualWarmStart(int size, const double *dual) {
 
 void OsiLPWarmStart::write(std::ostream &) const { assert(!"implement me!"); }
 
+bool OsiLPWarmStart::writeInfo(FILE *f) const {
+  // a head of three ints: 0 for no information, 1 for a basis followed by
+  // the numbers of structurals and artificials, 2 for dual values followed
+  // by their number. The statuses or values come after the head.
+  CoinWarmStart *coin_ws = newCoinWarmStart();
+  const CoinWarmStartBasis *basis =
+      dynamic_cast<const CoinWarmStartBasis *>(coin_ws);
+  const CoinWarmStartDual *dual =
+      dynamic_cast<const CoinWarmStartDual *>(coin_ws);
+  int head[3] = {0, 0, 0};
+  size_t sbytes, abytes;
+  bool ok;
+
+  if (basis) {
+    head[0] = 1;
+    head[1] = basis->getNumStructural();
+    head[2] = basis->getNumArtificial();
+  } else if (dual) {
+    head[0] = 2;
+    head[1] = dual->size();
+  } else if (coin_ws) {
+    delete coin_ws;
+    return false;
+  }
+  ok = (1 == fwrite(head, sizeof(head), 1, f));
+  if (ok && basis) {
+    sbytes = basisBytes_(head[1], 0);
+    abytes = basisBytes_(0, head[2]);
+    ok = (0 == sbytes ||
+          1 == fwrite(basis->getStructuralStatus(), sbytes, 1, f)) &&
+         (0 == abytes ||
+          1 == fwrite(basis->getArtificialStatus(), abytes, 1, f));
+  } else if (ok && dual && head[1] > 0) {
+    ok = (1 == fwrite(dual->dual(), sizeof(double) * head[1], 1, f));
+  }
+  if (coin_ws) {
+    delete coin_ws;
+  }
+  return ok;
+}
+
 // ----------------------------------------------------------------------- //
 // ----------------------------------------------------------------------- //
 
@@ -497,8 +672,16 @@ void OsiLPEngine::load(ProblemPtr problem) {
 void OsiLPEngine::loadFromWarmStart(const WarmStartPtr ws) {
   ConstOsiLPWarmStartPtr ws2 = dynamic_cast<const OsiLPWarmStart *>(ws);
   assert(ws2);
-  CoinWarmStart *coin_ws = ws2->getCoinWarmStart();
-  osilp_->setWarmStart(coin_ws);
+  CoinWarmStart *coin_ws;
+  if (ws2->isDiff()) {
+    // rebuild the basis, osilp_ keeps a copy of it.
+    coin_ws = ws2->newCoinWarmStart();
+    osilp_->setWarmStart(coin_ws);
+    delete coin_ws;
+  } else {
+    coin_ws = ws2->getCoinWarmStart();
+    osilp_->setWarmStart(coin_ws);
+  }
 }
 
 void OsiLPEngine::loadDualWarmStart(int size, double *dualVec) {
@@ -17,6 +17,7 @@
 #include "WarmStart.h"
 
 class CoinWarmStart;
+class CoinWarmStartDiff;
 class OsiSolverInterface;
 
 namespace Minotaur {
@@ -62,12 +63,37 @@ class OsiLPWarmStart : public WarmStart {
   /// Destroy.
   ~OsiLPWarmStart();
 
-  /// Get the warm-start description.
+  // Implement WarmStart::dropInfo().
+  void dropInfo();
+
+  /// Get the warm-start description. NULL if isDiff() is true.
   CoinWarmStart *getCoinWarmStart() const;
 
+  // Implement WarmStart::getMemSize().
+  size_t getMemSize() const;
+
   // Implement Engine::hasInfo().
   bool hasInfo();
 
+  /// Return true if only the difference from a reference basis is stored.
+  bool isDiff() const;
+
+  /**
+   * Store the difference of the basis from that of ref. It is done only if
+   * both are bases of the same size and at most a quarter of the memory of
+   * the basis is needed for the difference.
+   */
+  bool makeDiff(WarmStartPtr ref);
+
+  /**
+   * Return a new copy of the warm-start description. If isDiff() is true,
+   * the basis is rebuilt from the reference. The caller must free it.
+   */
+  CoinWarmStart *newCoinWarmStart() const;
+
+  // Implement WarmStart::readNew().
+  WarmStartPtr readNew(FILE *f) const;
+
   /**
    * Save the given coin-warm start. If must_delete is true, it is our
    * responsibility to free it.
@@ -82,6 +108,12 @@ class OsiLPWarmStart : public WarmStart {
   // Implement Engine::write().
   void write(std::ostream &out) const;
 
+  /**
+   * Implement WarmStart::writeInfo(). A basis or dual values are written,
+   * other kinds of COIN warm starts are not.
+   */
+  bool writeInfo(FILE *f) const;
+
  private:
   /**
    * COIN provides the warm start basis. For now, we don't need our own
@@ -89,11 +121,23 @@ class OsiLPWarmStart : public WarmStart {
    */
   CoinWarmStart *coinWs_;
 
+  /// Difference of the basis from the basis of ref_. NULL if not used.
+  CoinWarmStartDiff *diff_;
+
+  /// Approximate number of bytes used by diff_.
+  size_t diffBytes_;
+
   /**
    * If true, we must delete the warm-start description. If it is false,
    * we should never delete it.
    */
   bool mustDelete_;
+
+  /// The warm start whose basis diff_ is applied to. NULL if not used.
+  OsiLPWarmStart *ref_;
+
+  /// Number of bytes in a basis of the given size.
+  static size_t basisBytes_(int nstruct, int nartif);
 };
 typedef OsiLPWarmStart *OsiLPWarmStartPtr;
 typedef const OsiLPWarmStart *ConstOsiLPWarmStartPtr;
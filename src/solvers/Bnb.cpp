@@ -194,6 +194,15 @@ BrancherPtr Bnb::getBrancher_(HandlerVector handlers, EnginePtr e)
     if (e->getName()=="Filter-SQP") {
       rel_br->setIterLim(5);
     }
+    // Filter-SQP and bqpd are thread-safe only if their common blocks are
+    // threadprivate.
+#if !defined(MINOTAUR_BQPD_THREADPRIVATE)
+    if (e->getName()!="Filter-SQP" && e->getName()!="Bqpd")
+#endif
+    {
+      rel_br->setNumThreads(env_->getOptions()->findInt("strbr_threads")
+                            ->getValue());
+    }
     env_->getLogger()->msgStream(LogExtraInfo) << me_ <<
       "reliability branching iteration limit = " <<
       rel_br->getIterLim() << std::endl;
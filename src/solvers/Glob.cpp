@@ -12,17 +12,25 @@
 
 #include "Glob.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
+#if USE_OPENMP
+#include <omp.h>
+#endif
 
 #include "AMPLInterface.h"
 #include "BranchAndBound.h"
+#include "Constraint.h"
 #include "Engine.h"
 #include "EngineFactory.h"
 #include "Environment.h"
+#include "FbbtHandler.h"
+#include "Function.h"
 #include "LPEngine.h"
 #include "LexicoBrancher.h"
+#include "LinearFunction.h"
 #include "LinearHandler.h"
 #include "Logger.h"
 #include "MaxVioBrancher.h"
@@ -34,11 +42,15 @@
 #include "Objective.h"
 #include "Option.h"
 #include "PCBProcessor.h"
+#include "ParBranchAndBound.h"
+#include "ParNodeIncRelaxer.h"
+#include "ParPCBProcessor.h"
 #include "Presolver.h"
 #include "Problem.h"
 #include "ProblemSize.h"
 #include "QG.h"
 #include "QuadHandler.h"
+#include "QuadraticFunction.h"
 #include "QuadTransformer.h"
 #include "Relaxation.h"
 #include "ReliabilityBrancher.h"
@@ -50,9 +62,58 @@
 #include "Timer.h"
 #include "Transformer.h"
 #include "TreeManager.h"
+#include "Variable.h"
 #include "WeakBrancher.h"
 
 using namespace Minotaur;
+
+/// Check if two functions have the same linear and quadratic terms, with
+/// variables of the same indices.
+static bool sameTerms(FunctionPtr f1, FunctionPtr f2)
+{
+  LinearFunctionPtr l1 = f1 ? f1->getLinearFunction() : 0;
+  LinearFunctionPtr l2 = f2 ? f2->getLinearFunction() : 0;
+  QuadraticFunctionPtr q1 = f1 ? f1->getQuadraticFunction() : 0;
+  QuadraticFunctionPtr q2 = f2 ? f2->getQuadraticFunction() : 0;
+  std::vector<std::pair<std::pair<UInt, UInt>, double> > t1, t2;
+
+  if((f1 ? f1->getType() : Constant) != (f2 ? f2->getType() : Constant) ||
+      (l1 ? l1->getNumTerms() : 0) != (l2 ? l2->getNumTerms() : 0) ||
+      (q1 ? q1->getNumTerms() : 0) != (q2 ? q2->getNumTerms() : 0)) {
+    return false;
+  }
+  // the variables of the two problems are different objects, so the terms
+  // are compared by the indices of their variables.
+  if(l1) {
+    for(VariableGroupConstIterator it = l1->termsBegin();
+         it != l1->termsEnd(); ++it) {
+      t1.push_back(std::make_pair(std::make_pair(it->first->getIndex(), 0),
+                                  it->second));
+    }
+    for(VariableGroupConstIterator it = l2->termsBegin();
+         it != l2->termsEnd(); ++it) {
+      t2.push_back(std::make_pair(std::make_pair(it->first->getIndex(), 0),
+                                  it->second));
+    }
+  }
+  if(q1) {
+    for(VariablePairGroupConstIterator it = q1->begin(); it != q1->end();
+         ++it) {
+      t1.push_back(std::make_pair(std::make_pair(it->first.first->getIndex()+1,
+                                  it->first.second->getIndex()+1),
+                                  it->second));
+    }
+    for(VariablePairGroupConstIterator it = q2->begin(); it != q2->end();
+         ++it) {
+      t2.push_back(std::make_pair(std::make_pair(it->first.first->getIndex()+1,
+                                  it->first.second->getIndex()+1),
+                                  it->second));
+    }
+  }
+  std::sort(t1.begin(), t1.end());
+  std::sort(t2.begin(), t2.end());
+  return (t1 == t2);
+}
 const std::string Glob::me_ = "mntr-glob: ";
 
 Glob::Glob(EnvPtr env)
@@ -135,6 +196,29 @@ BranchAndBound* Glob::createBab_(EnginePtr e, HandlerVector& handlers)
   BranchAndBound* bab = new BranchAndBound(env_, newp_);
   PCBProcessorPtr nproc;
   NodeIncRelaxerPtr nr;
+  HeurVector heurs;
+
+  nproc = (PCBProcessorPtr) new PCBProcessor(env_, e, handlers);
+  nproc->setBrancher(getBrancher_(handlers, e, newp_));
+  bab->setNodeProcessor(nproc);
+
+  nr = (NodeIncRelaxerPtr) new NodeIncRelaxer(env_, handlers);
+  nr->setProblem(newp_);
+  nr->setEngine(e);
+  bab->setNodeRelaxer(nr);
+  bab->shouldCreateRoot(true);
+
+  getPreRootHeurs_(heurs);
+  for(HeurVector::iterator it = heurs.begin(); it != heurs.end(); ++it) {
+    bab->addPreRootHeur(*it);
+  }
+
+  return bab;
+}
+
+BrancherPtr Glob::getBrancher_(HandlerVector& handlers, EnginePtr e,
+                               ProblemPtr p)
+{
   BrancherPtr br = 0;
   std::string brancher = env_->getOptions()->findString("brancher")->getValue();
 
@@ -143,17 +227,19 @@ BranchAndBound* Glob::createBab_(EnginePtr e, HandlerVector& handlers)
     ReliabilityBrancherPtr rel_br;
     rel_br = (ReliabilityBrancherPtr) new ReliabilityBrancher(env_, handlers);
     rel_br->setEngine(e);
-    t = (newp_->getSize()->ints + newp_->getSize()->bins) / 10;
+    t = (p->getSize()->ints + p->getSize()->bins) / 10;
     t = std::max(t, (UInt)2);
     t = std::min(t, (UInt)4);
     rel_br->setThresh(t);
     env_->getLogger()->msgStream(LogExtraInfo)
         << me_ << "setting reliability threshhold to " << t << std::endl;
-    t = (UInt)newp_->getSize()->ints + newp_->getSize()->bins / 20 + 2;
+    t = (UInt)p->getSize()->ints + p->getSize()->bins / 20 + 2;
     t = std::min(t, (UInt)10);
     rel_br->setMaxDepth(t);
     env_->getLogger()->msgStream(LogExtraInfo)
         << me_ << "setting reliability maxdepth to " << t << std::endl;
+    rel_br->setNumThreads(
+        env_->getOptions()->findInt("strbr_threads")->getValue());
     env_->getLogger()->msgStream(LogExtraInfo)
         << me_
         << "reliability branching iteration limit = " << rel_br->getIterLim()
@@ -173,32 +259,27 @@ BranchAndBound* Glob::createBab_(EnginePtr e, HandlerVector& handlers)
     str_br->setEngine(e);
     if(brancher == "stronger") {
       str_br->doStronger();
-      str_br->setProblem(newp_);
+      str_br->setProblem(p);
     } else if(brancher == "relstronger") {
       str_br->reliabilitySetup(20, 50, 5);
-      str_br->setProblem(newp_);
+      str_br->setProblem(p);
     }
     br = str_br;
   } else if(brancher == "weak") {
     WeakBrancherPtr wbr = (WeakBrancherPtr) new WeakBrancher(env_, handlers);
-    wbr->setProblem(newp_);
+    wbr->setProblem(p);
     br = wbr;
   }
   env_->getLogger()->msgStream(LogExtraInfo)
       << me_ << "brancher used = " << br->getName() << std::endl;
-  nproc = (PCBProcessorPtr) new PCBProcessor(env_, e, handlers);
-  nproc->setBrancher(br);
-  bab->setNodeProcessor(nproc);
-
-  nr = (NodeIncRelaxerPtr) new NodeIncRelaxer(env_, handlers);
-  nr->setProblem(newp_);
-  nr->setEngine(e);
-  bab->setNodeRelaxer(nr);
-  bab->shouldCreateRoot(true);
+  return br;
+}
 
+void Glob::getPreRootHeurs_(HeurVector& heurs)
+{
   if(env_->getOptions()->findBool("samplingheur")->getValue() == true) {
     SamplingHeurPtr s_heur = (SamplingHeurPtr) new SamplingHeur(env_, newp_);
-    bab->addPreRootHeur(s_heur);
+    heurs.push_back(s_heur);
   }
 
   if(env_->getOptions()->findBool("msheur")->getValue() == true &&
@@ -206,10 +287,8 @@ BranchAndBound* Glob::createBab_(EnginePtr e, HandlerVector& handlers)
     EnginePtr nlp_e = getNLPEngine_();
     newp_->setNativeDer();
     NLPMSPtr ms_heur = (NLPMSPtr) new NLPMultiStart(env_, newp_, nlp_e);
-    bab->addPreRootHeur(ms_heur);
+    heurs.push_back(ms_heur);
   }
-
-  return bab;
 }
 
 PresolverPtr Glob::createPres_(HandlerVector& handlers)
@@ -267,6 +346,68 @@ PresolverPtr Glob::createPres_(HandlerVector& handlers)
   return pres;
 }
 
+int Glob::copyProblem_(ProblemPtr& p, HandlerVector& handlers)
+{
+  QuadTranPtr trans = (QuadTranPtr) new QuadTransformer(env_, inst_);
+  PresolverPtr pres;
+  int err = 0;
+
+  p = 0;
+  handlers.clear();
+  trans->reformulate(p, handlers, err);
+  delete trans;
+
+  if(0 == err) {
+    pres = (PresolverPtr) new Presolver(p, env_, handlers);
+    pres->solve();
+    delete pres;
+    if(p->getNumVars() != newp_->getNumVars() ||
+       p->getNumCons() != newp_->getNumCons()) {
+      err = 1;
+    }
+  }
+  for(UInt j = 0; 0 == err && j < p->getNumVars(); ++j) {
+    if(p->getVariable(j)->getLb() != newp_->getVariable(j)->getLb() ||
+       p->getVariable(j)->getUb() != newp_->getVariable(j)->getUb() ||
+       p->getVariable(j)->getType() != newp_->getVariable(j)->getType()) {
+      err = 1;
+    }
+  }
+  for(UInt j = 0; 0 == err && j < p->getNumCons(); ++j) {
+    ConstraintPtr c1 = p->getConstraint(j);
+    ConstraintPtr c2 = newp_->getConstraint(j);
+    if(c1->getLb() != c2->getLb() || c1->getUb() != c2->getUb() ||
+       !sameTerms(c1->getFunction(), c2->getFunction())) {
+      err = 1;
+    }
+  }
+  if(0 == err && (!p->getObjective() != !newp_->getObjective() ||
+     (p->getObjective() &&
+      !sameTerms(p->getObjective()->getFunction(),
+                 newp_->getObjective()->getFunction())))) {
+    err = 1;
+  }
+
+  if(0 == err && env_->getOptions()->findBool("nl_fbbt")->getValue()) {
+    FbbtHandlerPtr fbbt_hand = (FbbtHandlerPtr) new FbbtHandler(env_, p);
+    fbbt_hand->setModFlags(false, true);
+    handlers.push_back(fbbt_hand);
+  }
+
+  if(0 != err) {
+    for(HandlerVector::iterator it = handlers.begin(); it != handlers.end();
+        ++it) {
+      delete(*it);
+    }
+    handlers.clear();
+    if(p) {
+      delete p;
+      p = 0;
+    }
+  }
+  return err;
+}
+
 void Glob::fwd2QG_()
 {
   QG qg(env_);
@@ -290,6 +431,117 @@ SolveStatus Glob::getStatus()
   return status_;
 }
 
+UInt Glob::getNumThreads_()
+{
+  UInt nt = 1;
+#if USE_OPENMP
+  int t = env_->getOptions()->findInt("threads")->getValue();
+
+  if(t > 1) {
+    nt = std::min(t, omp_get_max_threads());
+  }
+  if(nt > 1 &&
+     env_->getOptions()->findString("transformer")->getValue() == "simp") {
+    env_->getLogger()->msgStream(LogInfo)
+        << me_ << "parallel branch-and-bound needs the quad transformer, "
+        << "using one thread" << std::endl;
+    nt = 1;
+  }
+#endif
+  return nt;
+}
+
+void Glob::parSolve_(UInt nt, LPEnginePtr engine, HandlerVector& handlers,
+                     VarVector* orig_v, PresolverPtr pres)
+{
+  ProblemPtr* pcopy = new ProblemPtr[nt];
+  HandlerVector* hcopy = new HandlerVector[nt];
+  LPEnginePtr* lpe = new LPEnginePtr[nt];
+  ParPCBProcessorPtr* nproc = new ParPCBProcessorPtr[nt];
+  ParNodeIncRelaxerPtr* nr = new ParNodeIncRelaxerPtr[nt];
+  ParBranchAndBound* parbab = 0;
+  HeurVector heurs;
+  RelaxationPtr rel;
+  bool prune = false;
+  UInt n = nt;
+
+  pcopy[0] = newp_;
+  hcopy[0] = handlers;
+  lpe[0] = engine;
+  for(UInt i = 1; i < nt; ++i) {
+    if(0 != copyProblem_(pcopy[i], hcopy[i])) {
+      env_->getLogger()->msgStream(LogInfo)
+          << me_ << "copy of the transformed problem differs, using " << i
+          << " threads" << std::endl;
+      n = i;
+      break;
+    }
+    lpe[i] = getEngine_();
+  }
+  nt = n;
+
+  // all relaxations are created alike, so that the modifications stored in
+  // the nodes can be copied by index from one thread to another.
+  for(UInt i = 0; i < nt; ++i) {
+    nproc[i] = (ParPCBProcessorPtr) new ParPCBProcessor(env_, lpe[i],
+                                                        hcopy[i]);
+    nproc[i]->setBrancher(getBrancher_(hcopy[i], lpe[i], pcopy[i]));
+    nr[i] = (ParNodeIncRelaxerPtr) new ParNodeIncRelaxer(env_, hcopy[i]);
+    nr[i]->setModFlag(true);
+    nr[i]->setProblem(pcopy[i]);
+    rel = nr[i]->createRootRelaxation(NodePtr(), prune);
+    rel->setProblem(pcopy[i]);
+    nr[i]->setEngine(lpe[i]);
+  }
+
+  parbab = new ParBranchAndBound(env_, newp_);
+  parbab->shouldCreateRoot(false);
+  getPreRootHeurs_(heurs);
+  for(HeurVector::iterator it = heurs.begin(); it != heurs.end(); ++it) {
+    parbab->addPreRootHeur(*it);
+  }
+
+  if(true == env_->getOptions()->findBool("solve")->getValue()) {
+    parbab->parsolveOppor(nr, nproc, nt);
+    parbab->writeStats(env_->getLogger()->msgStream(LogExtraInfo));
+    parbab->writeParStats(env_->getLogger()->msgStream(LogExtraInfo), nproc);
+    for(UInt i = 0; i < nt; ++i) {
+      lpe[i]->writeStats(env_->getLogger()->msgStream(LogExtraInfo));
+      for(HandlerVector::iterator it = hcopy[i].begin(); it != hcopy[i].end();
+          ++it) {
+        (*it)->writeStats(env_->getLogger()->msgStream(LogExtraInfo));
+      }
+    }
+    writeSol_(env_, orig_v, pres, parbab->getSolution(), parbab->getStatus(),
+              iface_);
+    writeStatus_(parbab->getStatus(), parbab->getUb(), parbab->getLb(),
+                 parbab->getPerGap());
+  }
+
+  // the handlers, engine and problem of thread 0 are deleted by solve().
+  for(UInt i = 0; i < nt; ++i) {
+    delete nr[i];
+    delete nproc[i];
+    if(i > 0) {
+      for(HandlerVector::iterator it = hcopy[i].begin(); it != hcopy[i].end();
+          ++it) {
+        delete(*it);
+      }
+      delete lpe[i];
+      delete pcopy[i];
+    }
+  }
+  for(HeurVector::iterator it = heurs.begin(); it != heurs.end(); ++it) {
+    delete(*it);
+  }
+  delete parbab;
+  delete[] nr;
+  delete[] nproc;
+  delete[] lpe;
+  delete[] hcopy;
+  delete[] pcopy;
+}
+
 void Glob::setInitialOptions_()
 {
   OptionDBPtr options = env_->getOptions();
@@ -314,6 +566,7 @@ int Glob::solve(ProblemPtr inst)
   ProblemPtr newp = 0;
   BranchAndBound* bab = 0;
   OptionDBPtr options = env_->getOptions();
+  UInt nt = 1;
 
   env_->initRand();
 
@@ -404,6 +657,18 @@ int Glob::solve(ProblemPtr inst)
   env_->getLogger()->msgStream(LogExtraInfo)
       << me_ << "Finished presolving transformed problem" << std::endl;
 
+  if(options->findBool("nl_fbbt")->getValue() == true) {
+    FbbtHandlerPtr fbbt_hand = (FbbtHandlerPtr) new FbbtHandler(env_, newp_);
+    fbbt_hand->setModFlags(false, true);
+    handlers.push_back(fbbt_hand);
+  }
+
+  nt = getNumThreads_();
+  if(nt > 1) {
+    parSolve_(nt, engine, handlers, orig_v, pres);
+    goto CLEANUP;
+  }
+
   // get branch-and-bound
   bab = createBab_(engine, handlers);
 
@@ -513,23 +778,8 @@ void Glob::writeStatus_(BranchAndBound* bab)
   int err = 0;
 
   if(bab) {
-    status_ = bab->getStatus();
-    env_->getLogger()->msgStream(LogInfo)
-        << me_ << std::fixed << std::setprecision(4)
-        << "best solution value = " << objSense_ * bab->getUb() << std::endl
-        << me_ << std::fixed << std::setprecision(4)
-        << "best bound estimate from remaining nodes = "
-        << objSense_ * bab->getLb() << std::endl
-        << me_ << "gap = " << std::max(0.0, bab->getUb() - bab->getLb())
-        << std::endl
-        << me_ << "gap percentage = " << bab->getPerGap() << std::endl
-        << me_ << "time used = " << std::fixed << std::setprecision(2)
-        << env_->getTime(err) << std::endl
-        << me_
-        << "status of branch-and-bound: " << getSolveStatusString(status_)
-        << std::endl;
-    env_->stopTimer(err);
-    assert(0 == err);
+    writeStatus_(bab->getStatus(), bab->getUb(), bab->getLb(),
+                 bab->getPerGap());
   } else {
     env_->getLogger()->msgStream(LogInfo)
         << me_ << std::fixed << std::setprecision(4)
@@ -549,6 +799,29 @@ void Glob::writeStatus_(BranchAndBound* bab)
   }
 }
 
+void Glob::writeStatus_(SolveStatus status, double ub, double lb,
+                        double per_gap)
+{
+  int err = 0;
+
+  status_ = status;
+  env_->getLogger()->msgStream(LogInfo)
+      << me_ << std::fixed << std::setprecision(4)
+      << "best solution value = " << objSense_ * ub << std::endl
+      << me_ << std::fixed << std::setprecision(4)
+      << "best bound estimate from remaining nodes = " << objSense_ * lb
+      << std::endl
+      << me_ << "gap = " << std::max(0.0, ub - lb) << std::endl
+      << me_ << "gap percentage = " << per_gap << std::endl
+      << me_ << "time used = " << std::fixed << std::setprecision(2)
+      << env_->getTime(err) << std::endl
+      << me_
+      << "status of branch-and-bound: " << getSolveStatusString(status_)
+      << std::endl;
+  env_->stopTimer(err);
+  assert(0 == err);
+}
+
 // ProblemPtr Glob::loadProblem()
 //{
 //  OptionDBPtr options = env_->getOptions();
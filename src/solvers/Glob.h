@@ -70,12 +70,43 @@ private:
   BranchAndBound* createBab_(EnginePtr e, HandlerVector& handlers);
   PresolverPtr createPres_(HandlerVector& handlers);
   void fwd2QG_();
-  BrancherPtr getBrancher_(HandlerVector handlers, Engine* e);
+  BrancherPtr getBrancher_(HandlerVector& handlers, EnginePtr e, ProblemPtr p);
   LPEnginePtr getEngine_();
   NLPEnginePtr getNLPEngine_();
+  void getPreRootHeurs_(HeurVector& heurs);
   void setInitialOptions_();
   int transform_(ProblemPtr& newp, HandlerVector& handlers, LPEnginePtr engine);
   void writeStatus_(BranchAndBound* bab);
+  void writeStatus_(SolveStatus status, double ub, double lb, double per_gap);
+
+  /**
+   * Number of threads for branch-and-bound: the option threads, at most the
+   * number of OpenMP threads. One if the transformer is not quad.
+   */
+  UInt getNumThreads_();
+
+  /**
+   * \brief Make another copy of the transformed problem newp_ and its
+   * handlers, for one thread of the parallel branch-and-bound.
+   *
+   * The instance is transformed and presolved again, which must give a
+   * problem with the same variables, constraints and bounds as newp_. Node
+   * modifications are copied between the threads by index.
+   *
+   * \return 0 if the copy is the same as newp_. Nothing is created
+   * otherwise.
+   */
+  int copyProblem_(ProblemPtr& p, HandlerVector& handlers);
+
+  /**
+   * \brief Solve newp_ by branch-and-bound with nt threads. Each thread
+   * has its own copy of the problem, the handlers, the relaxation and the
+   * LP engine. The incumbents are shared through the solution pool of
+   * ParBranchAndBound, and the bounds tightened by OBBT at the root are
+   * modifications of the root node, which every thread applies.
+   */
+  void parSolve_(UInt nt, LPEnginePtr engine, HandlerVector& handlers,
+                 VarVector* orig_v, PresolverPtr pres);
 };
 } // namespace Minotaur
 #endif
@@ -22,6 +22,7 @@
 #include "AMPLJacobian.h"
 #include "EngineFactory.h"
 #include "Environment.h"
+#include "FbbtHandler.h"
 #include "Handler.h"
 #include "IntVarHandler.h"
 #include "LPEngine.h"
@@ -30,6 +31,7 @@
 #include "Logger.h"
 #include "MaxVioBrancher.h"
 #include "MinotaurConfig.h"
+#include "NLPCache.h"
 #include "NLPEngine.h"
 #include "NlPresHandler.h"
 #include "NodeIncRelaxer.h"
@@ -233,6 +235,7 @@ int QG::solve(ProblemPtr p)
   Timer* timer = env_->getNewTimer();
   EnginePtr nlp_e = 0;
   LPEnginePtr lp_e = 0; // lp engine
+  NLPCachePtr nlp_cache = 0;
   VarVector* orig_v = 0;
   BranchAndBound* bab = 0;
   PresolverPtr pres = 0;
@@ -339,10 +342,23 @@ int QG::solve(ProblemPtr p)
 
   qg_hand = (QGHandlerPtr) new QGHandler(env_, oinst_, nlp_e);
   qg_hand->setModFlags(false, true);
+  if (options->findInt("nlp_cache_size")->getValue() > 0 &&
+      options->findDouble("nlp_cache_mb")->getValue() > 0) {
+    nlp_cache = (NLPCachePtr) new NLPCache(
+        options->findInt("nlp_cache_size")->getValue(),
+        (size_t) (options->findDouble("nlp_cache_mb")->getValue()*1048576));
+    qg_hand->setNLPCache(nlp_cache);
+  }
 
   handlers.push_back(qg_hand);
   assert(qg_hand);
 
+  if(options->findBool("nl_fbbt")->getValue() == true) {
+    FbbtHandlerPtr fbbt_hand = (FbbtHandlerPtr) new FbbtHandler(env_, oinst_);
+    fbbt_hand->setModFlags(false, true);
+    handlers.push_back(fbbt_hand);
+  }
+
   // report name
   env_->getLogger()->msgStream(LogExtraInfo)
       << me_ << "handlers used:" << std::endl;
@@ -417,6 +433,9 @@ int QG::solve(ProblemPtr p)
       ++it) {
     (*it)->writeStats(env_->getLogger()->msgStream(LogExtraInfo));
   }
+  if(nlp_cache) {
+    nlp_cache->writeStats(env_->getLogger()->msgStream(LogExtraInfo));
+  }
 
 
   err = writeSol_(env_, orig_v, pres, sol_, status_, iface_);
@@ -436,6 +455,9 @@ CLEANUP:
   if(nlp_e) {
     delete nlp_e;
   }
+  if(nlp_cache) {
+    delete nlp_cache;
+  }
   if(iface_ && ownIface_) {
     delete iface_;
     iface_ = 0;
@@ -33,6 +33,7 @@
 #include "MaxFreqBrancher.h"
 #include "MaxVioBrancher.h"
 #include "ParMINLPDiving.h"
+#include "NLPCache.h"
 #include "NLPEngine.h"
 #include "NlPresHandler.h"
 #include "Node.h"
@@ -71,7 +72,7 @@ ParQGBranchAndBound* createParBab(EnvPtr env, UInt numThreads, NodePtr &node,
                                   ParNodeIncRelaxerPtr parNodeRlxr[],
                                   HandlerVector handlersCopy[],
                                   LPEnginePtr lpeCopy[], EnginePtr eCopy[],
-                                  bool &prune)
+                                  NLPCachePtr nlpCache, bool &prune)
 {
   ParQGBranchAndBound *bab = new ParQGBranchAndBound(env, pCopy[0]);
   const std::string me("qgpar main: ");
@@ -92,6 +93,7 @@ ParQGBranchAndBound* createParBab(EnvPtr env, UInt numThreads, NodePtr &node,
 
     ParQGHandlerAdvancePtr qg_hand = (ParQGHandlerAdvancePtr) new ParQGHandlerAdvance(env, pCopy[i], eCopy[i]);
     qg_hand->setModFlags(false, true);
+    qg_hand->setNLPCache(nlpCache);
     qg_hand->loadProbToEngine();
     if (i>0) {
       qg_hand->nlCons();
@@ -625,6 +627,7 @@ int main(int argc, char** argv)
   EngineFactory *efac = 0;
   LPEnginePtr *lpeCopy = 0;
   EnginePtr *eCopy = 0;
+  NLPCachePtr nlpCache = 0;
   ObjectivePtr oPtr = 0;
   NodePtr node = 0;
   std::string name = "";
@@ -725,8 +728,17 @@ int main(int argc, char** argv)
     env->getLogger()->msgStream(LogInfo)
       << "Number of threads = " << numThreads << std::endl;
   }
+  // one cache is shared by the QG handlers of all threads.
+  if (env->getOptions()->findInt("nlp_cache_size")->getValue() > 0 &&
+      env->getOptions()->findDouble("nlp_cache_mb")->getValue() > 0) {
+    nlpCache = (NLPCachePtr) new NLPCache(
+        env->getOptions()->findInt("nlp_cache_size")->getValue(),
+        (size_t) (env->getOptions()->findDouble("nlp_cache_mb")->getValue()
+                  *1048576));
+  }
   parbab = createParBab(env, numThreads, node, relCopy, pCopy, nodePrcssr,
-                        parNodeRlxr, handlersCopy, lpeCopy, eCopy, prune);
+                        parNodeRlxr, handlersCopy, lpeCopy, eCopy, nlpCache,
+                        prune);
   //if (true==env->getOptions()->findBool("mcbnb_oppor_mode")->getValue()) {
     parbab->parsolveOppor(parNodeRlxr, nodePrcssr, numThreads, prune);
   //} else {
@@ -755,6 +767,9 @@ int main(int argc, char** argv)
 
   writeSol(env, orig_v, pres, parbab->getSolution(), parbab->getStatus(), iface);
   writeParQGStats(env, parbab, numThreads, handlersCopy);
+  if (nlpCache) {
+    nlpCache->writeStats(env->getLogger()->msgStream(LogExtraInfo));
+  }
   writeParBnbStatus(env, parbab, obj_sense, wallTimeStart, clockTimeStart);
 
 CLEANUP:
@@ -764,6 +779,9 @@ CLEANUP:
   if (efac) {
     delete efac;
   }
+  if (nlpCache) {
+    delete nlpCache;
+  }
   if (iface) {
     delete iface;
   }
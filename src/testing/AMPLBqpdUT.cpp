@@ -10,8 +10,12 @@
 #include "AMPLHessian.h"
 #include "BranchAndBound.h"
 #include "BqpdEngine.h"
+#include "Constraint.h"
 #include "Environment.h"
+#include "Function.h"
+#include "LinearFunction.h"
 #include "Option.h"
+#include "Solution.h"
 
 CPPUNIT_TEST_SUITE_REGISTRATION(AMPLBqpdUT);
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(AMPLBqpdUT, "AMPLBqpdUT");
@@ -69,6 +73,73 @@ void AMPLBqpdUT::testNLP()
   delete env;
 }
 
+
+// hs021: min 0.01x0^2 + x1^2 - 100, s.t. 10x0 - x1 >= 10, x0 in [2, 50],
+// x1 in [-50, 50]. Add and delete linear cuts between solves.
+void AMPLBqpdUT::testCuts()
+{
+  Minotaur::EnvPtr env = (Minotaur::EnvPtr) new Minotaur::Environment();
+  Minotaur::LinearFunctionPtr lf;
+  Minotaur::ConstraintPtr c1;
+  Minotaur::ConstSolutionPtr sol, sol2;
+  env->setLogLevel(Minotaur::LogNone);
+  iface_ = (AMPLInterfacePtr) new AMPLInterface(env);
+
+  Minotaur::ProblemPtr inst = iface_->readInstance("instances/hs021");
+  inst->setInitialPoint(iface_->getInitialPoint());
+  inst->calculateSize();
+  inst->setNativeDer();
+
+  Minotaur::BqpdEnginePtr bqpd_e = (Minotaur::BqpdEnginePtr) 
+    new Minotaur::BqpdEngine(env);
+  bqpd_e->load(inst);
+  bqpd_e->solve();
+  CPPUNIT_ASSERT(bqpd_e->getStatus()==Minotaur::ProvenLocalOptimal);
+  sol = bqpd_e->getSolution();
+  CPPUNIT_ASSERT(fabs(sol->getObjValue()+99.96) < 1e-7);
+
+  // cut x1 >= 1.
+  lf = (Minotaur::LinearFunctionPtr) new Minotaur::LinearFunction();
+  lf->addTerm(inst->getVariable(1), 1.0);
+  c1 = inst->newConstraint((Minotaur::FunctionPtr) new Minotaur::Function(lf),
+                           1.0, INFINITY);
+  bqpd_e->solve();
+  CPPUNIT_ASSERT(bqpd_e->getStatus()==Minotaur::ProvenLocalOptimal);
+
+  // the solution of the last solve is still valid and updated.
+  sol2 = bqpd_e->getSolution();
+  CPPUNIT_ASSERT(sol2==sol);
+  CPPUNIT_ASSERT(fabs(sol->getObjValue()+98.96) < 1e-7);
+
+  // cut x0 >= 3.
+  lf = (Minotaur::LinearFunctionPtr) new Minotaur::LinearFunction();
+  lf->addTerm(inst->getVariable(0), 1.0);
+  inst->newConstraint((Minotaur::FunctionPtr) new Minotaur::Function(lf),
+                      3.0, INFINITY);
+  bqpd_e->solve();
+  CPPUNIT_ASSERT(bqpd_e->getStatus()==Minotaur::ProvenLocalOptimal);
+  CPPUNIT_ASSERT(fabs(sol->getObjValue()+98.91) < 1e-7);
+
+  // delete the first cut: x0 >= 3 moves from row 2 to row 1 and stays
+  // active.
+  inst->markDelete(c1);
+  inst->delMarkedCons();
+  CPPUNIT_ASSERT(inst->getNumCons()==2);
+  bqpd_e->solve();
+  CPPUNIT_ASSERT(bqpd_e->getStatus()==Minotaur::ProvenLocalOptimal);
+  CPPUNIT_ASSERT(bqpd_e->getSolution()==sol);
+  CPPUNIT_ASSERT(fabs(sol->getObjValue()+99.91) < 1e-7);
+  CPPUNIT_ASSERT(fabs(sol->getPrimal()[0]-3.0) < 1e-7);
+  CPPUNIT_ASSERT(fabs(sol->getPrimal()[1]) < 1e-7);
+  CPPUNIT_ASSERT(fabs(sol->getDualOfCons()[0]) < 1e-7);
+  CPPUNIT_ASSERT(fabs(fabs(sol->getDualOfCons()[1])-0.06) < 1e-7);
+
+  delete bqpd_e;
+  delete inst;
+  delete iface_;
+  delete env;
+}
+
 // Local Variables: 
 // mode: c++ 
 // eval: (c-set-style "k&r") 
@@ -27,11 +27,13 @@ public:
   AMPLBqpdUT() {}
 
   void testNLP();
+  void testCuts();
   void setUp() { }      // need not implement
   void tearDown() { }   // need not implement
 
   CPPUNIT_TEST_SUITE(AMPLBqpdUT);
   CPPUNIT_TEST(testNLP);
+  CPPUNIT_TEST(testCuts);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -4,12 +4,14 @@
 //     (C)opyright 2009 - 2024 The Minotaur Team.
 // 
 
+#include <algorithm>
 #include <cmath>
 
 #include "MinotaurConfig.h"
 #include "CGraphUT.h"
 #include "CGraph.h"
 #include "CNode.h"
+#include "HessianOfLag.h"
 #include "Problem.h"
 #include "Variable.h"
 
@@ -17,6 +19,361 @@ CPPUNIT_TEST_SUITE_REGISTRATION(CGraphUT);
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(CGraphUT, "CGraphUT");
 using namespace Minotaur;
 
+void CGraphUT::testCompile()
+{
+  CNode *n0, *n1, *n2, *n3;
+  CGraph cgraph;
+  CGraphWork work;
+  int error = 0;
+
+  VariablePtr v0 = new Variable(0, 0, 0.0, 10.0, Continuous, "x0");
+  VariablePtr v1 = new Variable(1, 1, 0.0, 10.0, Continuous, "x1");
+  VariablePtr v2 = new Variable(2, 2, 0.0, 10.0, Continuous, "x2");
+
+  double x[3] = {1.0, 2.0, 0.5};
+  double g1[3] = {0.0, 0.0, 0.0};
+  double g2[3] = {0.0, 0.0, 0.0};
+  double f1, f2;
+
+  // exp(x0*x1) + x2^3/x0 + log(x1 + 2)
+  n0 = cgraph.newNode(v0);
+  n1 = cgraph.newNode(v1);
+  n2 = cgraph.newNode(OpMult, n0, n1);
+  n2 = cgraph.newNode(OpExp, n2, 0);
+  n3 = cgraph.newNode(3.0);
+  n3 = cgraph.newNode(OpPowK, cgraph.newNode(v2), n3);
+  n3 = cgraph.newNode(OpDiv, n3, n0);
+  n2 = cgraph.newNode(OpPlus, n2, n3);
+  n3 = cgraph.newNode(OpPlus, n1, cgraph.newNode(2.0));
+  n3 = cgraph.newNode(OpLog, n3, 0);
+  n2 = cgraph.newNode(OpPlus, n2, n3);
+  cgraph.setOut(n2);
+  cgraph.finalize();
+
+  f1 = cgraph.eval(x, &error);
+  CPPUNIT_ASSERT(0==error);
+  cgraph.evalGradient(x, g1, &error);
+  CPPUNIT_ASSERT(0==error);
+
+  cgraph.compile();
+  CPPUNIT_ASSERT(true == cgraph.isCompiled());
+  f2 = cgraph.eval(x, &work, &error);
+  CPPUNIT_ASSERT(0==error);
+  CPPUNIT_ASSERT(fabs(f1-f2)<1e-12);
+  CPPUNIT_ASSERT(fabs(cgraph.eval(x, &error)-f1)<1e-12);
+  cgraph.evalGradient(x, g2, &work, &error);
+  CPPUNIT_ASSERT(0==error);
+  for (UInt i=0; i<3; ++i) {
+    CPPUNIT_ASSERT(fabs(g1[i]-g2[i])<1e-12);
+  }
+
+  // any change to the graph discards the tape.
+  cgraph.finalize();
+  CPPUNIT_ASSERT(false == cgraph.isCompiled());
+
+  delete v0;
+  delete v1;
+  delete v2;
+}
+
+
+void CGraphUT::testCompileDerivs()
+{
+  CNode *n0, *n1, *n2, *n3;
+  CGraph cgraph;
+  CGraphPtr cg2;
+  CGraphWork work;
+  LTHessStor stor;
+  VariableSet vars;
+  UInt nz;
+  int error = 0;
+
+  VariablePtr v0 = new Variable(0, 0, 0.0, 10.0, Continuous, "x0");
+  VariablePtr v1 = new Variable(1, 1, 0.0, 10.0, Continuous, "x1");
+  VariablePtr v2 = new Variable(2, 2, 0.0, 10.0, Continuous, "x2");
+
+  double x[2][3] = {{1.0, 2.0, 0.5}, {0.3, 1.5, 2.0}};
+  double j1[3], j2[3];
+  double *h1, *h2;
+
+  // exp(x0*x1) + x2^3/x0 + sqrt(x1)*x2 + log(x1 + 2)
+  n0 = cgraph.newNode(v0);
+  n1 = cgraph.newNode(v1);
+  n2 = cgraph.newNode(OpMult, n0, n1);
+  n2 = cgraph.newNode(OpExp, n2, 0);
+  n3 = cgraph.newNode(3.0);
+  n3 = cgraph.newNode(OpPowK, cgraph.newNode(v2), n3);
+  n3 = cgraph.newNode(OpDiv, n3, n0);
+  n2 = cgraph.newNode(OpPlus, n2, n3);
+  n3 = cgraph.newNode(OpSqrt, n1, 0);
+  n3 = cgraph.newNode(OpMult, n3, cgraph.newNode(v2));
+  n2 = cgraph.newNode(OpPlus, n2, n3);
+  n3 = cgraph.newNode(OpPlus, n1, cgraph.newNode(2.0));
+  n3 = cgraph.newNode(OpLog, n3, 0);
+  n2 = cgraph.newNode(OpPlus, n2, n3);
+  cgraph.setOut(n2);
+  cgraph.finalize();
+
+  // the const overloads do not evaluate a graph that is not compiled.
+  CPPUNIT_ASSERT(false == cgraph.isCompiled());
+  cgraph.eval(x[0], &work, &error);
+  CPPUNIT_ASSERT(0!=error);
+  error = 0;
+
+  // hessian storage with all three variables nonlinear, as HessianOfLag
+  // sets it up.
+  stor.nlVars = 3;
+  stor.rows = new VariablePtr[3];
+  stor.rows[0] = v0;
+  stor.rows[1] = v1;
+  stor.rows[2] = v2;
+  stor.colQs = new std::deque<UInt>[3];
+  stor.starts = new UInt[4];
+  cgraph.fillHessStor(&stor);
+  nz = 0;
+  for (UInt i=0; i<3; ++i) {
+    stor.starts[i] = nz;
+    nz += stor.colQs[i].size();
+  }
+  stor.starts[3] = nz;
+  stor.nz = nz;
+  stor.cols = new UInt[nz];
+  nz = 0;
+  for (UInt i=0; i<3; ++i) {
+    for (UInt j=0; j<stor.colQs[i].size(); ++j, ++nz) {
+      stor.cols[nz] = stor.colQs[i][j];
+    }
+  }
+  cgraph.finalHessStor(&stor);
+  vars.insert(v0);
+  vars.insert(v1);
+  vars.insert(v2);
+  cgraph.prepJac(vars.begin(), vars.end());
+  CPPUNIT_ASSERT(true == cgraph.isCompiled());
+
+  // a clone has the same offsets but uses the nodes.
+  cg2 = (CGraphPtr) cgraph.clone(&error);
+  CPPUNIT_ASSERT(0==error);
+  CPPUNIT_ASSERT(false == cg2->isCompiled());
+
+  h1 = new double[stor.nz];
+  h2 = new double[stor.nz];
+  for (UInt k=0; k<2; ++k) {
+    std::fill(h1, h1+stor.nz, 0.0);
+    std::fill(h2, h2+stor.nz, 0.0);
+    cg2->evalHessian(1.5, x[k], &stor, h1, &error);
+    CPPUNIT_ASSERT(0==error);
+    cgraph.evalHessian(1.5, x[k], h2, &work, &error);
+    CPPUNIT_ASSERT(0==error);
+    for (UInt i=0; i<stor.nz; ++i) {
+      CPPUNIT_ASSERT(fabs(h1[i]-h2[i])<1e-10*(1.0+fabs(h1[i])));
+    }
+    std::fill(h2, h2+stor.nz, 0.0);
+    cgraph.evalHessian(1.5, x[k], &stor, h2, &error);
+    CPPUNIT_ASSERT(0==error);
+    for (UInt i=0; i<stor.nz; ++i) {
+      CPPUNIT_ASSERT(fabs(h1[i]-h2[i])<1e-10*(1.0+fabs(h1[i])));
+    }
+
+    std::fill(j1, j1+3, 0.0);
+    std::fill(j2, j2+3, 0.0);
+    cg2->fillJac(x[k], j1, &error);
+    CPPUNIT_ASSERT(0==error);
+    cgraph.fillJac(x[k], j2, &work, &error);
+    CPPUNIT_ASSERT(0==error);
+    for (UInt i=0; i<3; ++i) {
+      CPPUNIT_ASSERT(fabs(j1[i]-j2[i])<1e-12*(1.0+fabs(j1[i])));
+    }
+  }
+
+  delete [] h1;
+  delete [] h2;
+  delete [] stor.rows;
+  delete [] stor.colQs;
+  delete [] stor.starts;
+  delete [] stor.cols;
+  delete cg2;
+  delete v0;
+  delete v1;
+  delete v2;
+}
+
+
+void CGraphUT::testCompileReuse()
+{
+  CNode *n0, *n1, *n2;
+  CGraph cgraph;
+  CGraphWork work, fresh;
+  int error = 0;
+
+  VariablePtr v0 = new Variable(0, 0, 0.0, 10.0, Continuous, "x0");
+  VariablePtr v2 = new Variable(2, 2, 0.0, 10.0, Continuous, "x2");
+
+  double x[3] = {1.0, 5.0, 2.0};
+  double g1[3], g2[3];
+  double f1, f2;
+
+  // x0*exp(x2) + x2^2. x1 is not in the graph.
+  n0 = cgraph.newNode(v0);
+  n1 = cgraph.newNode(v2);
+  n2 = cgraph.newNode(OpExp, n1, 0);
+  n2 = cgraph.newNode(OpMult, n0, n2);
+  n1 = cgraph.newNode(OpSqr, n1, 0);
+  n2 = cgraph.newNode(OpPlus, n2, n1);
+  cgraph.setOut(n2);
+  cgraph.finalize();
+  cgraph.compile();
+
+  // the gradient at the same point reuses the values.
+  f1 = cgraph.eval(x, &work, &error);
+  CPPUNIT_ASSERT(0==error);
+  CPPUNIT_ASSERT(fabs(f1-(exp(2.0)+4.0))<1e-12);
+  std::fill(g1, g1+3, 0.0);
+  cgraph.evalGradient(x, g1, &work, &error);
+  CPPUNIT_ASSERT(0==error);
+  CPPUNIT_ASSERT(fabs(g1[0]-exp(2.0))<1e-12);
+  CPPUNIT_ASSERT(fabs(g1[2]-(exp(2.0)+4.0))<1e-12);
+
+  // a variable not in the graph does not change the values.
+  x[1] = 7.0;
+  std::fill(g2, g2+3, 0.0);
+  cgraph.evalGradient(x, g2, &work, &error);
+  for (UInt i=0; i<3; ++i) {
+    CPPUNIT_ASSERT(g1[i]==g2[i]);
+  }
+
+  // the same array with new values is a new point.
+  x[0] = 3.0;
+  x[2] = 0.5;
+  f1 = cgraph.eval(x, &work, &error);
+  f2 = cgraph.eval(x, &fresh, &error);
+  CPPUNIT_ASSERT(0==error);
+  CPPUNIT_ASSERT(f1==f2);
+  std::fill(g1, g1+3, 0.0);
+  std::fill(g2, g2+3, 0.0);
+  cgraph.evalGradient(x, g1, &work, &error);
+  cgraph.evalGradient(x, g2, &fresh, &error);
+  CPPUNIT_ASSERT(0==error);
+  for (UInt i=0; i<3; ++i) {
+    CPPUNIT_ASSERT(g1[i]==g2[i]);
+  }
+  CPPUNIT_ASSERT(fabs(g1[2]-(3.0*exp(0.5)+1.0))<1e-12);
+
+  // values of a changed graph are not reused after it is compiled again.
+  cgraph.finalize();
+  n1 = cgraph.newNode(OpUMinus, n2, 0);
+  cgraph.setOut(n1);
+  cgraph.finalize();
+  cgraph.compile();
+  f2 = cgraph.eval(x, &work, &error);
+  CPPUNIT_ASSERT(0==error);
+  CPPUNIT_ASSERT(fabs(f1+f2)<1e-12);
+
+  delete v0;
+  delete v2;
+}
+
+
+void CGraphUT::testCompileSumList()
+{
+  const UInt n = 6;
+  CGraph cgraph;
+  CGraphPtr cg2;
+  CGraphWork work;
+  LTHessStor stor;
+  VariableSet vars;
+  std::vector<VariablePtr> v(n);
+  std::vector<CNode *> kids(n);
+  CNode *n0;
+  UInt nz;
+  int error = 0;
+
+  double x[2][n] = {{1.0, 0.5, -0.3, 2.0, 0.1, 0.7},
+                    {0.2, -1.0, 0.4, 0.3, 1.5, -0.6}};
+  double *h1, *h2;
+
+  // sin(x0*x1 + x1*x2 + ... + x5*x0)^2 + exp(x0) + ... + exp(x5). Only a
+  // few children of each list depend on a given variable.
+  for (UInt i=0; i<n; ++i) {
+    v[i] = new Variable(i, i, -10.0, 10.0, Continuous, "x");
+  }
+  for (UInt i=0; i<n; ++i) {
+    kids[i] = cgraph.newNode(OpMult, cgraph.newNode(v[i]),
+                             cgraph.newNode(v[(i+1)%n]));
+  }
+  n0 = cgraph.newNode(OpSumList, &(kids[0]), n);
+  n0 = cgraph.newNode(OpSqr, cgraph.newNode(OpSin, n0, 0), 0);
+  for (UInt i=0; i<n; ++i) {
+    kids[i] = cgraph.newNode(OpExp, cgraph.newNode(v[i]), 0);
+  }
+  kids[0] = cgraph.newNode(OpPlus, kids[0], n0);
+  cgraph.setOut(cgraph.newNode(OpSumList, &(kids[0]), n));
+  cgraph.finalize();
+
+  stor.nlVars = n;
+  stor.rows = new VariablePtr[n];
+  for (UInt i=0; i<n; ++i) {
+    stor.rows[i] = v[i];
+  }
+  stor.colQs = new std::deque<UInt>[n];
+  stor.starts = new UInt[n+1];
+  cgraph.fillHessStor(&stor);
+  nz = 0;
+  for (UInt i=0; i<n; ++i) {
+    stor.starts[i] = nz;
+    nz += stor.colQs[i].size();
+  }
+  stor.starts[n] = nz;
+  stor.nz = nz;
+  stor.cols = new UInt[nz];
+  nz = 0;
+  for (UInt i=0; i<n; ++i) {
+    for (UInt j=0; j<stor.colQs[i].size(); ++j, ++nz) {
+      stor.cols[nz] = stor.colQs[i][j];
+    }
+  }
+  cg2 = (CGraphPtr) cgraph.clone(&error);
+  CPPUNIT_ASSERT(0==error);
+  cg2->finalHessStor(&stor);
+  cgraph.finalHessStor(&stor);
+  for (UInt i=0; i<n; ++i) {
+    vars.insert(v[i]);
+  }
+  cg2->prepJac(vars.begin(), vars.end());
+  cgraph.prepJac(vars.begin(), vars.end());
+  CPPUNIT_ASSERT(true == cgraph.isCompiled());
+
+  // evaluate the tape twice with the same workspace, and compare with the
+  // nodes of the clone once it is no longer compiled.
+  cg2->finalize();
+  CPPUNIT_ASSERT(false == cg2->isCompiled());
+  h1 = new double[stor.nz];
+  h2 = new double[stor.nz];
+  for (UInt k=0; k<2; ++k) {
+    std::fill(h1, h1+stor.nz, 0.0);
+    std::fill(h2, h2+stor.nz, 0.0);
+    cg2->evalHessian(1.0, x[k], &stor, h1, &error);
+    CPPUNIT_ASSERT(0==error);
+    cgraph.evalHessian(1.0, x[k], h2, &work, &error);
+    CPPUNIT_ASSERT(0==error);
+    for (UInt i=0; i<stor.nz; ++i) {
+      CPPUNIT_ASSERT(fabs(h1[i]-h2[i])<1e-10*(1.0+fabs(h1[i])));
+    }
+  }
+
+  delete [] h1;
+  delete [] h2;
+  delete [] stor.rows;
+  delete [] stor.colQs;
+  delete [] stor.starts;
+  delete [] stor.cols;
+  delete cg2;
+  for (UInt i=0; i<n; ++i) {
+    delete v[i];
+  }
+}
+
+
 void CGraphUT::testIdentical()
 {
   VariablePtr v0 = new Variable(0, 0, 0.0, 10.0, Continuous, "x0");
@@ -24,11 +24,19 @@ public:
 
   void setUp() { }      // need not implement
   void tearDown() { }   // need not implement
+  void testCompile();
+  void testCompileDerivs();
+  void testCompileReuse();
+  void testCompileSumList();
   void testIdentical();
   void testLin();
   void testQuad();
 
   CPPUNIT_TEST_SUITE(CGraphUT);
+  CPPUNIT_TEST(testCompile);
+  CPPUNIT_TEST(testCompileDerivs);
+  CPPUNIT_TEST(testCompileReuse);
+  CPPUNIT_TEST(testCompileSumList);
   CPPUNIT_TEST(testIdentical);
   CPPUNIT_TEST(testLin);
   CPPUNIT_TEST(testQuad);
@@ -0,0 +1,207 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+#include <cmath>
+
+#include "MinotaurConfig.h"
+#include "Constraint.h"
+#include "Cut.h"
+#include "CutStore.h"
+#include "CutStoreUT.h"
+#include "Environment.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Problem.h"
+#include "Relaxation.h"
+#include "Variable.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(CutStoreUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(CutStoreUT, "CutStoreUT");
+
+using namespace Minotaur;
+
+// number of variables in p_.
+const UInt nvars = 50;
+
+
+void CutStoreUT::setUp()
+{
+  env_ = new Environment();
+  LinearFunctionPtr lf = new LinearFunction();
+
+  p_ = new Problem(env_);
+  for (UInt i=0; i<nvars; ++i) {
+    p_->newVariable(-1.0, 1.0, Continuous);
+  }
+  // a relaxation can not be made without an objective.
+  lf->addTerm(p_->getVariable(0), 1.0);
+  p_->newObjective(new Function(lf), 0.0, Minimize);
+}
+
+
+void CutStoreUT::tearDown()
+{
+  delete p_;
+  delete env_;
+}
+
+
+int CutStoreUT::addCut_(CutStore *store, UInt t, UInt k)
+{
+  // x_{k mod n} + (t+1) x_{(k+t+1) mod n} <= 100000 t + k. The bound
+  // tells which thread made the cut and when. Returns -2 if the id is not
+  // saved in the cut.
+  LinearFunctionPtr lf = new LinearFunction();
+  FunctionPtr f;
+  CutPtr cut;
+  int id;
+
+  lf->addTerm(p_->getVariable(k % nvars), 1.0);
+  lf->addTerm(p_->getVariable((k+t+1) % nvars), t+1.0);
+  f = new Function(lf);
+  cut = new Cut(nvars, f, -INFINITY, 100000.0*t + k, false, false);
+  id = store->add(cut, t);
+  if (id != cut->getInfo()->storeId) {
+    id = -2;
+  }
+  delete cut;
+  delete f;
+  return id;
+}
+
+
+bool CutStoreUT::checkCon_(ConstraintPtr con)
+{
+  LinearFunctionPtr lf = con->getLinearFunction();
+  UInt t = (UInt) floor(con->getUb() / 100000.0);
+  UInt k = (UInt) (con->getUb() - 100000.0*t);
+  UInt i0 = k % nvars;
+  UInt i1 = (k+t+1) % nvars;
+
+  if (!lf || lf->getNumTerms() != 2) {
+    return false;
+  }
+  for (VariableGroupConstIterator it=lf->termsBegin(); it!=lf->termsEnd();
+       ++it) {
+    if (it->first->getIndex() == i0) {
+      if (fabs(it->second - 1.0) > 1e-12) {
+        return false;
+      }
+    } else if (it->first->getIndex() == i1) {
+      if (fabs(it->second - t - 1.0) > 1e-12) {
+        return false;
+      }
+    } else {
+      return false;
+    }
+  }
+  return (con->getLb() <= -INFINITY);
+}
+
+
+void CutStoreUT::testAddToRel()
+{
+  CutStore store;
+  RelaxationPtr rel = new Relaxation(p_, env_);
+  UInt first = 0;
+  UInt i = 0;
+
+  CPPUNIT_ASSERT(0 == store.getNumCuts());
+  // more than the first chunk.
+  for (UInt k=0; k<3000; ++k) {
+    CPPUNIT_ASSERT((int) k == addCut_(&store, k%2, k));
+  }
+  CPPUNIT_ASSERT(3000 == store.getNumCuts());
+
+  // cuts of thread 1 are skipped.
+  store.addNewToRel(rel, 1, &first);
+  CPPUNIT_ASSERT(3000 == first);
+  CPPUNIT_ASSERT(1500 == rel->getNumCons());
+  for (ConstraintConstIterator it=rel->consBegin(); it!=rel->consEnd();
+       ++it, i+=2) {
+    CPPUNIT_ASSERT(checkCon_(*it));
+    CPPUNIT_ASSERT((double) i == (*it)->getUb());
+    // the variables are those of rel, not of p_.
+    CPPUNIT_ASSERT((*it)->getLinearFunction()->hasVar(rel->getVariable(
+          i % nvars)));
+  }
+
+  // nothing new.
+  store.addNewToRel(rel, 1, &first);
+  CPPUNIT_ASSERT(1500 == rel->getNumCons());
+
+  store.addToRel(2999, rel);
+  CPPUNIT_ASSERT(1501 == rel->getNumCons());
+  CPPUNIT_ASSERT(checkCon_(rel->getConstraint(1500)));
+  CPPUNIT_ASSERT(100000.0 + 2999 == rel->getConstraint(1500)->getUb());
+  delete rel;
+}
+
+
+void CutStoreUT::testConcurrent()
+{
+  const UInt nadd = 4;
+  const UInt ncuts = 5000;
+  CutStore store;
+  RelaxationPtr rel = new Relaxation(p_, env_);
+  UInt first = 0;
+  bool ok = true;
+  std::vector<int> seen(nadd*ncuts, 0);
+
+  // threads 0 to nadd-1 add cuts, thread nadd reads them while they are
+  // being added.
+#pragma omp parallel num_threads(nadd+1)
+  {
+#pragma omp for schedule(static, 1)
+    for (UInt t=0; t<=nadd; ++t) {
+      if (t < nadd) {
+        for (UInt k=0; k<ncuts; ++k) {
+          if (addCut_(&store, t, k) < 0) {
+#pragma omp critical (cutStoreUT)
+            ok = false;
+          }
+        }
+      } else {
+        while (first < nadd*ncuts) {
+          store.addNewToRel(rel, nadd, &first);
+        }
+      }
+    }
+  }
+  CPPUNIT_ASSERT(ok);
+  CPPUNIT_ASSERT(nadd*ncuts == store.getNumCuts());
+  CPPUNIT_ASSERT(nadd*ncuts == rel->getNumCons());
+
+  // each cut is seen once, and the cuts of a thread are in their order.
+  std::vector<int> last(nadd, -1);
+  for (ConstraintConstIterator it=rel->consBegin(); it!=rel->consEnd();
+       ++it) {
+    UInt t, k;
+    CPPUNIT_ASSERT(checkCon_(*it));
+    t = (UInt) floor((*it)->getUb() / 100000.0);
+    k = (UInt) ((*it)->getUb() - 100000.0*t);
+    CPPUNIT_ASSERT(t < nadd && k < ncuts);
+    CPPUNIT_ASSERT((int) k > last[t]);
+    last[t] = k;
+    ++seen[t*ncuts+k];
+  }
+  for (UInt i=0; i<nadd*ncuts; ++i) {
+    CPPUNIT_ASSERT(1 == seen[i]);
+  }
+  delete rel;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,60 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+#ifndef CUTSTOREUT_H
+#define CUTSTOREUT_H
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "CutStore.h"
+
+using namespace Minotaur;
+
+// Test the append-only store of cuts shared by threads.
+class CutStoreUT : public CppUnit::TestCase {
+
+public:
+  CutStoreUT(std::string name) : TestCase(name) {}
+  CutStoreUT() {}
+
+  void setUp();
+  void tearDown();
+
+  void testAddToRel();
+  void testConcurrent();
+
+  CPPUNIT_TEST_SUITE(CutStoreUT);
+  CPPUNIT_TEST(testAddToRel);
+  CPPUNIT_TEST(testConcurrent);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  EnvPtr env_;
+  ProblemPtr p_;
+
+  /// Make the k-th cut of thread t and add it to store.
+  int addCut_(CutStore *store, UInt t, UInt k);
+
+  /// Check that con is the cut made by addCut_().
+  bool checkCon_(ConstraintPtr con);
+};
+
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
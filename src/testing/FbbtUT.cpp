@@ -0,0 +1,314 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+#include <cmath>
+
+#include "MinotaurConfig.h"
+#include "CGraph.h"
+#include "CNode.h"
+#include "Environment.h"
+#include "FbbtHandler.h"
+#include "FbbtUT.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Problem.h"
+#include "Relaxation.h"
+#include "VarBoundMod.h"
+#include "Variable.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FbbtUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(FbbtUT, "FbbtUT");
+
+using namespace Minotaur;
+
+
+/**
+ * Tighten the bounds [vlb, vub] of x0 so that lb <= op(x0) <= ub, or
+ * lb <= x0^k <= ub if op is OpPowK. Sets is_inf if no x0 is left.
+ */
+static void propVar(OpCode op, double k, double lb, double ub, double *vlb,
+                    double *vub, bool *is_inf)
+{
+  VariablePtr v = new Variable(0, 0, *vlb, *vub, Continuous, "x0");
+  CGraph cg;
+  CNode *n = cg.newNode(v);
+  int err = 0;
+
+  if (OpPowK==op) {
+    n = cg.newNode(OpPowK, n, cg.newNode(k));
+  } else {
+    n = cg.newNode(op, n, 0);
+  }
+  cg.setOut(n);
+  cg.finalize();
+  cg.varBoundsInPlace(lb, ub, vlb, vub, is_inf, &err);
+  CPPUNIT_ASSERT(0==err);
+  delete v;
+}
+
+
+/**
+ * min x0 + x1, for x0, x1 in [lb0, 10] x [0, 10], with
+ * x0^2 + x1 <= 4 and
+ * sqrt(x1) + x0 >= 2.
+ */
+static ProblemPtr fbbtProblem(EnvPtr env, double lb0)
+{
+  ProblemPtr p = new Problem(env);
+  VariablePtr x0, x1;
+  LinearFunctionPtr lf;
+  CGraphPtr cg;
+
+  x0 = p->newVariable(lb0, 10.0, Continuous);
+  x1 = p->newVariable(0.0, 10.0, Continuous);
+
+  lf = new LinearFunction();
+  lf->addTerm(x0, 1.0);
+  lf->addTerm(x1, 1.0);
+  p->newObjective(new Function(lf), 0.0, Minimize);
+
+  cg = new CGraph();
+  cg->setOut(cg->newNode(OpSqr, cg->newNode(x0), 0));
+  cg->finalize();
+  lf = new LinearFunction();
+  lf->addTerm(x1, 1.0);
+  p->newConstraint(new Function(lf, cg), -INFINITY, 4.0);
+
+  cg = new CGraph();
+  cg->setOut(cg->newNode(OpSqrt, cg->newNode(x1), 0));
+  cg->finalize();
+  lf = new LinearFunction();
+  lf->addTerm(x0, 1.0);
+  p->newConstraint(new Function(lf, cg), 2.0, INFINITY);
+  return p;
+}
+
+
+void FbbtUT::testCeil()
+{
+  double lb = -10.0, ub = 10.0;
+  bool is_inf = false;
+
+  // ceil(x) = 3 for x in (2, 3].
+  propVar(OpCeil, 0.0, 3.0, 4.0, &lb, &ub, &is_inf);
+  CPPUNIT_ASSERT(false==is_inf);
+  CPPUNIT_ASSERT(2.0==lb && 4.0==ub);
+
+  lb = -10.0;
+  ub = 10.0;
+  propVar(OpCeil, 0.0, 2.5, 4.5, &lb, &ub, &is_inf);
+  CPPUNIT_ASSERT(false==is_inf);
+  CPPUNIT_ASSERT(2.0==lb && 4.0==ub);
+}
+
+
+void FbbtUT::testFloor()
+{
+  double lb = -10.0, ub = 10.0;
+  bool is_inf = false;
+
+  // floor(x) = 4 for x in [4, 5).
+  propVar(OpFloor, 0.0, 3.0, 4.0, &lb, &ub, &is_inf);
+  CPPUNIT_ASSERT(false==is_inf);
+  CPPUNIT_ASSERT(3.0==lb && 5.0==ub);
+
+  lb = -10.0;
+  ub = 10.0;
+  propVar(OpFloor, 0.0, 2.5, 4.5, &lb, &ub, &is_inf);
+  CPPUNIT_ASSERT(false==is_inf);
+  CPPUNIT_ASSERT(3.0==lb && 5.0==ub);
+}
+
+
+void FbbtUT::testPowK()
+{
+  double lb = -10.0, ub = 10.0;
+  bool is_inf = false;
+  VariablePtr v = new Variable(0, 0, -10.0, 10.0, Continuous, "x0");
+  CGraph cg;
+  CNode *n;
+  int err = 0;
+
+  // odd powers keep the sign.
+  propVar(OpPowK, 3.0, -8.0, 27.0, &lb, &ub, &is_inf);
+  CPPUNIT_ASSERT(false==is_inf);
+  CPPUNIT_ASSERT(fabs(lb+2.0)<1e-9 && fabs(ub-3.0)<1e-9);
+
+  lb = -10.0;
+  ub = 10.0;
+  propVar(OpPowK, 3.0, -27.0, -8.0, &lb, &ub, &is_inf);
+  CPPUNIT_ASSERT(false==is_inf);
+  CPPUNIT_ASSERT(fabs(lb+3.0)<1e-9 && fabs(ub+2.0)<1e-9);
+
+  // even powers are symmetric.
+  lb = -10.0;
+  ub = 10.0;
+  propVar(OpPowK, 4.0, 0.0, 16.0, &lb, &ub, &is_inf);
+  CPPUNIT_ASSERT(false==is_inf);
+  CPPUNIT_ASSERT(fabs(lb+2.0)<1e-9 && fabs(ub-2.0)<1e-9);
+
+  // an even power can not be negative.
+  n = cg.newNode(OpPowK, cg.newNode(v), cg.newNode(2.0));
+  cg.setOut(n);
+  cg.finalize();
+  n->setBounds(-5.0, -1.0);
+  n->propBounds(&is_inf, &err);
+  CPPUNIT_ASSERT(3141==err);
+  delete v;
+}
+
+
+void FbbtUT::testPresolve()
+{
+  EnvPtr env = (EnvPtr) new Environment();
+  ProblemPtr p;
+  RelaxationPtr rel;
+  FbbtHandler *fbbt;
+  ModVector p_mods, r_mods;
+  VarBoundModPtr mod;
+  VariablePtr x0, x1;
+  int err = 0;
+
+  env->setLogLevel(LogNone);
+  env->startTimer(err);
+  p = fbbtProblem(env, 0.0);
+  rel = (RelaxationPtr) new Relaxation(p, env);
+  x0 = rel->getRelaxationVar(p->getVariable(0));
+  x1 = rel->getRelaxationVar(p->getVariable(1));
+  fbbt = new FbbtHandler(env, p);
+
+  // x0^2 <= 4 - x1 <= 4. Continuous bounds get some slack.
+  CPPUNIT_ASSERT(false==fbbt->presolveNode(rel, 0, 0, p_mods, r_mods));
+  CPPUNIT_ASSERT(1==r_mods.size());
+  CPPUNIT_ASSERT(p_mods.empty());
+  CPPUNIT_ASSERT(fabs(x0->getUb()-2.0)<2e-5 && x0->getUb()>=2.0);
+  CPPUNIT_ASSERT(0.0==x0->getLb());
+  CPPUNIT_ASSERT(0.0==x1->getLb() && 10.0==x1->getUb());
+
+  // only the changed bound is propagated again: x0^2 <= 4 - 3.
+  mod = (VarBoundModPtr) new VarBoundMod(x1, Lower, 3.0);
+  mod->applyToProblem(rel);
+  delete mod;
+  for (UInt i=0; i<r_mods.size(); ++i) {
+    delete r_mods[i];
+  }
+  r_mods.clear();
+  CPPUNIT_ASSERT(false==fbbt->presolveNode(rel, 0, 0, p_mods, r_mods));
+  CPPUNIT_ASSERT(1==r_mods.size());
+  CPPUNIT_ASSERT(fabs(x0->getUb()-1.0)<2e-5 && x0->getUb()>=1.0);
+  CPPUNIT_ASSERT(3.0==x1->getLb() && 10.0==x1->getUb());
+
+  // nothing left to tighten.
+  delete r_mods[0];
+  r_mods.clear();
+  CPPUNIT_ASSERT(false==fbbt->presolveNode(rel, 0, 0, p_mods, r_mods));
+  CPPUNIT_ASSERT(r_mods.empty());
+
+  delete fbbt;
+  delete rel;
+  delete p;
+  delete env;
+}
+
+
+void FbbtUT::testPresolveInf()
+{
+  EnvPtr env = (EnvPtr) new Environment();
+  ProblemPtr p;
+  RelaxationPtr rel;
+  FbbtHandler *fbbt;
+  ModVector p_mods, r_mods;
+  int err = 0;
+
+  env->setLogLevel(LogNone);
+  env->startTimer(err);
+
+  // x0 >= 3 and x0^2 <= 4.
+  p = fbbtProblem(env, 3.0);
+  rel = (RelaxationPtr) new Relaxation(p, env);
+  fbbt = new FbbtHandler(env, p);
+  CPPUNIT_ASSERT(true==fbbt->presolveNode(rel, 0, 0, p_mods, r_mods));
+  CPPUNIT_ASSERT(r_mods.empty());
+
+  delete fbbt;
+  delete rel;
+  delete p;
+  delete env;
+}
+
+
+void FbbtUT::testSqr()
+{
+  double lb = -10.0, ub = 10.0;
+  bool is_inf = false;
+  VariablePtr v = new Variable(0, 0, -10.0, 10.0, Continuous, "x0");
+  CGraph cg;
+  CNode *n;
+  int err = 0;
+
+  propVar(OpSqr, 0.0, 0.0, 4.0, &lb, &ub, &is_inf);
+  CPPUNIT_ASSERT(false==is_inf);
+  CPPUNIT_ASSERT(-2.0==lb && 2.0==ub);
+
+  // x^2 <= 9 does not cut [-1, 10] from below.
+  lb = -1.0;
+  ub = 10.0;
+  propVar(OpSqr, 0.0, -INFINITY, 9.0, &lb, &ub, &is_inf);
+  CPPUNIT_ASSERT(false==is_inf);
+  CPPUNIT_ASSERT(-1.0==lb && 3.0==ub);
+
+  // a square can not be negative.
+  n = cg.newNode(OpSqr, cg.newNode(v), 0);
+  cg.setOut(n);
+  cg.finalize();
+  n->setBounds(-5.0, -1.0);
+  n->propBounds(&is_inf, &err);
+  CPPUNIT_ASSERT(true==is_inf);
+  CPPUNIT_ASSERT(0==err);
+  delete v;
+}
+
+
+void FbbtUT::testSqrt()
+{
+  double lb = 0.0, ub = 100.0;
+  bool is_inf = false;
+  VariablePtr v = new Variable(0, 0, 0.0, 100.0, Continuous, "x0");
+  CGraph cg;
+  CNode *n;
+  int err = 0;
+
+  propVar(OpSqrt, 0.0, 1.0, 3.0, &lb, &ub, &is_inf);
+  CPPUNIT_ASSERT(false==is_inf);
+  CPPUNIT_ASSERT(1.0==lb && 9.0==ub);
+
+  lb = 0.0;
+  ub = 100.0;
+  propVar(OpSqrt, 0.0, -INFINITY, 3.0, &lb, &ub, &is_inf);
+  CPPUNIT_ASSERT(false==is_inf);
+  CPPUNIT_ASSERT(0.0==lb && 9.0==ub);
+
+  // a square root can not be negative.
+  n = cg.newNode(OpSqrt, cg.newNode(v), 0);
+  cg.setOut(n);
+  cg.finalize();
+  n->setBounds(-5.0, -1.0);
+  n->propBounds(&is_inf, &err);
+  CPPUNIT_ASSERT(true==is_inf);
+  CPPUNIT_ASSERT(0==err);
+  delete v;
+}
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,60 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+#ifndef FBBTUT_H
+#define FBBTUT_H
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <Types.h>
+using namespace Minotaur;
+
+// Test bound propagation through nonlinear functions (CNode::propBounds) and
+// the FbbtHandler that presolves nodes with it.
+class FbbtUT : public CppUnit::TestCase {
+
+public:
+  FbbtUT(std::string name) : TestCase(name) {}
+  FbbtUT() {}
+
+  void setUp() { }      // need not implement
+  void tearDown() { }   // need not implement
+  void testCeil();
+  void testFloor();
+  void testPowK();
+  void testPresolve();
+  void testPresolveInf();
+  void testSqr();
+  void testSqrt();
+
+  CPPUNIT_TEST_SUITE(FbbtUT);
+  CPPUNIT_TEST(testCeil);
+  CPPUNIT_TEST(testFloor);
+  CPPUNIT_TEST(testPowK);
+  CPPUNIT_TEST(testPresolve);
+  CPPUNIT_TEST(testPresolveInf);
+  CPPUNIT_TEST(testSqr);
+  CPPUNIT_TEST(testSqrt);
+  CPPUNIT_TEST_SUITE_END();
+
+};
+
+#endif
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
@@ -0,0 +1,254 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+#include <cmath>
+
+#include "MinotaurConfig.h"
+#include "Cut.h"
+#include "Environment.h"
+#include "Function.h"
+#include "LinCutPoolUT.h"
+#include "LinearFunction.h"
+#include "Problem.h"
+#include "Variable.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(LinCutPoolUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(LinCutPoolUT, "LinCutPoolUT");
+
+using namespace Minotaur;
+
+// number of variables in p_.
+const UInt nvars = 10;
+
+
+void LinCutPoolUT::setUp()
+{
+  env_ = new Environment();
+  p_ = new Problem(env_);
+  for (UInt i=0; i<nvars; ++i) {
+    p_->newVariable(-5.0, 5.0, Continuous);
+  }
+}
+
+
+void LinCutPoolUT::tearDown()
+{
+  for (UInt i=0; i<cuts_.size(); ++i) {
+    delete cuts_[i]->getFunction();
+    delete cuts_[i];
+  }
+  cuts_.clear();
+  delete p_;
+  delete env_;
+}
+
+
+void LinCutPoolUT::checkRows_(LinCutPool &pool, const double *x)
+{
+  CutPtr cut;
+  FunctionPtr f;
+  double viol, score, nrm;
+  int err = 0;
+
+  pool.evalScores(p_, x);
+  for (UInt i=0; i<pool.getNumRows(); ++i) {
+    cut = pool.getCut(i);
+    if (!cut) {
+      continue;
+    }
+    // Cut::evalScore() divides by a norm it never computes, so only its
+    // violation is compared.
+    cut->evalScore(x, &viol, &score);
+    CPPUNIT_ASSERT(fabs(pool.getViol(i)-viol) < 1e-10);
+
+    nrm = 0.0;
+    for (VariableGroupConstIterator it
+         =cut->getFunction()->getLinearFunction()->termsBegin();
+         it!=cut->getFunction()->getLinearFunction()->termsEnd(); ++it) {
+      nrm += it->second*it->second;
+    }
+    CPPUNIT_ASSERT(fabs(pool.getScore(i)-viol/sqrt(nrm)) < 1e-10);
+
+    // the row has the coefficients of the cut.
+    f = pool.newFunction(i);
+    CPPUNIT_ASSERT(fabs(f->eval(x, &err)-cut->eval(x, &err)) < 1e-10);
+    CPPUNIT_ASSERT(0 == err);
+    delete f;
+  }
+}
+
+
+CutPtr LinCutPoolUT::newCut_(UInt i, bool never_delete)
+{
+  LinearFunctionPtr lf = new LinearFunction();
+  double lb = -INFINITY, ub = INFINITY;
+  CutPtr cut;
+
+  // the first variable is not used, so that it can be deleted.
+  lf->incTerm(p_->getVariable(1 + i%(nvars-1)), 1.0 + 0.5*i);
+  lf->incTerm(p_->getVariable(1 + (3*i+4)%(nvars-1)), -0.5 - (i%4));
+  if (4 == i%5) {
+    lb = -1.0;
+    ub = 1.0;
+  } else if (0 == i%2) {
+    ub = 0.1*i;
+  } else {
+    lb = 0.1*i - 1.0;
+  }
+  cut = new Cut(nvars, new Function(lf), lb, ub, never_delete, false);
+  cuts_.push_back(cut);
+  return cut;
+}
+
+
+void LinCutPoolUT::testEvalScores()
+{
+  LinCutPool pool;
+  double x[nvars];
+  UInt nviol = 0;
+
+  for (UInt j=0; j<nvars; ++j) {
+    x[j] = 2.0*sin(j+1.0);
+  }
+  for (UInt i=0; i<20; ++i) {
+    CPPUNIT_ASSERT(LinCutPool::accepts(newCut_(i, false)));
+    pool.add(cuts_.back());
+  }
+  CPPUNIT_ASSERT(20 == pool.getSize());
+  checkRows_(pool, x);
+
+  // the age of a cut counts the evaluations since it was last violated.
+  for (UInt i=0; i<pool.getNumRows(); ++i) {
+    if (pool.getScore(i) < 1e-6) {
+      CPPUNIT_ASSERT(1 == pool.getAge(i));
+    } else {
+      CPPUNIT_ASSERT(0 == pool.getAge(i));
+      ++nviol;
+    }
+  }
+  CPPUNIT_ASSERT(nviol > 0 && nviol < 20);
+}
+
+
+void LinCutPoolUT::testPopOldest()
+{
+  LinCutPool pool;
+
+  // cuts 0 and 3 are never deleted.
+  for (UInt i=0; i<5; ++i) {
+    pool.add(newCut_(i, 0==i || 3==i));
+  }
+  CPPUNIT_ASSERT(cuts_[1] == pool.popOldest());
+  CPPUNIT_ASSERT(cuts_[2] == pool.popOldest());
+  CPPUNIT_ASSERT(cuts_[4] == pool.popOldest());
+  CPPUNIT_ASSERT(0 == pool.popOldest());
+  CPPUNIT_ASSERT(2 == pool.getSize());
+  pool.purge();
+  CPPUNIT_ASSERT(2 == pool.getNumRows());
+  CPPUNIT_ASSERT(cuts_[0] == pool.getCut(0));
+  CPPUNIT_ASSERT(cuts_[3] == pool.getCut(1));
+  pool.clear();
+
+  // removed rows at the front are skipped, and cuts added later are the
+  // newest.
+  for (UInt i=5; i<10; ++i) {
+    pool.add(newCut_(i, false));
+  }
+  CPPUNIT_ASSERT(cuts_[5] == pool.remove(0));
+  CPPUNIT_ASSERT(cuts_[6] == pool.remove(1));
+  CPPUNIT_ASSERT(0 == pool.remove(1));
+  CPPUNIT_ASSERT(cuts_[7] == pool.popOldest());
+  pool.add(newCut_(10, false));
+  CPPUNIT_ASSERT(cuts_[8] == pool.popOldest());
+  CPPUNIT_ASSERT(cuts_[9] == pool.popOldest());
+  CPPUNIT_ASSERT(cuts_[10] == pool.popOldest());
+  CPPUNIT_ASSERT(0 == pool.popOldest());
+  CPPUNIT_ASSERT(0 == pool.getSize());
+  pool.purge();
+  CPPUNIT_ASSERT(0 == pool.getNumRows());
+}
+
+
+void LinCutPoolUT::testPurge()
+{
+  LinCutPool pool;
+  double x[nvars];
+  UInt dels[] = {0, 3, 4, 11, 19};
+  UInt j;
+
+  for (UInt k=0; k<nvars; ++k) {
+    x[k] = 1.5*cos(k+0.5);
+  }
+  for (UInt i=0; i<20; ++i) {
+    pool.add(newCut_(i, false));
+  }
+  checkRows_(pool, x);
+  for (UInt k=0; k<5; ++k) {
+    CPPUNIT_ASSERT(cuts_[dels[k]] == pool.remove(dels[k]));
+  }
+  CPPUNIT_ASSERT(15 == pool.getSize());
+  CPPUNIT_ASSERT(20 == pool.getNumRows());
+
+  // the rows left keep their order and their coefficients.
+  pool.purge();
+  CPPUNIT_ASSERT(15 == pool.getNumRows());
+  j = 0;
+  for (UInt i=0, k=0; i<20; ++i) {
+    if (k<5 && dels[k]==i) {
+      ++k;
+    } else {
+      CPPUNIT_ASSERT(cuts_[i] == pool.getCut(j));
+      ++j;
+    }
+  }
+  checkRows_(pool, x);
+
+  // rows added after a purge.
+  for (UInt i=20; i<25; ++i) {
+    pool.add(newCut_(i, false));
+  }
+  pool.remove(15);
+  pool.purge();
+  CPPUNIT_ASSERT(19 == pool.getNumRows());
+  CPPUNIT_ASSERT(cuts_[21] == pool.getCut(15));
+  checkRows_(pool, x);
+}
+
+
+void LinCutPoolUT::testRenumber()
+{
+  LinCutPool pool;
+  double x[nvars];
+
+  for (UInt k=0; k<nvars; ++k) {
+    x[k] = 0.3*k - 1.0;
+  }
+  for (UInt i=0; i<12; ++i) {
+    pool.add(newCut_(i, false));
+  }
+  checkRows_(pool, x);
+
+  // deleting the first variable shifts the index of all others by one.
+  p_->markDelete(p_->getVariable(0));
+  p_->delMarkedVars();
+  CPPUNIT_ASSERT(nvars-1 == p_->getNumVars());
+  for (UInt k=0; k+1<nvars; ++k) {
+    x[k] = x[k+1];
+  }
+  x[nvars-1] = 1e6;
+  checkRows_(pool, x);
+}
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
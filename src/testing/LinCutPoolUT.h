@@ -0,0 +1,65 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+#ifndef LINCUTPOOLUT_H
+#define LINCUTPOOLUT_H
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "LinCutPool.h"
+
+using namespace Minotaur;
+
+// Test the pool of linear cuts stored as rows of a sparse matrix.
+class LinCutPoolUT : public CppUnit::TestCase {
+
+public:
+  LinCutPoolUT(std::string name) : TestCase(name) {}
+  LinCutPoolUT() {}
+
+  void setUp();
+  void tearDown();
+
+  void testEvalScores();
+  void testPopOldest();
+  void testPurge();
+  void testRenumber();
+
+  CPPUNIT_TEST_SUITE(LinCutPoolUT);
+  CPPUNIT_TEST(testEvalScores);
+  CPPUNIT_TEST(testPopOldest);
+  CPPUNIT_TEST(testPurge);
+  CPPUNIT_TEST(testRenumber);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  CutVector cuts_;
+  EnvPtr env_;
+  ProblemPtr p_;
+
+  /// Check the scores and rows of all cuts in pool at x against the cuts.
+  void checkRows_(LinCutPool &pool, const double *x);
+
+  /// Make the i-th cut, in variables other than the first.
+  CutPtr newCut_(UInt i, bool never_delete);
+};
+
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
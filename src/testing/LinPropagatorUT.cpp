@@ -0,0 +1,189 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+#include <cmath>
+#include <cstdlib>
+
+#include "MinotaurConfig.h"
+#include "Constraint.h"
+#include "Environment.h"
+#include "Function.h"
+#include "LinPropagator.h"
+#include "LinPropagatorUT.h"
+#include "LinearFunction.h"
+#include "Modification.h"
+#include "Problem.h"
+#include "Variable.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(LinPropagatorUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(LinPropagatorUT, "LinPropagatorUT");
+
+using namespace Minotaur;
+
+static const double infty = 1e20;
+
+
+void LinPropagatorUT::setUp()
+{
+  VariablePtr x0, x1, x2, x3;
+  LinearFunctionPtr lf;
+
+  env_ = (EnvPtr) new Environment();
+  p_ = (ProblemPtr) new Problem(env_);
+  x0 = p_->newVariable(0.0, 10.0, Continuous);
+  x1 = p_->newVariable(-5.0, 5.0, Integer);
+  x2 = p_->newVariable(0.0, INFINITY, Continuous);
+  x3 = p_->newVariable(-INFINITY, 3.0, Continuous);
+
+  // x0 + 2x1 - x2 <= 20
+  lf = (LinearFunctionPtr) new LinearFunction();
+  lf->addTerm(x0, 1.0);
+  lf->addTerm(x1, 2.0);
+  lf->addTerm(x2, -1.0);
+  p_->newConstraint((FunctionPtr) new Function(lf), -INFINITY, 20.0);
+
+  // -3x0 + x1 + 0.5x3 >= -30
+  lf = (LinearFunctionPtr) new LinearFunction();
+  lf->addTerm(x0, -3.0);
+  lf->addTerm(x1, 1.0);
+  lf->addTerm(x3, 0.5);
+  p_->newConstraint((FunctionPtr) new Function(lf), -30.0, INFINITY);
+
+  // -4 <= x1 + x2 + x3 <= 8
+  lf = (LinearFunctionPtr) new LinearFunction();
+  lf->addTerm(x1, 1.0);
+  lf->addTerm(x2, 1.0);
+  lf->addTerm(x3, 1.0);
+  p_->newConstraint((FunctionPtr) new Function(lf), -4.0, 8.0);
+
+  // 0.1x0 - 7x3 <= 50
+  lf = (LinearFunctionPtr) new LinearFunction();
+  lf->addTerm(x0, 0.1);
+  lf->addTerm(x3, -7.0);
+  p_->newConstraint((FunctionPtr) new Function(lf), -INFINITY, 50.0);
+}
+
+
+void LinPropagatorUT::tearDown()
+{
+  delete p_;
+  delete env_;
+}
+
+
+void LinPropagatorUT::checkActs_(LinPropagator *prop)
+{
+  ConstraintPtr c;
+  LinearFunctionPtr lf;
+  double a, lo, up, minfin, maxfin, pminfin, pmaxfin;
+  UInt mininf, maxinf, pmininf, pmaxinf;
+
+  for (ConstraintConstIterator it=p_->consBegin(); it!=p_->consEnd(); ++it) {
+    c = *it;
+    CPPUNIT_ASSERT(prop->getActivity(c, &pminfin, &pmininf, &pmaxfin,
+                                     &pmaxinf));
+    minfin = maxfin = 0.0;
+    mininf = maxinf = 0;
+    lf = c->getLinearFunction();
+    for (VariableGroupConstIterator vit=lf->termsBegin();
+         vit!=lf->termsEnd(); ++vit) {
+      a = vit->second;
+      lo = (a > 0) ? vit->first->getLb() : vit->first->getUb();
+      up = (a > 0) ? vit->first->getUb() : vit->first->getLb();
+      if (fabs(lo) >= infty) {
+        ++mininf;
+      } else {
+        minfin += a*lo;
+      }
+      if (fabs(up) >= infty) {
+        ++maxinf;
+      } else {
+        maxfin += a*up;
+      }
+    }
+    CPPUNIT_ASSERT(mininf == pmininf);
+    CPPUNIT_ASSERT(maxinf == pmaxinf);
+    CPPUNIT_ASSERT(fabs(minfin - pminfin) < 1e-9);
+    CPPUNIT_ASSERT(fabs(maxfin - pmaxfin) < 1e-9);
+  }
+}
+
+
+// Change bounds of the variables, sometimes to or from infinity, and compare
+// the activities after each sync() with a full computation.
+void LinPropagatorUT::testBoundChanges()
+{
+  LinPropagator *prop = new LinPropagator(1e-6, infty);
+  VariablePtr v;
+  double lb, ub;
+
+  prop->sync(p_);
+  checkActs_(prop);
+
+  srand(1);
+  for (UInt i=0; i<200; ++i) {
+    v = p_->getVariable(rand() % p_->getNumVars());
+    lb = (rand() % 5 == 0) ? -INFINITY : -10.0 + rand() % 10;
+    ub = (rand() % 5 == 0) ? INFINITY : lb + rand() % 10;
+    if (ub < lb) {
+      ub = lb;
+    }
+    p_->changeBound(v, lb, ub);
+    if (i % 3 == 0) {
+      continue; // several changes between syncs.
+    }
+    prop->sync(p_);
+    checkActs_(prop);
+  }
+
+  delete prop;
+}
+
+
+// Bounds tightened by propagate() are applied to the rows incrementally too.
+void LinPropagatorUT::testPropagate()
+{
+  LinPropagator *prop = new LinPropagator(1e-6, infty);
+  bool changed = false;
+  ModQ mods;
+  UInt nintmods = 0;
+  SolveStatus status;
+
+  prop->sync(p_);
+  status = prop->propagate(p_, 10, &changed, &mods, &nintmods);
+  CPPUNIT_ASSERT(SolvedInfeasible != status);
+  checkActs_(prop);
+
+  // the last row gives x3 >= -50/7, and then the third gives
+  // x2 <= 8 + 5 + 50/7.
+  CPPUNIT_ASSERT(true == changed);
+  CPPUNIT_ASSERT(fabs(p_->getVariable(3)->getLb() + 50.0/7) < 1e-9);
+  CPPUNIT_ASSERT(fabs(p_->getVariable(2)->getUb() - 13.0 - 50.0/7) < 1e-9);
+
+  // tighten more after a branching-like change.
+  p_->changeBound(p_->getVariable(0), Lower, 8.0);
+  prop->sync(p_);
+  checkActs_(prop);
+  status = prop->propagate(p_, 10, &changed, &mods, &nintmods);
+  CPPUNIT_ASSERT(SolvedInfeasible != status);
+  checkActs_(prop);
+
+  for (ModQ::iterator it=mods.begin(); it!=mods.end(); ++it) {
+    delete *it;
+  }
+  delete prop;
+}
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
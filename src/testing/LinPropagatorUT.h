@@ -0,0 +1,57 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+#ifndef LINPROPAGATORUT_H
+#define LINPROPAGATORUT_H
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "Types.h"
+
+using namespace Minotaur;
+
+// Test the incremental activities of LinPropagator.
+class LinPropagatorUT : public CppUnit::TestCase {
+
+public:
+  LinPropagatorUT(std::string name) : TestCase(name) {}
+  LinPropagatorUT() {}
+
+  void setUp();
+  void tearDown();
+
+  void testBoundChanges();
+  void testPropagate();
+
+  CPPUNIT_TEST_SUITE(LinPropagatorUT);
+  CPPUNIT_TEST(testBoundChanges);
+  CPPUNIT_TEST(testPropagate);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  EnvPtr env_;
+  ProblemPtr p_;
+
+  // Compare the activities kept by prop with ones computed from the bounds.
+  void checkActs_(LinPropagator *prop);
+};
+
+#endif
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
@@ -257,6 +257,48 @@ void LinearFunctionTest::testFix()
 }
 
 
+void LinearFunctionTest::testFreeze()
+{
+  VariablePtr x0, x1, x2;
+  LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+  double x[3] = {1.0, 5.0, -1.0};
+  double g[3] = {0.0, 0.0, 0.0};
+  double l, u;
+
+  x0 = new Variable(0, 2, 0.0, 1.0, Integer, "x0");
+  x1 = new Variable(1, 0, -2.0, 3.0, Integer, "x1");
+  x2 = new Variable(2, 1, -1.0, 1.0, Integer, "x2");
+
+  // 2x0 - 6x1 + x2, with indices of variables not in the order of ids.
+  lf->addTerm(x0, 2.0);
+  lf->addTerm(x1,-6.0);
+  lf->addTerm(x2, 1.0);
+  lf->freeze();
+
+  CPPUNIT_ASSERT(lf->eval(x) == (2.0*(-1.0) - 6.0*1.0 + 1.0*5.0));
+  lf->evalGradient(g);
+  CPPUNIT_ASSERT(g[0] == -6.0);
+  CPPUNIT_ASSERT(g[1] ==  1.0);
+  CPPUNIT_ASSERT(g[2] ==  2.0);
+
+  lf->computeBounds(&l, &u);
+  CPPUNIT_ASSERT(l == -18.0 - 1.0);
+  CPPUNIT_ASSERT(u ==  2.0 + 12.0 + 1.0);
+
+  // modifying the function must not use the stale arrays.
+  lf->incTerm(x1, 6.0);
+  CPPUNIT_ASSERT(lf->eval(x) == (2.0*(-1.0) + 1.0*5.0));
+  lf->computeBounds(&l, &u);
+  CPPUNIT_ASSERT(l == -1.0);
+  CPPUNIT_ASSERT(u ==  3.0);
+
+  delete lf;
+  delete x0;
+  delete x1;
+  delete x2;
+}
+
+
 // Local Variables: 
 // mode: c++ 
 // eval: (c-set-style "k&r") 
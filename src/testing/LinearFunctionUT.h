@@ -34,12 +34,14 @@ public:
   CPPUNIT_TEST(testGetObj);
   CPPUNIT_TEST(testOperations);
   CPPUNIT_TEST(testFix);
+  CPPUNIT_TEST(testFreeze);
   CPPUNIT_TEST_SUITE_END();
 
   void testGetCoeffs();
   void testGetObj();
   void testOperations();
   void testFix();
+  void testFreeze();
 
 private:
   EnvPtr env_;
@@ -0,0 +1,170 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+#include <cmath>
+
+#include "MinotaurConfig.h"
+#include "NLPCache.h"
+#include "NLPCacheUT.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(NLPCacheUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(NLPCacheUT, "NLPCacheUT");
+
+using namespace Minotaur;
+
+
+/// Key of the i-th NLP: (i, 1, 0).
+static DoubleVector cacheKey(UInt i)
+{
+  DoubleVector key(3, 0.0);
+
+  key[0] = i;
+  key[1] = 1.0;
+  return key;
+}
+
+
+/// Insert the i-th NLP with a solution of size n, filled with i.
+static void cacheInsert(NLPCache &cache, UInt i, UInt n)
+{
+  DoubleVector x(n, (double) i);
+
+  cache.insert(cacheKey(i), ProvenOptimal, 10.0*i, &(x[0]), n);
+}
+
+
+/// Check that the i-th NLP is in the cache with a solution of size n.
+static bool cacheHas(NLPCache &cache, UInt i, UInt n)
+{
+  EngineStatus status = EngineUnknownStatus;
+  double obj = 0.0;
+  DoubleVector x;
+
+  if (false==cache.find(cacheKey(i), &status, &obj, x)) {
+    return false;
+  }
+  CPPUNIT_ASSERT(ProvenOptimal==status);
+  CPPUNIT_ASSERT(10.0*i==obj);
+  CPPUNIT_ASSERT(n==x.size());
+  for (UInt j=0; j<n; ++j) {
+    CPPUNIT_ASSERT((double) i==x[j]);
+  }
+  return true;
+}
+
+
+void NLPCacheUT::testBytes()
+{
+  // an entry with 1000 doubles takes a bit more than 8000 bytes, so four
+  // of them fit.
+  NLPCache cache(100, 40000);
+
+  for (UInt i=0; i<6; ++i) {
+    cacheInsert(cache, i, 1000);
+  }
+  CPPUNIT_ASSERT(4 == cache.getSize());
+
+  // 2 is used, so 3 is the least recently used one.
+  CPPUNIT_ASSERT(true == cacheHas(cache, 2, 1000));
+  cacheInsert(cache, 6, 1000);
+  CPPUNIT_ASSERT(4 == cache.getSize());
+  CPPUNIT_ASSERT(false == cacheHas(cache, 0, 1000));
+  CPPUNIT_ASSERT(false == cacheHas(cache, 1, 1000));
+  CPPUNIT_ASSERT(false == cacheHas(cache, 3, 1000));
+  CPPUNIT_ASSERT(true == cacheHas(cache, 4, 1000));
+  CPPUNIT_ASSERT(true == cacheHas(cache, 5, 1000));
+
+  // an entry larger than the bound is not stored and removes nothing.
+  cacheInsert(cache, 7, 10000);
+  CPPUNIT_ASSERT(4 == cache.getSize());
+  CPPUNIT_ASSERT(false == cacheHas(cache, 7, 10000));
+  CPPUNIT_ASSERT(true == cacheHas(cache, 2, 1000));
+  CPPUNIT_ASSERT(true == cacheHas(cache, 6, 1000));
+
+  // a small entry fits next to the large ones.
+  cacheInsert(cache, 8, 10);
+  CPPUNIT_ASSERT(5 == cache.getSize());
+  CPPUNIT_ASSERT(true == cacheHas(cache, 4, 1000));
+  CPPUNIT_ASSERT(true == cacheHas(cache, 8, 10));
+}
+
+
+void NLPCacheUT::testCacheable()
+{
+  NLPCache cache(10, 1048576);
+  NLPCache none(0, 1048576);
+  EngineStatus st[] = {ProvenUnbounded, EngineIterationLimit,
+                       ProvenFailedCQFeas, ProvenFailedCQInfeas, FailedFeas,
+                       FailedInfeas, EngineError, EngineUnknownStatus};
+  EngineStatus status;
+  double x[2] = {1.0, 2.0};
+  double obj;
+  DoubleVector y;
+
+  for (UInt i=0; i<8; ++i) {
+    CPPUNIT_ASSERT(false == NLPCache::isCacheable(st[i]));
+    cache.insert(cacheKey(i), st[i], 1.0, x, 2);
+  }
+  CPPUNIT_ASSERT(0 == cache.getSize());
+  for (UInt i=0; i<8; ++i) {
+    CPPUNIT_ASSERT(false == cache.find(cacheKey(i), &status, &obj, y));
+  }
+
+  // infeasible NLPs give cuts as well.
+  cache.insert(cacheKey(0), ProvenLocalInfeasible, 5.0, x, 2);
+  CPPUNIT_ASSERT(true == cache.find(cacheKey(0), &status, &obj, y));
+  CPPUNIT_ASSERT(ProvenLocalInfeasible == status && 5.0 == obj);
+
+  // the first result of an NLP is kept.
+  cache.insert(cacheKey(0), ProvenOptimal, 3.0, x, 2);
+  CPPUNIT_ASSERT(1 == cache.getSize());
+  CPPUNIT_ASSERT(true == cache.find(cacheKey(0), &status, &obj, y));
+  CPPUNIT_ASSERT(ProvenLocalInfeasible == status && 5.0 == obj);
+
+  // a cache without entries stores nothing.
+  none.insert(cacheKey(0), ProvenOptimal, 3.0, x, 2);
+  CPPUNIT_ASSERT(0 == none.getSize());
+  CPPUNIT_ASSERT(false == none.find(cacheKey(0), &status, &obj, y));
+}
+
+
+void NLPCacheUT::testLRU()
+{
+  NLPCache cache(3, 1048576);
+
+  cacheInsert(cache, 1, 5);
+  cacheInsert(cache, 2, 5);
+  cacheInsert(cache, 3, 5);
+  CPPUNIT_ASSERT(3 == cache.getSize());
+
+  // finding 1 makes 2 the least recently used entry.
+  CPPUNIT_ASSERT(true == cacheHas(cache, 1, 5));
+  cacheInsert(cache, 4, 5);
+  CPPUNIT_ASSERT(3 == cache.getSize());
+  CPPUNIT_ASSERT(false == cacheHas(cache, 2, 5));
+
+  // order of use is now 3, 1, 4, so 3 goes next.
+  CPPUNIT_ASSERT(true == cacheHas(cache, 3, 5));
+  CPPUNIT_ASSERT(true == cacheHas(cache, 1, 5));
+  CPPUNIT_ASSERT(true == cacheHas(cache, 4, 5));
+  cacheInsert(cache, 5, 5);
+  CPPUNIT_ASSERT(false == cacheHas(cache, 3, 5));
+  CPPUNIT_ASSERT(true == cacheHas(cache, 1, 5));
+  CPPUNIT_ASSERT(true == cacheHas(cache, 4, 5));
+  CPPUNIT_ASSERT(true == cacheHas(cache, 5, 5));
+  CPPUNIT_ASSERT(3 == cache.getSize());
+}
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
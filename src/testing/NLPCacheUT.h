@@ -0,0 +1,52 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+#ifndef NLPCACHEUT_H
+#define NLPCACHEUT_H
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "Types.h"
+
+using namespace Minotaur;
+
+// Test the bounded LRU cache of fixed-integer NLP results.
+class NLPCacheUT : public CppUnit::TestCase {
+
+public:
+  NLPCacheUT(std::string name) : TestCase(name) {}
+  NLPCacheUT() {}
+
+  void setUp() { }      // need not implement
+  void tearDown() { }   // need not implement
+  void testBytes();
+  void testCacheable();
+  void testLRU();
+
+  CPPUNIT_TEST_SUITE(NLPCacheUT);
+  CPPUNIT_TEST(testBytes);
+  CPPUNIT_TEST(testCacheable);
+  CPPUNIT_TEST(testLRU);
+  CPPUNIT_TEST_SUITE_END();
+
+};
+
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
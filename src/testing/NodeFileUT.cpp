@@ -0,0 +1,210 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+#include <cmath>
+#include <sstream>
+
+#include "MinotaurConfig.h"
+#include "Branch.h"
+#include "Node.h"
+#include "NodeFile.h"
+#include "NodeFileUT.h"
+#include "NodeHeap.h"
+#include "VarBoundMod.h"
+#include "Variable.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(NodeFileUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(NodeFileUT, "NodeFileUT");
+
+using namespace Minotaur;
+
+
+void NodeFileUT::setUp()
+{
+  root_ = (NodePtr) new Node();
+  v0_ = (VariablePtr) new Variable(0, 0, 0.0, 10.0, Integer, "x0");
+  v1_ = (VariablePtr) new Variable(1, 1, 0.0, 10.0, Continuous, "x1");
+}
+
+
+void NodeFileUT::tearDown()
+{
+  for (NodePtrIterator it=root_->childrenBegin(); it!=root_->childrenEnd();
+       ++it) {
+    delete *it;
+  }
+  delete root_;
+  delete v0_;
+  delete v1_;
+}
+
+
+NodePtr NodeFileUT::newChild_(UInt id, double lb, double tb_score,
+                              UInt depth)
+{
+  BranchPtr br = (BranchPtr) new Branch();
+  NodePtr node;
+
+  br->addPMod((VarBoundModPtr) new VarBoundMod(v0_, Upper, id%10));
+  br->addRMod((VarBoundModPtr) new VarBoundMod(v0_, Upper, id%10));
+  br->addRMod((VarBoundMod2Ptr) new VarBoundMod2(v1_, 0.5, 2.0+id));
+  br->setActivity(0.25);
+  node = (NodePtr) new Node(root_, br);
+  node->setId(id);
+  node->setLb(lb);
+  node->setTbScore(tb_score);
+  node->setDepth(depth);
+  root_->addChild(node);
+  return node;
+}
+
+
+void NodeFileUT::testChildCount()
+{
+  NodeFile file;
+  NodePtr n1 = newChild_(1, 1.0, 0.0, 1);
+  NodePtr n2 = newChild_(2, 2.0, 0.0, 1);
+
+  newChild_(3, 3.0, 0.0, 1);
+  CPPUNIT_ASSERT(3==root_->getNumChildren());
+
+  // the root counts the nodes written to the file.
+  CPPUNIT_ASSERT(file.write(n1));
+  CPPUNIT_ASSERT(file.write(n2));
+  CPPUNIT_ASSERT(2==file.getSize());
+  CPPUNIT_ASSERT(3==root_->getNumChildren());
+  CPPUNIT_ASSERT(1==root_->childrenEnd()-root_->childrenBegin());
+
+  // and adds them back to its children when they are read.
+  n1 = file.read();
+  CPPUNIT_ASSERT(n1 && 1==n1->getId());
+  CPPUNIT_ASSERT(3==root_->getNumChildren());
+  CPPUNIT_ASSERT(2==root_->childrenEnd()-root_->childrenBegin());
+  n2 = file.read();
+  CPPUNIT_ASSERT(n2 && 2==n2->getId());
+  CPPUNIT_ASSERT(3==root_->getNumChildren());
+  CPPUNIT_ASSERT(3==root_->childrenEnd()-root_->childrenBegin());
+  CPPUNIT_ASSERT(file.isEmpty());
+  CPPUNIT_ASSERT(0==file.read());
+
+  // nodes that have children are not written.
+  n1->addChild(n2);
+  CPPUNIT_ASSERT(false==file.write(n1));
+  n1->removeChildren();
+}
+
+
+void NodeFileUT::testOrder()
+{
+  // enough nodes that the file is compacted while they are read.
+  const UInt n = 20000;
+  NodeFile file;
+  NodeHeap heap(NodeHeap::Value);
+  NodePtrVector twins(n);
+  NodePtr node;
+  std::stringstream stats;
+  double lb, tb_score;
+  UInt depth;
+
+  for (UInt i=1; i<=n; ++i) {
+    // many nodes have the same bound, so that ties are broken.
+    lb = (i*7919)%101;
+    tb_score = (i%3==0) ? 0.0 : (i*104729)%13;
+    depth = 1+(i*31)%17;
+    node = newChild_(i, lb, tb_score, depth);
+    CPPUNIT_ASSERT(file.write(node));
+
+    // the same node in a heap of active nodes.
+    twins[i-1] = (NodePtr) new Node();
+    twins[i-1]->setId(i);
+    twins[i-1]->setLb(lb);
+    twins[i-1]->setTbScore(tb_score);
+    twins[i-1]->setDepth(depth);
+    heap.push(twins[i-1]);
+  }
+  CPPUNIT_ASSERT(n==file.getSize());
+  CPPUNIT_ASSERT(0.0==file.getBestLB());
+  CPPUNIT_ASSERT(root_->childrenBegin()==root_->childrenEnd());
+
+  for (UInt i=0; i<n; ++i) {
+    CPPUNIT_ASSERT(file.comesBefore(heap.top())==false);
+    node = file.read();
+    CPPUNIT_ASSERT(node);
+    CPPUNIT_ASSERT(node->getId()==heap.top()->getId());
+    CPPUNIT_ASSERT(node->getLb()==heap.top()->getLb());
+    CPPUNIT_ASSERT(node->getBranch()->getActivity()==0.25);
+    CPPUNIT_ASSERT(2==node->getBranch()->rModsEnd()-
+                   node->getBranch()->rModsBegin());
+    heap.pop();
+  }
+  CPPUNIT_ASSERT(file.isEmpty());
+  CPPUNIT_ASSERT(INFINITY==file.getBestLB());
+  file.writeStats(stats);
+  CPPUNIT_ASSERT(std::string::npos==
+                 stats.str().find("times compacted     = 0"));
+
+  for (UInt i=0; i<n; ++i) {
+    delete twins[i];
+  }
+}
+
+
+void NodeFileUT::testRoundTrip()
+{
+  NodeFile file;
+  NodePtr node = newChild_(4, 2.5, 1.5, 3);
+  VarBoundModPtr mod;
+  VarBoundMod2Ptr mod2;
+  BranchPtr br;
+  ModificationConstIterator it;
+
+  node->setVioVal(0.125);
+  CPPUNIT_ASSERT(file.isEmpty());
+  CPPUNIT_ASSERT(INFINITY==file.getBestLB());
+  CPPUNIT_ASSERT(file.write(node));
+  CPPUNIT_ASSERT(1==file.getSize());
+  CPPUNIT_ASSERT(2.5==file.getBestLB());
+
+  node = file.read();
+  CPPUNIT_ASSERT(node);
+  CPPUNIT_ASSERT(file.isEmpty());
+  CPPUNIT_ASSERT(INFINITY==file.getBestLB());
+  CPPUNIT_ASSERT(4==node->getId());
+  CPPUNIT_ASSERT(2.5==node->getLb());
+  CPPUNIT_ASSERT(1.5==node->getTbScore());
+  CPPUNIT_ASSERT(3==node->getDepth());
+  CPPUNIT_ASSERT(0.125==node->getVioVal());
+  CPPUNIT_ASSERT(root_==node->getParent());
+  CPPUNIT_ASSERT(NodeNotProcessed==node->getStatus());
+  CPPUNIT_ASSERT(0==node->getWarmStart());
+
+  br = node->getBranch();
+  CPPUNIT_ASSERT(0.25==br->getActivity());
+  CPPUNIT_ASSERT(1==br->pModsEnd()-br->pModsBegin());
+  mod = dynamic_cast<VarBoundModPtr>(*(br->pModsBegin()));
+  CPPUNIT_ASSERT(mod && v0_==mod->getVar());
+  CPPUNIT_ASSERT(Upper==mod->getLU() && 4.0==mod->getNewVal());
+  CPPUNIT_ASSERT(2==br->rModsEnd()-br->rModsBegin());
+  it = br->rModsBegin();
+  mod = dynamic_cast<VarBoundModPtr>(*it);
+  CPPUNIT_ASSERT(mod && v0_==mod->getVar());
+  ++it;
+  mod2 = dynamic_cast<VarBoundMod2Ptr>(*it);
+  CPPUNIT_ASSERT(mod2 && v1_==mod2->getVar());
+  CPPUNIT_ASSERT(0.5==mod2->getNewLb() && 6.0==mod2->getNewUb());
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,60 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+#ifndef NODEFILEUT_H
+#define NODEFILEUT_H
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "Types.h"
+
+using namespace Minotaur;
+
+// Test the file of active nodes.
+class NodeFileUT : public CppUnit::TestCase {
+
+public:
+  NodeFileUT(std::string name) : TestCase(name) {}
+  NodeFileUT() {}
+
+  void setUp();
+  void tearDown();
+
+  void testChildCount();
+  void testOrder();
+  void testRoundTrip();
+
+  CPPUNIT_TEST_SUITE(NodeFileUT);
+  CPPUNIT_TEST(testChildCount);
+  CPPUNIT_TEST(testOrder);
+  CPPUNIT_TEST(testRoundTrip);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  NodePtr root_;
+  VariablePtr v0_;
+  VariablePtr v1_;
+
+  // Create a child of root_ that changes the bounds of v0_ and v1_.
+  NodePtr newChild_(UInt id, double lb, double tb_score, UInt depth);
+};
+
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
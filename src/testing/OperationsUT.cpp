@@ -81,6 +81,46 @@ void OperationsTest::testSortVarX()
 }
 
 
+void OperationsTest::testRenumberRows()
+{
+  IntVector map;
+  UIntVector dels;
+
+  for (int i=0; i<6; ++i) {
+    map.push_back(i);
+  }
+
+  // delete rows 1 and 4.
+  dels.push_back(1);
+  dels.push_back(4);
+  renumberRows(map, dels);
+  CPPUNIT_ASSERT(map[0]==0);
+  CPPUNIT_ASSERT(map[1]==-1);
+  CPPUNIT_ASSERT(map[2]==1);
+  CPPUNIT_ASSERT(map[3]==2);
+  CPPUNIT_ASSERT(map[4]==-1);
+  CPPUNIT_ASSERT(map[5]==3);
+
+  // a second round uses the new indices: delete what were rows 0 and 5.
+  dels.clear();
+  dels.push_back(0);
+  dels.push_back(3);
+  renumberRows(map, dels);
+  CPPUNIT_ASSERT(map[0]==-1);
+  CPPUNIT_ASSERT(map[1]==-1);
+  CPPUNIT_ASSERT(map[2]==0);
+  CPPUNIT_ASSERT(map[3]==1);
+  CPPUNIT_ASSERT(map[4]==-1);
+  CPPUNIT_ASSERT(map[5]==-1);
+
+  // nothing deleted.
+  dels.clear();
+  renumberRows(map, dels);
+  CPPUNIT_ASSERT(map[2]==0);
+  CPPUNIT_ASSERT(map[3]==1);
+}
+
+
 // Local Variables: 
 // mode: c++ 
 // eval: (c-set-style "k&r") 
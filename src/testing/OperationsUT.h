@@ -29,11 +29,13 @@ public:
   CPPUNIT_TEST(testGcd);
   CPPUNIT_TEST(testToLower);
   CPPUNIT_TEST(testSortVarX);
+  CPPUNIT_TEST(testRenumberRows);
   CPPUNIT_TEST_SUITE_END();
 
   void testGcd();
   void testToLower();
   void testSortVarX();
+  void testRenumberRows();
 private:
 
 };
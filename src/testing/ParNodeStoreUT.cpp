@@ -0,0 +1,204 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+#include <cmath>
+#include <omp.h>
+
+#include "MinotaurConfig.h"
+#include "Node.h"
+#include "ParNodeStore.h"
+#include "ParNodeStoreUT.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ParNodeStoreUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ParNodeStoreUT, "ParNodeStoreUT");
+
+using namespace Minotaur;
+
+
+/// A node with this id and lower bound.
+static NodePtr storeNode(UInt id, double lb)
+{
+  NodePtr node = new Node();
+
+  node->setId(id);
+  node->setLb(lb);
+  return node;
+}
+
+
+void ParNodeStoreUT::testBestFirst()
+{
+  ParNodeStore store(1, BestFirst);
+  double lbs[] = {4.0, 1.0, 7.0, 3.0, 9.0, 2.0, 8.0, 5.0, 6.0, 0.0};
+  NodePtr node;
+
+  for (UInt i=0; i<10; ++i) {
+    store.push(storeNode(i, lbs[i]));
+  }
+  for (UInt i=0; i<10; ++i) {
+    node = store.take();
+    CPPUNIT_ASSERT(node);
+    CPPUNIT_ASSERT((double) i == node->getLb());
+    delete node;
+  }
+  CPPUNIT_ASSERT(0 == store.take());
+  CPPUNIT_ASSERT(true == store.isEmpty());
+}
+
+
+void ParNodeStoreUT::testBounds()
+{
+  ParNodeStore store(2, BestFirst);
+  NodePtr node;
+
+  CPPUNIT_ASSERT(INFINITY == store.getBestLB());
+  CPPUNIT_ASSERT(0 == store.getSize());
+
+  store.push(storeNode(0, 5.0));
+  store.push(storeNode(1, 3.0));
+  store.push(storeNode(2, 8.0));
+  CPPUNIT_ASSERT(3.0 == store.getBestLB());
+  CPPUNIT_ASSERT(3 == store.getSize());
+
+  node = store.take();
+  CPPUNIT_ASSERT(1 == node->getId());
+  CPPUNIT_ASSERT(5.0 == store.getBestLB());
+  CPPUNIT_ASSERT(2 == store.getSize());
+  delete node;
+
+  // a worse node does not change the bound.
+  store.push(storeNode(3, 6.0));
+  CPPUNIT_ASSERT(5.0 == store.getBestLB());
+  CPPUNIT_ASSERT(3 == store.getSize());
+
+  // pruned the way the tree manager prunes: top() and pop().
+  node = store.top();
+  CPPUNIT_ASSERT(0 == node->getId());
+  store.pop();
+  delete node;
+  CPPUNIT_ASSERT(6.0 == store.getBestLB());
+  CPPUNIT_ASSERT(2 == store.getSize());
+
+  node = store.take();
+  CPPUNIT_ASSERT(3 == node->getId());
+  delete node;
+  node = store.take();
+  CPPUNIT_ASSERT(2 == node->getId());
+  delete node;
+  CPPUNIT_ASSERT(INFINITY == store.getBestLB());
+  CPPUNIT_ASSERT(0 == store.getSize());
+  CPPUNIT_ASSERT(true == store.isEmpty());
+}
+
+
+void ParNodeStoreUT::testConcurrent()
+{
+  const UInt nthreads = 4;
+  const UInt nnodes = 4000;
+  ParNodeStore store(nthreads, BestFirst);
+  std::vector<NodePtr> nodes(nnodes);
+  std::vector<UIntVector> taken(nthreads);
+  UIntVector cnt(nnodes, 0);
+  UInt nt = 0;
+
+  for (UInt i=0; i<nnodes; ++i) {
+    nodes[i] = storeNode(i, (double) ((i*7919) % 1000));
+  }
+
+#pragma omp parallel num_threads(nthreads)
+  {
+    UInt t = omp_get_thread_num();
+    NodePtr node;
+
+#pragma omp single
+    nt = omp_get_num_threads();
+
+    // push and take at the same time.
+    for (UInt i=t; i<nnodes; i+=nthreads) {
+      store.push(nodes[i]);
+      if (0 == i%3) {
+        node = store.take();
+        if (node) {
+          taken[t].push_back(node->getId());
+        }
+      }
+    }
+#pragma omp barrier
+    // the stores of threads that finish early are emptied by stealing.
+    node = store.take();
+    while (node) {
+      taken[t].push_back(node->getId());
+      node = store.take();
+    }
+  }
+
+  CPPUNIT_ASSERT(nthreads == nt);
+  CPPUNIT_ASSERT(0 == store.getSize());
+  CPPUNIT_ASSERT(INFINITY == store.getBestLB());
+  for (UInt t=0; t<nthreads; ++t) {
+    for (UInt i=0; i<taken[t].size(); ++i) {
+      ++cnt[taken[t][i]];
+    }
+  }
+  for (UInt i=0; i<nnodes; ++i) {
+    CPPUNIT_ASSERT(1 == cnt[i]);
+    delete nodes[i];
+  }
+}
+
+
+void ParNodeStoreUT::testSteal()
+{
+  ParNodeStore store(3, BestFirst);
+  NodePtr node;
+  UInt nt = 0;
+
+  // threads 1 and 2 fill their own sub-stores.
+#pragma omp parallel num_threads(3)
+  {
+    UInt t = omp_get_thread_num();
+#pragma omp single
+    nt = omp_get_num_threads();
+    if (1 == t) {
+      store.push(storeNode(1, 5.0));
+      store.push(storeNode(2, 7.0));
+    } else if (2 == t) {
+      store.push(storeNode(3, 3.0));
+      store.push(storeNode(4, 9.0));
+    }
+  }
+  CPPUNIT_ASSERT(3 == nt);
+  CPPUNIT_ASSERT(4 == store.getSize());
+  CPPUNIT_ASSERT(3.0 == store.getBestLB());
+
+  // the own sub-store comes first, even if its node is worse.
+  store.push(storeNode(0, 100.0));
+  node = store.take();
+  CPPUNIT_ASSERT(0 == node->getId());
+  delete node;
+
+  // then the sub-store with the smallest bound is robbed.
+  for (UInt i=0; i<4; ++i) {
+    node = store.take();
+    CPPUNIT_ASSERT(node);
+    CPPUNIT_ASSERT(3.0+2.0*i == node->getLb());
+    delete node;
+    CPPUNIT_ASSERT(3-i == store.getSize());
+    CPPUNIT_ASSERT((i<3 ? 5.0+2.0*i : INFINITY) == store.getBestLB());
+  }
+  CPPUNIT_ASSERT(0 == store.take());
+}
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,54 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+#ifndef PARNODESTOREUT_H
+#define PARNODESTOREUT_H
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "Types.h"
+
+using namespace Minotaur;
+
+// Test the active-node store with one sub-store for each thread.
+class ParNodeStoreUT : public CppUnit::TestCase {
+
+public:
+  ParNodeStoreUT(std::string name) : TestCase(name) {}
+  ParNodeStoreUT() {}
+
+  void setUp() { }      // need not implement
+  void tearDown() { }   // need not implement
+  void testBestFirst();
+  void testBounds();
+  void testConcurrent();
+  void testSteal();
+
+  CPPUNIT_TEST_SUITE(ParNodeStoreUT);
+  CPPUNIT_TEST(testBestFirst);
+  CPPUNIT_TEST(testBounds);
+  CPPUNIT_TEST(testConcurrent);
+  CPPUNIT_TEST(testSteal);
+  CPPUNIT_TEST_SUITE_END();
+
+};
+
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
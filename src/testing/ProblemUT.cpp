@@ -139,6 +139,36 @@ void ProblemTest::testDeleteVar()
 }
 
 
+void ProblemTest::testRenumberVars()
+{
+  VariablePtr v0 = instance_->getVariable(0);
+  VariablePtr v1 = instance_->getVariable(1);
+  VariablePtr v2 = instance_->newVariable(-1.0, 1.0, Continuous);
+  LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+  ConstraintPtr c;
+  UInt version = instance_->getVarIndexVersion();
+  double x[2] = {1.5, -0.5};
+  int err = 0;
+
+  // 3x3 + x2 <= 4, evaluated from its frozen arrays.
+  lf->addTerm(v2, 3.0);
+  lf->addTerm(v1, 1.0);
+  c = instance_->newConstraint((FunctionPtr) new Function(lf), -INFINITY,
+                               4.0);
+  c->getFunction()->prepJac();
+  CPPUNIT_ASSERT(2 == v2->getIndex());
+
+  // x1 is removed at its lower bound 0, x2 and x3 get indices 0 and 1.
+  instance_->markDelete(v0);
+  instance_->delMarkedVars();
+  CPPUNIT_ASSERT(version+1 == instance_->getVarIndexVersion());
+  CPPUNIT_ASSERT(0 == v1->getIndex());
+  CPPUNIT_ASSERT(1 == v2->getIndex());
+  CPPUNIT_ASSERT(fabs(c->getFunction()->eval(x, &err) - 0.0) < 1e-12);
+  CPPUNIT_ASSERT(0 == err);
+}
+
+
 void ProblemTest::testaddToObj()
 {
   LinearFunctionPtr lf = LinearFunctionPtr(new LinearFunction());
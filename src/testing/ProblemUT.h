@@ -33,6 +33,7 @@ class ProblemTest : public CppUnit::TestCase {
     void testObjTypes();  
     void testVarTypes(); 
     void testDeleteVar(); 
+    void testRenumberVars(); 
     void testChangeBound(); 
     void testaddToObj(); 
  
@@ -43,6 +44,7 @@ class ProblemTest : public CppUnit::TestCase {
     CPPUNIT_TEST(testObjTypes); 
     CPPUNIT_TEST(testVarTypes);
     CPPUNIT_TEST(testDeleteVar);
+    CPPUNIT_TEST(testRenumberVars);
     CPPUNIT_TEST(testChangeBound); 
     CPPUNIT_TEST(testaddToObj);  
     CPPUNIT_TEST_SUITE_END();
@@ -0,0 +1,191 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+#include "MinotaurConfig.h"
+#include "PseudoCosts.h"
+#include "PseudoCostsUT.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(PseudoCostsUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(PseudoCostsUT, "PseudoCostsUT");
+
+using namespace Minotaur;
+
+typedef std::map<UInt, double> PCostModel;
+
+
+/// A record whose fields are all derived from val.
+static PCostRecord pcRec(double val)
+{
+  PCostRecord rec;
+  rec.down = val;
+  rec.up = 2*val;
+  rec.timesDown = (UInt) val;
+  rec.timesUp = (UInt) val + 1;
+  rec.lastStrBranched = (UInt) val + 2;
+  return rec;
+}
+
+
+/// True if pc has exactly the records of model, made by pcRec().
+static bool pcSame(ConstPseudoCostsPtr pc, const PCostModel &model,
+                   UInt max_index)
+{
+  const PCostRecord *rec;
+  PCostModel::const_iterator it;
+
+  if (pc->getSize() != model.size()) {
+    return false;
+  }
+  for (UInt i=0; i<=max_index; ++i) {
+    rec = pc->find(i);
+    it = model.find(i);
+    if (it == model.end()) {
+      if (rec) {
+        return false;
+      }
+    } else if (!rec || rec->down != it->second || rec->up != 2*it->second ||
+               rec->timesDown != (UInt) it->second ||
+               rec->lastStrBranched != (UInt) it->second + 2) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+void PseudoCostsUT::testChild()
+{
+  PseudoCostsPtr parent = new PseudoCosts();
+  PseudoCostsPtr child, grandchild;
+  PCostModel pmodel, cmodel;
+
+  for (UInt i=0; i<100; ++i) {
+    parent->set(i, pcRec(i));
+    pmodel[i] = i;
+  }
+  child = new PseudoCosts(parent);
+  cmodel = pmodel;
+  CPPUNIT_ASSERT(pcSame(child, cmodel, 5000));
+
+  // replace a record, and add one that makes the trie deeper.
+  child->set(5, pcRec(55.0));
+  cmodel[5] = 55.0;
+  child->set(4096, pcRec(7.0));
+  cmodel[4096] = 7.0;
+  CPPUNIT_ASSERT(pcSame(child, cmodel, 5000));
+  CPPUNIT_ASSERT(pcSame(parent, pmodel, 5000));
+
+  // a change in the parent does not reach the child either.
+  parent->set(6, pcRec(66.0));
+  pmodel[6] = 66.0;
+  CPPUNIT_ASSERT(pcSame(parent, pmodel, 5000));
+  CPPUNIT_ASSERT(pcSame(child, cmodel, 5000));
+
+  // the child outlives the parent.
+  grandchild = new PseudoCosts(child);
+  delete parent;
+  delete child;
+  CPPUNIT_ASSERT(pcSame(grandchild, cmodel, 5000));
+  delete grandchild;
+
+  // a copy of NULL is empty.
+  child = new PseudoCosts(0);
+  CPPUNIT_ASSERT(0 == child->getSize());
+  CPPUNIT_ASSERT(0 == child->find(0));
+  delete child;
+}
+
+
+void PseudoCostsUT::testSiblings()
+{
+  PseudoCostsPtr parent = new PseudoCosts();
+  PseudoCostsPtr left, right;
+  PCostModel pmodel, lmodel, rmodel;
+
+  for (UInt i=0; i<40; i+=3) {
+    parent->set(i, pcRec(i));
+    pmodel[i] = i;
+  }
+  left = new PseudoCosts(parent);
+  right = new PseudoCosts(parent);
+  lmodel = rmodel = pmodel;
+
+  // both children change the same record and records next to it.
+  left->set(9, pcRec(90.0));
+  lmodel[9] = 90.0;
+  right->set(9, pcRec(91.0));
+  rmodel[9] = 91.0;
+  left->set(10, pcRec(100.0));
+  lmodel[10] = 100.0;
+  right->set(300, pcRec(3.0));
+  rmodel[300] = 3.0;
+
+  CPPUNIT_ASSERT(pcSame(parent, pmodel, 400));
+  CPPUNIT_ASSERT(pcSame(left, lmodel, 400));
+  CPPUNIT_ASSERT(pcSame(right, rmodel, 400));
+
+  delete left;
+  CPPUNIT_ASSERT(pcSame(parent, pmodel, 400));
+  CPPUNIT_ASSERT(pcSame(right, rmodel, 400));
+  delete right;
+  delete parent;
+}
+
+
+// Grow a random tree of versions, change random records of random versions
+// and compare every version with a map after each change.
+void PseudoCostsUT::testRandomTree()
+{
+  const UInt max_index = 700;
+  std::vector<PseudoCostsPtr> pcs;
+  std::vector<PCostModel> models;
+  UInt k, idx;
+  double val;
+
+  srand(1);
+  pcs.push_back(new PseudoCosts());
+  models.push_back(PCostModel());
+  for (UInt iter=0; iter<400; ++iter) {
+    k = rand() % pcs.size();
+    if (rand() % 4 == 0) {
+      pcs.push_back(new PseudoCosts(pcs[k]));
+      models.push_back(models[k]);
+      continue;
+    }
+    idx = rand() % (max_index+1);
+    val = rand() % 1000;
+    pcs[k]->set(idx, pcRec(val));
+    models[k][idx] = val;
+    for (UInt i=0; i<pcs.size(); ++i) {
+      CPPUNIT_ASSERT(pcSame(pcs[i], models[i], max_index));
+    }
+  }
+
+  // delete in an order different from creation.
+  for (UInt i=0; i<pcs.size(); i+=2) {
+    delete pcs[i];
+    pcs[i] = 0;
+  }
+  for (UInt i=1; i<pcs.size(); i+=2) {
+    CPPUNIT_ASSERT(pcSame(pcs[i], models[i], max_index));
+    delete pcs[i];
+  }
+}
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
@@ -0,0 +1,49 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+#ifndef PSEUDOCOSTSUT_H
+#define PSEUDOCOSTSUT_H
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "Types.h"
+
+using namespace Minotaur;
+
+// Test the copy-on-write versions of pseudocosts.
+class PseudoCostsUT : public CppUnit::TestCase {
+
+public:
+  PseudoCostsUT(std::string name) : TestCase(name) {}
+  PseudoCostsUT() {}
+
+  void testChild();
+  void testSiblings();
+  void testRandomTree();
+
+  CPPUNIT_TEST_SUITE(PseudoCostsUT);
+  CPPUNIT_TEST(testChild);
+  CPPUNIT_TEST(testSiblings);
+  CPPUNIT_TEST(testRandomTree);
+  CPPUNIT_TEST_SUITE_END();
+};
+
+#endif
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
@@ -231,6 +231,36 @@ void QuadraticFunctionTest::testEigen()
 }
 
 
+void QuadraticFunctionTest::testFreeze()
+{
+  double x[4] = {1.0, 2.0, 3.0, 4.0};
+  double g[4] = {0.0, 0.0, 0.0, 0.0};
+  double l, u;
+
+  // x0^2 + 2x0.x1 + x1^2
+  CPPUNIT_ASSERT(q_->eval(x) == 9.0);
+  q_->freeze();
+  CPPUNIT_ASSERT(q_->eval(x) == 9.0);
+
+  q_->evalGradient(x, g);
+  CPPUNIT_ASSERT(g[0] == 6.0);
+  CPPUNIT_ASSERT(g[1] == 6.0);
+  CPPUNIT_ASSERT(g[2] == 0.0);
+
+  // modifying the function must not use the stale arrays.
+  q_->incTerm(vars_[2], vars_[3], 1.0);
+  CPPUNIT_ASSERT(q_->eval(x) == 21.0);
+  q_->multiply(2.0);
+  CPPUNIT_ASSERT(q_->eval(x) == 42.0);
+
+  // x0 in [0, 1], x1 in [9, 1], x2 in [-1, 1], x3 in [-100, 100].
+  q1_->computeBounds(&l, &u);
+  CPPUNIT_ASSERT(q1_->eval(x) == -12.0);
+  CPPUNIT_ASSERT(l == -2.0*9.0 - 2.0*81.0);
+  CPPUNIT_ASSERT(u == -2.0*0.0 - 2.0*1.0);
+}
+
+
 // Local Variables: 
 // mode: c++ 
 // eval: (c-set-style "k&r") 
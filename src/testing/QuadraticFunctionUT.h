@@ -34,12 +34,14 @@ public:
   CPPUNIT_TEST(testEvaluate);
   CPPUNIT_TEST(testOperations);
   CPPUNIT_TEST(testEigen);
+  CPPUNIT_TEST(testFreeze);
   CPPUNIT_TEST_SUITE_END();
 
   void testGetCoeffs();
   void testEvaluate();
   void testOperations();
   void testEigen();
+  void testFreeze();
 
 private:
   std::vector <VariablePtr> vars_;
@@ -0,0 +1,164 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+#include "MinotaurConfig.h"
+#include "Constraint.h"
+#include "Environment.h"
+#include "LinearFunction.h"
+#include "Objective.h"
+#include "Problem.h"
+#include "Reader.h"
+#include "ReaderUT.h"
+#include "Variable.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ReaderUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ReaderUT, "ReaderUT");
+
+using namespace Minotaur;
+
+
+void ReaderUT::setUp()
+{
+  env_ = (EnvPtr) new Environment();
+  env_->setLogLevel(LogNone);
+}
+
+
+void ReaderUT::tearDown()
+{
+  delete env_;
+}
+
+
+int ReaderUT::readNum_(const std::string &num, double *ub)
+{
+  const char *fname = "ReaderUT_num.mps";
+  std::ofstream out(fname);
+  Reader rdr(env_);
+  ProblemPtr p;
+  int err = 0;
+
+  out << "NAME          NUM" << std::endl
+    << "ROWS" << std::endl
+    << " N  obj" << std::endl
+    << "COLUMNS" << std::endl
+    << "    x1        obj       1" << std::endl
+    << "BOUNDS" << std::endl
+    << " UP BND       x1        " << num << std::endl
+    << "ENDATA" << std::endl;
+  out.close();
+
+  p = rdr.readMps(fname, err);
+  if (p) {
+    *ub = p->getVariable(0)->getUb();
+    delete p;
+  }
+  remove(fname);
+  return err;
+}
+
+
+void ReaderUT::testRead()
+{
+  Reader rdr(env_);
+  ProblemPtr p;
+  VariablePtr x1, y1, x2;
+  ConstraintPtr c;
+  LinearFunctionPtr lf;
+  int err = 0;
+
+  p = rdr.readMps("instances/mps_eg0.mps", err);
+  CPPUNIT_ASSERT(0==err);
+  CPPUNIT_ASSERT(p);
+  CPPUNIT_ASSERT(3==p->getNumVars());
+  CPPUNIT_ASSERT(3==p->getNumCons());
+
+  // variables are in the order their columns were first seen.
+  x1 = p->getVariable(0);
+  y1 = p->getVariable(1);
+  x2 = p->getVariable(2);
+  CPPUNIT_ASSERT("x1"==x1->getName());
+  CPPUNIT_ASSERT("y1"==y1->getName());
+  CPPUNIT_ASSERT("x2"==x2->getName());
+  CPPUNIT_ASSERT(Continuous==x1->getType());
+  CPPUNIT_ASSERT(Integer==y1->getType());
+  CPPUNIT_ASSERT(Continuous==x2->getType());
+  CPPUNIT_ASSERT(0.0==x1->getLb() && 10.0==x1->getUb());
+  CPPUNIT_ASSERT(0.0==y1->getLb() && 3.0==y1->getUb());
+  CPPUNIT_ASSERT(-INFINITY==x2->getLb() && INFINITY==x2->getUb());
+
+  // L row with a range.
+  c = p->getConstraint(0);
+  CPPUNIT_ASSERT("c1"==c->getName());
+  CPPUNIT_ASSERT(fabs(c->getLb()-1.5)<1e-12 && 4.0==c->getUb());
+  lf = c->getLinearFunction();
+  CPPUNIT_ASSERT(2==lf->getNumTerms());
+  CPPUNIT_ASSERT(1.0==lf->getWeight(x1) && 1.0==lf->getWeight(y1));
+
+  // G row.
+  c = p->getConstraint(1);
+  CPPUNIT_ASSERT(1.0==c->getLb() && INFINITY==c->getUb());
+  lf = c->getLinearFunction();
+  CPPUNIT_ASSERT(2.0==lf->getWeight(x1) && 1.0==lf->getWeight(x2));
+
+  // E row.
+  c = p->getConstraint(2);
+  CPPUNIT_ASSERT(0.5==c->getLb() && 0.5==c->getUb());
+  lf = c->getLinearFunction();
+  CPPUNIT_ASSERT(1.0==lf->getWeight(y1) && -1.0==lf->getWeight(x2));
+
+  CPPUNIT_ASSERT(p->getObjective());
+  lf = p->getObjective()->getLinearFunction();
+  CPPUNIT_ASSERT(2==lf->getNumTerms());
+  CPPUNIT_ASSERT(1.0==lf->getWeight(x1) && -2.0==lf->getWeight(y1));
+
+  delete p;
+
+  p = rdr.readMps("instances/no_such_file.mps", err);
+  CPPUNIT_ASSERT(0==p && 0!=err);
+}
+
+
+// Only decimal numbers and infinity are read. Tokens that strtod would take
+// as NaN or a hexadecimal number are errors, and so is trailing text.
+void ReaderUT::testBadNumbers()
+{
+  double ub = 0.0;
+
+  CPPUNIT_ASSERT(0==readNum_("2.5", &ub) && 2.5==ub);
+  CPPUNIT_ASSERT(0==readNum_("1e30", &ub) && 1e30==ub);
+  CPPUNIT_ASSERT(0==readNum_("+.5E-3", &ub) && 5e-4==ub);
+
+  // some writers use these for infinite bounds.
+  CPPUNIT_ASSERT(0==readNum_("inf", &ub) && INFINITY==ub);
+  CPPUNIT_ASSERT(0==readNum_("+Inf", &ub) && INFINITY==ub);
+  CPPUNIT_ASSERT(0==readNum_("INFINITY", &ub) && INFINITY==ub);
+  CPPUNIT_ASSERT(0==readNum_("-Infinity", &ub) && -INFINITY==ub);
+  CPPUNIT_ASSERT(0==readNum_("-inf", &ub) && -INFINITY==ub);
+
+  CPPUNIT_ASSERT(0!=readNum_("nan", &ub));
+  CPPUNIT_ASSERT(0!=readNum_("-NaN", &ub));
+  CPPUNIT_ASSERT(0!=readNum_("0x10", &ub));
+  CPPUNIT_ASSERT(0!=readNum_("infinit", &ub));
+  CPPUNIT_ASSERT(0!=readNum_("infx", &ub));
+  CPPUNIT_ASSERT(0!=readNum_("1.5abc", &ub));
+  CPPUNIT_ASSERT(0!=readNum_("1e", &ub));
+}
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
@@ -0,0 +1,59 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+#ifndef READERUT_H
+#define READERUT_H
+
+#include <string>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "Types.h"
+
+using namespace Minotaur;
+
+// Test the MPS reader.
+class ReaderUT : public CppUnit::TestCase {
+
+public:
+  ReaderUT(std::string name) : TestCase(name) {}
+  ReaderUT() {}
+
+  void setUp();
+  void tearDown();
+
+  void testRead();
+  void testBadNumbers();
+
+  CPPUNIT_TEST_SUITE(ReaderUT);
+  CPPUNIT_TEST(testRead);
+  CPPUNIT_TEST(testBadNumbers);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  EnvPtr env_;
+
+  // Read an MPS file in which num is the upper bound of the only column.
+  // Return the error code, and the bound read in ub.
+  int readNum_(const std::string &num, double *ub);
+};
+
+#endif
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
@@ -0,0 +1,244 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+#include <cmath>
+
+#include "MinotaurConfig.h"
+#include "CGraph.h"
+#include "CNode.h"
+#include "Environment.h"
+#include "Function.h"
+#include "HessianOfLag.h"
+#include "Jacobian.h"
+#include "Option.h"
+#include "Problem.h"
+#include "SharedDAG.h"
+#include "SharedDAGUT.h"
+#include "Variable.h"
+#include "YEqCGs.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SharedDAGUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(SharedDAGUT, "SharedDAGUT");
+
+using namespace Minotaur;
+
+
+/**
+ * A problem in x0, x1, x2 whose objective and constraints have the common
+ * subexpressions exp(x0*x1) and x2^2, written differently in each graph.
+ */
+static ProblemPtr dagProblem(EnvPtr env)
+{
+  ProblemPtr p = new Problem(env);
+  VariablePtr v0, v1, v2;
+  CGraphPtr cg;
+  CNode *n, *m;
+
+  v0 = p->newVariable(0.5, 5.0, Continuous);
+  v1 = p->newVariable(0.5, 5.0, Continuous);
+  v2 = p->newVariable(0.5, 5.0, Continuous);
+
+  // exp(x0*x1) + x2^2
+  cg = new CGraph();
+  n = cg->newNode(OpMult, cg->newNode(v0), cg->newNode(v1));
+  n = cg->newNode(OpExp, n, 0);
+  m = cg->newNode(OpSqr, cg->newNode(v2), 0);
+  cg->setOut(cg->newNode(OpPlus, n, m));
+  cg->finalize();
+  p->newObjective(new Function(cg), 0.0, Minimize);
+
+  // exp(x1*x0)*x2 <= 10
+  cg = new CGraph();
+  n = cg->newNode(OpMult, cg->newNode(v1), cg->newNode(v0));
+  n = cg->newNode(OpExp, n, 0);
+  cg->setOut(cg->newNode(OpMult, n, cg->newNode(v2)));
+  cg->finalize();
+  p->newConstraint(new Function(cg), -INFINITY, 10.0);
+
+  // log(x0*x1 + x2) + x2^2 <= 5
+  cg = new CGraph();
+  n = cg->newNode(OpMult, cg->newNode(v0), cg->newNode(v1));
+  n = cg->newNode(OpPlus, n, cg->newNode(v2));
+  n = cg->newNode(OpLog, n, 0);
+  m = cg->newNode(OpSqr, cg->newNode(v2), 0);
+  cg->setOut(cg->newNode(OpPlus, n, m));
+  cg->finalize();
+  p->newConstraint(new Function(cg), -INFINITY, 5.0);
+
+  // x2^2 * exp(x0*x1) >= 1
+  cg = new CGraph();
+  n = cg->newNode(OpMult, cg->newNode(v0), cg->newNode(v1));
+  n = cg->newNode(OpExp, n, 0);
+  m = cg->newNode(OpSqr, cg->newNode(v2), 0);
+  cg->setOut(cg->newNode(OpMult, m, n));
+  cg->finalize();
+  p->newConstraint(new Function(cg), 1.0, INFINITY);
+
+  return p;
+}
+
+
+void SharedDAGUT::setUp()
+{
+  x0_ = (VariablePtr) new Variable(0, 0, 0.0, 10.0, Continuous, "x0");
+  x1_ = (VariablePtr) new Variable(1, 1, 0.0, 10.0, Continuous, "x1");
+  x2_ = (VariablePtr) new Variable(2, 2, 0.0, 10.0, Continuous, "x2");
+}
+
+
+void SharedDAGUT::tearDown()
+{
+  delete x0_;
+  delete x1_;
+  delete x2_;
+}
+
+
+void SharedDAGUT::testShare()
+{
+  SharedDAG dag;
+  CGraph cg1, cg2;
+  CNode *n1, *n2, *d1, *d2;
+  UInt nnodes;
+
+  // exp(x0*x1) + x2^2
+  n1 = cg1.newNode(OpMult, cg1.newNode(x0_), cg1.newNode(x1_));
+  n1 = cg1.newNode(OpExp, n1, 0);
+  cg1.setOut(cg1.newNode(OpPlus, n1,
+                         cg1.newNode(OpSqr, cg1.newNode(x2_), 0)));
+  cg1.finalize();
+
+  // exp(x1*x0) * 2.5
+  n2 = cg2.newNode(OpMult, cg2.newNode(x1_), cg2.newNode(x0_));
+  n2 = cg2.newNode(OpExp, n2, 0);
+  cg2.setOut(cg2.newNode(OpMult, n2, cg2.newNode(2.5)));
+  cg2.finalize();
+
+  // x0, x1, x0*x1, exp, x2, x2^2, +
+  dag.add(cg1.getOut());
+  nnodes = dag.getNumNodes();
+  CPPUNIT_ASSERT(7 == nnodes);
+
+  // the same subexpression in another graph, with the product reversed.
+  CPPUNIT_ASSERT(dag.add(n1) == dag.add(n2));
+  CPPUNIT_ASSERT(nnodes == dag.getNumNodes());
+
+  // only the constant and the outer product are new.
+  dag.add(cg2.getOut());
+  CPPUNIT_ASSERT(nnodes+2 == dag.getNumNodes());
+
+  // OpMinus is not commutative.
+  d1 = cg1.newNode(OpMinus, cg1.newNode(x0_), cg1.newNode(x1_));
+  d2 = cg1.newNode(OpMinus, cg1.newNode(x1_), cg1.newNode(x0_));
+  CPPUNIT_ASSERT(dag.add(d1) != dag.add(d2));
+  CPPUNIT_ASSERT(nnodes+4 == dag.getNumNodes());
+}
+
+
+void SharedDAGUT::testFind()
+{
+  SharedDAG dag;
+  CGraph cg1, cg2;
+  CNode *n;
+  UInt id = 0, nnodes;
+  YEqCGs yeq;
+
+  // sqrt(x0 + x1)
+  n = cg1.newNode(OpPlus, cg1.newNode(x0_), cg1.newNode(x1_));
+  cg1.setOut(cg1.newNode(OpSqrt, n, 0));
+  cg1.finalize();
+
+  // sqrt(x1 + x0) + 1
+  n = cg2.newNode(OpPlus, cg2.newNode(x1_), cg2.newNode(x0_));
+  n = cg2.newNode(OpSqrt, n, 0);
+  cg2.setOut(cg2.newNode(OpPlus, n, cg2.newNode(1.0)));
+  cg2.finalize();
+
+  // a lookup of an absent expression adds nothing.
+  CPPUNIT_ASSERT(false == dag.find(cg1.getOut(), &id));
+  CPPUNIT_ASSERT(0 == dag.getNumNodes());
+  dag.add(cg1.getOut());
+  nnodes = dag.getNumNodes();
+  CPPUNIT_ASSERT(false == dag.find(cg2.getOut(), &id));
+  CPPUNIT_ASSERT(nnodes == dag.getNumNodes());
+
+  CPPUNIT_ASSERT(true == dag.find(cg1.getOut(), &id));
+  CPPUNIT_ASSERT(id == dag.add(cg1.getOut()));
+  CPPUNIT_ASSERT(true == dag.find(n, &id));
+  CPPUNIT_ASSERT(id == dag.add(cg1.getOut()));
+
+  // auxiliary variables are found by structure.
+  CPPUNIT_ASSERT(0 == yeq.findY(&cg1));
+  yeq.insert(x2_, &cg1);
+  CPPUNIT_ASSERT(x2_ == yeq.findY(&cg1));
+  CPPUNIT_ASSERT(0 == yeq.findY(&cg2));
+}
+
+
+// The native Jacobian and Hessian of a problem are the same with and
+// without the shared DAG.
+void SharedDAGUT::testDerivs()
+{
+  EnvPtr env1 = (EnvPtr) new Environment();
+  EnvPtr env2 = (EnvPtr) new Environment();
+  ProblemPtr p1, p2;
+  double x[3] = {1.2, 0.7, 2.1};
+  double mult[3] = {1.0, -0.5, 2.0};
+  DoubleVector v1, v2;
+  int err1 = 0, err2 = 0;
+
+  env1->setLogLevel(LogNone);
+  env2->setLogLevel(LogNone);
+  env2->getOptions()->findBool("shared_dag")->setValue(true);
+  p1 = dagProblem(env1);
+  p2 = dagProblem(env2);
+  p1->setNativeDer();
+  p2->setNativeDer();
+
+  CPPUNIT_ASSERT(p1->getJacobian()->getNumNz() ==
+                 p2->getJacobian()->getNumNz());
+  v1.assign(p1->getJacobian()->getNumNz(), 0.0);
+  v2.assign(p2->getJacobian()->getNumNz(), 0.0);
+  for (UInt k=0; k<2; ++k) {
+    p1->getJacobian()->fillRowColValues(x, &(v1[0]), &err1);
+    p2->getJacobian()->fillRowColValues(x, &(v2[0]), &err2);
+    CPPUNIT_ASSERT(0 == err1 && 0 == err2);
+    for (UInt i=0; i<v1.size(); ++i) {
+      CPPUNIT_ASSERT(v1[i] == v2[i]);
+    }
+    x[1] += 0.3; // and once more at a new point.
+  }
+
+  CPPUNIT_ASSERT(p1->getHessian()->getNumNz() ==
+                 p2->getHessian()->getNumNz());
+  v1.assign(p1->getHessian()->getNumNz(), 0.0);
+  v2.assign(p2->getHessian()->getNumNz(), 0.0);
+  for (UInt k=0; k<2; ++k) {
+    p1->getHessian()->fillRowColValues(x, 1.0, mult, &(v1[0]), &err1);
+    p2->getHessian()->fillRowColValues(x, 1.0, mult, &(v2[0]), &err2);
+    CPPUNIT_ASSERT(0 == err1 && 0 == err2);
+    for (UInt i=0; i<v1.size(); ++i) {
+      CPPUNIT_ASSERT(v1[i] == v2[i]);
+    }
+    x[0] -= 0.4;
+  }
+
+  delete p1;
+  delete p2;
+  delete env1;
+  delete env2;
+}
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
@@ -0,0 +1,57 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+#ifndef SHAREDDAGUT_H
+#define SHAREDDAGUT_H
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "Types.h"
+
+using namespace Minotaur;
+
+// Test the hash-consed DAG of expressions.
+class SharedDAGUT : public CppUnit::TestCase {
+
+public:
+  SharedDAGUT(std::string name) : TestCase(name) {}
+  SharedDAGUT() {}
+
+  void setUp();
+  void tearDown();
+
+  void testShare();
+  void testFind();
+  void testDerivs();
+
+  CPPUNIT_TEST_SUITE(SharedDAGUT);
+  CPPUNIT_TEST(testShare);
+  CPPUNIT_TEST(testFind);
+  CPPUNIT_TEST(testDerivs);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  VariablePtr x0_;
+  VariablePtr x1_;
+  VariablePtr x2_;
+};
+
+#endif
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
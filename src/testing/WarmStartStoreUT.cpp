@@ -0,0 +1,178 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+#include "MinotaurConfig.h"
+#include "Environment.h"
+#include "Option.h"
+#include "WarmStart.h"
+#include "WarmStartStore.h"
+#include "WarmStartStoreUT.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(WarmStartStoreUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(WarmStartStoreUT, "WarmStartStoreUT");
+
+using namespace Minotaur;
+
+namespace {
+  // number of TestWarmStart objects alive.
+  int numAlive = 0;
+
+  // A warm start of 1000 bytes. It is a difference from ref if both have
+  // the same key.
+  class TestWarmStart : public WarmStart {
+  public:
+    TestWarmStart(int key) : info_(true), key_(key), ref_(0) {++numAlive;}
+    ~TestWarmStart() {dropInfo(); --numAlive;}
+    void dropInfo()
+    {
+      info_ = false;
+      if (ref_ && 0==ref_->decrUseCnt()) {
+        delete ref_;
+      }
+      ref_ = 0;
+    }
+    size_t getMemSize() const {return 1000;}
+    bool hasInfo() {return info_;}
+    bool isDiff() const {return 0!=ref_;}
+    bool makeDiff(WarmStart *ref)
+    {
+      TestWarmStart *ref2 = dynamic_cast<TestWarmStart *>(ref);
+      if (!ref2 || ref2->key_!=key_) {
+        return false;
+      }
+      ref_ = ref2;
+      ref_->incrUseCnt();
+      return true;
+    }
+    void write(std::ostream &) const {}
+  private:
+    bool info_;
+    int key_;
+    TestWarmStart *ref_;
+  };
+
+  // a node takes the warm start and gives it to the store.
+  TestWarmStart* branch(WarmStartStore *store, int key)
+  {
+    TestWarmStart *ws = new TestWarmStart(key);
+    ws->incrUseCnt();
+    store->add(ws);
+    return ws;
+  }
+
+  // the node is processed.
+  void process(TestWarmStart *ws)
+  {
+    if (0==ws->decrUseCnt()) {
+      delete ws;
+    }
+  }
+}
+
+
+void WarmStartStoreUT::setUp()
+{
+  env_ = new Environment();
+  numAlive = 0;
+}
+
+
+void WarmStartStoreUT::tearDown()
+{
+  delete env_;
+  CPPUNIT_ASSERT(0==numAlive);
+}
+
+
+void WarmStartStoreUT::testBudget()
+{
+  WarmStartStore *store;
+  std::vector<TestWarmStart *> open;
+
+  // room for about 20 warm starts. None is a difference.
+  env_->getOptions()->findDouble("ws_mem_budget")->setValue(20000.0/1048576);
+  store = new WarmStartStore(env_);
+  for (int i=0; i<100; ++i) {
+    open.push_back(branch(store, i));
+  }
+  CPPUNIT_ASSERT(store->getMemUsed()<=20000);
+  CPPUNIT_ASSERT(false==open[0]->hasInfo());
+  CPPUNIT_ASSERT(true==open[98]->hasInfo());
+  CPPUNIT_ASSERT(true==open[99]->hasInfo());
+  for (UInt i=0; i<open.size(); ++i) {
+    process(open[i]);
+  }
+
+  // warm starts that only the store uses are released when the list
+  // grows, even behind an old one that is still open.
+  open.clear();
+  open.push_back(branch(store, 0));
+  for (int i=1; i<1000; ++i) {
+    process(branch(store, i));
+  }
+  CPPUNIT_ASSERT(numAlive<200);
+  process(open[0]);
+  delete store;
+}
+
+
+void WarmStartStoreUT::testDiff()
+{
+  WarmStartStore *store = new WarmStartStore(env_);
+  std::vector<TestWarmStart *> open;
+
+  // warm starts with the same key are differences from the first one.
+  for (int i=0; i<10; ++i) {
+    open.push_back(branch(store, 0));
+  }
+  CPPUNIT_ASSERT(false==open[0]->isDiff());
+  for (UInt i=1; i<open.size(); ++i) {
+    CPPUNIT_ASSERT(true==open[i]->isDiff());
+  }
+
+  // a new reference does not free the old one while differences need it.
+  open.push_back(branch(store, 1));
+  CPPUNIT_ASSERT(false==open.back()->isDiff());
+  CPPUNIT_ASSERT(0!=open[0]->getUseCnt());
+  for (UInt i=0; i<open.size(); ++i) {
+    process(open[i]);
+  }
+  CPPUNIT_ASSERT(1==numAlive);
+  delete store;
+}
+
+
+void WarmStartStoreUT::testRelease()
+{
+  WarmStartStore *store = new WarmStartStore(env_);
+  TestWarmStart *first;
+
+  // without a budget, the store does not keep a warm start alive after its
+  // nodes are processed, even behind one that is still open. Only the
+  // latest reference is kept.
+  first = branch(store, 0);
+  for (int i=1; i<1000; ++i) {
+    process(branch(store, i));
+  }
+  CPPUNIT_ASSERT(2==numAlive);
+  CPPUNIT_ASSERT(0==store->getMemUsed());
+  process(first);
+  CPPUNIT_ASSERT(1==numAlive);
+  store->clear();
+  CPPUNIT_ASSERT(0==numAlive);
+  delete store;
+}
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,55 @@
+//
+//     Minotaur -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2024 The Minotaur Team.
+//
+
+#ifndef WARMSTARTSTOREUT_H
+#define WARMSTARTSTOREUT_H
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "Types.h"
+
+using namespace Minotaur;
+
+// Test the store of warm starts of open nodes.
+class WarmStartStoreUT : public CppUnit::TestCase {
+
+public:
+  WarmStartStoreUT(std::string name) : TestCase(name) {}
+  WarmStartStoreUT() {}
+
+  void setUp();
+  void tearDown();
+
+  void testBudget();
+  void testDiff();
+  void testRelease();
+
+  CPPUNIT_TEST_SUITE(WarmStartStoreUT);
+  CPPUNIT_TEST(testBudget);
+  CPPUNIT_TEST(testDiff);
+  CPPUNIT_TEST(testRelease);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  EnvPtr env_;
+};
+
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
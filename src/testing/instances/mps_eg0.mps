@@ -0,0 +1,25 @@
+* A small MILP for ReaderUT.
+NAME          MPS_EG0
+ROWS
+ N  obj
+ L  c1
+ G  c2
+ E  c3
+COLUMNS
+    x1        obj       1.0          c1        1.0
+    x1        c2        2.0
+    MARKER    'MARKER'  'INTORG'
+    y1        obj       -2.0         c1        1.0
+    y1        c3        1.0
+    MARKER    'MARKER'  'INTEND'
+    x2        c2        1.0          c3        -1.0
+RHS
+    RHS       c1        4.0          c2        1.0
+    RHS       c3        0.5
+RANGES
+    RNG       c1        2.5
+BOUNDS
+ UP BND       x1        10.0
+ MI BND       x2
+ UP BND       y1        3
+ENDATA